@@ -0,0 +1,41 @@
+/*
+    Benchmarks: mailbox handoff and tally redraw
+    Video Walrus 2025
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "../test/tally_test.h"
+
+// One publish on the UDP task and the render task's read of it
+static void BM_MailboxPublishRead(benchmark::State &state) {
+  TallyMailbox mailbox;
+  TallySnapshot snap = {};
+  TallySnapshot out;
+  uint32_t seq = 0;
+  for (auto _ : state) {
+    snap.state ^= 3;
+    mailbox.publish(snap);
+    benchmark::DoNotOptimize(mailbox.read(out, seq));
+  }
+}
+BENCHMARK(BM_MailboxPublishRead);
+
+// A cut on our address: decode, handoff and one frame to the LEDs, on a
+// 7-LED ring and a 300-LED strip
+static void BM_CueToFrame(benchmark::State &state) {
+  FakeClock clock;
+  RecordingLedSink sink(state.range(0));
+  TallyMailbox mailbox;
+  TslDecoder decoder(mailbox, clock);
+  TallyRenderer renderer(sink, clock, mailbox);
+  Bytes packet = tsl31Message(0, 0x32, "CAM 1");
+  for (auto _ : state) {
+    packet[1] ^= 0x03;  // Program <-> preview
+    clock.advanceMs(20);  // Past the frame rate cap
+    decoder.decodeTsl31(packet.data(), packet.size(), clock.micros());
+    renderer.update();
+  }
+  if (sink.shows < state.iterations()) state.SkipWithError("a cue did not reach the LEDs");
+}
+BENCHMARK(BM_CueToFrame)->Arg(7)->Arg(300);
@@ -0,0 +1,114 @@
+/*
+    Benchmarks: TSL 3.1 and 5.0 decoding
+    Video Walrus 2025
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <stdio.h>
+
+#include <string>
+
+#include "../test/tally_test.h"
+#include "tsl_stream.h"
+
+// Every address 1-126 with a label, as a switcher's full refresh
+static Bytes tsl31Refresh(uint8_t control) {
+  Bytes data;
+  for (int addr = 1; addr <= TSL_MAX_ADDRESS; addr++) {
+    char label[17];
+    snprintf(label, sizeof(label), "CAMERA %03d", addr);
+    append(data, tsl31Message(addr, control, label));
+  }
+  return data;
+}
+
+// The refresh packed into one datagram
+static void BM_Tsl31RefreshOneDatagram(benchmark::State &state) {
+  FakeClock clock;
+  TallyMailbox mailbox;
+  TslDecoder decoder(mailbox, clock);
+  decoder.address = 3;
+  Bytes refresh[2] = { tsl31Refresh(0x31), tsl31Refresh(0x32) };
+  int i = 0;
+  for (auto _ : state) {
+    const Bytes &data = refresh[i ^= 1];  // Every address changes
+    benchmark::DoNotOptimize(decoder.decodeTsl31(data.data(), data.size(), clock.micros()));
+  }
+  state.SetItemsProcessed(state.iterations() * TSL_MAX_ADDRESS);
+}
+BENCHMARK(BM_Tsl31RefreshOneDatagram);
+
+// The refresh as 126 back-to-back single-display datagrams
+static void BM_Tsl31RefreshBurst(benchmark::State &state) {
+  FakeClock clock;
+  TallyMailbox mailbox;
+  TslDecoder decoder(mailbox, clock);
+  decoder.address = 3;
+  Bytes refresh[2] = { tsl31Refresh(0x31), tsl31Refresh(0x32) };
+  int i = 0;
+  for (auto _ : state) {
+    const Bytes &data = refresh[i ^= 1];
+    for (size_t at = 0; at < data.size(); at += TSL31_MESSAGE_LENGTH) {
+      benchmark::DoNotOptimize(decoder.decodeTsl31(data.data() + at, TSL31_MESSAGE_LENGTH, clock.micros()));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * TSL_MAX_ADDRESS);
+}
+BENCHMARK(BM_Tsl31RefreshBurst);
+
+// The same with no rule table, one rule and a full table watching other
+// addresses. Rules are compiled into masks, so the cost should not grow
+// with them.
+static void BM_Tsl31RefreshWithRules(benchmark::State &state) {
+  FakeClock clock;
+  TallyMailbox mailbox;
+  TslDecoder decoder(mailbox, clock);
+  TallyRules rules;
+  std::string spec;
+  for (int i = 0; i < state.range(0); i++) spec += std::to_string(10 + i * 3) + ":1:R:T,";
+  rules.parse(spec.c_str());
+  decoder.address = 3;
+  decoder.rules = state.range(0) ? &rules : NULL;  // As the firmware: no table, no pointer
+  Bytes refresh[2] = { tsl31Refresh(0x31), tsl31Refresh(0x32) };
+  int i = 0;
+  for (auto _ : state) {
+    const Bytes &data = refresh[i ^= 1];
+    benchmark::DoNotOptimize(decoder.decodeTsl31(data.data(), data.size(), clock.micros()));
+  }
+  state.SetItemsProcessed(state.iterations() * TSL_MAX_ADDRESS);
+}
+BENCHMARK(BM_Tsl31RefreshWithRules)->Arg(0)->Arg(1)->Arg(MAX_TALLY_RULES);
+
+// TSL 5.0 packets of one to 64 DMSGs, as a datagram (UDP) and DLE/STX
+// framed through the deframer (TCP, with a DLE in every control word to
+// unstuff)
+static void BM_Tsl5Packet(benchmark::State &state) {
+  FakeClock clock;
+  TallyMailbox mailbox;
+  TslDecoder decoder(mailbox, clock);
+  TslStreamDeframer deframer;
+  deframer.begin(TSL_PROTOCOL_V50);
+  decoder.address = 3;
+  bool framed = state.range(1);
+  std::vector<Tsl5Dmsg> dmsgs;
+  for (int i = 0; i < state.range(0); i++) {
+    uint16_t control = framed ? 0x00FE : tsl5Control(1, 0, 0, 3);
+    dmsgs.push_back({ (uint16_t)(1 + i % TSL_MAX_ADDRESS), control, "CAMERA " + std::to_string(i) });
+  }
+  Bytes packet = tsl5Packet(dmsgs);
+  if (framed) packet = tsl5Stuff(packet);
+  for (auto _ : state) {
+    if (!framed) {
+      benchmark::DoNotOptimize(decoder.decodeTsl5(packet.data(), packet.size(), clock.micros()));
+      continue;
+    }
+    const uint8_t *data = packet.data();
+    size_t len = packet.size();
+    int n = deframer.next(data, len);
+    benchmark::DoNotOptimize(decoder.decodeTsl5(deframer.packet(), n, clock.micros()));
+  }
+  state.SetBytesProcessed(state.iterations() * packet.size());
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Tsl5Packet)->ArgsProduct({ { 1, 8, 64 }, { 0, 1 } });
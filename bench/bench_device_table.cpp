@@ -0,0 +1,73 @@
+/*
+    Benchmarks: the discovered device table at 256 devices
+    Video Walrus 2025
+
+    env:bench inherits -DMAX_DISCOVERED_DEVICES=256 from env:native.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <stdio.h>
+
+#include "device_table.h"
+
+#define DEVICE_TTL_MS 45000
+
+// A table filled to capacity as the discovery task leaves it
+static void fillTable(DeviceTable &table, uint64_t *keys) {
+  for (int i = 0; i < MAX_DISCOVERED_DEVICES; i++) {
+    char mac[18];
+    char hostname[DEVICE_HOSTNAME_LENGTH];
+    snprintf(mac, sizeof(mac), "24:0A:C4:00:%02X:%02X", i >> 8, i & 0xFF);
+    snprintf(hostname, sizeof(hostname), "tally-%06x", 0x240000 + i);
+    keys[i] = DeviceTable::deviceKey(mac, hostname);
+    table.update(keys[i], hostname, 0x0A000000 + i, 1 + i % 126, DEVICE_TTL_MS, 0);
+  }
+}
+
+// One discovery round refreshing every device in place
+static void BM_DeviceTableUpdate(benchmark::State &state) {
+  DeviceTable table;
+  uint64_t keys[MAX_DISCOVERED_DEVICES];
+  fillTable(table, keys);
+  uint32_t nowMs = 0;
+  char hostname[DEVICE_HOSTNAME_LENGTH];
+  for (auto _ : state) {
+    nowMs += 15000;
+    for (int i = 0; i < MAX_DISCOVERED_DEVICES; i++) {
+      snprintf(hostname, sizeof(hostname), "tally-%06x", 0x240000 + i);
+      benchmark::DoNotOptimize(table.update(keys[i], hostname, 0x0A000000 + i, 1 + i % 126, DEVICE_TTL_MS, nowMs));
+    }
+    table.age(nowMs, 600000);
+  }
+  state.SetItemsProcessed(state.iterations() * MAX_DISCOVERED_DEVICES);
+}
+BENCHMARK(BM_DeviceTableUpdate);
+
+// Looking up every device, as /api/fleet/status does for each ack
+static void BM_DeviceTableFind(benchmark::State &state) {
+  DeviceTable table;
+  uint64_t keys[MAX_DISCOVERED_DEVICES];
+  fillTable(table, keys);
+  for (auto _ : state) {
+    for (int i = 0; i < MAX_DISCOVERED_DEVICES; i++) benchmark::DoNotOptimize(table.find(keys[i]));
+  }
+  state.SetItemsProcessed(state.iterations() * MAX_DISCOVERED_DEVICES);
+}
+BENCHMARK(BM_DeviceTableFind);
+
+// The /discover page with every device on it
+static void BM_DeviceTableDiscoverPage(benchmark::State &state) {
+  DeviceTable table;
+  uint64_t keys[MAX_DISCOVERED_DEVICES];
+  fillTable(table, keys);
+  char device[DEVICE_JSON_MAX_LENGTH];
+  size_t bytes = 0;
+  for (auto _ : state) {
+    for (size_t i = 0; i < table.count(); i++) bytes += table.formatJson(i, 30000, device, sizeof(device));
+    benchmark::DoNotOptimize(device);
+  }
+  state.SetBytesProcessed(bytes);
+  state.SetItemsProcessed(state.iterations() * table.count());
+}
+BENCHMARK(BM_DeviceTableDiscoverPage);
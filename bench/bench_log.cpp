@@ -0,0 +1,67 @@
+/*
+    Benchmarks: deferred logging against formatting on the spot
+    Video Walrus 2025
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <chrono>
+
+#include "log_ring.h"
+
+static void discardLine(const char *, size_t) {}
+
+#define LOG_BATCH (LOG_RING_SIZE / 2)
+
+// LOG_INFOs from the packet path, a batch of records into the ring per
+// iteration. The clock covers the pushes only; the log task's drain runs
+// between batches, before the ring fills.
+static void BM_LogPush(benchmark::State &state) {
+  eventLog.drain(discardLine);
+  uint32_t n = 0;
+  for (auto _ : state) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < LOG_BATCH; i++, n++) LOG_INFO("[UDP] %u bytes from %u.%u.%u.%u", n, 10, 0, 0, n & 0xFF);
+    state.SetIterationTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    eventLog.drain(discardLine);
+  }
+  if (eventLog.dropped() > 0) state.SkipWithError("the ring filled up");
+  state.SetItemsProcessed(state.iterations() * LOG_BATCH);
+}
+BENCHMARK(BM_LogPush)->UseManualTime();
+
+// The same with a copied label (LOG_INFO_STR)
+static void BM_LogPushStr(benchmark::State &state) {
+  eventLog.drain(discardLine);
+  uint32_t n = 0;
+  for (auto _ : state) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < LOG_BATCH; i++, n++) LOG_INFO_STR("[TSL] Label %s on address %u", "CAMERA 1", n & 0x7F);
+    state.SetIterationTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    eventLog.drain(discardLine);
+  }
+  if (eventLog.dropped() > 0) state.SkipWithError("the ring filled up");
+  state.SetItemsProcessed(state.iterations() * LOG_BATCH);
+}
+BENCHMARK(BM_LogPushStr)->UseManualTime();
+
+// What the packet path did before: format the line and write it out.
+// /dev/null stands in for Serial, so this is the least it cost; on the
+// device the write also waits on USB-CDC.
+static void BM_LogSnprintfWrite(benchmark::State &state) {
+  int fd = open("/dev/null", O_WRONLY);
+  char line[192];
+  uint32_t n = 0;
+  for (auto _ : state) {
+    int len = snprintf(line, sizeof(line), "[UDP] %u bytes from %u.%u.%u.%u\n", n, 10, 0, 0, n & 0xFF);
+    benchmark::DoNotOptimize(write(fd, line, len));
+    n++;
+  }
+  close(fd);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogSnprintfWrite);
@@ -0,0 +1,11 @@
+/*
+    Google Benchmark timings of the tally hot paths (pio run -e bench)
+    Video Walrus 2025
+
+    .pio/build/bench/program runs every benchmark in bench/; the usual
+    --benchmark_filter=<regex> picks some.
+*/
+
+#include <benchmark/benchmark.h>
+
+BENCHMARK_MAIN();
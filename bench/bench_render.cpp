@@ -0,0 +1,94 @@
+/*
+    Benchmarks: compositor frames and the render stage
+    Video Walrus 2025
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "../test/tally_test.h"
+
+#define LONG_CHAIN 300  // Talent strip plus rear ring
+#define WS2812_US_PER_LED 30  // 24 bits at 800 kHz
+#define WS2812_RESET_US 50
+
+enum FrameCase { FRAME_STATIC, FRAME_PULSE, FRAME_DISCO };
+
+// One compositor frame on a 7-LED ring and a 300-LED chain: a static
+// tally (the dirty check finds nothing to send), a pulse overlay (every
+// frame changes) and disco (a new colour every frame)
+static void BM_CompositorFrame(benchmark::State &state) {
+  size_t size = state.range(0);
+  FrameCase frameCase = (FrameCase)state.range(1);
+  Compositor compositor;
+  compositor.setPixelCount(size);
+  compositor.setLayout("TTTPPPV");
+  compositor.setTally(3, 50);
+  if (frameCase == FRAME_PULSE) compositor.setOverlay(OVERLAY_PULSE, Rgb{128, 0, 128}, 50, RENDER_PULSE_PERIOD_MS);
+  Rgb out[COMPOSITOR_MAX_PIXELS];
+  uint32_t frame = 0;
+  uint64_t shown = 0;
+  for (auto _ : state) {
+    if (frameCase == FRAME_DISCO) compositor.setOverlay(OVERLAY_SOLID, discoFrameColor(1, frame), 255);
+    shown += compositor.render(frame * (COMPOSITOR_FRAME_US / 1000), out);
+    benchmark::DoNotOptimize(out);
+    frame++;
+  }
+  state.counters["shown"] = benchmark::Counter(shown, benchmark::Counter::kAvgIterations);
+  state.SetLabel(frameCase == FRAME_STATIC ? "static tally" : frameCase == FRAME_PULSE ? "pulse overlay" : "disco");
+}
+BENCHMARK(BM_CompositorFrame)->ArgsProduct({ { 7, LONG_CHAIN }, { FRAME_STATIC, FRAME_PULSE, FRAME_DISCO } });
+
+// A switcher resending the same tally at 50 Hz, with a cut every ten
+// seconds, through the decoder and renderer on a 7-LED ring. Unchanged
+// frames are suppressed: "shown" is the share of resends that reached
+// the LEDs.
+static void BM_RepeatResend(benchmark::State &state) {
+  FakeClock clock;
+  RecordingLedSink sink(7);
+  TallyMailbox mailbox;
+  TslDecoder decoder(mailbox, clock);
+  TallyRenderer renderer(sink, clock, mailbox);
+  TallyMetrics metrics;
+  renderer.metrics = &metrics;
+  Bytes packet = tsl31Message(0, 0x32, "CAM 1");
+  uint32_t i = 0;
+  for (auto _ : state) {
+    if (i++ % 500 == 0) packet[1] ^= 0x03;  // Program <-> preview
+    clock.advanceMs(20);
+    decoder.decodeTsl31(packet.data(), packet.size(), clock.micros());
+    renderer.update();
+  }
+  state.counters["shown"] = benchmark::Counter(sink.shows, benchmark::Counter::kAvgIterations);
+  state.counters["suppressed"] =
+      benchmark::Counter(metrics.framesSuppressed.load(), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_RepeatResend);
+
+// A 300-LED disco frame handed to one, two or three outputs (300,
+// 150+150, 144+144+12). Pixel indexes run through the outputs in order,
+// as FastLedSink's do. The outputs transmit in parallel, so "wire_ms",
+// the time the frame takes on the wire, is the longest chain's.
+static void BM_LongChainFrame(benchmark::State &state) {
+  static const size_t splits[][3] = { { LONG_CHAIN, 0, 0 }, { 150, 150, 0 }, { 144, 144, 12 } };
+  const size_t *split = splits[state.range(0) - 1];
+  Compositor compositor;
+  compositor.setPixelCount(LONG_CHAIN);
+  compositor.setLayout("TTTPPPV");
+  Rgb out[COMPOSITOR_MAX_PIXELS];
+  static Rgb outputs[3][LONG_CHAIN];
+  uint32_t frame = 0;
+  for (auto _ : state) {
+    compositor.setOverlay(OVERLAY_SOLID, discoFrameColor(1, frame), 255);
+    compositor.render(frame * (COMPOSITOR_FRAME_US / 1000), out);
+    const Rgb *pixel = out;
+    for (int o = 0; o < 3; o++) {
+      memcpy(outputs[o], pixel, split[o] * sizeof(Rgb));
+      pixel += split[o];
+    }
+    benchmark::DoNotOptimize(outputs);
+    frame++;
+  }
+  size_t longest = split[0] > split[1] ? split[0] : split[1];
+  state.counters["wire_ms"] = (longest * WS2812_US_PER_LED + WS2812_RESET_US) / 1000.0;
+}
+BENCHMARK(BM_LongChainFrame)->DenseRange(1, 3);
@@ -4,8 +4,13 @@
 # Discovers all tally devices on the network and updates them
 #
 # Usage: ./ota-update-all.sh [known-device-ip]
+#        ./ota-update-all.sh --fleet <known-device-ip>
 #
 # If no IP provided, uses mDNS to discover devices
+#
+# --fleet installs the latest GitHub release instead of a local build: the
+# known device downloads it once and relays it to the rest of the fleet
+# (needs a fleet key on every device)
 
 set -e
 
@@ -16,6 +21,52 @@ PIO="/Users/richard/Library/Python/3.10/bin/pio"
 echo "=== TSL Tally Bulk OTA Update ==="
 echo ""
 
+if [ "$1" = "--fleet" ]; then
+    SEED="$2"
+    if [ -z "$SEED" ]; then
+        echo "Usage: ./ota-update-all.sh --fleet <known-device-ip>"
+        exit 1
+    fi
+    echo "Asking $SEED for the latest release..."
+    RESPONSE=$(curl -s "http://$SEED/api/check-update")
+    for attempt in $(seq 1 30); do
+        echo "$RESPONSE" | grep -q '"checking":true' || break
+        sleep 1
+        RESPONSE=$(curl -s "http://$SEED/api/check-update?poll=1")
+    done
+    LATEST=$(echo "$RESPONSE" | python3 -c "
+import sys, json
+d = json.load(sys.stdin)
+print(d['latest'] if d.get('updateAvailable') else '')
+" 2>/dev/null)
+    if [ -z "$LATEST" ]; then
+        echo "No update available."
+        exit 0
+    fi
+
+    read -p "Install $LATEST on the whole fleet? [y/N] " -n 1 -r
+    echo ""
+    if [[ ! $REPLY =~ ^[Yy]$ ]]; then
+        echo "Cancelled."
+        exit 0
+    fi
+
+    echo "$(curl -s -X POST "http://$SEED/api/fleet/update")"
+    # The seed reboots once its peers stop pulling from it
+    for attempt in $(seq 1 300); do
+        STATE=$(curl -s --max-time 2 "http://$SEED/status" | python3 -c "
+import sys, json
+o = json.load(sys.stdin)['ota']
+print('%s %d/%d serving %d %s' % (o['state'], o['bytes'], o['total'], o.get('serving', 0), o.get('error', '')))
+" 2>/dev/null) || break
+        echo "  $STATE"
+        case "$STATE" in failed*) exit 1 ;; esac
+        sleep 2
+    done
+    echo "Seed is rebooting; each device reports its firmware version in /info."
+    exit 0
+fi
+
 # Build firmware first
 echo "Building firmware..."
 cd "$SCRIPT_DIR"
@@ -27,7 +78,13 @@ echo ""
 if [ -n "$1" ]; then
     # Use provided IP to discover others
     echo "Querying $1 for device list..."
-    DEVICES=$(curl -s "http://$1/discover" | python3 -c "
+    # The device rescans in the background when its list is stale
+    for attempt in 1 2 3 4 5; do
+        RESPONSE=$(curl -s "http://$1/discover?limit=0")
+        echo "$RESPONSE" | grep -q '"scanning":true' || break
+        sleep 2
+    done
+    DEVICES=$(echo "$RESPONSE" | python3 -c "
 import sys, json
 data = json.load(sys.stdin)
 # Include the queried device itself
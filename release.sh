@@ -83,6 +83,11 @@ fi
 FIRMWARE_SIZE=$(ls -lh "$FIRMWARE_PATH" | awk '{print $5}')
 echo "Firmware built: $FIRMWARE_PATH ($FIRMWARE_SIZE)"
 
+# Devices refuse an OTA image that doesn't match this hash
+SHA256_PATH="$FIRMWARE_PATH.sha256"
+shasum -a 256 "$FIRMWARE_PATH" | awk '{print $1}' > "$SHA256_PATH"
+echo "SHA-256: $(cat "$SHA256_PATH")"
+
 # Commit version change
 echo ""
 echo "Committing version change..."
@@ -132,9 +137,10 @@ Or use bulk update script:
 \`\`\`
 
 ### Firmware Binary
-Download \`firmware.bin\` below and flash manually if needed.
+Download \`firmware.bin\` below and flash manually if needed. \`firmware.bin.sha256\` is its SHA-256, which devices check before installing an OTA update.
 " \
-    "$FIRMWARE_PATH"
+    "$FIRMWARE_PATH" \
+    "$SHA256_PATH"
 
 echo ""
 echo "=== Release Complete ==="
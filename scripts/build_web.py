@@ -0,0 +1,80 @@
+"""
+Build the web UI into flash
+Video Walrus 2025
+
+Minifies web/index.html, gzips it and writes src/web_assets.h as a
+PROGMEM byte array with an ETag. Runs before every PlatformIO build
+(extra_scripts = pre:scripts/build_web.py) and only rewrites the header
+when the page changes. Can also be run by hand:
+
+    python3 scripts/build_web.py
+"""
+
+import gzip
+import hashlib
+import os
+import re
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCE = os.path.join(ROOT, "web", "index.html")
+OUTPUT = os.path.join(ROOT, "src", "web_assets.h")
+
+
+def minify(html):
+    # Conservative: comments, indentation and blank lines only. Line breaks
+    # are kept so inline JS never depends on semicolon insertion.
+    html = re.sub(r"<!--.*?-->", "", html, flags=re.S)
+    lines = []
+    for line in html.splitlines():
+        line = line.strip()
+        if not line or line.startswith("//"):
+            continue
+        lines.append(line)
+    html = "\n".join(lines)
+    return re.sub(r">\n<", "><", html)
+
+
+def build():
+    with open(SOURCE, encoding="utf-8") as f:
+        page = minify(f.read()).encode("utf-8")
+
+    # mtime=0 keeps the output (and so the ETag) reproducible
+    data = gzip.compress(page, compresslevel=9, mtime=0)
+    etag = hashlib.sha256(data).hexdigest()[:16]
+
+    rows = []
+    for i in range(0, len(data), 16):
+        rows.append("  " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+
+    header = "\n".join([
+        "// Generated by scripts/build_web.py from web/index.html - do not edit",
+        "// %d bytes minified, %d bytes gzipped" % (len(page), len(data)),
+        "",
+        "#pragma once",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "#define INDEX_HTML_ETAG \"\\\"%s\\\"\"" % etag,
+        "#define INDEX_HTML_GZ_LENGTH %d" % len(data),
+        "",
+        "const uint8_t INDEX_HTML_GZ[] PROGMEM = {",
+    ] + rows + [
+        "};",
+        "",
+    ])
+
+    if os.path.exists(OUTPUT):
+        with open(OUTPUT, encoding="utf-8") as f:
+            if f.read() == header:
+                return
+    with open(OUTPUT, "w", encoding="utf-8") as f:
+        f.write(header)
+    print("build_web: %s (%d -> %d bytes)" % (os.path.relpath(OUTPUT, ROOT), len(page), len(data)))
+
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO
+    build()
+except NameError:
+    if __name__ == "__main__":
+        build()
@@ -0,0 +1,83 @@
+"""
+Flaky firmware server for testing OTA resume
+Video Walrus 2025
+
+Serves one file over plain HTTP with Range support, cutting each
+response off after a random number of bytes so the downloader has to
+reconnect and resume. Run it against the host build:
+
+    python3 scripts/ota_drop_server.py firmware.bin --port 8080 --drop 0.3
+    .pio/build/native/program --ota http://127.0.0.1:8080/firmware.bin \\
+        $(shasum -a 256 firmware.bin | cut -c1-64) /tmp/ota.bin
+
+--drop is the chance that a response is cut short; --ignore-range
+answers every request with the whole file (200), like a server without
+Range support, so every drop restarts the image.
+"""
+
+import argparse
+import http.server
+import os
+import random
+import re
+
+
+def make_handler(path, drop, ignore_range, rng):
+    data = open(path, "rb").read()
+    name = "/" + os.path.basename(path)
+
+    class Handler(http.server.BaseHTTPRequestHandler):
+        protocol_version = "HTTP/1.1"
+
+        def do_GET(self):
+            if self.path != name:
+                self.send_error(404)
+                return
+
+            start = 0
+            match = re.match(r"bytes=(\d+)-$", self.headers.get("Range", ""))
+            if match and not ignore_range:
+                start = int(match.group(1))
+                if start >= len(data):
+                    self.send_response(416)
+                    self.send_header("Content-Range", "bytes */%d" % len(data))
+                    self.send_header("Content-Length", "0")
+                    self.end_headers()
+                    return
+                self.send_response(206)
+                self.send_header("Content-Range", "bytes %d-%d/%d" % (start, len(data) - 1, len(data)))
+            else:
+                self.send_response(200)
+            body = data[start:]
+            self.send_header("Content-Length", str(len(body)))
+            self.send_header("Connection", "close")
+            self.end_headers()
+
+            if rng.random() < drop:
+                cut = rng.randrange(len(body))
+                self.wfile.write(body[:cut])
+                self.log_message("dropped after %d of %d bytes (from %d)", cut, len(body), start)
+                self.close_connection = True
+                return
+            self.wfile.write(body)
+
+    return Handler
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("file")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--drop", type=float, default=0.3, help="chance each response is cut short")
+    parser.add_argument("--ignore-range", action="store_true", help="always send the whole file")
+    parser.add_argument("--seed", type=int, help="repeatable drops")
+    args = parser.parse_args()
+
+    handler = make_handler(args.file, args.drop, args.ignore_range, random.Random(args.seed))
+    server = http.server.ThreadingHTTPServer(("", args.port), handler)
+    print("Serving /%s on port %d" % (os.path.basename(args.file), args.port))
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,144 @@
+"""
+Stand-in TSL source for testing the unicast and TCP receivers
+Video Walrus 2025
+
+Steps one address through red, green and off every --interval seconds,
+as a switcher or aggregator would, and sends each change:
+
+  tcp   as a TCP server: every client gets the stream, TSL 5.0 DLE/STX
+        framed and byte-stuffed, or TSL 3.1 messages back to back
+  udp   as unicast datagrams to --target host:port
+
+Run it against the host build:
+
+    python3 scripts/tsl_test_server.py tcp --port 8900 --address 3 --drop 10
+    .pio/build/native/program settings.txt   # tally.tslTcpHost=127.0.0.1
+
+--drop closes every TCP connection after that many seconds, to watch the
+client back off and reconnect; --split writes each packet in small
+pieces, to exercise the deframer across reads.
+"""
+
+import argparse
+import select
+import socket
+import struct
+import time
+
+DLE = 0xFE
+STX = 0x02
+
+# (name, TSL 3.1 control bits, TSL 5.0 lamp value)
+STATES = [("red", 0b10, 1), ("green", 0b01, 2), ("off", 0b00, 0)]
+
+
+def tsl31(address, tally, text):
+    label = text.encode("ascii", "replace")[:16].ljust(16)
+    return bytes([0x80 + address, 0x30 | tally]) + label
+
+
+def tsl5(address, lamp, text):
+    label = text.encode("ascii", "replace")
+    control = lamp | (lamp << 4) | (3 << 6)  # Right and left tally, full brightness
+    dmsg = struct.pack("<HHH", address, control, len(label)) + label
+    body = struct.pack("<BBH", 0, 0, 0) + dmsg  # VER, FLAGS, SCREEN
+    return struct.pack("<H", len(body)) + body
+
+
+def stuff(packet):
+    return bytes([DLE, STX]) + packet.replace(bytes([DLE]), bytes([DLE, DLE]))
+
+
+def packet_for(args, step):
+    name, tally, lamp = STATES[step % len(STATES)]
+    text = "CAM %d %s" % (args.address, name)
+    return name, tsl5(args.address, lamp, text) if args.protocol == "5" else tsl31(args.address, tally, text)
+
+
+def send_stream(conn, data, split):
+    if split <= 0:
+        conn.sendall(data)
+        return
+    for i in range(0, len(data), split):
+        conn.sendall(data[i : i + split])
+        time.sleep(0.001)  # Separate segments, most of the time
+
+
+def serve_tcp(args):
+    server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    server.bind(("", args.port))
+    server.listen()
+    print("TSL %s over TCP on port %d, address %d" % (args.protocol, args.port, args.address))
+
+    clients = {}  # socket -> connect time
+    step = 0
+    next_change = time.monotonic()
+    while True:
+        now = time.monotonic()
+        readable, _, _ = select.select([server] + list(clients), [], [], max(0, next_change - now))
+        for s in readable:
+            if s is server:
+                conn, peer = server.accept()
+                clients[conn] = time.monotonic()
+                print("client %s:%d connected" % peer)
+            elif not s.recv(256):  # Clients never send; this is a close
+                del clients[s]
+                s.close()
+                print("client closed")
+
+        now = time.monotonic()
+        if args.drop > 0:
+            for conn, since in list(clients.items()):
+                if now - since >= args.drop:
+                    del clients[conn]
+                    conn.close()
+                    print("dropped a client after %.0f s" % args.drop)
+
+        if now >= next_change:
+            name, packet = packet_for(args, step)
+            data = stuff(packet) if args.protocol == "5" else packet
+            for conn in list(clients):
+                try:
+                    send_stream(conn, data, args.split)
+                except OSError:
+                    del clients[conn]
+                    conn.close()
+            print("address %d %s to %d client(s)" % (args.address, name, len(clients)))
+            step += 1
+            next_change = now + args.interval
+
+
+def serve_udp(args):
+    host, port = args.target.rsplit(":", 1)
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    print("TSL %s over UDP to %s:%s, address %d" % (args.protocol, host, port, args.address))
+    step = 0
+    while True:
+        name, packet = packet_for(args, step)
+        sock.sendto(packet, (host, int(port)))
+        print("address %d %s" % (args.address, name))
+        step += 1
+        time.sleep(args.interval)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("mode", choices=["tcp", "udp"])
+    parser.add_argument("--port", type=int, default=8900, help="TCP listening port")
+    parser.add_argument("--target", default="127.0.0.1:8910", help="UDP destination host:port")
+    parser.add_argument("--protocol", choices=["3.1", "5"], default="5")
+    parser.add_argument("--address", type=int, default=0)
+    parser.add_argument("--interval", type=float, default=1.0, help="seconds between tally changes")
+    parser.add_argument("--drop", type=float, default=0, help="close TCP clients after this many seconds")
+    parser.add_argument("--split", type=int, default=0, help="write TCP data in pieces of this many bytes")
+    args = parser.parse_args()
+
+    if args.mode == "tcp":
+        serve_tcp(args)
+    else:
+        serve_udp(args)
+
+
+if __name__ == "__main__":
+    main()
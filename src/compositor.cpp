@@ -0,0 +1,156 @@
+/*
+    LED compositor
+    Video Walrus 2025
+*/
+
+#include "compositor.h"
+
+#include <math.h>
+#include <string.h>
+
+static const char roleLetters[] = "TPV-";  // Indexed by PixelRole
+
+static const Rgb tallyColors[] = {
+  { 0, 0, 0 },      // Off
+  { 0, 128, 0 },    // Green
+  { 255, 0, 0 },    // Red
+  { 255, 255, 0 },  // Yellow
+};
+
+Compositor::Compositor() {
+  memset(roles, ROLE_TALLY, sizeof(roles));
+  for (int i = 0; i < 256; i++) {
+    pulseGamma[i] = (uint8_t)lroundf(255.0f * powf(i / 255.0f, 2.2f));
+  }
+  buildScale(baseScale, baseBrightness);
+  buildScale(overlayScale, overlayBrightness);
+  setTally(0, baseBrightness);
+}
+
+// Same rounding as FastLED's scale8(), so a frame scaled here matches what
+// FastLED.setBrightness() would have shown
+void Compositor::buildScale(uint8_t *lut, uint8_t brightness) {
+  for (int v = 0; v < 256; v++) lut[v] = (uint8_t)((v * (brightness + 1)) >> 8);
+}
+
+void Compositor::setPixelCount(size_t count) {
+  numPixels = count < COMPOSITOR_MAX_PIXELS ? count : COMPOSITOR_MAX_PIXELS;
+  lastValid = false;
+}
+
+// Expand a layout string into roles; returns how many, or 0 if invalid
+static size_t parseLayout(const char *layout, uint8_t *roles) {
+  size_t n = 0;
+  while (*layout) {
+    uint32_t repeat = 0;
+    bool counted = false;
+    for (; *layout >= '0' && *layout <= '9'; layout++) {
+      repeat = repeat * 10 + (*layout - '0');
+      if (repeat > COMPOSITOR_MAX_PIXELS) return 0;
+      counted = true;
+    }
+    const char *p = strchr(roleLetters, *layout);
+    if (*layout == '\0' || p == NULL) return 0;
+    layout++;
+    if (!counted) repeat = 1;
+    if (n + repeat > COMPOSITOR_MAX_PIXELS) return 0;
+    if (roles) memset(roles + n, p - roleLetters, repeat);
+    n += repeat;
+  }
+  return n;
+}
+
+bool Compositor::validLayout(const char *layout) {
+  return parseLayout(layout, NULL) > 0;
+}
+
+bool Compositor::setLayout(const char *layout) {
+  uint8_t parsed[COMPOSITOR_MAX_PIXELS];
+  size_t n = parseLayout(layout, parsed);
+  if (n == 0) return false;
+  memcpy(roles, parsed, n);
+  memset(roles + n, parsed[n - 1], COMPOSITOR_MAX_PIXELS - n);
+  lastValid = false;
+  return true;
+}
+
+void Compositor::setTally(uint8_t state, uint8_t brightness) {
+  state &= 3;
+  Rgb colors[NUM_PIXEL_ROLES];
+  colors[ROLE_TALLY] = tallyColors[state];
+  colors[ROLE_PROGRAM] = (state & 2) ? tallyColors[2] : tallyColors[0];
+  colors[ROLE_PREVIEW] = (state & 1) ? tallyColors[1] : tallyColors[0];
+  colors[ROLE_OFF] = tallyColors[0];
+  setBase(colors, brightness);
+}
+
+void Compositor::setBase(const Rgb *colors, uint8_t brightness) {
+  memcpy(roleColor, colors, sizeof(roleColor));
+  roleColor[ROLE_OFF] = tallyColors[0];
+  if (brightness != baseBrightness) {
+    baseBrightness = brightness;
+    buildScale(baseScale, brightness);
+  }
+}
+
+void Compositor::setOverlay(OverlayMode mode, Rgb color, uint8_t brightness, uint32_t periodMs, uint8_t roleMask) {
+  overlay = mode;
+  overlayColor = color;
+  overlayMask = roleMask;
+  overlayPeriodMs = periodMs > 0 ? periodMs : 1000;
+  overlayStarted = false;  // Phase starts at the next render()
+  if (brightness != overlayBrightness) {
+    overlayBrightness = brightness;
+    buildScale(overlayScale, brightness);
+  }
+}
+
+static inline Rgb scaled(Rgb c, const uint8_t *lut) {
+  return Rgb{ lut[c.r], lut[c.g], lut[c.b] };
+}
+
+static inline uint8_t lerp8(uint8_t a, uint8_t b, uint8_t t) {
+  return (uint8_t)(a + (((int)b - a) * t + 127) / 255);
+}
+
+bool Compositor::render(uint32_t nowMs, Rgb *out) {
+  // Overlay weight for this frame: 0 = tally base only, 255 = overlay only
+  uint8_t weight = 0;
+  if (overlay != OVERLAY_NONE) {
+    if (!overlayStarted) {
+      overlayStarted = true;
+      overlayStartMs = nowMs;
+    }
+    uint32_t phase = (nowMs - overlayStartMs) % overlayPeriodMs;
+    switch (overlay) {
+      case OVERLAY_SOLID: weight = 255; break;
+      case OVERLAY_FLASH: weight = phase < overlayPeriodMs / 2 ? 255 : 0; break;
+      case OVERLAY_PULSE: {
+        // Triangle wave through the gamma table
+        uint32_t half = overlayPeriodMs / 2 > 0 ? overlayPeriodMs / 2 : 1;
+        uint32_t ramp = phase < half ? phase : overlayPeriodMs - phase;
+        weight = pulseGamma[ramp * 255 / half > 255 ? 255 : ramp * 255 / half];
+        break;
+      }
+      default: break;
+    }
+  }
+
+  Rgb base[NUM_PIXEL_ROLES];
+  for (int r = 0; r < NUM_PIXEL_ROLES; r++) base[r] = scaled(roleColor[r], baseScale);
+  Rgb top = scaled(overlayColor, overlayScale);
+
+  for (size_t i = 0; i < numPixels; i++) {
+    uint8_t role = roles[i];
+    Rgb c = base[role];
+    if (weight > 0 && (overlayMask & (1 << role))) {
+      c = weight == 255 ? top : Rgb{ lerp8(c.r, top.r, weight), lerp8(c.g, top.g, weight), lerp8(c.b, top.b, weight) };
+    }
+    out[i] = c;
+  }
+
+  if (lastValid && memcmp(out, last, numPixels * sizeof(Rgb)) == 0) return false;
+  memcpy(last, out, numPixels * sizeof(Rgb));
+  lastValid = true;
+  return true;
+}
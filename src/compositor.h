@@ -0,0 +1,104 @@
+/*
+    LED compositor
+    Video Walrus 2025
+
+    Builds each LED frame from layers, bottom to top:
+
+      1. Tally base - each pixel has a role (a segment of the ring), so
+         one light can show program on its talent-facing LEDs and
+         program + preview on the ones under the monitor
+      2. Overlay - solid, flash or pulse in one colour, over the pixels
+         whose role is in its mask (disco, OTA progress)
+      3. Brightness - per-layer 256-entry scale tables, rebuilt only when
+         a brightness changes, and a gamma table for the pulse ramp
+
+    render() compares the result with the last frame it returned, so the
+    caller only pays for a LED transfer when a pixel actually changed.
+    Hardware-free, like the tally core.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hal.h"
+
+#ifndef COMPOSITOR_MAX_PIXELS
+#define COMPOSITOR_MAX_PIXELS 512  // Across every LED output
+#endif
+#define COMPOSITOR_FRAME_US 20000  // 50 fps while an overlay animates
+
+// Pixel roles, written as one letter per pixel in a layout string
+enum PixelRole : uint8_t {
+  ROLE_TALLY,    // 'T': red on program, green on preview, yellow on both
+  ROLE_PROGRAM,  // 'P': red on program only (talent-facing)
+  ROLE_PREVIEW,  // 'V': green on preview only
+  ROLE_OFF,      // '-': always dark
+  NUM_PIXEL_ROLES
+};
+
+#define ROLE_MASK_ALL 0xFF
+
+enum OverlayMode : uint8_t {
+  OVERLAY_NONE,
+  OVERLAY_SOLID,
+  OVERLAY_FLASH,  // Colour for half of each period, tally base for the other half
+  OVERLAY_PULSE,  // Fades tally base -> colour -> tally base once per period
+};
+
+class Compositor {
+ public:
+  Compositor();
+
+  void setPixelCount(size_t count);
+  size_t pixelCount() const { return numPixels; }
+
+  // Roles from a string like "TTTPPPP"; a count repeats the next letter,
+  // so "3T144P" is the same as three Ts then 144 Ps. Pixels past the end
+  // repeat the last role. False (layout unchanged) on an unknown letter or
+  // more than COMPOSITOR_MAX_PIXELS roles.
+  bool setLayout(const char *layout);
+  static bool validLayout(const char *layout);
+
+  // Tally bits: bit 0 preview (green), bit 1 program (red)
+  void setTally(uint8_t state, uint8_t brightness);
+  // Base colour of each role directly (NUM_PIXEL_ROLES entries)
+  void setBase(const Rgb *colors, uint8_t brightness);
+
+  void setOverlay(OverlayMode mode, Rgb color, uint8_t brightness, uint32_t periodMs = 0,
+                  uint8_t roleMask = ROLE_MASK_ALL);
+  void clearOverlay() { setOverlay(OVERLAY_NONE, Rgb{0, 0, 0}, 0); }
+  OverlayMode overlayMode() const { return overlay; }
+  // Output changes with time and needs a render() every COMPOSITOR_FRAME_US
+  bool animating() const { return overlay == OVERLAY_FLASH || overlay == OVERLAY_PULSE; }
+
+  // Render the frame for nowMs into out (pixelCount() entries, already
+  // brightness-scaled). Returns false if it is identical to the last
+  // frame returned, so there is nothing to show.
+  bool render(uint32_t nowMs, Rgb *out);
+
+ private:
+  static void buildScale(uint8_t *lut, uint8_t brightness);
+
+  size_t numPixels = 0;
+  uint8_t roles[COMPOSITOR_MAX_PIXELS];
+
+  Rgb roleColor[NUM_PIXEL_ROLES];  // Tally base per role, for the current state
+  uint8_t baseBrightness = 0;
+  uint8_t baseScale[256];
+
+  OverlayMode overlay = OVERLAY_NONE;
+  Rgb overlayColor = {0, 0, 0};
+  uint8_t overlayMask = 0;
+  uint32_t overlayPeriodMs = 0;
+  uint32_t overlayStartMs = 0;
+  bool overlayStarted = false;
+  uint8_t overlayBrightness = 0;
+  uint8_t overlayScale[256];
+
+  uint8_t pulseGamma[256];  // Perceptually even fade for OVERLAY_PULSE
+
+  Rgb last[COMPOSITOR_MAX_PIXELS];
+  bool lastValid = false;
+};
@@ -0,0 +1,156 @@
+/*
+    Table of other tally devices seen via mDNS
+    Video Walrus 2025
+*/
+
+#include "device_table.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "json_text.h"
+
+static_assert(MAX_DISCOVERED_DEVICES < 0xFFFF, "Entry indexes are 16-bit");
+static_assert(DEVICE_NAME_POOL_SIZE <= 0xFFFF, "Name offsets are 16-bit");
+
+DeviceTable::DeviceTable() {
+  for (size_t i = 0; i < SLOTS; i++) slots[i] = EMPTY;
+}
+
+uint64_t DeviceTable::deviceKey(const char *mac, const char *hostname) {
+  unsigned int b[6];
+  if (mac && sscanf(mac, "%2x:%2x:%2x:%2x:%2x:%2x", &b[0], &b[1], &b[2], &b[3], &b[4], &b[5]) == 6) {
+    uint64_t key = 0;
+    for (int i = 0; i < 6; i++) key = (key << 8) | b[i];
+    return key;
+  }
+
+  // FNV-1a; bit 63 keeps it clear of real MACs
+  uint64_t hash = 0xCBF29CE484222325ULL;
+  for (const char *p = hostname; *p; p++) {
+    hash = (hash ^ (uint8_t)*p) * 0x100000001B3ULL;
+  }
+  return hash | (1ULL << 63);
+}
+
+// Home slot: fold the key and let the multiply spread the low MAC bits
+size_t DeviceTable::slotFor(uint64_t key) const {
+  uint32_t h = (uint32_t)(key ^ (key >> 32)) * 0x9E3779B1u;
+  return (h >> 8) & (SLOTS - 1);
+}
+
+int DeviceTable::find(uint64_t key) const {
+  for (size_t s = slotFor(key);; s = (s + 1) & (SLOTS - 1)) {
+    if (slots[s] == EMPTY) return -1;
+    if (entries[slots[s]].key == key) return slots[s];
+  }
+}
+
+bool DeviceTable::update(uint64_t key, const char *hostname, uint32_t ip, int tslAddress,
+                         uint32_t ttlMs, uint32_t nowMs) {
+  size_t s = slotFor(key);
+  while (slots[s] != EMPTY && entries[slots[s]].key != key) s = (s + 1) & (SLOTS - 1);
+
+  DeviceEntry *e;
+  if (slots[s] == EMPTY) {
+    if (numEntries == MAX_DISCOVERED_DEVICES) return false;
+    int name = internName(hostname);
+    if (name < 0) return false;
+    e = &entries[numEntries];
+    e->key = key;
+    e->nameOffset = name;
+    slots[s] = numEntries++;
+  } else {
+    e = &entries[slots[s]];
+    if (strcmp(namePool + e->nameOffset, hostname) != 0) {  // Renamed
+      int name = internName(hostname);
+      if (name < 0) return false;
+      e->nameOffset = name;
+    }
+  }
+
+  e->ip = ip;
+  e->tslAddress = tslAddress;
+  e->lastSeenMs = nowMs;
+  e->ttlMs = ttlMs;
+  e->online = true;
+  return true;
+}
+
+void DeviceTable::age(uint32_t nowMs, uint32_t forgetMs) {
+  for (size_t i = 0; i < numEntries;) {
+    uint32_t silentMs = nowMs - entries[i].lastSeenMs;
+    if (silentMs > forgetMs) {
+      removeAt(i);  // Moves the last entry into i; look at it next
+      continue;
+    }
+    entries[i].online = silentMs <= entries[i].ttlMs;
+    i++;
+  }
+}
+
+// Remove entry index: clear its slot with backward-shift deletion (no
+// tombstones), then move the last entry into the hole
+void DeviceTable::removeAt(size_t index) {
+  size_t hole = slotFor(entries[index].key);
+  while (slots[hole] != index) hole = (hole + 1) & (SLOTS - 1);
+
+  for (size_t s = (hole + 1) & (SLOTS - 1); slots[s] != EMPTY; s = (s + 1) & (SLOTS - 1)) {
+    size_t home = slotFor(entries[slots[s]].key);
+    // Shift back unless the entry's home lies cyclically in (hole, s]
+    if (((s - home) & (SLOTS - 1)) >= ((s - hole) & (SLOTS - 1))) {
+      slots[hole] = slots[s];
+      hole = s;
+    }
+  }
+  slots[hole] = EMPTY;
+
+  size_t last = --numEntries;
+  if (index != last) {
+    entries[index] = entries[last];
+    size_t s = slotFor(entries[index].key);
+    while (slots[s] != last) s = (s + 1) & (SLOTS - 1);
+    slots[s] = index;
+  }
+}
+
+// Store name in the pool; returns its offset, or -1 if there is no room
+int DeviceTable::internName(const char *name) {
+  size_t len = strnlen(name, DEVICE_HOSTNAME_LENGTH - 1);
+  if (namePoolUsed + len + 1 > DEVICE_NAME_POOL_SIZE) {
+    compactNames();
+    if (namePoolUsed + len + 1 > DEVICE_NAME_POOL_SIZE) return -1;
+  }
+  int offset = namePoolUsed;
+  memcpy(namePool + offset, name, len);
+  namePool[offset + len] = '\0';
+  namePoolUsed += len + 1;
+  return offset;
+}
+
+// Drop names no entry refers to any more (forgotten or renamed devices)
+void DeviceTable::compactNames() {
+  static char scratch[DEVICE_NAME_POOL_SIZE];
+  size_t used = 0;
+  for (size_t i = 0; i < numEntries; i++) {
+    const char *name = namePool + entries[i].nameOffset;
+    size_t len = strlen(name) + 1;
+    memcpy(scratch + used, name, len);
+    entries[i].nameOffset = used;
+    used += len;
+  }
+  memcpy(namePool, scratch, used);
+  namePoolUsed = used;
+}
+
+size_t DeviceTable::formatJson(size_t i, uint32_t nowMs, char *buf, size_t len) const {
+  const DeviceEntry &e = entries[i];
+  char name[(DEVICE_HOSTNAME_LENGTH - 1) * 6 + 1];  // \u00XX at worst
+  jsonEscape(hostname(i), name, sizeof(name));
+  // ip is in network byte order: first octet in the low byte
+  int n = snprintf(buf, len, "{\"hostname\":\"%s\",\"ip\":\"%u.%u.%u.%u\",\"tslAddress\":%u,\"online\":%s,\"lastSeen\":%u}",
+                   name, (unsigned)(e.ip & 0xFF), (unsigned)((e.ip >> 8) & 0xFF), (unsigned)((e.ip >> 16) & 0xFF),
+                   (unsigned)(e.ip >> 24), e.tslAddress, e.online ? "true" : "false",
+                   (unsigned)((nowMs - e.lastSeenMs) / 1000));
+  return n < 0 ? 0 : (size_t)n;
+}
@@ -0,0 +1,86 @@
+/*
+    Table of other tally devices seen via mDNS
+    Video Walrus 2025
+
+    Hardware-free, like the tally core: the ESP32 discovery task feeds it
+    from mDNS results. Entries are refreshed in place as answers arrive
+    and age out by their record TTL instead of being wiped on each scan.
+
+    Entries are small fixed records in a dense array (so paging is a
+    plain offset), indexed by MAC through an open-addressing hash.
+    Hostnames live once each in a shared string pool.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Capacity, set at build time (-DMAX_DISCOVERED_DEVICES=256)
+#ifndef MAX_DISCOVERED_DEVICES
+#define MAX_DISCOVERED_DEVICES 128
+#endif
+
+#define DEVICE_HOSTNAME_LENGTH 33  // 32 characters + NUL
+#define DEVICE_NAME_POOL_SIZE (MAX_DISCOVERED_DEVICES * 24)  // Average hostname budget
+#define DEVICE_JSON_MAX_LENGTH 320  // formatJson() with every hostname character escaped
+
+// Hash slots: a power of two at least twice the capacity, so probes stay short
+constexpr size_t deviceTableSlots(size_t n, size_t slots = 1) {
+  return slots >= 2 * n ? slots : deviceTableSlots(n, slots * 2);
+}
+
+struct DeviceEntry {
+  uint64_t key;          // MAC (48 bits), or a hostname hash with bit 63 set
+  uint32_t ip;           // IPv4, network byte order
+  uint32_t lastSeenMs;   // Last mDNS answer
+  uint32_t ttlMs;        // Record TTL; offline once it passes without an answer
+  uint16_t nameOffset;   // Hostname, in the name pool
+  uint8_t tslAddress;
+  bool online;
+};
+
+class DeviceTable {
+ public:
+  DeviceTable();
+
+  // Key for a device: its MAC ("AA:BB:CC:DD:EE:FF") when advertised, else
+  // a hash of the hostname
+  static uint64_t deviceKey(const char *mac, const char *hostname);
+
+  // Insert or refresh the entry for key. Returns false if it is new and
+  // the table (or the name pool) is full.
+  bool update(uint64_t key, const char *hostname, uint32_t ip, int tslAddress, uint32_t ttlMs, uint32_t nowMs);
+
+  // Mark entries offline once their TTL has passed, and drop entries
+  // that have been silent for forgetMs
+  void age(uint32_t nowMs, uint32_t forgetMs);
+
+  // Index of the entry for key, or -1
+  int find(uint64_t key) const;
+
+  size_t count() const { return numEntries; }
+  const DeviceEntry &entry(size_t i) const { return entries[i]; }
+  const char *hostname(size_t i) const { return namePool + entries[i].nameOffset; }
+
+  // Entry i as one of /discover's devices, e.g. {"hostname":"tally-1",
+  // "ip":"10.0.0.5","tslAddress":3,"online":true,"lastSeen":12}; returns
+  // its length
+  size_t formatJson(size_t i, uint32_t nowMs, char *buf, size_t len) const;
+
+ private:
+  static const size_t SLOTS = deviceTableSlots(MAX_DISCOVERED_DEVICES);
+  static const uint16_t EMPTY = 0xFFFF;
+
+  size_t slotFor(uint64_t key) const;
+  void removeAt(size_t index);
+  int internName(const char *name);
+  void compactNames();
+
+  DeviceEntry entries[MAX_DISCOVERED_DEVICES];
+  size_t numEntries = 0;
+  uint16_t slots[SLOTS];   // Entry index, or EMPTY
+
+  char namePool[DEVICE_NAME_POOL_SIZE];
+  size_t namePoolUsed = 0;
+};
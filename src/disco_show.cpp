@@ -0,0 +1,58 @@
+/*
+    Disco show: deterministic frames on a shared clock
+    Video Walrus 2025
+*/
+
+#include "disco_show.h"
+
+// 6 distinct rainbow colors for disco (avoid in-between muddy colors):
+// FastLED rainbow hues 0, 32, 64, 96, 160, 192 at full saturation
+static const Rgb discoColors[] = {
+  { 255, 0, 0 },    // Red
+  { 171, 85, 0 },   // Orange
+  { 171, 171, 0 },  // Yellow
+  { 0, 255, 0 },    // Green
+  { 0, 0, 255 },    // Blue
+  { 85, 0, 171 },   // Purple
+};
+
+Rgb discoFrameColor(uint32_t seed, uint32_t frame) {
+  // murmur3 finalizer: every bit of seed and frame reaches the result
+  uint32_t h = seed ^ (frame * 0x9E3779B9u);
+  h ^= h >> 16;
+  h *= 0x85EBCA6Bu;
+  h ^= h >> 13;
+  h *= 0xC2B2AE35u;
+  h ^= h >> 16;
+  return discoColors[h % 6];
+}
+
+bool ShowSync::sample(uint32_t seed, uint32_t elapsedUs, uint32_t durationMs, uint32_t rxUs) {
+  uint32_t candidate = rxUs - elapsedUs;
+
+  if (!active || seed != showSeed) {
+    active = true;
+    showSeed = seed;
+    duration = durationMs;
+    epoch = candidate;
+    candidates[0] = candidate;
+    numCandidates = 1;
+    nextCandidate = 1 % DISCO_SYNC_WINDOW;
+    return true;
+  }
+
+  candidates[nextCandidate] = candidate;
+  nextCandidate = (nextCandidate + 1) % DISCO_SYNC_WINDOW;
+  if (numCandidates < DISCO_SYNC_WINDOW) numCandidates++;
+  duration = durationMs;
+
+  // Earliest candidate in the window, compared relative to this one so
+  // micros() wrapping does not matter
+  uint32_t best = candidate;
+  for (size_t i = 0; i < numCandidates; i++) {
+    if ((int32_t)(candidates[i] - best) < 0) best = candidates[i];
+  }
+  if (best == epoch) return false;
+  epoch = best;
+  return true;
+}
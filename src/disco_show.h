@@ -0,0 +1,52 @@
+/*
+    Disco show: deterministic frames on a shared clock
+    Video Walrus 2025
+
+    A show is a seed, an epoch and a duration. Frame N starts N * 250 ms
+    after the epoch and its colour depends only on (seed, N), so every
+    tally that agrees on the epoch shows the same colour at the same time
+    without exchanging frames.
+
+    ShowSync turns the leader's beacons ("show seed, elapsed E us, sent
+    now") into an epoch on this device's own micros() clock. Hardware-free,
+    like the tally core: times are passed in.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hal.h"
+
+#define DISCO_FRAME_US 250000     // One colour per frame
+#define DISCO_BEACON_MS 1000      // Leader beacon interval
+#define DISCO_SYNC_WINDOW 4       // Beacons in the epoch estimate; bounds clock drift
+
+// Colour of frame N of the show with this seed
+Rgb discoFrameColor(uint32_t seed, uint32_t frame);
+
+class ShowSync {
+ public:
+  // A beacon for show seed, elapsedUs into it by the leader's clock,
+  // received at rxUs on ours. Returns true if this starts a new show or
+  // moves the epoch, i.e. the renderer needs telling.
+  bool sample(uint32_t seed, uint32_t elapsedUs, uint32_t durationMs, uint32_t rxUs);
+  void stop() { active = false; }
+
+  bool running() const { return active; }
+  uint32_t seed() const { return showSeed; }
+  uint32_t epochUs() const { return epoch; }
+  uint32_t durationMs() const { return duration; }
+
+ private:
+  bool active = false;
+  uint32_t showSeed = 0;
+  uint32_t epoch = 0;
+  uint32_t duration = 0;
+  // rx - elapsed for recent beacons. Network and scheduling delay only
+  // ever make a beacon late, so the earliest candidate is the best one.
+  uint32_t candidates[DISCO_SYNC_WINDOW] = {};
+  size_t numCandidates = 0;
+  size_t nextCandidate = 0;
+};
@@ -0,0 +1,123 @@
+/*
+    Fleet control datagrams
+    Video Walrus 2025
+*/
+
+#include "fleet_control.h"
+
+#include <string.h>
+
+static inline uint64_t rotl(uint64_t x, int b) {
+  return (x << b) | (x >> (64 - b));
+}
+
+#define SIPROUND                                                     \
+  do {                                                               \
+    v0 += v1; v1 = rotl(v1, 13); v1 ^= v0; v0 = rotl(v0, 32);        \
+    v2 += v3; v3 = rotl(v3, 16); v3 ^= v2;                           \
+    v0 += v3; v3 = rotl(v3, 21); v3 ^= v0;                           \
+    v2 += v1; v1 = rotl(v1, 17); v1 ^= v2; v2 = rotl(v2, 32);        \
+  } while (0)
+
+static uint64_t readLe64(const uint8_t *p, size_t n) {
+  uint64_t v = 0;
+  for (size_t i = 0; i < n; i++) v |= (uint64_t)p[i] << (8 * i);
+  return v;
+}
+
+static void writeLe(uint8_t *p, uint64_t v, size_t n) {
+  for (size_t i = 0; i < n; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+uint64_t sipHash24(const FleetKey &key, const uint8_t *data, size_t len) {
+  uint64_t v0 = 0x736F6D6570736575ULL ^ key.k0;
+  uint64_t v1 = 0x646F72616E646F6DULL ^ key.k1;
+  uint64_t v2 = 0x6C7967656E657261ULL ^ key.k0;
+  uint64_t v3 = 0x7465646279746573ULL ^ key.k1;
+
+  size_t whole = len & ~(size_t)7;
+  for (size_t i = 0; i < whole; i += 8) {
+    uint64_t m = readLe64(data + i, 8);
+    v3 ^= m;
+    SIPROUND;
+    SIPROUND;
+    v0 ^= m;
+  }
+
+  uint64_t last = readLe64(data + whole, len - whole) | ((uint64_t)len << 56);
+  v3 ^= last;
+  SIPROUND;
+  SIPROUND;
+  v0 ^= last;
+
+  v2 ^= 0xFF;
+  SIPROUND;
+  SIPROUND;
+  SIPROUND;
+  SIPROUND;
+  return v0 ^ v1 ^ v2 ^ v3;
+}
+
+void FleetCodec::setKey(const char *passphrase) {
+  size_t len = strlen(passphrase);
+  keySet = len > 0;
+  // Two fixed-key hashes of the passphrase make the 128-bit key
+  key.k0 = sipHash24(FleetKey{0x74616C6C79666C74ULL, 0}, (const uint8_t *)passphrase, len);
+  key.k1 = sipHash24(FleetKey{0x74616C6C79666C74ULL, 1}, (const uint8_t *)passphrase, len);
+}
+
+void FleetCodec::encode(const FleetMessage &msg, uint8_t *buf) const {
+  memset(buf, 0, FLEET_MESSAGE_LENGTH);
+  buf[0] = 'T';
+  buf[1] = 'F';
+  buf[2] = FLEET_VERSION;
+  buf[3] = msg.type;
+  writeLe(buf + 4, msg.sequence, 4);
+  writeLe(buf + 8, msg.sender, 8);
+  writeLe(buf + 16, msg.arg, 4);
+  buf[20] = msg.command;
+  buf[21] = msg.hops;
+  writeLe(buf + 24, msg.arg2, 4);
+  writeLe(buf + FLEET_TAG_OFFSET, sipHash24(key, buf, FLEET_TAG_OFFSET), 8);
+}
+
+bool FleetCodec::decode(const uint8_t *buf, size_t len, FleetMessage *msg) const {
+  if (!keySet || len != FLEET_MESSAGE_LENGTH) return false;
+  if (buf[0] != 'T' || buf[1] != 'F' || buf[2] != FLEET_VERSION) return false;
+
+  // Whole-tag compare, so timing does not reveal how many bytes matched
+  uint64_t diff = sipHash24(key, buf, FLEET_TAG_OFFSET) ^ readLe64(buf + FLEET_TAG_OFFSET, 8);
+  if (diff != 0) return false;
+
+  msg->type = buf[3];
+  msg->sequence = (uint32_t)readLe64(buf + 4, 4);
+  msg->sender = readLe64(buf + 8, 8);
+  msg->arg = (uint32_t)readLe64(buf + 16, 4);
+  msg->command = buf[20];
+  msg->arg2 = (uint32_t)readLe64(buf + 24, 4);
+  msg->hops = buf[21];
+  return msg->type == FLEET_COMMAND || msg->type == FLEET_ACK || msg->type == FLEET_BEACON ||
+         msg->type == FLEET_SOURCE;
+}
+
+void FleetRound::begin(uint32_t sequence, uint8_t command, uint32_t arg, size_t expected, uint32_t nowUs) {
+  seq = sequence;
+  cmd = command;
+  cmdArg = arg;
+  sentUs = nowUs;
+  numExpected = expected;
+  numAcks = 0;
+  slowestUs = 0;
+}
+
+bool FleetRound::recordAck(uint32_t sequence, uint64_t sender, uint32_t ip, uint32_t nowUs) {
+  if (sequence != seq || numAcks == MAX_DISCOVERED_DEVICES) return false;
+  for (size_t i = 0; i < numAcks; i++) {
+    if (acks[i].sender == sender) return false;  // Ack to a retransmission
+  }
+
+  uint32_t latency = nowUs - sentUs;
+  acks[numAcks++] = FleetAck{ sender, ip, latency };
+  if (latency > slowestUs) slowestUs = latency;
+  return true;
+}
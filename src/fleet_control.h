@@ -0,0 +1,128 @@
+/*
+    Fleet control datagrams
+    Video Walrus 2025
+
+    One device sends a single command datagram to the TSL multicast group
+    on FLEET_PORT. Every tally applies it as soon as it arrives and acks
+    back to the sender by unicast. The sender times those acks, which
+    replaces the browser making one HTTP request per device.
+
+    Datagrams carry a SipHash-2-4 tag keyed from the shared fleet key, so
+    only devices configured with the same key act on them. Hardware-free,
+    like the tally core.
+
+    A disco started this way also sends FLEET_BEACON datagrams while it
+    runs, so every tally renders the same frame at the same time
+    (disco_show.h). A firmware update started this way is relayed from
+    tally to tally, announced with FLEET_SOURCE datagrams (fleet_ota.h).
+
+    Layout (40 bytes, little-endian):
+      0  "TF"        magic
+      2  version     FLEET_VERSION
+      3  type        FLEET_COMMAND, FLEET_ACK, FLEET_BEACON or FLEET_SOURCE
+      4  sequence    u32, chosen by the sender; acks echo it
+      8  sender      u64, MAC of the device that sent this datagram
+     16  arg         u32, command argument
+     20  command     FLEET_CMD_*
+     21  hops        FLEET_SOURCE only: distance from the update's seed
+     22  reserved    2 bytes, zero
+     24  arg2        u32, second argument
+     28  reserved    4 bytes, zero
+     32  tag         SipHash-2-4 of bytes 0-31
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "device_table.h"
+
+#define FLEET_PORT 8902
+#define FLEET_VERSION 1
+#define FLEET_MESSAGE_LENGTH 40
+#define FLEET_TAG_OFFSET 32
+
+enum FleetMessageType : uint8_t {
+  FLEET_COMMAND = 1,
+  FLEET_ACK = 2,
+  FLEET_BEACON = 3,  // Disco clock: sequence = show seed, arg = elapsed us, arg2 = duration ms
+  FLEET_SOURCE = 4,  // Sender serves the image tagged arg, hops from the seed; no ack
+};
+
+enum FleetCommand : uint8_t {
+  FLEET_CMD_TALLY = 1,       // arg = tally state (test buttons)
+  FLEET_CMD_DISCO = 2,       // arg = duration in ms, arg2 = show seed; starts at send time
+  FLEET_CMD_DISCO_STOP = 3,
+  FLEET_CMD_UPDATE = 4,      // arg = image tag (fleet_ota.h); the sender is the seed and serves it
+};
+
+struct FleetMessage {
+  uint8_t type;
+  uint32_t sequence;
+  uint64_t sender;
+  uint32_t arg;
+  uint8_t command;
+  uint32_t arg2;
+  uint8_t hops;
+};
+
+struct FleetKey {
+  uint64_t k0, k1;
+};
+
+uint64_t sipHash24(const FleetKey &key, const uint8_t *data, size_t len);
+
+class FleetCodec {
+ public:
+  // Derive the SipHash key from the configured passphrase; an empty
+  // passphrase disables fleet control
+  void setKey(const char *passphrase);
+  bool enabled() const { return keySet; }
+
+  // Writes FLEET_MESSAGE_LENGTH bytes to buf
+  void encode(const FleetMessage &msg, uint8_t *buf) const;
+  // False for anything that is not a well-formed datagram with a valid tag
+  bool decode(const uint8_t *buf, size_t len, FleetMessage *msg) const;
+  // Tag for other datagrams keyed from the fleet key (tsl_relay.h)
+  uint64_t tag(const uint8_t *data, size_t len) const { return sipHash24(key, data, len); }
+
+ private:
+  FleetKey key = {0, 0};
+  bool keySet = false;
+};
+
+struct FleetAck {
+  uint64_t sender;
+  uint32_t ip;         // Network byte order
+  uint32_t latencyUs;  // Command sent -> ack received
+};
+
+// Acks for the most recent command this device sent
+class FleetRound {
+ public:
+  void begin(uint32_t sequence, uint8_t command, uint32_t arg, size_t expected, uint32_t nowUs);
+  // Records the first ack from each sender for the current sequence;
+  // false for stale, duplicate or surplus acks
+  bool recordAck(uint32_t sequence, uint64_t sender, uint32_t ip, uint32_t nowUs);
+
+  uint32_t sequence() const { return seq; }
+  uint8_t command() const { return cmd; }
+  uint32_t arg() const { return cmdArg; }
+  uint32_t startUs() const { return sentUs; }
+  size_t expected() const { return numExpected; }
+  size_t count() const { return numAcks; }
+  const FleetAck &ack(size_t i) const { return acks[i]; }
+  // Slowest ack so far
+  uint32_t maxLatencyUs() const { return slowestUs; }
+
+ private:
+  uint32_t seq = 0;
+  uint8_t cmd = 0;
+  uint32_t cmdArg = 0;
+  uint32_t sentUs = 0;
+  size_t numExpected = 0;
+  size_t numAcks = 0;
+  uint32_t slowestUs = 0;
+  FleetAck acks[MAX_DISCOVERED_DEVICES];
+};
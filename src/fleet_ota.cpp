@@ -0,0 +1,101 @@
+/*
+    Fleet firmware distribution
+    Video Walrus 2025
+*/
+
+#include "fleet_ota.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ota_stream.h"
+
+uint32_t fleetImageTag(const uint8_t sha256[32]) {
+  return ((uint32_t)sha256[0] << 24) | ((uint32_t)sha256[1] << 16) | ((uint32_t)sha256[2] << 8) | sha256[3];
+}
+
+size_t formatFleetImage(const FleetCodec &codec, const char *version, const char *sha256Hex, uint32_t size,
+                        char *buf, size_t len) {
+  uint8_t digest[32];
+  size_t versionLen = strlen(version);
+  if (!codec.enabled() || versionLen == 0 || versionLen >= FLEET_IMAGE_MAX_VERSION || strchr(version, ' ') != NULL ||
+      !parseSha256(sha256Hex, digest)) {
+    return 0;
+  }
+  int n = snprintf(buf, len, "%s %s %u", version, sha256Hex, (unsigned)size);
+  if (n < 0 || (size_t)n + 18 > len) return 0;  // Room for " <mac>" and the NUL
+  uint64_t mac = codec.tag((const uint8_t *)buf, n);
+  n += snprintf(buf + n, len - n, " %08x%08x", (unsigned)(mac >> 32), (unsigned)mac);
+  return n;
+}
+
+bool parseFleetImage(const FleetCodec &codec, const char *text, FleetImage &image) {
+  const char *macAt = strrchr(text, ' ');
+  if (!codec.enabled() || macAt == NULL) return false;
+  char *end;
+  uint64_t mac = strtoull(macAt + 1, &end, 16);
+  if (end != macAt + 17 || *end != '\0') return false;
+  if (mac != codec.tag((const uint8_t *)text, macAt - text)) return false;
+
+  const char *space = strchr(text, ' ');
+  size_t versionLen = space - text;
+  if (versionLen == 0 || versionLen >= sizeof(image.version)) return false;
+  const char *hex = space + 1;
+  if (macAt - hex < 66 || hex[64] != ' ' || !parseSha256(hex, image.sha256)) return false;
+  unsigned long size = strtoul(hex + 65, &end, 10);
+  if (end == hex + 65 || end != macAt) return false;
+
+  memcpy(image.version, text, versionLen);
+  image.version[versionLen] = '\0';
+  image.size = size;
+  return true;
+}
+
+void FleetOtaSources::begin(uint32_t imageTag) {
+  tag = imageTag;
+  numSources = 0;
+}
+
+bool FleetOtaSources::add(uint32_t imageTag, uint32_t ip, uint8_t hops) {
+  if (imageTag != tag || ip == 0) return false;
+  for (size_t i = 0; i < numSources; i++) {
+    if (ips[i] == ip) {
+      if (hops < hopCounts[i]) hopCounts[i] = hops;
+      return true;
+    }
+  }
+  if (numSources == FLEET_OTA_MAX_SOURCES) return false;
+  ips[numSources] = ip;
+  hopCounts[numSources] = hops;
+  numSources++;
+  return true;
+}
+
+uint8_t FleetOtaSources::hops(uint32_t ip) const {
+  for (size_t i = 0; i < numSources; i++) {
+    if (ips[i] == ip) return hopCounts[i];
+  }
+  return FLEET_OTA_UNKNOWN_HOPS;
+}
+
+uint32_t FleetOtaSources::pick(uint8_t maxHops, uint32_t avoid, uint32_t &rng) const {
+  size_t eligible = 0;
+  bool avoided = false;
+  for (size_t i = 0; i < numSources; i++) {
+    if (hopCounts[i] >= maxHops) continue;
+    if (ips[i] == avoid) avoided = true;
+    else eligible++;
+  }
+  if (eligible == 0) return avoided ? avoid : 0;
+
+  rng ^= rng << 13;
+  rng ^= rng >> 17;
+  rng ^= rng << 5;
+  size_t n = rng % eligible;
+  for (size_t i = 0; i < numSources; i++) {
+    if (hopCounts[i] >= maxHops || ips[i] == avoid) continue;
+    if (n-- == 0) return ips[i];
+  }
+  return 0;
+}
@@ -0,0 +1,92 @@
+/*
+    Fleet firmware distribution
+    Video Walrus 2025
+
+    One tally (the seed) downloads an update from GitHub and announces it
+    to the fleet with FLEET_CMD_UPDATE. Every tally that is downloading
+    the image serves the part it has already written, to at most
+    FLEET_OTA_MAX_STREAMS peers at a time, and says so with a FLEET_SOURCE
+    datagram once its own download is under way. The image cuts through a
+    tree of tallies while the seed is still fetching it, so the fleet
+    finishes in about one download time plus a few LAN hops, instead of
+    one espota push or GitHub download per device.
+
+    Sources carry their hop count from the seed. After a drop a peer only
+    re-picks sources nearer the seed than itself, so pulls can never go
+    round in a loop. Every peer checks the full SHA-256 itself, so a bad
+    relay costs a retry, never a bad flash. The hash and version it
+    checks against come from the seed with a MAC under the fleet key, and
+    a peer only installs a version newer than its own. Hardware-free,
+    like the tally core.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fleet_control.h"
+
+#define FLEET_OTA_MAX_SOURCES 64
+#define FLEET_OTA_MAX_STREAMS 3      // Peers one tally serves at once
+#define FLEET_OTA_RETRY_MS 250       // Busy or dropped source: try another after this (plus jitter)
+#define FLEET_OTA_MAX_RETRY_MS 1000
+#define FLEET_OTA_MAX_STALLS 120     // Attempts in a row without progress before a peer gives up
+#define FLEET_OTA_LINGER_MS 10000    // Keep serving this long after the last peer left, then reboot
+#define FLEET_OTA_ANNOUNCE_MS 2000   // FLEET_SOURCE resend interval while downloading
+#define FLEET_OTA_UNKNOWN_HOPS 0xFF
+
+// Image tag: the first four bytes of its SHA-256, as carried in fleet
+// datagrams. Peers fetch the full hash from the source and check it
+// against the tag.
+uint32_t fleetImageTag(const uint8_t sha256[32]);
+
+// What a source serves on /api/fleet/image:
+//
+//   <version> <sha256> <size> <mac>
+//
+// sha256 is 64 hex digits and mac is the fleet key's SipHash-2-4 of
+// everything before it, as 16 hex digits. The tag in FLEET_CMD_UPDATE is
+// only 32 bits; the MAC makes the full hash and the version as
+// trustworthy as the command.
+#define FLEET_IMAGE_MAX_TEXT 128
+#define FLEET_IMAGE_MAX_VERSION 32
+
+struct FleetImage {
+  char version[FLEET_IMAGE_MAX_VERSION];
+  uint8_t sha256[32];
+  uint32_t size;
+};
+
+// Writes the description, NUL terminated, to buf and returns its length;
+// 0 if fleet control is off, the arguments are malformed or it does not fit
+size_t formatFleetImage(const FleetCodec &codec, const char *version, const char *sha256Hex, uint32_t size,
+                        char *buf, size_t len);
+// False if text is malformed or its MAC is not from our fleet key
+bool parseFleetImage(const FleetCodec &codec, const char *text, FleetImage &image);
+
+// Tallies that can serve the image being distributed, as heard on the
+// fleet channel
+class FleetOtaSources {
+ public:
+  // Forget every source; later adds must carry imageTag
+  void begin(uint32_t imageTag);
+  uint32_t imageTag() const { return tag; }
+  size_t count() const { return numSources; }
+
+  // Add a source, or lower its hop count; false if it is for another
+  // image or the table is full
+  bool add(uint32_t imageTag, uint32_t ip, uint8_t hops);
+  uint8_t hops(uint32_t ip) const;  // FLEET_OTA_UNKNOWN_HOPS if not a source
+
+  // A random source with fewer hops than maxHops, other than avoid (the
+  // one that just failed, if there is another); 0 if there is none.
+  // rng is xorshift32 state, never 0.
+  uint32_t pick(uint8_t maxHops, uint32_t avoid, uint32_t &rng) const;
+
+ private:
+  uint32_t tag = 0;
+  size_t numSources = 0;
+  uint32_t ips[FLEET_OTA_MAX_SOURCES];
+  uint8_t hopCounts[FLEET_OTA_MAX_SOURCES];
+};
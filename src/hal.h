@@ -0,0 +1,153 @@
+/*
+    Hardware abstraction for the tally core
+    Video Walrus 2025
+
+    The tally core (tally_core.h) only talks to the outside world through
+    these interfaces, so it builds both for the ESP32 (hal_esp32.cpp) and
+    for the host (native/hal_linux.cpp, pio run -e native).
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct Rgb {
+  uint8_t r, g, b;
+};
+
+inline bool operator==(const Rgb &a, const Rgb &b) {
+  return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+inline bool operator!=(const Rgb &a, const Rgb &b) {
+  return !(a == b);
+}
+
+inline Rgb rgbFromCode(uint32_t code) {
+  return Rgb{ (uint8_t)(code >> 16), (uint8_t)(code >> 8), (uint8_t)code };
+}
+
+// LED output (WS2812B chain on the ESP32, terminal on the host)
+class LedSink {
+ public:
+  virtual ~LedSink() {}
+  virtual size_t size() const = 0;
+  // Blocks until the frame has been clocked out
+  virtual void show(const Rgb *pixels, size_t count, uint8_t brightness) = 0;
+};
+
+// Monotonic time since boot
+class Clock {
+ public:
+  virtual ~Clock() {}
+  virtual uint32_t millis() = 0;
+  virtual uint32_t micros() = 0;
+};
+
+// Persistent settings (NVS Preferences on the ESP32, a text file on the host)
+class KeyValueStore {
+ public:
+  virtual ~KeyValueStore() {}
+  virtual bool begin(const char *ns, bool readOnly) = 0;
+  virtual void end() = 0;
+  virtual void clear() = 0;
+  virtual int32_t getInt(const char *key, int32_t defaultValue) = 0;
+  virtual void putInt(const char *key, int32_t value) = 0;
+  virtual bool getBool(const char *key, bool defaultValue) = 0;
+  virtual void putBool(const char *key, bool value) = 0;
+  // Copies the value (or defaultValue) into buf, always NUL terminated
+  virtual size_t getString(const char *key, char *buf, size_t len, const char *defaultValue) = 0;
+  virtual void putString(const char *key, const char *value) = 0;
+  // Binary blob; returns its length, or 0 if missing or not exactly len bytes
+  virtual size_t getBytes(const char *key, void *buf, size_t len) = 0;
+  virtual void putBytes(const char *key, const void *value, size_t len) = 0;
+};
+
+// Socket base: lwIP and Linux share the BSD socket API, so the UDP and
+// TCP sockets below (udp_socket.cpp, tcp_socket.cpp) serve both builds.
+class Socket {
+ public:
+  bool isOpen() const { return fd >= 0; }
+
+  // Block until a datagram or stream bytes are queued (or, for a TCP
+  // connect, it finished) or timeoutMs passes
+  bool wait(uint32_t timeoutMs) {
+    Socket *self = this;
+    return wait(&self, 1, timeoutMs);
+  }
+  // The same over count sockets; closed ones are skipped
+  static bool wait(Socket *const *sockets, size_t count, uint32_t timeoutMs);
+
+ protected:
+  int fd = -1;
+  bool connecting = false;  // TCP connect in progress: wait() watches for writable
+};
+
+// UDP socket
+class UdpSocket : public Socket {
+ public:
+  ~UdpSocket() { stop(); }
+
+  // Bind to port and join group (network byte order). By default on
+  // every interface; with ifName ("en1", "st1") only datagrams arriving
+  // on that interface are received, and the group is joined on ifAddr.
+  bool beginMulticast(uint32_t group, uint16_t port, const char *ifName = NULL, uint32_t ifAddr = 0);
+  // Bind to port on every interface, for unicast (and broadcast)
+  bool begin(uint16_t port);
+  // Unbound socket, for sending only
+  bool open();
+  void stop();
+  // The port bound to, e.g. the free one picked by begin(0); 0 if none
+  uint16_t localPort() const;
+
+  // Non-blocking; returns the datagram length, or 0 once the queue is drained
+  int receive(uint8_t *buf, size_t len, uint32_t *fromAddr = NULL, uint16_t *fromPort = NULL);
+  // addr in network byte order; false if the datagram was not queued
+  bool sendTo(uint32_t addr, uint16_t port, const uint8_t *buf, size_t len);
+};
+
+// TCP client socket. connect() only starts connecting; connected()
+// reports the outcome once wait() says the socket is ready.
+class TcpSocket : public Socket {
+ public:
+  ~TcpSocket() { stop(); }
+
+  // addr in network byte order; false if the connect could not be started
+  bool connect(uint32_t addr, uint16_t port);
+  // 1 once connected, 0 while still connecting, -1 if the connect failed
+  int connected();
+  void stop();
+
+  // Non-blocking; bytes read, 0 if nothing is queued, -1 once the peer
+  // closed the connection or it failed
+  int receive(uint8_t *buf, size_t len);
+};
+
+// HTTP(S) GET of a firmware image (HTTPClient on the ESP32, plain HTTP
+// sockets on the host)
+class HttpSource {
+ public:
+  virtual ~HttpSource() {}
+  // Request the image from byte offset on (a Range request if offset > 0).
+  // Returns the HTTP status, or < 0 if the request never got one. The
+  // Content-Range header (or "") goes to contentRange and the body length
+  // (-1 if unknown) to length.
+  virtual int open(uint32_t offset, char *contentRange, size_t rangeLen, int32_t *length) = 0;
+  // Up to len body bytes; <= 0 once the connection drops or times out
+  virtual int read(uint8_t *buf, size_t len) = 0;
+  virtual void close() = 0;
+};
+
+// Where a firmware image is written (the OTA partition on the ESP32, a
+// file on the host)
+class FirmwareSink {
+ public:
+  virtual ~FirmwareSink() {}
+  virtual bool begin(uint32_t size) = 0;
+  virtual bool write(const uint8_t *data, size_t len) = 0;
+  // Only called once the image is complete and verified
+  virtual bool finish() = 0;
+  virtual void abort() = 0;
+};
+
@@ -0,0 +1,258 @@
+/*
+    ESP32 implementations of the tally HAL
+    Video Walrus 2025
+*/
+
+#include "hal_esp32.h"
+
+#include <Arduino.h>
+#include <Update.h>
+#include <esp_ota_ops.h>
+
+#include "log_ring.h"
+
+// FastLED needs the data pin at compile time, so each usable GPIO gets
+// its own controller instantiation. Pins used by the W5500, the BOOT
+// button and USB are left out.
+#define LED_PIN_CASE(pin) case pin: return &FastLED.addLeds<WS2812B, pin, GRB>(data, count);
+
+static CLEDController *addController(uint8_t pin, CRGB *data, int count) {
+  switch (pin) {
+    LED_PIN_CASE(4)
+    LED_PIN_CASE(6)
+    LED_PIN_CASE(7)
+    LED_PIN_CASE(15)
+    LED_PIN_CASE(16)
+    LED_PIN_CASE(17)
+    LED_PIN_CASE(18)
+    LED_PIN_CASE(21)
+    LED_PIN_CASE(38)
+    LED_PIN_CASE(39)
+    LED_PIN_CASE(40)
+    LED_PIN_CASE(41)
+    LED_PIN_CASE(42)
+    default: return NULL;
+  }
+}
+
+static bool ledPinUsable(int pin) {
+  static const uint8_t pins[] = { 4, 6, 7, 15, 16, 17, 18, 21, 38, 39, 40, 41, 42 };
+  for (uint8_t p : pins) {
+    if (p == pin) return true;
+  }
+  return false;
+}
+
+size_t FastLedSink::parseOutputs(const char *spec, LedOutput *outputs, size_t max) {
+  size_t n = 0;
+  size_t total = 0;
+  const char *p = spec;
+  while (*p) {
+    char *end;
+    long pin = strtol(p, &end, 10);
+    if (end == p || *end != ':' || !ledPinUsable(pin)) return 0;
+    p = end + 1;
+    long leds = strtol(p, &end, 10);
+    if (end == p || leds < 1) return 0;
+    total += leds;
+    if (n == max || total > LED_MAX_PIXELS) return 0;
+    for (size_t i = 0; i < n; i++) {
+      if (outputs[i].pin == pin) return 0;  // Same pin twice
+    }
+    outputs[n++] = { (uint8_t)pin, (uint16_t)leds };
+    p = end;
+    if (*p == ',') p++;
+    else if (*p) return 0;
+  }
+  return n;
+}
+
+bool FastLedSink::begin(const char *spec) {
+  numOutputs = parseOutputs(spec, outputs, LED_MAX_OUTPUTS);
+  if (numOutputs == 0) return false;
+  count = 0;
+  for (size_t i = 0; i < numOutputs; i++) {
+    controllers[i] = addController(outputs[i].pin, buffers[front] + count, outputs[i].count);
+    count += outputs[i].count;
+  }
+  return true;
+}
+
+// Point every controller at one of the two frame buffers
+void FastLedSink::useBuffer(int index) {
+  front = index;
+  size_t offset = 0;
+  for (size_t i = 0; i < numOutputs; i++) {
+    controllers[i]->setLeds(buffers[front] + offset, outputs[i].count);
+    offset += outputs[i].count;
+  }
+}
+
+void FastLedSink::startOutputTask() {
+  if (taskHandle != NULL) return;
+  idle = xSemaphoreCreateBinary();
+  xSemaphoreGive(idle);
+  xTaskCreatePinnedToCore(
+    outputTask,        // Task function
+    "LED Task",        // Name
+    4096,              // Stack size
+    this,              // Parameters
+    3,                 // Priority (above the render task, so a frame starts at once)
+    &taskHandle,       // Task handle
+    1                  // Core 1
+  );
+}
+
+// Clocks out each frame handed over by show(); every RMT channel
+// transmits at once, so the outputs take as long as the longest chain
+void FastLedSink::outputTask(void *param) {
+  FastLedSink *sink = (FastLedSink *)param;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    uint32_t start = ::micros();
+    FastLED.setBrightness(sink->brightness);
+    FastLED.show();
+    if (sink->transferTime) sink->transferTime->record(::micros() - start);
+    xSemaphoreGive(sink->idle);
+  }
+}
+
+void FastLedSink::show(const Rgb *pixels, size_t n, uint8_t brightness) {
+  if (n > count) n = count;
+  if (taskHandle == NULL) {
+    CRGB *leds = buffers[front];
+    for (size_t i = 0; i < n; i++) leds[i] = CRGB(pixels[i].r, pixels[i].g, pixels[i].b);
+    FastLED.setBrightness(brightness);
+    FastLED.show();
+    return;
+  }
+
+  // The back buffer went out two frames ago; the frame in flight uses the front
+  CRGB *back = buffers[1 - front];
+  for (size_t i = 0; i < n; i++) back[i] = CRGB(pixels[i].r, pixels[i].g, pixels[i].b);
+  xSemaphoreTake(idle, portMAX_DELAY);
+  useBuffer(1 - front);
+  this->brightness = brightness;
+  xTaskNotifyGive(taskHandle);
+}
+
+int HttpsSource::open(uint32_t offset, char *contentRange, size_t rangeLen, int32_t *length) {
+  static const char *headers[] = { "Content-Range" };
+  close();
+  contentRange[0] = '\0';
+  *length = -1;
+
+  bool plain = url.startsWith("http://");
+  if (!plain && rootCas == NULL) return -1;
+  if (!plain) client.setCACert(rootCas);
+  http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
+  http.setTimeout(OTA_READ_TIMEOUT_MS);
+  if (!http.begin(plain ? (WiFiClient &)plainClient : client, url)) return -1;
+  opened = true;
+  http.collectHeaders(headers, 1);
+  if (offset > 0) http.addHeader("Range", "bytes=" + String(offset) + "-");
+
+  int status = http.GET();
+  if (status <= 0) {
+    close();
+    return -1;
+  }
+  snprintf(contentRange, rangeLen, "%s", http.header("Content-Range").c_str());
+  *length = http.getSize();
+  return status;
+}
+
+int HttpsSource::read(uint8_t *buf, size_t len) {
+  WiFiClient *stream = http.getStreamPtr();
+  if (!opened || stream == NULL) return -1;
+  uint32_t start = ::millis();
+  while (stream->available() == 0) {
+    if (!stream->connected() || ::millis() - start > OTA_READ_TIMEOUT_MS) return -1;
+    delay(1);
+  }
+  return stream->read(buf, len);
+}
+
+void HttpsSource::close() {
+  if (opened) http.end();
+  opened = false;
+}
+
+bool UpdateSink::begin(uint32_t size) {
+  imageSize = 0;
+  written = 0;
+  complete = false;
+  partition = esp_ota_get_next_update_partition(NULL);  // Where Update.begin() will write
+  if (!Update.begin(size)) return false;
+  imageSize = size;
+  return true;
+}
+
+bool UpdateSink::write(const uint8_t *data, size_t len) {
+  uint32_t at = written;
+  if (at < sizeof(head)) memcpy(head + at, data, len < sizeof(head) - at ? len : sizeof(head) - at);
+  if (Update.write(const_cast<uint8_t *>(data), len) != len) return false;
+  written = at + len;
+  return true;
+}
+
+bool UpdateSink::finish() {
+  if (Update.end()) {
+    complete = true;
+    return true;
+  }
+  LOG_INFO_STR("[OTA] %s", Update.errorString());
+  return false;
+}
+
+void UpdateSink::abort() {
+  imageSize = 0;
+  Update.abort();
+}
+
+int UpdateSink::readBack(uint32_t offset, uint8_t *buf, size_t len) {
+  uint32_t size = imageSize;
+  if (size == 0 || offset >= size) return -1;
+  // Update writes a sector once the next byte after it arrives, so all but
+  // the last (up to) 4 KB received is in flash
+  uint32_t w = written;
+  uint32_t inFlash = complete ? size : w > 0 ? (w - 1) / SPI_FLASH_SEC_SIZE * SPI_FLASH_SEC_SIZE : 0;
+  if (offset >= inFlash) return 0;
+  size_t n = inFlash - offset < len ? inFlash - offset : len;
+
+  size_t fromHead = 0;
+  if (offset < sizeof(head)) {
+    fromHead = sizeof(head) - offset < n ? sizeof(head) - offset : n;
+    memcpy(buf, head + offset, fromHead);
+  }
+  if (n > fromHead && esp_partition_read(partition, offset + fromHead, buf + fromHead, n - fromHead) != ESP_OK) return -1;
+  return n;
+}
+
+uint32_t ArduinoClock::millis() {
+  return ::millis();
+}
+
+uint32_t ArduinoClock::micros() {
+  return ::micros();
+}
+
+size_t PreferencesStore::getString(const char *key, char *buf, size_t len, const char *defaultValue) {
+  // isKey() first: a missing key makes getString() log an NVS error
+  if (prefs.isKey(key)) {
+    size_t n = prefs.getString(key, buf, len);
+    if (n > 0) return n;
+  }
+  strncpy(buf, defaultValue, len - 1);
+  buf[len - 1] = '\0';
+  return strlen(buf);
+}
+
+size_t PreferencesStore::getBytes(const char *key, void *buf, size_t len) {
+  if (!prefs.isKey(key) || prefs.getBytesLength(key) != len) return 0;
+  return prefs.getBytes(key, buf, len);
+}
+
+uint32_t logMicros() {
+  return ::micros();
+}
@@ -0,0 +1,135 @@
+/*
+    ESP32 implementations of the tally HAL
+    Video Walrus 2025
+*/
+
+#pragma once
+
+#include <FastLED.h>
+#include <HTTPClient.h>
+#include <Preferences.h>
+#include <WiFiClientSecure.h>
+#include <esp_partition.h>
+
+#include <atomic>
+
+#include "compositor.h"
+#include "hal.h"
+#include "tally_metrics.h"
+
+#define LED_MAX_OUTPUTS 4  // One RMT TX channel each on the ESP32-S3
+#define LED_MAX_PIXELS COMPOSITOR_MAX_PIXELS
+
+struct LedOutput {
+  uint8_t pin;
+  uint16_t count;
+};
+
+// WS2812B chains driven by FastLED, one RMT channel per output pin. Pixel
+// indexes run through the outputs in order, so "16:144,17:24" puts pixels
+// 0-143 on GPIO 16 and 144-167 on GPIO 17.
+//
+// Once startOutputTask() has run, show() only converts the frame into the
+// back buffer and hands it to the output task, which clocks it out while
+// the render task composes the next one. show() waits only if the
+// previous frame is still going out.
+class FastLedSink : public LedSink {
+ public:
+  // Parse "pin:count,pin:count"; returns the number of outputs, 0 if the
+  // string is invalid (unknown pin, too many outputs or pixels)
+  static size_t parseOutputs(const char *spec, LedOutput *outputs, size_t max);
+
+  // Register the outputs with FastLED; false (nothing added) if invalid
+  bool begin(const char *spec);
+  void startOutputTask();
+
+  size_t size() const override { return count; }
+  void show(const Rgb *pixels, size_t n, uint8_t brightness) override;
+
+  // Front buffer, for drawing directly before the output task starts
+  CRGB *leds() { return buffers[front]; }
+  LatencyHistogram *transferTime = NULL;  // Optional: FastLED.show() per frame
+
+ private:
+  static void outputTask(void *param);
+  void useBuffer(int index);
+
+  CRGB buffers[2][LED_MAX_PIXELS];
+  int front = 0;
+  CLEDController *controllers[LED_MAX_OUTPUTS] = {};
+  LedOutput outputs[LED_MAX_OUTPUTS] = {};
+  size_t numOutputs = 0;
+  size_t count = 0;
+  uint8_t brightness = 0;
+  TaskHandle_t taskHandle = NULL;
+  SemaphoreHandle_t idle = NULL;  // Given when no transfer is in flight
+};
+
+#define OTA_READ_TIMEOUT_MS 10000  // A stalled body counts as a dropped connection
+
+// HTTP(S) GET through HTTPClient, following GitHub's redirect to its
+// asset host; plain HTTP for "http://" URLs (a fleet peer). An https://
+// server must chain to one of rootCas, or the request fails.
+class HttpsSource : public HttpSource {
+ public:
+  String url;
+  const char *rootCas = NULL;  // PEM bundle, e.g. GITHUB_ROOT_CAS (github_ca.h)
+
+  int open(uint32_t offset, char *contentRange, size_t rangeLen, int32_t *length) override;
+  int read(uint8_t *buf, size_t len) override;
+  void close() override;
+
+ private:
+  WiFiClientSecure client;
+  WiFiClient plainClient;
+  HTTPClient http;
+  bool opened = false;
+};
+
+// The inactive OTA partition, through the Update library. readBack()
+// lets other tasks serve the image to fleet peers while it is written.
+class UpdateSink : public FirmwareSink {
+ public:
+  bool begin(uint32_t size) override;
+  bool write(const uint8_t *data, size_t len) override;
+  bool finish() override;
+  void abort() override;
+
+  uint32_t size() const { return imageSize; }  // 0 before begin() and after abort()
+  // Up to len bytes of the image from offset that are already in flash.
+  // 0 if none are yet, -1 if there is no image (aborted) or offset is
+  // past the end.
+  int readBack(uint32_t offset, uint8_t *buf, size_t len);
+
+ private:
+  const esp_partition_t *partition = NULL;
+  std::atomic<uint32_t> imageSize{0};
+  std::atomic<uint32_t> written{0};
+  std::atomic<bool> complete{false};
+  uint8_t head[16];  // Update holds the first 16 bytes back until end()
+};
+
+class ArduinoClock : public Clock {
+ public:
+  uint32_t millis() override;
+  uint32_t micros() override;
+};
+
+// NVS via Preferences
+class PreferencesStore : public KeyValueStore {
+ public:
+  bool begin(const char *ns, bool readOnly) override { return prefs.begin(ns, readOnly); }
+  void end() override { prefs.end(); }
+  void clear() override { prefs.clear(); }
+  int32_t getInt(const char *key, int32_t defaultValue) override { return prefs.getInt(key, defaultValue); }
+  void putInt(const char *key, int32_t value) override { prefs.putInt(key, value); }
+  bool getBool(const char *key, bool defaultValue) override { return prefs.getBool(key, defaultValue); }
+  void putBool(const char *key, bool value) override { prefs.putBool(key, value); }
+  size_t getString(const char *key, char *buf, size_t len, const char *defaultValue) override;
+  void putString(const char *key, const char *value) override { prefs.putString(key, value); }
+  size_t getBytes(const char *key, void *buf, size_t len) override;
+  void putBytes(const char *key, const void *value, size_t len) override { prefs.putBytes(key, value, len); }
+
+ private:
+  Preferences prefs;
+};
@@ -0,0 +1,29 @@
+/*
+    JSON string escaping for the web pages
+    Video Walrus 2025
+*/
+
+#include "json_text.h"
+
+#include <stdio.h>
+
+size_t jsonEscape(const char *s, char *buf, size_t len) {
+  if (len == 0) return 0;
+  size_t n = 0;
+  const char *p = s;
+  for (; *p; p++) {
+    char c[7] = { *p, 0 };
+    size_t width = 1;
+    if (*p == '"' || *p == '\\') {
+      c[0] = '\\';
+      c[1] = *p;
+      width = 2;
+    } else if ((unsigned char)*p < 0x20) {
+      width = snprintf(c, sizeof(c), "\\u%04x", (unsigned char)*p);
+    }
+    if (n + width + 1 > len) break;
+    for (size_t i = 0; i < width; i++) buf[n++] = c[i];
+  }
+  buf[n] = '\0';
+  return p - s;
+}
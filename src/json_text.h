@@ -0,0 +1,18 @@
+/*
+    JSON string escaping for the web pages
+    Video Walrus 2025
+
+    Settings, labels and hostnames come from users and the network, so
+    every string that goes into a JSON response is escaped here: quote,
+    backslash and control characters. Other bytes (UTF-8 included) pass
+    through. Hardware-free, like the tally core.
+*/
+
+#pragma once
+
+#include <stddef.h>
+
+// Escape the start of s for the inside of a JSON string into buf,
+// NUL-terminated. Stops short rather than split an escape; returns how
+// many bytes of s went in, so a long s can be written a piece at a time.
+size_t jsonEscape(const char *s, char *buf, size_t len);
@@ -0,0 +1,48 @@
+/*
+    Duplicate filter for listening on two links at once
+    Video Walrus 2025
+*/
+
+#include "link_dedupe.h"
+
+#include <string.h>
+
+// FNV-1a over the datagram, with its length folded in
+static uint32_t datagramHash(const uint8_t *data, size_t len) {
+  uint32_t h = 2166136261u ^ (uint32_t)len;
+  for (size_t i = 0; i < len; i++) {
+    h ^= data[i];
+    h *= 16777619u;
+  }
+  return h;
+}
+
+bool LinkDedupe::duplicate(int link, const uint8_t *data, size_t len, uint32_t nowUs) {
+  if (link < 0 || link >= LINK_DEDUPE_LINKS) return false;
+  uint32_t hash = datagramHash(data, len);
+  nowUs |= 1;  // 0 marks a free slot
+
+  // The oldest unmatched copy from the other link, so copies pair up in order
+  Seen *match = NULL;
+  for (int other = 0; other < LINK_DEDUPE_LINKS; other++) {
+    if (other == link) continue;
+    for (int i = 0; i < LINK_DEDUPE_SLOTS; i++) {
+      Seen &s = seen[other][i];
+      if (s.atUs == 0 || s.hash != hash || nowUs - s.atUs > LINK_DEDUPE_WINDOW_US) continue;
+      if (match == NULL || (int32_t)(s.atUs - match->atUs) < 0) match = &s;
+    }
+  }
+  if (match != NULL) {
+    match->atUs = 0;
+    return true;
+  }
+
+  seen[link][next[link]] = Seen{ hash, nowUs };
+  next[link] = (next[link] + 1) % LINK_DEDUPE_SLOTS;
+  return false;
+}
+
+void LinkDedupe::reset() {
+  memset(seen, 0, sizeof(seen));
+  memset(next, 0, sizeof(next));
+}
@@ -0,0 +1,37 @@
+/*
+    Duplicate filter for listening on two links at once
+    Video Walrus 2025
+
+    With TSL joined on Ethernet and WiFi, the same switcher datagram
+    arrives once on each. The first copy is decoded; the second, from
+    the other link, is dropped. Copies are matched one for one across
+    links, so a datagram the switcher genuinely sends again (a cut and
+    back, or its periodic resend) still goes through: that copy arrives
+    on the same link as the first and never matches it. Hardware-free,
+    like the tally core.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define LINK_DEDUPE_LINKS 2
+#define LINK_DEDUPE_SLOTS 32           // Unmatched datagrams remembered per link
+#define LINK_DEDUPE_WINDOW_US 500000   // Longest the second copy can lag the first
+
+class LinkDedupe {
+ public:
+  // True if data is the other link's copy of a datagram already taken
+  // from link; otherwise it is remembered for the other link to match
+  bool duplicate(int link, const uint8_t *data, size_t len, uint32_t nowUs);
+  void reset();
+
+ private:
+  struct Seen {
+    uint32_t hash;
+    uint32_t atUs;  // 0 = free or matched
+  };
+  Seen seen[LINK_DEDUPE_LINKS][LINK_DEDUPE_SLOTS] = {};
+  uint8_t next[LINK_DEDUPE_LINKS] = {};
+};
@@ -0,0 +1,93 @@
+/*
+    Deferred event log
+    Video Walrus 2025
+*/
+
+#include "log_ring.h"
+
+#include <stdio.h>
+#include <string.h>
+
+LogRing eventLog;
+
+LogRing::LogRing() {
+  for (uint32_t i = 0; i < LOG_RING_SIZE; i++) {
+    records[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+// A slot is free for position pos when its sequence equals pos, and ready
+// to drain when it equals pos + 1.
+void LogRing::push(uint8_t level, const char *fmt, const char *str,
+                   uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3, uint32_t a4, uint32_t a5) {
+  uint32_t pos = head.load(std::memory_order_relaxed);
+  LogRecord *record;
+  for (;;) {
+    record = &records[pos & (LOG_RING_SIZE - 1)];
+    uint32_t seq = record->sequence.load(std::memory_order_acquire);
+    int32_t diff = (int32_t)(seq - pos);
+    if (diff == 0) {
+      if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+    } else if (diff < 0) {
+      droppedCount.fetch_add(1, std::memory_order_relaxed);  // Full
+      return;
+    } else {
+      pos = head.load(std::memory_order_relaxed);
+    }
+  }
+
+  record->micros = logMicros();
+  record->fmt = fmt;
+  record->level = level;
+  record->args[0] = a0;
+  record->args[1] = a1;
+  record->args[2] = a2;
+  record->args[3] = a3;
+  record->args[4] = a4;
+  record->args[5] = a5;
+  if (str) {
+    strncpy(record->str, str, LOG_STR_LENGTH - 1);
+    record->str[LOG_STR_LENGTH - 1] = '\0';
+  } else {
+    record->str[0] = '\0';
+  }
+  record->sequence.store(pos + 1, std::memory_order_release);
+}
+
+size_t LogRing::drain(void (*emit)(const char *line, size_t len)) {
+  static const char *levelTags[] = { "D", "I", "W" };
+  char line[192];
+  size_t count = 0;
+
+  for (;;) {
+    LogRecord &record = records[tail & (LOG_RING_SIZE - 1)];
+    if (record.sequence.load(std::memory_order_acquire) != tail + 1) break;
+
+    int n = snprintf(line, sizeof(line), "%lu.%03lu %s ",
+                     (unsigned long)(record.micros / 1000000), (unsigned long)(record.micros / 1000 % 1000),
+                     levelTags[record.level < 3 ? record.level : 2]);
+    const uint32_t *a = record.args;
+    if (strstr(record.fmt, "%s")) {
+      n += snprintf(line + n, sizeof(line) - n, record.fmt, record.str, a[0], a[1], a[2], a[3], a[4], a[5]);
+    } else {
+      n += snprintf(line + n, sizeof(line) - n, record.fmt, a[0], a[1], a[2], a[3], a[4], a[5]);
+    }
+    if (n >= (int)sizeof(line) - 1) n = sizeof(line) - 2;
+    if (line[n - 1] != '\n') line[n++] = '\n';
+    line[n] = '\0';
+
+    record.sequence.store(tail + LOG_RING_SIZE, std::memory_order_release);
+    tail++;
+    emit(line, n);
+    count++;
+  }
+
+  uint32_t dropped = droppedCount.load(std::memory_order_relaxed);
+  if (dropped != reportedDrops) {
+    int n = snprintf(line, sizeof(line), "[Log] %lu records dropped (ring full)\n",
+                     (unsigned long)(dropped - reportedDrops));
+    reportedDrops = dropped;
+    emit(line, n);
+  }
+  return count;
+}
@@ -0,0 +1,92 @@
+/*
+    Deferred event log
+    Video Walrus 2025
+
+    Logging from the packet and render paths must never wait on Serial
+    (USB-CDC blocks when no host is reading). LOG_* calls store a format
+    string pointer, a timestamp and a few integer arguments into a
+    lock-free ring; a low-priority task formats and prints them later.
+
+    Format strings must be literals. Integer conversions only, apart from
+    the LOG_*_STR variants, which copy one short string (first conversion
+    must be %s) into the record.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_NONE 3
+
+// Compile-time threshold; calls below it compile to nothing
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#define LOG_RING_SIZE 64     // Records, power of two
+#define LOG_MAX_ARGS 6
+#define LOG_STR_LENGTH 24    // Copied string argument, including NUL
+
+struct LogRecord {
+  std::atomic<uint32_t> sequence;  // Slot turn, see LogRing
+  uint32_t micros;
+  const char *fmt;
+  uint8_t level;
+  uint32_t args[LOG_MAX_ARGS];
+  char str[LOG_STR_LENGTH];        // Empty unless logged with a string
+};
+
+// Bounded multi-producer ring (Vyukov). Producers claim a slot with one
+// compare-and-swap and never block: if the ring is full the record is
+// dropped and counted. drain() must only be called from one task.
+class LogRing {
+ public:
+  LogRing();
+
+  void push(uint8_t level, const char *fmt, const char *str,
+            uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3, uint32_t a4, uint32_t a5);
+
+  // Format every pending record as one line ("12.345 message\n") and pass
+  // it to emit. Returns the number of records drained.
+  size_t drain(void (*emit)(const char *line, size_t len));
+
+  uint32_t dropped() const { return droppedCount.load(std::memory_order_relaxed); }
+
+ private:
+  LogRecord records[LOG_RING_SIZE];
+  std::atomic<uint32_t> head{0};  // Next slot to claim
+  uint32_t tail = 0;              // Next slot to drain (consumer only)
+  uint32_t reportedDrops = 0;     // Consumer only
+  std::atomic<uint32_t> droppedCount{0};
+};
+
+extern LogRing eventLog;
+
+// Timestamp source for records; defined by the platform (micros() on the
+// ESP32, CLOCK_MONOTONIC on the host)
+uint32_t logMicros();
+
+inline void logEvent(uint8_t level, const char *fmt, uint32_t a0 = 0, uint32_t a1 = 0, uint32_t a2 = 0,
+                     uint32_t a3 = 0, uint32_t a4 = 0, uint32_t a5 = 0) {
+  eventLog.push(level, fmt, NULL, a0, a1, a2, a3, a4, a5);
+}
+
+inline void logEventStr(uint8_t level, const char *fmt, const char *str, uint32_t a0 = 0, uint32_t a1 = 0,
+                        uint32_t a2 = 0, uint32_t a3 = 0, uint32_t a4 = 0, uint32_t a5 = 0) {
+  eventLog.push(level, fmt, str, a0, a1, a2, a3, a4, a5);
+}
+
+#define LOG_AT(level, fn, ...) \
+  do { if ((level) >= LOG_LEVEL) fn((level), __VA_ARGS__); } while (0)
+
+#define LOG_DEBUG(...) LOG_AT(LOG_LEVEL_DEBUG, logEvent, __VA_ARGS__)
+#define LOG_INFO(...) LOG_AT(LOG_LEVEL_INFO, logEvent, __VA_ARGS__)
+#define LOG_WARN(...) LOG_AT(LOG_LEVEL_WARN, logEvent, __VA_ARGS__)
+#define LOG_DEBUG_STR(...) LOG_AT(LOG_LEVEL_DEBUG, logEventStr, __VA_ARGS__)
+#define LOG_INFO_STR(...) LOG_AT(LOG_LEVEL_INFO, logEventStr, __VA_ARGS__)
+#define LOG_WARN_STR(...) LOG_AT(LOG_LEVEL_WARN, logEventStr, __VA_ARGS__)
@@ -5,18 +5,30 @@
 
 #include <Arduino.h>
 #include <FastLED.h>
-#include <Preferences.h>
-#include <WebServer.h>
+#include <ESPAsyncWebServer.h>
 #include <WiFi.h>
 
-#define BUFFER_LENGTH 256
-#define NUM_LEDS 7
-#define DATA_PIN 16
+#include "device_table.h"
+#include "fleet_control.h"
+#include "fleet_ota.h"
+#include "github_ca.h"
+#include "hal_esp32.h"
+#include "json_text.h"
+#include "link_dedupe.h"
+#include "log_ring.h"
+#include "ota_stream.h"
+#include "request_limit.h"
+#include "tally_core.h"
+#include "tally_events.h"
+#include "tsl_relay.h"
+#include "tsl_stream.h"
+#include "web_assets.h"  // Generated from web/index.html by scripts/build_web.py
+
+#define BUFFER_LENGTH 1472  // Largest UDP payload on a 1500-byte MTU
+#define DEFAULT_LED_OUTPUTS "16:7"  // 7-LED ring on GPIO 16
 #define RESET_BUTTON_PIN 0  // GPIO 0 (BOOT button) for factory reset
 #define WIFI_CONNECT_TIMEOUT 10000  // 10 seconds to connect to WiFi
 #define FIRMWARE_VERSION "1.0.7"
-#define MAX_DISCOVERED_DEVICES 16
-
 // W5500 SPI Ethernet configuration - MUST be defined BEFORE including ETH.h
 #define ETH_PHY_TYPE    ETH_PHY_W5500
 #define ETH_PHY_ADDR    1
@@ -30,13 +42,14 @@
 
 #include <ETH.h>
 #include <SPI.h>
-#include <NetworkUdp.h>
 #include <ArduinoOTA.h>
 #include <ESPmDNS.h>
+#include <mdns.h>
+#include <esp_timer.h>
+#include <time.h>
 #include <DNSServer.h>
 #include <HTTPClient.h>
 #include <WiFiClientSecure.h>
-#include <Update.h>
 
 // GitHub OTA Update configuration
 #define GITHUB_REPO "videojedi/esp32-s3-tally"
@@ -49,32 +62,110 @@ void resetSettings();
 void checkResetButton();
 void onEvent(arduino_event_id_t event);
 void setupWebServer();
-String getConfigPage();
-void udpTSL(char *data);
+void serviceEventClients();
+void serviceWebJobs();
+void scheduleRestart(uint32_t delayMs);
+void checkForUpdates();
+enum OtaMode : uint8_t {
+  OTA_FROM_GITHUB,
+  OTA_FLEET_SEED,  // From GitHub, serving the fleet as it downloads
+  OTA_FLEET_PEER,  // From other tallies (fleet_ota.h)
+};
+void startOtaTask(OtaMode mode);
+void otaTask(void *pvParameters);
 void setTallyState(int state);
-bool setupWiFi();
+void postRenderCommand(RenderCommandType type, uint32_t arg, uint32_t seed = 0, uint32_t epochUs = 0);
+void startRenderTask();
+void renderTask(void *pvParameters);
+void startLogTask();
+void logTask(void *pvParameters);
+bool startWiFi(bool standby = false);
 void startAP();
 String getActiveIP();
-void startUDP();
-void stopUDP();
 void udpListenerTask(void *pvParameters);
 void startUDPTask();
 void stopUDPTask();
 void startMDNS();
-void testLED();
-void discoverTallyDevices();
+void startOTA();
+void startServices();
+void serviceBoot();
+void discoveryTask(void *pvParameters);
+void startDiscoveryTask();
+void fleetTask(void *pvParameters);
+void startFleetTask();
 String getDefaultHostname();
 
-// Web server
-WebServer server(80);
+// Web server (async: handlers run on the AsyncTCP task, not in loop())
+#define MAX_HTTP_REQUESTS 8
+AsyncWebServer server(80);
+AsyncEventSource events("/events");
+AsyncCorsMiddleware eventsCors;
+RequestLimit httpLimit(MAX_HTTP_REQUESTS);
+SemaphoreHandle_t webDataMutex = NULL;  // Device table, fleet round and update status
+
+// Work the handlers hand to loop()
+volatile bool updateCheckRequested = false;
+volatile bool updateRequested = false;
+volatile uint32_t restartAt = 0;  // millis() to restart at, 0 = none
+
+// The fields of a /save request, copied on the AsyncTCP task for loop()
+// to apply. The handler only fills it while saveRequested is false, and
+// loop() only reads it while it is true.
+#define MAX_SAVE_FIELDS 40  // The settings page sends 27
+class SettingsForm {
+ public:
+  void clear() { count = 0; }
+  void add(const String &name, const String &value) {
+    if (count == MAX_SAVE_FIELDS) return;
+    names[count] = name;
+    values[count] = value;
+    count++;
+  }
+  bool has(const char *name) const { return find(name) >= 0; }
+  String arg(const char *name) const {
+    int i = find(name);
+    return i < 0 ? String() : values[i];
+  }
+
+ private:
+  int find(const char *name) const {
+    for (size_t i = 0; i < count; i++) {
+      if (names[i] == name) return i;
+    }
+    return -1;
+  }
+
+  String names[MAX_SAVE_FIELDS];
+  String values[MAX_SAVE_FIELDS];
+  size_t count = 0;
+};
+SettingsForm saveForm;
+std::atomic<bool> saveRequested{false};
+std::atomic<bool> resetRequested{false};  // /reset: loop() restores the defaults and restarts
 DNSServer dnsServer;
-Preferences preferences;
+PreferencesStore preferences;
 
 // Configurable settings (loaded from NVS)
 int tslAddress = 0;
 int maxBrightness = 50;  // Max brightness (0-255), TSL brightness maps to this
+String ledRoles = "T";   // Per-LED roles (compositor.h); the last one repeats
+String ledOutputs = DEFAULT_LED_OUTPUTS;  // "pin:count,..." (hal_esp32.h)
+String tslRules = "";    // Tally rule table (tally_core.h); empty = our address only
+int restoreTimeoutS = 600;  // Restored tally held this long without TSL; 0 = never restore
+int lostSignalS = 0;        // Pulse lostSignalColor after this long without TSL; 0 = off
+String lostSignalColor = "0000FF";  // RRGGBB
+std::atomic<uint32_t> lostSignalRgb{0x0000FF};  // lostSignalColor as a number, for the UDP task
 int tslPort = 8901;      // TSL multicast port
+int tslProtocol = TSL_PROTOCOL_V31;
 String tslMulticast = "239.1.2.3";  // TSL multicast address
+bool tslMulticastOn = true;
+int tslUnicastPort = 0;   // TSL over unicast UDP; 0 = off
+String tslTcpHost = "";   // TSL server or aggregator (IPv4) to stay connected to; empty = off
+int tslTcpPort = 8900;
+// TSL relay (tsl_relay.h): pass the feed on to subscribed tallies, or take
+// it from a relay. Needs the fleet key.
+enum RelayRole { RELAY_ROLE_OFF, RELAY_ROLE_RELAY, RELAY_ROLE_SUBSCRIBE };
+int relayRole = RELAY_ROLE_OFF;
 bool useDHCP = true;
 String staticIP = "192.168.1.100";
 String gateway = "192.168.1.1";
@@ -86,6 +177,12 @@ String deviceHostname = "ESP-TSL-Tally";
 String wifiSSID = "";
 String wifiPassword = "";
 bool wifiEnabled = false;
+// With Ethernet up: FAILOVER_STANDBY keeps WiFi associated and listens
+// on it once Ethernet drops; FAILOVER_DUAL listens on both all the time
+// (LinkDedupe drops the second copy). Ethernet is preferred whenever it
+// has an address.
+enum NetFailover { FAILOVER_OFF, FAILOVER_STANDBY, FAILOVER_DUAL };
+int netFailover = FAILOVER_STANDBY;
 
 // AP settings
 String apSSID = "TSL-Tally-Setup";
@@ -98,42 +195,204 @@ int greenLED = false;
 
 IPAddress multicastAddress;
 
-// Synchronous UDP for dedicated task
-NetworkUDP udp;
+// Multicast receive sockets, one per link and bound to its interface, so
+// the listener task knows which link a datagram came in on. It blocks in
+// select() on every open one.
+#define UDP_SELECT_TIMEOUT_MS 100
+#define UDP_JOIN_RETRY_MS 1000
+enum TslLink { TSL_LINK_ETHERNET, TSL_LINK_WIFI, NUM_TSL_LINKS };
+static const char *const tslLinkNames[NUM_TSL_LINKS] = { "Ethernet", "WiFi" };
+UdpSocket tslSockets[NUM_TSL_LINKS];  // UDP task only
+LinkDedupe tslDedupe;                 // UDP task only
+
+// The other TSL receivers, also on the UDP task and into the same decoder:
+// unicast UDP, and a TCP client (tsl_stream.h)
+UdpSocket tslUnicastSocket;
+TcpSocket tslTcpSocket;
+UdpSocket tslRelaySocket;  // Either role, on TSL_RELAY_PORT
 
 // FreeRTOS task handle for UDP listener
 TaskHandle_t udpTaskHandle = NULL;
-volatile bool udpRunning = false;
-
-CRGB leds[NUM_LEDS];
+std::atomic<uint8_t> tslRejoinLinks{0};  // Links that got a (new) address: bit per TslLink
+std::atomic<uint32_t> ethDownUs{0};      // Ethernet lost its address (micros() | 1); for the UDP task
 
+static bool eth_link = false;  // Cable in, whether or not we have an address yet
 static bool eth_connected = false;
 static bool wifi_connected = false;
 static bool ap_mode = false;
-static bool discoMode = false;
-static unsigned long discoEndTime = 0;
-String currentTallyState = "Off";
-String currentTallyText = "";
-
-// Structure for discovered tally devices
-struct TallyDevice {
-  String hostname;
-  String ip;
-  int tslAddress;
-  String tallyState;
-  unsigned long lastSeen;
-  bool online;
-};
 
-TallyDevice discoveredDevices[MAX_DISCOVERED_DEVICES];
-int numDiscoveredDevices = 0;
-unsigned long lastDiscoveryScan = 0;
+// Tally core (tally_core.h): the UDP task decodes into tslDecoder, which
+// publishes our address through the lock-free mailbox to the render task.
+// ledSink is owned by the render task once it is running; setup() draws
+// on it directly (fillLeds) before that.
+FastLedSink ledSink;
+ArduinoClock appClock;
+TallyMailbox tallyMailbox;
+TslDecoder tslDecoder(tallyMailbox, appClock);
+TallyRenderer tallyRenderer(ledSink, appClock, tallyMailbox);
+TallyRules tallyRules;  // Read-only once setup() has compiled it
+TslTcpClient tslTcp(tslTcpSocket, appClock);  // UDP task only, once started
+
+// Last tally state (SavedTally, tally_core.h). The UDP task copies it to
+// RTC memory on every change, which survives a crash or software reset
+// but not a power cut; loop() batches it into NVS on
+// TallySaveSchedule's terms. setup() restores the RTC copy if it is
+// younger than restoreTimeoutS, else the NVS copy (age unknown after a
+// power cut), and the decoder holds it until TSL confirms it or the
+// timeout runs out.
+#define TALLY_STORE_NAMESPACE "tallymem"
+RTC_NOINIT_ATTR SavedTally rtcTally;
+std::atomic<uint32_t> rtcTallyWrites{0};  // Seqlock over rtcTally: odd while the UDP task writes
+PreferencesStore tallyStore;              // loop() only, apart from setup()
+TallySaveSchedule tallySaveSchedule;
+const char *tallyRestoredFrom = "none";   // For /api/boot
+bool tallyRestored = false;                // setup() put a saved tally back; set before any task starts
+volatile bool tslSignalLost = false;      // UDP task
+
+// Boot-time LED patterns, before the render task owns the LEDs
+void fillLeds(const CRGB &color) {
+  fill_solid(ledSink.leds(), ledSink.size(), color);
+}
 
-// GitHub OTA update state
+// Served from /metrics; recorded with atomics, formatted into a static buffer
+TallyMetrics tallyMetrics;
+static char metricsBuffer[TALLY_METRICS_MAX_LENGTH];
+
+// Deferred log (log_ring.h): the log task prints it to Serial and keeps
+// the most recent lines for /log
+#define LOG_DRAIN_INTERVAL_MS 50
+#define LOG_HISTORY_SIZE 4096
+static char logHistory[LOG_HISTORY_SIZE];
+static size_t logHistoryHead = 0;  // Next write position
+static bool logHistoryWrapped = false;
+SemaphoreHandle_t logHistoryMutex = NULL;
+TaskHandle_t logTaskHandle = NULL;
+
+// Commands from the web/loop side (core 1) to the render task
+#define RENDER_QUEUE_LENGTH 8
+QueueHandle_t renderQueue = NULL;
+TaskHandle_t renderTaskHandle = NULL;
+esp_timer_handle_t renderFrameTimer = NULL;  // Wakes the render task for the next animation frame
+
+// Server-Sent Events (/events), loop() only (tally_events.h)
+TallyEventFeed tallyEvents;
+
+// Other tally devices, kept up to date by the discovery task
+#define DISCOVERY_QUERY_MS 3000         // How long each mDNS query collects answers
+#define DISCOVERY_INTERVAL_MS 15000     // Between queries
+#define DISCOVERY_OFFLINE_MS 45000      // Longest a device stays online without an answer
+#define DISCOVERY_FORGET_MS 600000      // Dropped from the table after 10 minutes' silence
+#define DISCOVERY_MAX_RESULTS (MAX_DISCOVERED_DEVICES < 255 ? MAX_DISCOVERED_DEVICES : 255)  // mDNS counts in a uint8_t
+#define DISCOVER_PAGE_LIMIT 32          // Default /discover page size
+DeviceTable deviceTable;  // Guarded by webDataMutex
+TaskHandle_t discoveryTaskHandle = NULL;
+volatile bool discoveryScanning = false;
+
+// Fleet control (fleet_control.h): commands every tally with the same
+// fleet key in one datagram. Disabled until a key is set.
+#define FLEET_QUEUE_LENGTH 4
+#define FLEET_RETRANSMIT_MS 25   // First resend; doubles each time
+#define FLEET_RETRANSMITS 3      // Unless every online device has acked
+#define FLEET_IDLE_WAIT_MS 1000
+String fleetKey = "";
+FleetCodec fleetCodec;  // Keyed in setup(), before the UDP task starts
+TslRelay tslRelay(tslRelaySocket, appClock, fleetCodec);                      // UDP task only
+TslRelaySubscriber tslRelaySubscriber(tslRelaySocket, appClock, fleetCodec);  // UDP task only
+uint64_t fleetDeviceId = 0;       // Our MAC, as advertised in the mDNS "mac" TXT record
+UdpSocket fleetSocket;            // Fleet task only
+UdpSocket fleetWakeSocket;        // AsyncTCP task only; wakes the fleet task from select()
+QueueHandle_t fleetQueue = NULL;  // Commands from the web server
+TaskHandle_t fleetTaskHandle = NULL;
+uint32_t fleetSequence = 0;       // Last sequence sent; AsyncTCP task only
+FleetRound fleetRound;            // Guarded by webDataMutex
+ShowSync discoSync;               // Disco show we follow; fleet task only
+
+// GitHub OTA update state, guarded by webDataMutex. The OTA task
+// (ota_stream.h) downloads firmwareURL and only installs it if it hashes
+// to firmwareSha256, published with the release.
 String latestVersion = "";
 String firmwareURL = "";
+String firmwareSha256 = "";    // 64 hex digits, "" if the release has none
 bool updateAvailable = false;
-bool updateInProgress = false;
+OtaProgress otaProgress = {};  // Copied out of the OTA task for /status
+TaskHandle_t otaTaskHandle = NULL;
+UpdateSink otaSink;            // Written by the OTA task, read back for fleet peers
+volatile bool updateAsFleetSeed = false;  // Set with updateRequested by /api/fleet/update
+
+// Fleet update (fleet_ota.h): the seed downloads from GitHub and every
+// tally relays what it has to the next ones
+OtaMode otaMode = OTA_FROM_GITHUB;       // Of the running (or last) OTA task
+FleetOtaSources fleetOtaSources;        // Guarded by webDataMutex
+volatile bool fleetUpdateRequested = false;  // FLEET_CMD_UPDATE heard; loop() starts a peer download
+String fleetOtaVersion = "";            // Image we distribute, for /api/fleet/image; webDataMutex
+String fleetOtaSha256 = "";
+uint32_t otaFleetTag = 0;
+uint8_t otaFleetHops = FLEET_OTA_UNKNOWN_HOPS;  // Our distance from the seed; OTA task only
+std::atomic<int> fleetOtaStreams{0};    // Peers pulling from us right now
+volatile uint32_t fleetOtaLastServedMs = 0;
+
+// A peer's /api/fleet/firmware.bin stream ended
+static void fleetOtaStreamDone() {
+  fleetOtaStreams--;
+  fleetOtaLastServedMs = millis();
+}
+
+// Why the chip last reset, for /api/boot
+static const char *resetReasonName(esp_reset_reason_t reason) {
+  switch (reason) {
+    case ESP_RST_POWERON: return "power-on";
+    case ESP_RST_BROWNOUT: return "brownout";
+    case ESP_RST_EXT: return "external";
+    case ESP_RST_SW: return "software";
+    case ESP_RST_PANIC: return "panic";
+    case ESP_RST_INT_WDT:
+    case ESP_RST_TASK_WDT:
+    case ESP_RST_WDT: return "watchdog";
+    case ESP_RST_DEEPSLEEP: return "deep-sleep";
+    default: return "other";
+  }
+}
+
+// Boot: setup() only loads settings, starts the LEDs and starts Ethernet.
+// serviceBoot() in loop() joins multicast the moment a link has an
+// address, and only then starts the web server, mDNS, ArduinoOTA, the
+// fleet task and the LED self-test, so a tally that lost power mid-show
+// is back on air as soon as its network is.
+#define BOOT_ETH_LINK_TIMEOUT_MS 3000   // No Ethernet link by then: try WiFi
+#define BOOT_ETH_IP_TIMEOUT_MS 10000    // Link but no address by then: try WiFi
+#define BOOT_SELF_TEST_STEP_MS 500      // Red, green, blue, unless a tally arrives first or was restored
+enum BootStage : uint8_t {
+  BOOT_WAIT_ETHERNET,
+  BOOT_WAIT_WIFI,
+  BOOT_SELF_TEST,
+  BOOT_DONE,
+};
+BootStage bootStage = BOOT_WAIT_ETHERNET;  // loop() only
+uint32_t bootStageStartMs = 0;
+
+// When each boot phase finished, in micros() since the app started (0 =
+// not yet), for /api/boot. Each is written once, by whichever task gets
+// there.
+enum BootPhase : uint8_t {
+  BOOT_PHASE_SETTINGS,      // NVS loaded
+  BOOT_PHASE_LEDS,          // Render task owns the LEDs
+  BOOT_PHASE_LINK,          // First address on any interface
+  BOOT_PHASE_LISTENING,     // Multicast joined: tally-ready
+  BOOT_PHASE_FIRST_PACKET,  // First TSL datagram
+  BOOT_PHASE_FIRST_TALLY,   // First one for us
+  BOOT_PHASE_SERVICES,      // Web server, mDNS, ArduinoOTA and fleet running
+  BOOT_PHASE_SELF_TEST,     // LED self-test over (or skipped for a tally)
+  NUM_BOOT_PHASES,
+};
+static const char *const bootPhaseNames[NUM_BOOT_PHASES] = {
+  "settings", "leds", "link", "listening", "firstPacket", "firstTally", "services", "selfTest",
+};
+volatile uint32_t bootPhaseUs[NUM_BOOT_PHASES] = {};
+const char *bootLink = "";  // Interface that came up first
+
+static void markBootPhase(BootPhase phase) {
+  if (bootPhaseUs[phase] == 0) bootPhaseUs[phase] = micros() | 1;
+}
 
 // Generate unique default hostname using ESP32 base MAC address
 String getDefaultHostname() {
@@ -145,29 +404,71 @@ String getDefaultHostname() {
   return String(hostname);
 }
 
+// Read a string setting from the open store
+#define MAX_SETTING_LENGTH 640  // A full tally rule table
+static String getStringSetting(const char *key, const String &defaultValue) {
+  char buf[MAX_SETTING_LENGTH];
+  preferences.getString(key, buf, sizeof(buf), defaultValue.c_str());
+  return String(buf);
+}
+
 // Load settings from NVS
 void loadSettings() {
   preferences.begin("tally", true);  // read-only
   tslAddress = preferences.getInt("tslAddress", 0);
   maxBrightness = preferences.getInt("maxBright", 50);
   tslPort = preferences.getInt("tslPort", 8901);
-  tslMulticast = preferences.getString("tslMcast", "239.1.2.3");
+  tslProtocol = preferences.getInt("tslProto", TSL_PROTOCOL_V31);
+  tslMulticast = getStringSetting("tslMcast", "239.1.2.3");
+  tslMulticastOn = preferences.getBool("tslMcastOn", true);
+  tslUnicastPort = preferences.getInt("tslUdpPort", 0);
+  tslTcpHost = getStringSetting("tslTcpHost", "");
+  tslTcpPort = preferences.getInt("tslTcpPort", 8900);
   useDHCP = preferences.getBool("useDHCP", true);
-  staticIP = preferences.getString("staticIP", "192.168.1.100");
-  gateway = preferences.getString("gateway", "192.168.1.1");
-  subnet = preferences.getString("subnet", "255.255.255.0");
-  dns = preferences.getString("dns", "8.8.8.8");
-  deviceHostname = preferences.getString("hostname", getDefaultHostname());
-  wifiSSID = preferences.getString("wifiSSID", "");
-  wifiPassword = preferences.getString("wifiPass", "");
+  staticIP = getStringSetting("staticIP", "192.168.1.100");
+  gateway = getStringSetting("gateway", "192.168.1.1");
+  subnet = getStringSetting("subnet", "255.255.255.0");
+  dns = getStringSetting("dns", "8.8.8.8");
+  deviceHostname = getStringSetting("hostname", getDefaultHostname());
+  wifiSSID = getStringSetting("wifiSSID", "");
+  wifiPassword = getStringSetting("wifiPass", "");
   wifiEnabled = preferences.getBool("wifiEnabled", false);
+  netFailover = preferences.getInt("failover", FAILOVER_STANDBY);
+  relayRole = preferences.getInt("relayRole", RELAY_ROLE_OFF);
+  fleetKey = getStringSetting("fleetKey", "");
+  ledRoles = getStringSetting("ledRoles", "T");
+  ledOutputs = getStringSetting("ledOutputs", DEFAULT_LED_OUTPUTS);
+  tslRules = getStringSetting("tslRules", "");
+  restoreTimeoutS = preferences.getInt("restoreS", 600);
+  lostSignalS = preferences.getInt("lostSignalS", 0);
+  lostSignalColor = getStringSetting("lostColor", "0000FF");
+  lostSignalRgb = strtoul(lostSignalColor.c_str(), NULL, 16);
   preferences.end();
 
   Serial.println("Settings loaded:");
   Serial.printf("  TSL Address: %d\n", tslAddress);
-  Serial.printf("  TSL Multicast: %s\n", tslMulticast.c_str());
+  Serial.printf("  TSL Multicast: %s\n", tslMulticastOn ? tslMulticast.c_str() : "Off");
   Serial.printf("  TSL Port: %d\n", tslPort);
+  if (tslUnicastPort > 0) {
+    Serial.printf("  TSL Unicast Port: %d\n", tslUnicastPort);
+  }
+  if (tslTcpHost.length() > 0) {
+    Serial.printf("  TSL TCP Server: %s:%d\n", tslTcpHost.c_str(), tslTcpPort);
+  }
+  if (relayRole != RELAY_ROLE_OFF) {
+    Serial.printf("  TSL Relay: %s\n", relayRole == RELAY_ROLE_RELAY ? "Relay" : "Subscribe");
+  }
+  Serial.printf("  TSL Protocol: %s\n", tslProtocol == TSL_PROTOCOL_V50 ? "5.0" : "3.1");
   Serial.printf("  Max Brightness: %d\n", maxBrightness);
+  Serial.printf("  LED Outputs: %s\n", ledOutputs.c_str());
+  Serial.printf("  LED Roles: %s\n", ledRoles.c_str());
+  if (tslRules.length() > 0) {
+    Serial.printf("  Tally Rules: %s\n", tslRules.c_str());
+  }
+  Serial.printf("  Restore Tally: %d s\n", restoreTimeoutS);
+  if (lostSignalS > 0) {
+    Serial.printf("  Lost Signal: %d s, %s\n", lostSignalS, lostSignalColor.c_str());
+  }
   Serial.printf("  DHCP: %s\n", useDHCP ? "Yes" : "No");
   if (!useDHCP) {
     Serial.printf("  Static IP: %s\n", staticIP.c_str());
@@ -179,7 +480,10 @@ void loadSettings() {
   Serial.printf("  WiFi Enabled: %s\n", wifiEnabled ? "Yes" : "No");
   if (wifiEnabled && wifiSSID.length() > 0) {
     Serial.printf("  WiFi SSID: %s\n", wifiSSID.c_str());
+    Serial.printf("  WiFi Failover: %s\n", netFailover == FAILOVER_DUAL ? "Dual listen"
+                                           : netFailover == FAILOVER_STANDBY ? "Standby" : "Off");
   }
+  Serial.printf("  Fleet Control: %s\n", fleetKey.length() > 0 ? "Yes" : "No");
 }
 
 // Save settings to NVS
@@ -188,16 +492,30 @@ void saveSettings() {
   preferences.putInt("tslAddress", tslAddress);
   preferences.putInt("maxBright", maxBrightness);
   preferences.putInt("tslPort", tslPort);
-  preferences.putString("tslMcast", tslMulticast);
+  preferences.putInt("tslProto", tslProtocol);
+  preferences.putString("tslMcast", tslMulticast.c_str());
+  preferences.putBool("tslMcastOn", tslMulticastOn);
+  preferences.putInt("tslUdpPort", tslUnicastPort);
+  preferences.putString("tslTcpHost", tslTcpHost.c_str());
+  preferences.putInt("tslTcpPort", tslTcpPort);
   preferences.putBool("useDHCP", useDHCP);
-  preferences.putString("staticIP", staticIP);
-  preferences.putString("gateway", gateway);
-  preferences.putString("subnet", subnet);
-  preferences.putString("dns", dns);
-  preferences.putString("hostname", deviceHostname);
-  preferences.putString("wifiSSID", wifiSSID);
-  preferences.putString("wifiPass", wifiPassword);
+  preferences.putString("staticIP", staticIP.c_str());
+  preferences.putString("gateway", gateway.c_str());
+  preferences.putString("subnet", subnet.c_str());
+  preferences.putString("dns", dns.c_str());
+  preferences.putString("hostname", deviceHostname.c_str());
+  preferences.putString("wifiSSID", wifiSSID.c_str());
+  preferences.putString("wifiPass", wifiPassword.c_str());
   preferences.putBool("wifiEnabled", wifiEnabled);
+  preferences.putInt("failover", netFailover);
+  preferences.putInt("relayRole", relayRole);
+  preferences.putString("fleetKey", fleetKey.c_str());
+  preferences.putString("ledRoles", ledRoles.c_str());
+  preferences.putString("ledOutputs", ledOutputs.c_str());
+  preferences.putString("tslRules", tslRules.c_str());
+  preferences.putInt("restoreS", restoreTimeoutS);
+  preferences.putInt("lostSignalS", lostSignalS);
+  preferences.putString("lostColor", lostSignalColor.c_str());
   preferences.end();
   Serial.println("Settings saved to NVS");
 }
@@ -207,13 +525,21 @@ void resetSettings() {
   preferences.begin("tally", false);
   preferences.clear();
   preferences.end();
+  tallyStore.begin(TALLY_STORE_NAMESPACE, false);
+  tallyStore.clear();
+  tallyStore.end();
   Serial.println("Settings reset to factory defaults");
 
   // Reset to defaults in memory
   tslAddress = 0;
   maxBrightness = 50;
   tslPort = 8901;
+  tslProtocol = TSL_PROTOCOL_V31;
   tslMulticast = "239.1.2.3";
+  tslMulticastOn = true;
+  tslUnicastPort = 0;
+  tslTcpHost = "";
+  tslTcpPort = 8900;
   useDHCP = true;
   staticIP = "192.168.1.100";
   gateway = "192.168.1.1";
@@ -223,6 +549,16 @@ void resetSettings() {
   wifiSSID = "";
   wifiPassword = "";
   wifiEnabled = false;
+  netFailover = FAILOVER_STANDBY;
+  relayRole = RELAY_ROLE_OFF;
+  fleetKey = "";
+  ledRoles = "T";
+  ledOutputs = DEFAULT_LED_OUTPUTS;
+  tslRules = "";
+  restoreTimeoutS = 600;
+  lostSignalS = 0;
+  lostSignalColor = "0000FF";
+  lostSignalRgb = 0x0000FF;
 }
 
 // Check if reset button is held during boot
@@ -237,20 +573,20 @@ void checkResetButton() {
     while (digitalRead(RESET_BUTTON_PIN) == LOW) {
       if (millis() - startTime > 3000) {
         Serial.println("Resetting to factory defaults!");
-        fill_solid(leds, NUM_LEDS, CRGB::Blue);
+        fillLeds(CRGB::Blue);
         FastLED.show();
         resetSettings();
         delay(1000);
-        fill_solid(leds, NUM_LEDS, CRGB::Black);
+        fillLeds(CRGB::Black);
         FastLED.show();
         break;
       }
       // Blink red while waiting
-      fill_solid(leds, NUM_LEDS, ((millis() / 200) % 2) ? CRGB::Red : CRGB::Black);
+      fillLeds(((millis() / 200) % 2) ? CRGB::Red : CRGB::Black);
       FastLED.show();
       delay(50);
     }
-    fill_solid(leds, NUM_LEDS, CRGB::Black);
+    fillLeds(CRGB::Black);
     FastLED.show();
   }
 }
@@ -264,28 +600,42 @@ void onEvent(arduino_event_id_t event) {
       // to be set before DHCP, so set it from the event handler thread.
       ETH.setHostname(deviceHostname.c_str());
       break;
-    case ARDUINO_EVENT_ETH_CONNECTED: Serial.println("ETH Connected"); break;
+    case ARDUINO_EVENT_ETH_CONNECTED:
+      Serial.println("ETH Connected");
+      eth_link = true;
+      break;
     case ARDUINO_EVENT_ETH_GOT_IP:
       Serial.println("ETH Got IP");
       Serial.println(ETH);
+      markBootPhase(BOOT_PHASE_LINK);
       eth_connected = true;
+      ETH.setDefault();  // Outgoing traffic too; WiFi's route priority is higher
+      tslRejoinLinks.fetch_or(1 << TSL_LINK_ETHERNET);
       break;
     case ARDUINO_EVENT_ETH_LOST_IP:
       Serial.println("ETH Lost IP");
+      if (eth_connected) ethDownUs.store(micros() | 1);
       eth_connected = false;
       break;
     case ARDUINO_EVENT_ETH_DISCONNECTED:
       Serial.println("ETH Disconnected");
+      if (eth_connected) ethDownUs.store(micros() | 1);
+      eth_link = false;
       eth_connected = false;
       break;
     case ARDUINO_EVENT_ETH_STOP:
       Serial.println("ETH Stopped");
+      if (eth_connected) ethDownUs.store(micros() | 1);
+      eth_link = false;
       eth_connected = false;
       break;
     case ARDUINO_EVENT_WIFI_STA_GOT_IP:
       Serial.println("WiFi Got IP");
       Serial.println(WiFi.localIP());
+      markBootPhase(BOOT_PHASE_LINK);
       wifi_connected = true;
+      if (eth_connected) ETH.setDefault();  // Standby: keep Ethernet the default route
+      tslRejoinLinks.fetch_or(1 << TSL_LINK_WIFI);
       break;
     case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
       Serial.println("WiFi Disconnected");
@@ -331,61 +681,26 @@ String getConnectionStatus() {
   return status;
 }
 
-// Try to connect to WiFi
-bool setupWiFi() {
+// Start connecting to WiFi; serviceBoot() waits for the address. A
+// standby connection (Ethernet is up) shows nothing on the LEDs, and
+// keeps the radio awake so multicast isn't held back for the next beacon.
+bool startWiFi(bool standby) {
   if (!wifiEnabled || wifiSSID.length() == 0) {
     Serial.println("WiFi not configured or disabled");
     return false;
   }
 
-  Serial.printf("Connecting to WiFi: %s\n", wifiSSID.c_str());
-
-  // Make sure WiFi is in a clean state
-  WiFi.disconnect(true);
-  delay(100);
-  yield();
-
+  Serial.printf("Connecting to WiFi%s: %s\n", standby ? " (standby)" : "", wifiSSID.c_str());
   WiFi.setHostname(deviceHostname.c_str());
   WiFi.mode(WIFI_STA);
-  delay(100);
-  yield();
-
+  if (standby) WiFi.setSleep(false);
   WiFi.begin(wifiSSID.c_str(), wifiPassword.c_str());
-
-  unsigned long startTime = millis();
-  while (WiFi.status() != WL_CONNECTED && millis() - startTime < WIFI_CONNECT_TIMEOUT) {
-    yield();  // Feed the watchdog
-    delay(100);
-    Serial.print(".");
-    // Blink purple while connecting
-    fill_solid(leds, NUM_LEDS, ((millis() / 300) % 2) ? CRGB::Purple : CRGB::Black);
-    FastLED.show();
-  }
-  Serial.println();
-
-  fill_solid(leds, NUM_LEDS, CRGB::Black);
-  FastLED.show();
-
-  if (WiFi.status() == WL_CONNECTED) {
-    Serial.printf("WiFi connected! IP: %s\n", WiFi.localIP().toString().c_str());
-    wifi_connected = true;
-    return true;
-  } else {
-    Serial.println("WiFi connection failed");
-    WiFi.disconnect(true);
-    return false;
-  }
+  if (!standby) postRenderCommand(RENDER_FLASH, CRGB::Purple);  // Flash purple while connecting
+  return true;
 }
 
 // Start Access Point for configuration
 void startAP() {
-  // Flash white briefly to show we're about to start AP
-  fill_solid(leds, NUM_LEDS, CRGB::White);
-  FastLED.show();
-  delay(100);
-  fill_solid(leds, NUM_LEDS, CRGB::Black);
-  FastLED.show();
-
   // Disconnect any existing WiFi first
   WiFi.disconnect(true);
   delay(100);
@@ -415,145 +730,348 @@ void startAP() {
     dnsServer.start(53, "*", apIP);
     Serial.println("Captive portal DNS started");
 
-    // Blink cyan to indicate AP mode
-    for (int i = 0; i < 3; i++) {
-      fill_solid(leds, NUM_LEDS, CRGB::Cyan);
-      FastLED.show();
-      delay(200);
-      fill_solid(leds, NUM_LEDS, CRGB::Black);
-      FastLED.show();
-      delay(200);
-      yield();  // Feed watchdog
-    }
-    // Leave LED dim cyan to show AP mode is active
-    FastLED.setBrightness(10);
-    fill_solid(leds, NUM_LEDS, CRGB::Cyan);
-    FastLED.show();
+    // Pulse cyan to show AP mode is active
+    postRenderCommand(RENDER_PULSE, CRGB::Cyan);
   } else {
     Serial.println("ERROR: Failed to start AP!");
-    // Blink red to indicate error
-    for (int i = 0; i < 5; i++) {
-      fill_solid(leds, NUM_LEDS, CRGB::Red);
-      FastLED.show();
-      delay(100);
-      fill_solid(leds, NUM_LEDS, CRGB::Black);
-      FastLED.show();
-      delay(100);
-    }
+    postRenderCommand(RENDER_FLASH, CRGB::Red);
   }
 }
 
-// Set tally state directly (used by both TSL and test buttons)
+// Queue a command for the render task and wake it
+void postRenderCommand(RenderCommandType type, uint32_t arg, uint32_t seed, uint32_t epochUs) {
+  if (renderQueue == NULL) return;
+  RenderCommand cmd = { type, arg, seed, epochUs };
+  xQueueSend(renderQueue, &cmd, 0);
+  xTaskNotifyGive(renderTaskHandle);
+}
+
+// Set tally state locally (test buttons); the next TSL packet overrides it
 void setTallyState(int state) {
-  FastLED.setBrightness(maxBrightness);
-  switch (state) {
-    case 0:
-      fill_solid(leds, NUM_LEDS, CRGB::Black);
-      currentTallyState = "Off";
-      Serial.println("Tally: Off");
-      break;
-    case 1:
-      fill_solid(leds, NUM_LEDS, CRGB::Green);
-      currentTallyState = "Green";
-      Serial.println("Tally: Green");
-      break;
-    case 2:
-      fill_solid(leds, NUM_LEDS, CRGB::Red);
-      currentTallyState = "Red";
-      Serial.println("Tally: Red");
-      break;
-    case 3:
-      fill_solid(leds, NUM_LEDS, CRGB::Yellow);
-      currentTallyState = "Yellow";
-      Serial.println("Tally: Yellow");
-      break;
-    default:
-      fill_solid(leds, NUM_LEDS, CRGB::Black);
-      currentTallyState = "Off";
-      Serial.println("Tally: Off*");
+  postRenderCommand(RENDER_TALLY, state);
+}
+
+// Render task - sole owner of ledSink once started.
+// Wakes on a task notification from the UDP task, postRenderCommand() or
+// the frame timer.
+void renderTask(void *pvParameters) {
+  Serial.printf("[Render Task] Running on core %d\n", xPortGetCoreID());
+
+  for (;;) {
+    // Animations need a frame tick; otherwise sleep until something happens.
+    // The tick comes from a microsecond timer rather than the 1 ms RTOS
+    // tick, so synchronised disco frames change together.
+    esp_timer_stop(renderFrameTimer);
+    if (tallyRenderer.animating()) esp_timer_start_once(renderFrameTimer, tallyRenderer.frameDueInUs());
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    RenderCommand cmd;
+    while (xQueueReceive(renderQueue, &cmd, 0) == pdTRUE) {
+      tallyRenderer.handleCommand(cmd);
+    }
+    tallyRenderer.update();
   }
-  FastLED.show();
 }
 
-void udpTSL(char *data) {
-  char* message;
-  int T;
-  int Bright;
-  int addr;
-  String text;
-  message = data;
+// Start the render task on core 1 at a higher priority than loop()
+void startRenderTask() {
+  if (renderTaskHandle != NULL) return;
 
-  addr = message[0] - 128;
+  ledSink.startOutputTask();
+  renderQueue = xQueueCreate(RENDER_QUEUE_LENGTH, sizeof(RenderCommand));
+  esp_timer_create_args_t timerArgs = {};
+  timerArgs.callback = [](void *) { xTaskNotifyGive(renderTaskHandle); };
+  timerArgs.name = "render frame";
+  esp_timer_create(&timerArgs, &renderFrameTimer);
+  xTaskCreatePinnedToCore(
+    renderTask,        // Task function
+    "Render Task",     // Name
+    4096,              // Stack size
+    NULL,              // Parameters
+    2,                 // Priority (loop() runs at 1)
+    &renderTaskHandle, // Task handle
+    1                  // Core 1
+  );
+  // Pick up anything the UDP task published before we existed
+  xTaskNotifyGive(renderTaskHandle);
+  Serial.println("[Render] Task started on core 1");
+}
 
-  if (tslAddress == addr) {
-    T = message[1] & 0b00001111;
+// Log task: prints LOG_* records on behalf of the tasks that logged them
+static void emitLogLine(const char *line, size_t len) {
+  Serial.write((const uint8_t *)line, len);
 
-    for (int j = 2; j < 18; j++) {
-      char c = message[j];
-      if (c == '\0') break;  // Stop at null terminator
-      if (c >= 32 && c < 127) text += c;  // Only printable ASCII
+  xSemaphoreTake(logHistoryMutex, portMAX_DELAY);
+  for (size_t i = 0; i < len; i++) {
+    logHistory[logHistoryHead++] = line[i];
+    if (logHistoryHead == LOG_HISTORY_SIZE) {
+      logHistoryHead = 0;
+      logHistoryWrapped = true;
     }
-    text.trim();  // Remove trailing spaces
-    currentTallyText = text;
-    Serial.printf("Text: %s\n", text.c_str());
+  }
+  xSemaphoreGive(logHistoryMutex);
+}
+
+void logTask(void *pvParameters) {
+  for (;;) {
+    eventLog.drain(emitLogLine);
+    vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_INTERVAL_MS));
+  }
+}
 
-    Bright = message[1] & 0b00110000;
-    Bright = Bright >> 4;
-    Bright = map(Bright, 0, 3, 0, maxBrightness);
-    Serial.printf("Brightness: %d\n", Bright);
-    FastLED.setBrightness(Bright);
+// Start the log task on core 0, below the UDP task
+void startLogTask() {
+  if (logTaskHandle != NULL) return;
 
-    setTallyState(T);
+  logHistoryMutex = xSemaphoreCreateMutex();
+  xTaskCreatePinnedToCore(
+    logTask,           // Task function
+    "Log Task",        // Name
+    4096,              // Stack size
+    NULL,              // Parameters
+    0,                 // Priority (idle; only runs when nothing else wants core 0)
+    &logTaskHandle,    // Task handle
+    0                  // Core 0
+  );
+}
+
+// Join the TSL group on one link, bound to its interface
+static bool joinTslLink(TslLink link) {
+  NetworkInterface &iface = link == TSL_LINK_ETHERNET ? static_cast<NetworkInterface &>(ETH) : WiFi.STA;
+  String ifName = iface.impl_name();  // lwIP's name for it, e.g. "en1"
+  // IPAddress converts to network byte order
+  if (ifName.length() == 0 ||
+      !tslSockets[link].beginMulticast((uint32_t)multicastAddress, tslPort, ifName.c_str(), (uint32_t)iface.localIP())) {
+    LOG_WARN_STR("[UDP] Failed to join multicast on %s", tslLinkNames[link]);
+    return false;
   }
+  uint32_t group = (uint32_t)multicastAddress;
+  LOG_INFO_STR("[UDP] Multicast listening on %s, %u.%u.%u.%u:%u", tslLinkNames[link], group & 0xFF,
+               (group >> 8) & 0xFF, (group >> 16) & 0xFF, group >> 24, tslPort);
+  markBootPhase(BOOT_PHASE_LISTENING);
+  static bool joinedBefore = false;
+  if (joinedBefore) TallyMetrics::increment(tallyMetrics.multicastRejoins);
+  joinedBefore = true;
+  return true;
 }
 
-// Start UDP multicast listener
-void startUDP() {
-  if (udpRunning) return;
+// Failover timing, UDP task only: when Ethernet went down, and whether
+// WiFi has taken over yet. The first WiFi datagram after that ends it.
+static uint32_t failoverDownUs = 0;
+static bool failoverListening = false;
+
+// Listen on the links that should carry TSL: Ethernet whenever it has an
+// address, and WiFi when Ethernet hasn't (or always, with FAILOVER_DUAL).
+// A link that got a new address joins again, since the membership may
+// not have survived it going down. Runs every pass of the UDP task, so a
+// link change is acted on within UDP_SELECT_TIMEOUT_MS.
+static void updateTslLinks() {
+  static uint32_t retryAtMs[NUM_TSL_LINKS];
+  uint8_t rejoin = tslRejoinLinks.exchange(0);
+  uint32_t downUs = ethDownUs.exchange(0);
+  if (downUs != 0) {
+    failoverDownUs = downUs;
+    failoverListening = false;
+  }
 
-  Serial.println("Joining multicast group...");
-  if (udp.beginMulticast(multicastAddress, tslPort)) {
-    Serial.printf("UDP multicast listening on %s:%d\n",
-                  multicastAddress.toString().c_str(), tslPort);
-    udpRunning = true;
-  } else {
-    Serial.println("Failed to start multicast UDP!");
+  bool want[NUM_TSL_LINKS] = {
+    tslMulticastOn && eth_connected,
+    tslMulticastOn && wifi_connected && (netFailover == FAILOVER_DUAL || !eth_connected),
+  };
+  bool wifiOnly = tslSockets[TSL_LINK_WIFI].isOpen() && !tslSockets[TSL_LINK_ETHERNET].isOpen();
+  // Ethernet first, so failing back joins it before WiFi is left
+  for (int link = 0; link < NUM_TSL_LINKS; link++) {
+    UdpSocket &socket = tslSockets[link];
+    if (socket.isOpen() && (!want[link] || (rejoin & (1 << link)))) {
+      socket.stop();
+      LOG_INFO_STR("[UDP] Left the group on %s", tslLinkNames[link]);
+    }
+    if (want[link] && !socket.isOpen() && (int32_t)(millis() - retryAtMs[link]) >= 0) {
+      if (!joinTslLink((TslLink)link)) retryAtMs[link] = millis() + UDP_JOIN_RETRY_MS;
+    }
+  }
+
+  if (tslSockets[TSL_LINK_ETHERNET].isOpen()) {
+    if (wifiOnly) {
+      TallyMetrics::increment(tallyMetrics.failbacks);
+      LOG_INFO("[NET] Ethernet back: listening on Ethernet");
+    }
+    failoverDownUs = 0;
+  } else if (failoverDownUs != 0 && !failoverListening && tslSockets[TSL_LINK_WIFI].isOpen()) {
+    failoverListening = true;
+    uint32_t ms = (micros() - failoverDownUs) / 1000;
+    tallyMetrics.failoverListenMs.store(ms, std::memory_order_relaxed);
+    TallyMetrics::increment(tallyMetrics.failovers);
+    LOG_INFO("[NET] Ethernet down: listening on WiFi after %u ms", ms);
   }
 }
 
-// Stop UDP listener
-void stopUDP() {
-  if (udpRunning) {
-    udp.stop();
-    udpRunning = false;
-    Serial.println("[UDP] Stopped");
+// Unicast UDP and TCP: bound or connected once there is a network. The
+// multicast sockets already take unicast sent to their own port.
+static void updateTslReceivers() {
+  static uint32_t retryAtMs = 0;
+  bool online = eth_connected || wifi_connected;
+  bool unicast = tslUnicastPort > 0 && !(tslMulticastOn && tslUnicastPort == tslPort);
+  if (unicast && online && !tslUnicastSocket.isOpen() && (int32_t)(millis() - retryAtMs) >= 0) {
+    if (tslUnicastSocket.begin(tslUnicastPort)) {
+      LOG_INFO("[UDP] Unicast listening on port %u", tslUnicastPort);
+      markBootPhase(BOOT_PHASE_LISTENING);
+    } else {
+      retryAtMs = millis() + UDP_JOIN_RETRY_MS;
+    }
   }
+
+  tslTcp.service(online);
+  if (tslTcp.state() == TSL_TCP_CONNECTED) markBootPhase(BOOT_PHASE_LISTENING);
+
+  static uint32_t relayRetryAtMs = 0;
+  bool relay = relayRole != RELAY_ROLE_OFF && fleetCodec.enabled();
+  if (relay && online && !tslRelaySocket.isOpen() && (int32_t)(millis() - relayRetryAtMs) >= 0) {
+    if (tslRelaySocket.begin(TSL_RELAY_PORT)) {
+      LOG_INFO_STR("[RELAY] TSL relay %s on port %u", relayRole == RELAY_ROLE_RELAY ? "serving" : "subscribing",
+                   TSL_RELAY_PORT);
+      if (relayRole == RELAY_ROLE_SUBSCRIBE) markBootPhase(BOOT_PHASE_LISTENING);
+    } else {
+      relayRetryAtMs = millis() + UDP_JOIN_RETRY_MS;
+    }
+  }
+  if (!tslRelaySocket.isOpen()) return;
+  if (relayRole == RELAY_ROLE_SUBSCRIBE) tslRelaySubscriber.service();
 }
 
-// UDP listener task - runs on core 0 for reliable multicast reception
-void udpListenerTask(void *pvParameters) {
-  Serial.printf("[UDP Task] Running on core %d\n", xPortGetCoreID());
+// After each decode, from any receiver: wake the render task and note
+// the boot phases
+static void afterTslDecode(bool ours, uint32_t rxMicros) {
+  tallyMetrics.receiveToDecode.record(micros() - rxMicros);
+  if (ours && renderTaskHandle != NULL) xTaskNotifyGive(renderTaskHandle);
+  if (bootPhaseUs[BOOT_PHASE_FIRST_TALLY] == 0) {
+    markBootPhase(BOOT_PHASE_FIRST_PACKET);
+    if (ours) markBootPhase(BOOT_PHASE_FIRST_TALLY);
+  }
+}
+
+// Drain one UDP socket; link is its TslLink, or NUM_TSL_LINKS for unicast
+static void receiveTslDatagrams(UdpSocket &socket, int link) {
+  static uint8_t buffer[BUFFER_LENGTH];
+  int len;
+  uint32_t fromAddr;
+  uint16_t fromPort;
+  while ((len = socket.receive(buffer, sizeof(buffer), &fromAddr, &fromPort)) > 0) {
+    uint32_t rxMicros = micros();
+    TallyMetrics::increment(tallyMetrics.packetsReceived);
+    // fromAddr is in network byte order: first octet in the low byte
+    LOG_DEBUG("[UDP] From %u.%u.%u.%u:%u, Length: %d", fromAddr & 0xFF, (fromAddr >> 8) & 0xFF,
+              (fromAddr >> 16) & 0xFF, fromAddr >> 24, fromPort, len);
+    if (tslDedupe.duplicate(link, buffer, len, rxMicros)) {
+      TallyMetrics::increment(tallyMetrics.duplicatesDropped);
+      continue;
+    }
+    if (link == TSL_LINK_WIFI && failoverListening) {
+      failoverListening = false;
+      uint32_t ms = (rxMicros - failoverDownUs) / 1000;
+      tallyMetrics.failoverPacketMs.store(ms, std::memory_order_relaxed);
+      LOG_INFO("[NET] First TSL on WiFi %u ms after Ethernet went down", ms);
+    }
+
+    bool ours = tslProtocol == TSL_PROTOCOL_V50
+                    ? tslDecoder.decodeTsl5(buffer, len, rxMicros)
+                    : tslDecoder.decodeTsl31(buffer, len, rxMicros);
+    afterTslDecode(ours, rxMicros);
+  }
+}
 
-  char buffer[256];
+// Drain the relay socket: subscriptions to a relay, or a relay's deltas
+// and keyframes to a subscriber
+static void receiveRelayDatagrams() {
+  static uint8_t buffer[TSL_RELAY_MAX_DATAGRAM];
+  int len;
+  uint32_t fromAddr;
+  uint16_t fromPort;
+  while ((len = tslRelaySocket.receive(buffer, sizeof(buffer), &fromAddr, &fromPort)) > 0) {
+    uint32_t rxMicros = micros();
+    if (relayRole == RELAY_ROLE_RELAY) {
+      tslRelay.handle(buffer, len, fromAddr, fromPort, tslDecoder);
+      continue;
+    }
+    TallyMetrics::increment(tallyMetrics.packetsReceived);
+    bool ours;
+    if (tslRelaySubscriber.handle(buffer, len, fromAddr, tslDecoder, rxMicros, ours)) {
+      afterTslDecode(ours, rxMicros);
+    }
+  }
+}
+
+// Copy the decoder's state to RTC memory; UDP task only
+static void saveRtcTally() {
+  uint32_t seq = rtcTallyWrites.load(std::memory_order_relaxed);
+  rtcTallyWrites.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  tslDecoder.saveState(rtcTally, time(NULL));
+  rtcTallyWrites.store(seq + 2, std::memory_order_release);
+}
+
+// Consistent copy of rtcTally as of write count seq; false if the UDP
+// task was writing it
+static bool readRtcTally(SavedTally &out, uint32_t seq) {
+  if (seq & 1) return false;
+  memcpy(&out, &rtcTally, sizeof(out));
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return rtcTallyWrites.load(std::memory_order_relaxed) == seq && savedTallyValid(out);
+}
+
+// Expire an unconfirmed restored state, switch the lost-signal pulse and
+// keep the RTC copy current
+static void serviceTslState() {
+  static uint32_t savedVersion = 0;
+
+  if (tslDecoder.expire() && renderTaskHandle != NULL) xTaskNotifyGive(renderTaskHandle);
+  bool lost = lostSignalS > 0 && tslDecoder.silentMs() >= (uint32_t)lostSignalS * 1000;
+  if (lost != tslSignalLost) {
+    tslSignalLost = lost;
+    if (lost) LOG_INFO("[TSL] No TSL for %d s: signal lost", lostSignalS);
+    else LOG_INFO("[TSL] Signal back");
+    postRenderCommand(lost ? RENDER_SIGNAL_LOST : RENDER_SIGNAL_OK, lostSignalRgb.load());
+  }
+  if (tslDecoder.stateVersion() != savedVersion) {
+    savedVersion = tslDecoder.stateVersion();
+    saveRtcTally();
+  }
+}
+
+// UDP listener task - runs on core 0 for reliable multicast reception.
+// Blocks in select() on every TSL receiver (multicast, unicast, TCP, relay) until
+// one has data, then drains all of it before blocking again, so there is
+// no polling delay on a cue.
+// Runs from boot, before there is a network to join, so a restored tally
+// still expires and a lost signal still shows without one.
+void udpListenerTask(void *pvParameters) {
+  LOG_INFO("[UDP] Task running on core %d", xPortGetCoreID());
 
+  Socket *sockets[] = { &tslSockets[TSL_LINK_ETHERNET], &tslSockets[TSL_LINK_WIFI], &tslUnicastSocket,
+                        tslTcp.waitSocket(), &tslRelaySocket };
   for (;;) {
-    if (udpRunning) {
-      int packetSize = udp.parsePacket();
-      if (packetSize) {
-        IPAddress remote = udp.remoteIP();
-        uint16_t port = udp.remotePort();
-
-        int len = udp.read(buffer, sizeof(buffer) - 1);
-        if (len > 0) {
-          buffer[len] = '\0';
-          Serial.printf("[UDP] From %s:%d, Length: %d\n",
-                        remote.toString().c_str(), port, len);
-          udpTSL(buffer);
-        }
-      }
+    serviceTslState();
+    updateTslLinks();
+    updateTslReceivers();
+    bool listening = false;
+    for (Socket *socket : sockets) listening |= socket->isOpen();
+    if (!listening) {
+      vTaskDelay(pdMS_TO_TICKS(UDP_SELECT_TIMEOUT_MS));
+      continue;
     }
-    // Small delay to yield CPU time
-    vTaskDelay(pdMS_TO_TICKS(5));
+    // A relay wakes in time to repeat its last delta
+    uint32_t timeoutMs = relayRole == RELAY_ROLE_RELAY && tslRelay.repeatPending() ? TSL_RELAY_REPEAT_MS
+                                                                                   : UDP_SELECT_TIMEOUT_MS;
+    if (Socket::wait(sockets, sizeof(sockets) / sizeof(sockets[0]), timeoutMs)) {
+      for (int link = 0; link < NUM_TSL_LINKS; link++) receiveTslDatagrams(tslSockets[link], link);
+      receiveTslDatagrams(tslUnicastSocket, NUM_TSL_LINKS);
+      uint32_t rxMicros = micros();
+      bool ours;
+      if (tslTcp.receive(tslDecoder, rxMicros, ours) > 0) afterTslDecode(ours, rxMicros);
+      receiveRelayDatagrams();
+    }
+    // After the whole batch, so a cue's addresses go out together
+    if (relayRole == RELAY_ROLE_RELAY && tslRelaySocket.isOpen()) tslRelay.service(tslDecoder);
   }
 }
 
@@ -564,9 +1082,6 @@ void startUDPTask() {
     return;
   }
 
-  // Start UDP first, then the task
-  startUDP();
-
   xTaskCreatePinnedToCore(
     udpListenerTask,   // Task function
     "UDP Task",        // Name
@@ -586,7 +1101,7 @@ void stopUDPTask() {
     udpTaskHandle = NULL;
     Serial.println("[UDP] Task stopped");
   }
-  stopUDP();
+  for (UdpSocket &socket : tslSockets) socket.stop();
 }
 
 // Start mDNS responder with TXT records for device discovery
@@ -605,60 +1120,283 @@ void startMDNS() {
   }
 }
 
-// Discover other tally devices on the network via mDNS
-void discoverTallyDevices() {
-  Serial.println("[Discovery] Scanning for tally devices...");
-  numDiscoveredDevices = 0;
+// Fold one round of mDNS answers into the device table
+static void recordDiscoveryResults(mdns_result_t *results) {
+  uint32_t now = millis();
+  int seen = 0;
+
+  xSemaphoreTake(webDataMutex, portMAX_DELAY);
+  for (mdns_result_t *r = results; r != NULL; r = r->next) {
+    if (r->hostname == NULL) continue;
+    if (strcasecmp(r->hostname, deviceHostname.c_str()) == 0) continue;  // Skip ourselves
 
-  int n = MDNS.queryService("tally", "tcp");
-  Serial.printf("[Discovery] Found %d tally service(s)\n", n);
+    uint32_t ip = 0;
+    for (mdns_ip_addr_t *a = r->addr; a != NULL; a = a->next) {
+      if (a->addr.type == ESP_IPADDR_TYPE_V4) {
+        ip = a->addr.u_addr.ip4.addr;
+        break;
+      }
+    }
+    if (ip == 0) continue;
+
+    // TSL address and MAC from the TXT record
+    int tslAddr = 0;
+    const char *mac = NULL;
+    for (size_t j = 0; j < r->txt_count; j++) {
+      if (r->txt[j].value == NULL) continue;
+      if (strcmp(r->txt[j].key, "tsladdr") == 0) tslAddr = atoi(r->txt[j].value);
+      else if (strcmp(r->txt[j].key, "mac") == 0) mac = r->txt[j].value;
+    }
 
-  for (int i = 0; i < n && numDiscoveredDevices < MAX_DISCOVERED_DEVICES; i++) {
-    String foundIP = MDNS.address(i).toString();
-    String myIP = getActiveIP();
+    // mDNS PTR TTLs run to an hour; we requery far more often than that, so
+    // a device that misses a few rounds is shown offline
+    uint32_t ttlMs = r->ttl ? r->ttl * 1000 : DISCOVERY_OFFLINE_MS;
+    if (ttlMs > DISCOVERY_OFFLINE_MS) ttlMs = DISCOVERY_OFFLINE_MS;
 
-    // Skip ourselves
-    if (foundIP == myIP) {
-      Serial.printf("[Discovery] Skipping self: %s\n", foundIP.c_str());
-      continue;
+    uint64_t key = DeviceTable::deviceKey(mac, r->hostname);
+    if (deviceTable.update(key, r->hostname, ip, tslAddr, ttlMs, now)) seen++;
+  }
+  deviceTable.age(now, DISCOVERY_FORGET_MS);
+  size_t total = deviceTable.count();
+  xSemaphoreGive(webDataMutex);
+
+  LOG_INFO("[Discovery] %d answer(s), %u device(s) known", seen, (uint32_t)total);
+}
+
+// Discovery task: queries for _tally._tcp in the background and updates
+// the table in place. Runs every DISCOVERY_INTERVAL_MS, or at once when
+// notified (Scan button).
+void discoveryTask(void *pvParameters) {
+  for (;;) {
+    if ((eth_connected || wifi_connected) && !ap_mode) {
+      discoveryScanning = true;
+      mdns_search_once_t *search = mdns_query_async_new(NULL, "_tally", "_tcp", MDNS_TYPE_PTR,
+                                                        DISCOVERY_QUERY_MS, DISCOVERY_MAX_RESULTS, NULL);
+      if (search != NULL) {
+        mdns_result_t *results = NULL;
+        uint8_t numResults = 0;
+        if (mdns_query_async_get_results(search, DISCOVERY_QUERY_MS + 500, &results, &numResults)) {
+          recordDiscoveryResults(results);
+          mdns_query_results_free(results);
+        }
+        mdns_query_async_delete(search);
+      }
+      discoveryScanning = false;
     }
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(DISCOVERY_INTERVAL_MS));
+  }
+}
 
-    // Skip duplicates (same IP already in list)
-    bool isDuplicate = false;
-    for (int j = 0; j < numDiscoveredDevices; j++) {
-      if (discoveredDevices[j].ip == foundIP) {
-        Serial.printf("[Discovery] Skipping duplicate: %s\n", foundIP.c_str());
-        isDuplicate = true;
-        break;
+// Start the discovery task on core 1 at loop() priority
+void startDiscoveryTask() {
+  if (discoveryTaskHandle != NULL) return;
+
+  xTaskCreatePinnedToCore(
+    discoveryTask,        // Task function
+    "Discovery Task",     // Name
+    4096,                 // Stack size
+    NULL,                 // Parameters
+    1,                    // Priority
+    &discoveryTaskHandle, // Task handle
+    1                     // Core 1
+  );
+}
+
+// Encode msg and send it from the fleet socket (fleet task only)
+static void sendFleetMessage(const FleetMessage &msg, uint32_t addr) {
+  uint8_t buf[FLEET_MESSAGE_LENGTH];
+  fleetCodec.encode(msg, buf);
+  fleetSocket.sendTo(addr, FLEET_PORT, buf, sizeof(buf));
+}
+
+// Follow another tally's disco show: a start command counts as a beacon
+// at 0 us elapsed
+static void followDisco(uint32_t seed, uint32_t elapsedUs, uint32_t durationMs, uint32_t rxMicros) {
+  if (discoSync.sample(seed, elapsedUs, durationMs, rxMicros)) {
+    postRenderCommand(RENDER_DISCO, durationMs, seed, discoSync.epochUs());
+    LOG_DEBUG("[Fleet] Disco %u epoch %u us", seed, discoSync.epochUs());
+  }
+}
+
+// A fleet update was announced by the tally at fromAddr (the seed): note
+// it as the first source and have loop() start pulling
+static void joinFleetUpdate(uint32_t tag, uint32_t fromAddr) {
+  xSemaphoreTake(webDataMutex, portMAX_DELAY);
+  if (fleetOtaSources.imageTag() != tag) fleetOtaSources.begin(tag);
+  fleetOtaSources.add(tag, fromAddr, 0);
+  xSemaphoreGive(webDataMutex);
+  fleetUpdateRequested = true;
+}
+
+// Apply a command from another tally, as if our own button had been pressed
+static void applyFleetCommand(const FleetMessage &msg, uint32_t fromAddr, uint32_t rxMicros) {
+  switch (msg.command) {
+    case FLEET_CMD_TALLY: setTallyState(msg.arg); break;
+    case FLEET_CMD_DISCO: followDisco(msg.arg2, 0, msg.arg, rxMicros); break;
+    case FLEET_CMD_DISCO_STOP:
+      discoSync.stop();
+      postRenderCommand(RENDER_DISCO_STOP, 0);
+      break;
+    case FLEET_CMD_UPDATE: joinFleetUpdate(msg.arg, fromAddr); break;
+  }
+}
+
+// Start a round for cmd: reset the acks and send it to the group
+static void beginFleetRound(const FleetMessage &cmd) {
+  xSemaphoreTake(webDataMutex, portMAX_DELAY);
+  size_t online = 0;
+  for (size_t i = 0; i < deviceTable.count(); i++) {
+    if (deviceTable.entry(i).online) online++;
+  }
+  fleetRound.begin(cmd.sequence, cmd.command, cmd.arg, online, micros());
+  xSemaphoreGive(webDataMutex);
+
+  sendFleetMessage(cmd, (uint32_t)multicastAddress);
+  LOG_INFO("[Fleet] Sent command %u (arg %u), seq %u, %u device(s) online", cmd.command, cmd.arg,
+           cmd.sequence, (uint32_t)online);
+}
+
+// Milliseconds until due, clamped to [0, waitMs]
+static uint32_t fleetWaitUntil(uint32_t due, uint32_t waitMs) {
+  int32_t dueIn = (int32_t)(due - millis());
+  if (dueIn <= 0) return 0;
+  return (uint32_t)dueIn < waitMs ? dueIn : waitMs;
+}
+
+// Fleet task: applies and acks commands from other tallies, sends our own
+// commands from the web server and collects their acks, and beacons the
+// clock of a disco show we started. Blocks in select(); the web server
+// wakes it with a datagram on the loopback.
+void fleetTask(void *pvParameters) {
+  static uint8_t buffer[BUFFER_LENGTH];
+  FleetMessage pending = {};
+  int retransmitsLeft = 0;
+  uint32_t retransmitAt = 0;
+  uint32_t retransmitGap = FLEET_RETRANSMIT_MS;
+  uint64_t lastSender = 0;     // Last command applied, so resends are applied once
+  uint32_t lastSequence = 0;
+
+  // Disco show we lead
+  bool leading = false;
+  uint32_t leadSeed = 0, leadEpochUs = 0, leadDurationMs = 0;
+  uint32_t beaconAt = 0;
+
+  for (;;) {
+    uint32_t waitMs = FLEET_IDLE_WAIT_MS;
+    if (retransmitsLeft > 0) waitMs = fleetWaitUntil(retransmitAt, waitMs);
+    if (leading) waitMs = fleetWaitUntil(beaconAt, waitMs);
+    fleetSocket.wait(waitMs);
+
+    int len;
+    uint32_t fromAddr;
+    while ((len = fleetSocket.receive(buffer, sizeof(buffer), &fromAddr)) > 0) {
+      uint32_t rxMicros = micros();
+      FleetMessage msg;
+      if (!fleetCodec.decode(buffer, len, &msg)) {
+        if (len > 1) TallyMetrics::increment(tallyMetrics.fleetRejected);  // 1 byte is a wake-up
+        continue;
+      }
+      if (msg.sender == fleetDeviceId) continue;  // Our own command, looped back
+
+      if (msg.type == FLEET_BEACON) {
+        if (msg.sequence != leadSeed) leading = false;  // Someone else's show took over
+        followDisco(msg.sequence, msg.arg, msg.arg2, rxMicros);
+      } else if (msg.type == FLEET_SOURCE) {
+        xSemaphoreTake(webDataMutex, portMAX_DELAY);
+        fleetOtaSources.add(msg.arg, fromAddr, msg.hops);
+        xSemaphoreGive(webDataMutex);
+      } else if (msg.type == FLEET_COMMAND) {
+        if (msg.sender != lastSender || msg.sequence != lastSequence) {
+          if (msg.command == FLEET_CMD_DISCO || msg.command == FLEET_CMD_DISCO_STOP) leading = false;
+          applyFleetCommand(msg, fromAddr, rxMicros);
+          lastSender = msg.sender;
+          lastSequence = msg.sequence;
+          LOG_INFO("[Fleet] Command %u (arg %u) from %u.%u.%u.%u", msg.command, msg.arg, fromAddr & 0xFF,
+                   (fromAddr >> 8) & 0xFF, (fromAddr >> 16) & 0xFF, fromAddr >> 24);
+        }
+        FleetMessage ack = { FLEET_ACK, msg.sequence, fleetDeviceId, msg.arg, msg.command, 0 };
+        sendFleetMessage(ack, fromAddr);
+      } else {
+        xSemaphoreTake(webDataMutex, portMAX_DELAY);
+        if (fleetRound.recordAck(msg.sequence, msg.sender, fromAddr, rxMicros)) {
+          tallyMetrics.fleetAck.record(rxMicros - fleetRound.startUs());
+          if (fleetRound.count() >= fleetRound.expected()) retransmitsLeft = 0;
+        }
+        xSemaphoreGive(webDataMutex);
       }
     }
-    if (isDuplicate) continue;
-
-    discoveredDevices[numDiscoveredDevices].hostname = MDNS.hostname(i);
-    discoveredDevices[numDiscoveredDevices].ip = foundIP;
-    discoveredDevices[numDiscoveredDevices].lastSeen = millis();
-    discoveredDevices[numDiscoveredDevices].online = true;
-
-    // Try to get TSL address from TXT record
-    int txtCount = MDNS.numTxt(i);
-    for (int j = 0; j < txtCount; j++) {
-      if (MDNS.txtKey(i, j) == "tsladdr") {
-        discoveredDevices[numDiscoveredDevices].tslAddress = MDNS.txt(i, j).toInt();
+
+    // Newest command from the web server supersedes any being resent
+    FleetMessage cmd;
+    bool queued = false;
+    while (xQueueReceive(fleetQueue, &cmd, 0) == pdTRUE) {
+      pending = cmd;
+      queued = true;
+    }
+    if (queued) {
+      if (pending.command == FLEET_CMD_DISCO) {
+        // Our show starts as the command goes out; followers take that as 0 us
+        leading = true;
+        leadSeed = pending.arg2;
+        leadDurationMs = pending.arg;
+        leadEpochUs = micros();
+        beaconAt = millis() + DISCO_BEACON_MS;
+        discoSync.stop();
+        postRenderCommand(RENDER_DISCO, leadDurationMs, leadSeed, leadEpochUs);
+      } else if (pending.command == FLEET_CMD_DISCO_STOP) {
+        leading = false;
+      }
+      beginFleetRound(pending);
+      retransmitsLeft = FLEET_RETRANSMITS;
+      retransmitGap = FLEET_RETRANSMIT_MS;
+      retransmitAt = millis() + retransmitGap;
+    } else if (retransmitsLeft > 0 && (int32_t)(millis() - retransmitAt) >= 0) {
+      sendFleetMessage(pending, (uint32_t)multicastAddress);
+      retransmitsLeft--;
+      retransmitGap *= 2;
+      retransmitAt = millis() + retransmitGap;
+    }
+
+    if (leading && (int32_t)(millis() - beaconAt) >= 0) {
+      uint32_t elapsedUs = micros() - leadEpochUs;
+      if (elapsedUs / 1000 >= leadDurationMs) {
+        leading = false;
+      } else {
+        FleetMessage beacon = { FLEET_BEACON, leadSeed, fleetDeviceId, elapsedUs, FLEET_CMD_DISCO, leadDurationMs };
+        sendFleetMessage(beacon, (uint32_t)multicastAddress);
+        beaconAt += DISCO_BEACON_MS;
       }
     }
+  }
+}
 
-    Serial.printf("[Discovery] Found: %s at %s (TSL:%d)\n",
-                  discoveredDevices[numDiscoveredDevices].hostname.c_str(),
-                  discoveredDevices[numDiscoveredDevices].ip.c_str(),
-                  discoveredDevices[numDiscoveredDevices].tslAddress);
+// Start the fleet task on core 0 beside the UDP task. Needs the network
+// and a fleet key.
+void startFleetTask() {
+  if (fleetTaskHandle != NULL || !fleetCodec.enabled()) return;
 
-    numDiscoveredDevices++;
+  String mac = eth_connected ? ETH.macAddress() : WiFi.macAddress();
+  fleetDeviceId = DeviceTable::deviceKey(mac.c_str(), deviceHostname.c_str());
+  if (!fleetSocket.beginMulticast((uint32_t)multicastAddress, FLEET_PORT) || !fleetWakeSocket.open()) {
+    Serial.println("[Fleet] Socket setup failed");
+    return;
   }
+  fleetSequence = esp_random();
+  fleetQueue = xQueueCreate(FLEET_QUEUE_LENGTH, sizeof(FleetMessage));
 
-  lastDiscoveryScan = millis();
-  Serial.printf("[Discovery] Total devices found: %d\n", numDiscoveredDevices);
+  xTaskCreatePinnedToCore(
+    fleetTask,         // Task function
+    "Fleet Task",      // Name
+    4096,              // Stack size
+    NULL,              // Parameters
+    1,                 // Priority (same as the UDP task)
+    &fleetTaskHandle,  // Task handle
+    0                  // Core 0
+  );
+  Serial.printf("[Fleet] Listening on %s:%d\n", multicastAddress.toString().c_str(), FLEET_PORT);
 }
 
+
 // Compare version strings (returns true if v2 > v1)
 bool isNewerVersion(const String& v1, const String& v2) {
   // Strip 'v' prefix if present
@@ -680,6 +1418,31 @@ bool isNewerVersion(const String& v1, const String& v2) {
   return false;
 }
 
+// Fetch a release's firmware.bin.sha256 asset: the hex digest, or "" if
+// it can't be had
+static String fetchFirmwareSha256(const String &url) {
+  WiFiClientSecure client;
+  client.setCACert(GITHUB_ROOT_CAS);
+
+  HTTPClient http;
+  http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
+  http.setTimeout(10000);
+  http.begin(client, url);
+  http.addHeader("User-Agent", "ESP32-Tally-OTA");
+
+  String sha256 = "";
+  int httpCode = http.GET();
+  if (httpCode == 200) {
+    sha256 = http.getString().substring(0, 64);
+  } else {
+    Serial.printf("[Update] SHA-256 download failed: %d\n", httpCode);
+  }
+  http.end();
+
+  uint8_t digest[32];
+  return parseSha256(sha256.c_str(), digest) ? sha256 : String("");
+}
+
 // Check GitHub for firmware updates
 void checkForUpdates() {
   if (!eth_connected && !wifi_connected) {
@@ -689,9 +1452,9 @@ void checkForUpdates() {
 
   Serial.println("[Update] Checking GitHub for updates...");
 
-  // Use WiFiClientSecure for HTTPS
+  // Verified against GitHub's roots: the firmware URL and SHA-256 come from here
   WiFiClientSecure client;
-  client.setInsecure();  // Skip certificate verification
+  client.setCACert(GITHUB_ROOT_CAS);
 
   HTTPClient http;
   http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
@@ -705,460 +1468,699 @@ void checkForUpdates() {
 
   if (httpCode == 200) {
     String payload = http.getString();
+    http.end();
+    String version = "";
+    String binURL = "";
+    String sha256URL = "";
+    String sha256 = "";
 
     // Parse tag_name for version
     int tagStart = payload.indexOf("\"tag_name\":\"");
     if (tagStart > 0) {
       tagStart += 12;
       int tagEnd = payload.indexOf("\"", tagStart);
-      latestVersion = payload.substring(tagStart, tagEnd);
+      version = payload.substring(tagStart, tagEnd);
       Serial.printf("[Update] Latest version: %s, Current: %s\n",
-                    latestVersion.c_str(), FIRMWARE_VERSION);
+                    version.c_str(), FIRMWARE_VERSION);
     }
 
-    // Find firmware.bin in assets
+    // Find firmware.bin and its SHA-256 in assets
     int assetsStart = payload.indexOf("\"assets\":");
     if (assetsStart > 0) {
+      int assetStart = assetsStart;
       int binStart = payload.indexOf("\"browser_download_url\":", assetsStart);
       while (binStart > 0) {
-        binStart += 24;
-        int binEnd = payload.indexOf("\"", binStart);
-        String url = payload.substring(binStart, binEnd);
+        int binEnd = payload.indexOf("\"", binStart + 24);
+        String url = payload.substring(binStart + 24, binEnd);
         if (url.endsWith("firmware.bin")) {
-          firmwareURL = url;
-          Serial.printf("[Update] Firmware URL: %s\n", firmwareURL.c_str());
-          break;
+          binURL = url;
+          Serial.printf("[Update] Firmware URL: %s\n", binURL.c_str());
+          // GitHub also lists each asset's own digest, earlier in its object
+          int digest = payload.lastIndexOf("\"digest\":\"sha256:", binStart);
+          if (digest > assetStart) sha256 = payload.substring(digest + 18, digest + 18 + 64);
+        } else if (url.endsWith("firmware.bin.sha256")) {
+          sha256URL = url;
         }
+        assetStart = binEnd;
         binStart = payload.indexOf("\"browser_download_url\":", binEnd);
       }
     }
 
+    // The published hash file wins over GitHub's asset digest
+    if (sha256URL.length() > 0) {
+      String published = fetchFirmwareSha256(sha256URL);
+      if (published.length() > 0) sha256 = published;
+    }
+    uint8_t digest[32];
+    if (!parseSha256(sha256.c_str(), digest)) sha256 = "";
+    Serial.printf("[Update] Firmware SHA-256: %s\n", sha256.length() > 0 ? sha256.c_str() : "not published");
+
     // Check if update is available
-    if (latestVersion.length() > 0 && isNewerVersion(FIRMWARE_VERSION, latestVersion)) {
-      updateAvailable = true;
-      Serial.println("[Update] New version available!");
-    } else {
-      updateAvailable = false;
-      Serial.println("[Update] Firmware is up to date");
+    bool available = version.length() > 0 && isNewerVersion(FIRMWARE_VERSION, version);
+    Serial.println(available ? "[Update] New version available!" : "[Update] Firmware is up to date");
+
+    xSemaphoreTake(webDataMutex, portMAX_DELAY);
+    if (version.length() > 0) latestVersion = version;
+    if (binURL.length() > 0) {
+      firmwareURL = binURL;
+      firmwareSha256 = sha256;
     }
+    updateAvailable = available;
+    xSemaphoreGive(webDataMutex);
   } else {
     Serial.printf("[Update] Failed to check for updates: %d\n", httpCode);
+    http.end();
   }
+}
 
+// Announce that we serve the fleet image (OTA task only)
+static void announceFleetSource() {
+  static UdpSocket announceSocket;
+  if (!fleetCodec.enabled() || (!announceSocket.isOpen() && !announceSocket.open())) return;
+  FleetMessage msg = { FLEET_SOURCE, 0, fleetDeviceId, otaFleetTag, 0, 0, otaFleetHops };
+  uint8_t buf[FLEET_MESSAGE_LENGTH];
+  fleetCodec.encode(msg, buf);
+  announceSocket.sendTo((uint32_t)multicastAddress, FLEET_PORT, buf, sizeof(buf));
+}
+
+// Copy the download's progress out for /status; fleet relays also tell
+// the fleet they have bytes to serve
+static void reportOtaProgress(const OtaProgress &progress) {
+  static uint32_t lastAnnounceMs = 0;
+  xSemaphoreTake(webDataMutex, portMAX_DELAY);
+  otaProgress = progress;
+  xSemaphoreGive(webDataMutex);
+
+  if (otaMode == OTA_FLEET_PEER && progress.bytes > 0 &&
+      (lastAnnounceMs == 0 || millis() - lastAnnounceMs >= FLEET_OTA_ANNOUNCE_MS)) {
+    lastAnnounceMs = millis() | 1;
+    announceFleetSource();
+  }
+}
+
+// Pulls from a fixed URL, or for a fleet peer from another tally, moving
+// to a different source (nearer the seed) after each failed request
+class OtaSource : public HttpsSource {
+ public:
+  int open(uint32_t offset, char *contentRange, size_t rangeLen, int32_t *length) override {
+    if (otaMode != OTA_FLEET_PEER) return HttpsSource::open(offset, contentRange, rangeLen, length);
+
+    xSemaphoreTake(webDataMutex, portMAX_DELAY);
+    ip = fleetOtaSources.pick(otaFleetHops, ip, rng);
+    uint8_t sourceHops = fleetOtaSources.hops(ip);
+    xSemaphoreGive(webDataMutex);
+    if (ip == 0) return -1;
+    url = "http://" + IPAddress(ip).toString() + "/api/fleet/firmware.bin";
+    int status = HttpsSource::open(offset, contentRange, rangeLen, length);
+    if ((status == 200 || status == 206) && sourceHops + 1 < otaFleetHops) otaFleetHops = sourceHops + 1;
+    return status;
+  }
+
+  uint32_t ip = 0;
+  uint32_t rng = 1;
+};
+
+// Ask a fleet source what it is distributing; false unless the answer
+// carries our fleet key's MAC (fleet_ota.h). sha256Hex is the hash as sent.
+static bool fetchFleetImage(uint32_t ip, FleetImage &image, String &sha256Hex) {
+  WiFiClient client;
+  HTTPClient http;
+  http.setTimeout(5000);
+  http.begin(client, "http://" + IPAddress(ip).toString() + "/api/fleet/image");
+  int httpCode = http.GET();
+  String body = httpCode == 200 ? http.getString() : String("");
   http.end();
+
+  if (!parseFleetImage(fleetCodec, body.c_str(), image)) return false;
+  int space = body.indexOf(' ');
+  sha256Hex = body.substring(space + 1, space + 65);
+  return true;
 }
 
-// Perform OTA update from GitHub
-void performOTAUpdate() {
-  if (firmwareURL.length() == 0) {
-    Serial.println("[Update] No firmware URL available");
-    return;
+// OTA task: streams the update into the OTA partition, resuming after
+// drops, then restarts into it if the SHA-256 matches. Runs once per
+// update and deletes itself.
+//
+// A fleet seed or peer (fleet_ota.h) serves the image on
+// /api/fleet/firmware.bin while it downloads, and keeps serving until
+// FLEET_OTA_LINGER_MS after its last peer left before it restarts.
+void otaTask(void *pvParameters) {
+  // Static: the download's chunk buffer and the TLS client stay off the stack
+  static OtaSource source;
+  static OtaDownload download(source, otaSink);
+
+  uint8_t sha256[32];
+  if (otaMode == OTA_FLEET_PEER) {
+    // The seed publishes the full hash and version under the fleet key's
+    // MAC; the command carried the hash's tag. Only ever move forward.
+    FleetImage image;
+    String hash;
+    xSemaphoreTake(webDataMutex, portMAX_DELAY);
+    uint32_t tag = fleetOtaSources.imageTag();
+    uint32_t seed = fleetOtaSources.pick(1, 0, source.rng);
+    xSemaphoreGive(webDataMutex);
+    bool ok = seed != 0 && fetchFleetImage(seed, image, hash) && fleetImageTag(image.sha256) == tag;
+    String version = ok ? String(image.version) : String("");
+    if (!ok || !isNewerVersion(FIRMWARE_VERSION, version)) {
+      Serial.printf("[OTA] Fleet update %08x %s\n", tag, ok ? "is not newer than ours" : "unavailable");
+      xSemaphoreTake(webDataMutex, portMAX_DELAY);
+      otaTaskHandle = NULL;
+      xSemaphoreGive(webDataMutex);
+      vTaskDelete(NULL);
+    }
+    xSemaphoreTake(webDataMutex, portMAX_DELAY);
+    fleetOtaVersion = version;
+    fleetOtaSha256 = hash;
+    xSemaphoreGive(webDataMutex);
+    memcpy(sha256, image.sha256, sizeof(sha256));
+    otaFleetTag = tag;
+    otaFleetHops = FLEET_OTA_UNKNOWN_HOPS;
+    source.rng = (uint32_t)fleetDeviceId | 1;
+    source.ip = 0;
+    Serial.printf("[OTA] Fleet update to %s from the fleet\n", version.c_str());
+    download.retryMs = FLEET_OTA_RETRY_MS;
+    download.maxRetryMs = FLEET_OTA_MAX_RETRY_MS;
+    download.maxStalls = FLEET_OTA_MAX_STALLS;
+    // Jitter, so peers turned away by a busy source don't all come back at once
+    download.sleepMs = [](uint32_t ms) { vTaskDelay(pdMS_TO_TICKS(ms + esp_random() % ms)); };
+  } else {
+    xSemaphoreTake(webDataMutex, portMAX_DELAY);
+    source.url = firmwareURL;
+    source.rootCas = GITHUB_ROOT_CAS;
+    parseSha256(firmwareSha256.c_str(), sha256);  // Checked by /api/update
+    xSemaphoreGive(webDataMutex);
+    Serial.printf("[OTA] Downloading %s\n", source.url.c_str());
+    download.retryMs = OTA_RETRY_MS;
+    download.maxRetryMs = OTA_MAX_RETRY_MS;
+    download.maxStalls = OTA_MAX_STALLS;
+    download.sleepMs = [](uint32_t ms) { vTaskDelay(pdMS_TO_TICKS(ms)); };
   }
 
-  if (updateInProgress) {
+  postRenderCommand(RENDER_PULSE, CRGB::Purple);  // Pulse purple over the tally while the update runs
+  download.report = reportOtaProgress;
+  if (download.run(sha256)) {
+    const OtaProgress &p = download.progress();
+    LOG_INFO("[OTA] %u bytes verified (%u requests, %u resumes)", p.bytes, p.requests, p.resumes);
+    postRenderCommand(RENDER_SOLID, CRGB::Green);
+    if (otaMode != OTA_FROM_GITHUB) {
+      if (otaMode == OTA_FLEET_PEER) announceFleetSource();  // Now with the whole image
+      fleetOtaLastServedMs = millis();
+      while (fleetOtaStreams > 0 || millis() - fleetOtaLastServedMs < FLEET_OTA_LINGER_MS) {
+        if (fleetOtaStreams > 0) fleetOtaLastServedMs = millis();
+        vTaskDelay(pdMS_TO_TICKS(250));
+      }
+    }
+    LOG_INFO("[OTA] Rebooting into the new image");
+    scheduleRestart(1000);
+  } else {
+    // Flash red on failure, then drop the overlay: the tally underneath
+    // is still whatever TSL, the rules or a test button last set
+    postRenderCommand(RENDER_FLASH, CRGB::Red);
+    vTaskDelay(pdMS_TO_TICKS(2000));
+    postRenderCommand(RENDER_CLEAR, 0);
+  }
+
+  xSemaphoreTake(webDataMutex, portMAX_DELAY);
+  otaTaskHandle = NULL;
+  xSemaphoreGive(webDataMutex);
+  vTaskDelete(NULL);
+}
+
+// Start the OTA task on core 1 at loop() priority, unless one is running
+void startOtaTask(OtaMode mode) {
+  xSemaphoreTake(webDataMutex, portMAX_DELAY);
+  bool running = otaTaskHandle != NULL;
+  xSemaphoreGive(webDataMutex);
+  if (running) {
     Serial.println("[Update] Update already in progress");
     return;
   }
 
-  updateInProgress = true;
-  Serial.printf("[Update] Downloading firmware from: %s\n", firmwareURL.c_str());
+  otaMode = mode;
+  xTaskCreatePinnedToCore(
+    otaTask,         // Task function
+    "OTA Task",      // Name
+    12288,           // Stack size (TLS handshake)
+    NULL,            // Parameters
+    1,               // Priority
+    &otaTaskHandle,  // Task handle
+    1                // Core 1
+  );
+}
 
-  // Show update in progress on LEDs
-  fill_solid(leds, NUM_LEDS, CRGB::Purple);
-  FastLED.show();
+// PlatformIO (espota) updates; needs a real network, not AP mode
+static bool arduinoOtaStarted = false;  // loop() services it once set; loop() only
 
-  // Use WiFiClientSecure for HTTPS
-  WiFiClientSecure client;
-  client.setInsecure();  // Skip certificate verification for GitHub
+void startOTA() {
+  ArduinoOTA
+    .onStart([]() {
+      String type;
+      if (ArduinoOTA.getCommand() == U_FLASH) {
+        type = "sketch";
+      } else {
+        type = "filesystem";
+      }
+      Serial.println("Start updating " + type);
+    })
+    .onEnd([]() {
+      Serial.println("\nEnd");
+    })
+    .onProgress([](unsigned int progress, unsigned int total) {
+      Serial.printf("Progress: %u%%\r", (progress / (total / 100)));
+    })
+    .onError([](ota_error_t error) {
+      Serial.printf("Error[%u]: ", error);
+      if (error == OTA_AUTH_ERROR) Serial.println("Auth Failed");
+      else if (error == OTA_BEGIN_ERROR) Serial.println("Begin Failed");
+      else if (error == OTA_CONNECT_ERROR) Serial.println("Connect Failed");
+      else if (error == OTA_RECEIVE_ERROR) Serial.println("Receive Failed");
+      else if (error == OTA_END_ERROR) Serial.println("End Failed");
+    });
+
+  ArduinoOTA.setHostname(deviceHostname.c_str());
+  ArduinoOTA.setPassword("password");
+  ArduinoOTA.begin();
+  arduinoOtaStarted = true;
+  Serial.println("OTA enabled");
+}
 
-  HTTPClient http;
-  http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
-  http.setTimeout(60000);  // 60 second timeout for large downloads
-  http.begin(client, firmwareURL);
+// Latest TSL label for the web side
+String getTallyText() {
+  TallySnapshot snap;
+  tallyMailbox.peek(snap);
+  return String(snap.text);
+}
 
-  Serial.println("[Update] Starting download...");
-  int httpCode = http.GET();
-  Serial.printf("[Update] Download response: %d\n", httpCode);
+// Tally event data for the web side, e.g. {"tally":"Red","text":"CAM 1"}
+static void getTallyEvent(char *data, size_t len) {
+  TallySnapshot snap;
+  tallyMailbox.peek(snap);
+  formatTallyEvent(tallyRenderer.displayedState(), snap.text, data, len);
+}
 
-  if (httpCode == 200) {
-    int contentLength = http.getSize();
-    Serial.printf("[Update] Firmware size: %d bytes\n", contentLength);
-
-    if (contentLength > 0) {
-      if (Update.begin(contentLength)) {
-        Serial.println("[Update] Starting OTA flash...");
-
-        size_t written = Update.writeStream(client);
-        Serial.printf("[Update] Written: %d bytes\n", written);
-
-        if (Update.end()) {
-          if (Update.isFinished()) {
-            Serial.println("[Update] Update successful! Rebooting...");
-            fill_solid(leds, NUM_LEDS, CRGB::Green);
-            FastLED.show();
-            delay(1000);
-            ESP.restart();
-          } else {
-            Serial.println("[Update] Update not finished");
-          }
-        } else {
-          Serial.printf("[Update] Update error: %s\n", Update.errorString());
-        }
-      } else {
-        Serial.printf("[Update] Not enough space: %s\n", Update.errorString());
-      }
-    } else {
-      Serial.println("[Update] Invalid content length");
+// Called from loop(): push the tally to every subscriber when the render
+// task has redrawn it, and a keepalive so dead clients are found
+void serviceEventClients() {
+  TallySnapshot snap;
+  tallyMailbox.peek(snap);
+  switch (tallyEvents.poll(tallyRenderer.displayChanges(), tallyRenderer.displayedState(), snap.text, millis())) {
+    case TALLY_EVENT_CHANGE: events.send(tallyEvents.data(), "tally", millis()); break;
+    case TALLY_EVENT_KEEPALIVE: events.send("", "keepalive", millis()); break;
+    case TALLY_EVENT_NONE: break;
+  }
+}
+
+// Set the settings a /save form carries (loop() only)
+static void applySettingsForm(const SettingsForm &form) {
+  if (form.has("tslAddr")) {
+    tslAddress = form.arg("tslAddr").toInt();
+  }
+  if (form.has("tslMcast")) {
+    tslMulticast = form.arg("tslMcast");
+  }
+  if (form.has("tslPort")) {
+    tslPort = constrain(form.arg("tslPort").toInt(), 1, 65535);
+  }
+  if (form.has("tslMcastOn")) {
+    tslMulticastOn = form.arg("tslMcastOn") == "1";
+  }
+  if (form.has("tslUdpPort")) {
+    // Not the fleet or relay port: the unicast socket would take their datagrams
+    int port = constrain(form.arg("tslUdpPort").toInt(), 0, 65535);
+    if (port != FLEET_PORT && port != TSL_RELAY_PORT) tslUnicastPort = port;
+  }
+  if (form.has("tslTcpHost")) {
+    // An IPv4 address or blank: a name would need a blocking DNS lookup on the UDP task
+    String host = form.arg("tslTcpHost");
+    host.trim();
+    IPAddress check;
+    if (host.length() == 0 || check.fromString(host)) tslTcpHost = host;
+  }
+  if (form.has("tslTcpPort")) {
+    tslTcpPort = constrain(form.arg("tslTcpPort").toInt(), 1, 65535);
+  }
+  if (form.has("relayRole")) {
+    relayRole = constrain(form.arg("relayRole").toInt(), RELAY_ROLE_OFF, RELAY_ROLE_SUBSCRIBE);
+  }
+  if (form.has("tslProto")) {
+    tslProtocol = form.arg("tslProto") == "1" ? TSL_PROTOCOL_V50 : TSL_PROTOCOL_V31;
+  }
+  if (form.has("maxBright")) {
+    maxBrightness = constrain(form.arg("maxBright").toInt(), 1, 255);
+  }
+  if (form.has("ledRoles")) {
+    // Only letters the compositor knows; blank means the default
+    String roles = form.arg("ledRoles");
+    roles.trim();
+    roles.toUpperCase();
+    ledRoles = Compositor::validLayout(roles.c_str()) ? roles : String("T");
+  }
+  if (form.has("ledOutputs")) {
+    String outputs = form.arg("ledOutputs");
+    outputs.replace(" ", "");
+    LedOutput parsed[LED_MAX_OUTPUTS];
+    ledOutputs = FastLedSink::parseOutputs(outputs.c_str(), parsed, LED_MAX_OUTPUTS) > 0 ? outputs : String(DEFAULT_LED_OUTPUTS);
+  }
+  if (form.has("tslRules")) {
+    // Compiled into a scratch table first; an invalid one keeps the saved rules
+    static TallyRules check;
+    String rules = form.arg("tslRules");
+    rules.trim();
+    rules.toUpperCase();
+    if (rules.length() < MAX_SETTING_LENGTH && check.parse(rules.c_str())) tslRules = rules;
+  }
+  if (form.has("restoreS")) {
+    restoreTimeoutS = constrain(form.arg("restoreS").toInt(), 0, 86400);
+  }
+  if (form.has("lostSignalS")) {
+    lostSignalS = constrain(form.arg("lostSignalS").toInt(), 0, 3600);
+  }
+  if (form.has("lostColor")) {
+    // Six hex digits, or keep the saved colour
+    String color = form.arg("lostColor");
+    color.trim();
+    color.toUpperCase();
+    char *end;
+    uint32_t rgb = strtoul(color.c_str(), &end, 16);
+    if (color.length() == 6 && *end == '\0') {
+      lostSignalColor = color;
+      lostSignalRgb = rgb;
     }
-  } else {
-    Serial.printf("[Update] Download failed: %d\n", httpCode);
+  }
+  if (form.has("hostname")) {
+    deviceHostname = form.arg("hostname");
+  }
+  if (form.has("dhcp")) {
+    useDHCP = form.arg("dhcp") == "1";
+  }
+  if (form.has("ip")) {
+    staticIP = form.arg("ip");
+  }
+  if (form.has("gw")) {
+    gateway = form.arg("gw");
+  }
+  if (form.has("sn")) {
+    subnet = form.arg("sn");
+  }
+  if (form.has("dns")) {
+    dns = form.arg("dns");
   }
 
-  http.end();
-  updateInProgress = false;
+  // WiFi settings
+  if (form.has("wifiEn")) {
+    wifiEnabled = form.arg("wifiEn") == "1";
+  }
+  if (form.has("failover")) {
+    netFailover = constrain(form.arg("failover").toInt(), FAILOVER_OFF, FAILOVER_DUAL);
+  }
+  if (form.has("wifiSSID")) {
+    wifiSSID = form.arg("wifiSSID");
+  }
+  if (form.has("wifiPass") && form.arg("wifiPass").length() > 0) {  // Blank keeps the saved password
+    wifiPassword = form.arg("wifiPass");
+  }
+  if (form.has("fleetKey") && form.arg("fleetKey").length() > 0) {  // Blank keeps the saved key
+    fleetKey = form.arg("fleetKey");
+  }
+}
 
-  // Restore LED state on failure
-  fill_solid(leds, NUM_LEDS, CRGB::Red);
-  FastLED.show();
-  delay(2000);
-  fill_solid(leds, NUM_LEDS, CRGB::Black);
-  FastLED.show();
+// Run work the HTTP handlers deferred to loop(): anything that blocks
+// (GitHub requests, starting the OTA task), changes settings other tasks
+// read, or restarts the device
+void serviceWebJobs() {
+  if (updateCheckRequested) {
+    checkForUpdates();
+    updateCheckRequested = false;
+  }
+  if (updateRequested) {
+    updateRequested = false;
+    startOtaTask(updateAsFleetSeed ? OTA_FLEET_SEED : OTA_FROM_GITHUB);
+  }
+  if (fleetUpdateRequested) {
+    fleetUpdateRequested = false;
+    startOtaTask(OTA_FLEET_PEER);
+  }
+  if (saveRequested) {
+    applySettingsForm(saveForm);
+    saveSettings();
+    saveRequested = false;
+    scheduleRestart(1000);  // The response has had time to go out
+  }
+  if (resetRequested) {
+    resetSettings();
+    resetRequested = false;
+    scheduleRestart(1000);
+  }
+  if (restartAt != 0 && (long)(millis() - restartAt) >= 0) {
+    Serial.println("[Web] Restarting");
+    ESP.restart();
+  }
 }
 
-// LED test routine - cycles through R/G/B
-void testLED() {
-  FastLED.setBrightness(maxBrightness);
-  fill_solid(leds, NUM_LEDS, CRGB::Red);
-  FastLED.show();
-  delay(500);
-  fill_solid(leds, NUM_LEDS, CRGB::Green);
-  FastLED.show();
-  delay(500);
-  fill_solid(leds, NUM_LEDS, CRGB::Blue);
-  FastLED.show();
-  delay(500);
-  fill_solid(leds, NUM_LEDS, CRGB::Black);
-  FastLED.show();
+// Restart from loop() once the response has gone out
+void scheduleRestart(uint32_t delayMs) {
+  restartAt = millis() + delayMs;
+  if (restartAt == 0) restartAt = 1;
 }
 
-// HTML page for configuration
-String getConfigPage() {
-  String html = "<!DOCTYPE html><html><head>";
-  html += "<meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">";
-  html += "<link rel=\"icon\" href=\"data:image/svg+xml,<svg xmlns='http://www.w3.org/2000/svg' viewBox='0 0 100 100'><circle cx='50' cy='50' r='45' fill='%23ff0000'/></svg>\">";
-  html += "<title>TSL Tally Configuration</title>";
-  html += "<style>";
-  html += "body{font-family:Arial,sans-serif;margin:20px;background:#1a1a2e;color:#eee;transition:background-color 0.3s}";
-  html += "body.tally-off{background:#1a1a2e}body.tally-green{background:#0a3d0a}body.tally-red{background:#4d0000}body.tally-yellow{background:#4d4d00}";
-  html += ".container{max-width:500px;margin:0 auto}";
-  html += "h1{color:#00d4ff;text-align:center}";
-  html += ".card{background:#16213e;padding:20px;border-radius:10px;margin-bottom:20px}";
-  html += ".card h2{margin-top:0;color:#00d4ff;border-bottom:1px solid #0f3460;padding-bottom:10px}";
-  html += "label{display:block;margin:10px 0 5px;font-weight:bold}";
-  html += "input[type=text],input[type=number],input[type=password],select{width:100%;padding:10px;border:1px solid #0f3460;border-radius:5px;background:#0f3460;color:#eee;box-sizing:border-box}";
-  html += "input:focus,select:focus{outline:none;border-color:#00d4ff}";
-  html += ".ip-fields,.wifi-fields{display:none}.ip-fields.show,.wifi-fields.show{display:block}";
-  html += "button{width:100%;padding:15px;background:#00d4ff;color:#1a1a2e;border:none;border-radius:5px;font-size:16px;font-weight:bold;cursor:pointer;margin-top:20px}";
-  html += "button:hover{background:#00b4d8}";
-  html += ".test-btns{display:flex;gap:10px;margin-top:10px}";
-  html += ".test-btn{flex:1;padding:15px 10px;border:none;border-radius:5px;font-weight:bold;cursor:pointer;font-size:14px}";
-  html += ".test-btn:hover{opacity:0.8}";
-  html += ".btn-green{background:#0f0;color:#000}.btn-red{background:#f00;color:#fff}.btn-yellow{background:#ff0;color:#000}";
-  html += ".status{background:#0f3460;padding:15px;border-radius:5px;margin-bottom:20px}";
-  html += ".status-item{display:flex;justify-content:space-between;padding:5px 0}";
-  html += ".tally-off{color:#888}.tally-green{color:#0f0}.tally-red{color:#f00}.tally-yellow{color:#ff0}";
-  html += ".note{font-size:12px;color:#888;margin-top:5px}";
-  html += ".conn-eth{color:#4CAF50}.conn-wifi{color:#2196F3}.conn-ap{color:#FF9800}";
-  html += ".device-list{max-height:300px;overflow-y:auto}";
-  html += ".device-item{display:flex;align-items:center;padding:10px;background:#0f3460;border-radius:5px;margin-bottom:8px}";
-  html += ".device-status{width:12px;height:12px;border-radius:50%;margin-right:10px;flex-shrink:0}";
-  html += ".device-status.off{background:#666}.device-status.green{background:#0f0}.device-status.red{background:#f00}.device-status.yellow{background:#ff0}";
-  html += ".device-info{flex:1;min-width:0}";
-  html += ".device-name{font-weight:bold;white-space:nowrap;overflow:hidden;text-overflow:ellipsis}";
-  html += ".device-details{font-size:12px;color:#888}";
-  html += ".device-link{padding:8px 12px;background:#00d4ff;color:#1a1a2e;text-decoration:none;border-radius:4px;font-size:12px;white-space:nowrap}";
-  html += ".device-link:hover{background:#00b4d8}";
-  html += ".refresh-btn{background:#0f3460;padding:8px 15px;margin-bottom:15px}";
-  html += ".refresh-btn:hover{background:#1a4a7a}";
-  html += ".bulk-btns{display:flex;gap:8px;margin-top:15px}";
-  html += ".bulk-btn{flex:1;padding:10px;font-size:12px;margin-top:0}";
-  html += ".no-devices{text-align:center;color:#666;padding:20px}";
-  html += ".disco-overlay{display:none;position:fixed;top:0;left:0;width:100%;height:100%;background:rgba(0,0,0,0.9);z-index:9999;justify-content:center;align-items:center;flex-direction:column}";
-  html += ".disco-overlay.active{display:flex}";
-  html += ".disco-text{font-size:48px;font-weight:bold;text-align:center;animation:disco-rainbow 0.5s linear infinite}";
-  html += "@keyframes disco-rainbow{0%{color:#f00}16%{color:#ff0}33%{color:#0f0}50%{color:#0ff}66%{color:#00f}83%{color:#f0f}100%{color:#f00}}";
-  html += ".disco-cancel{margin-top:40px;padding:20px 40px;font-size:20px;background:#c00;border:none;color:#fff;border-radius:10px;cursor:pointer}";
-  html += ".disco-cancel:hover{background:#f00}";
-  html += "</style></head><body><div class=\"container\">";
-  html += "<h1>TSL Tally Configuration</h1>";
-
-  // Status section
-  html += "<div class=\"status\">";
-  html += "<div class=\"status-item\"><span>Connection:</span><span>" + getConnectionStatus() + "</span></div>";
-  html += "<div class=\"status-item\"><span>IP Address:</span><span id=\"currentIP\">" + getActiveIP() + "</span></div>";
-  html += "<div class=\"status-item\"><span>Tally State:</span><span id=\"tallyState\" class=\"tally-" + currentTallyState + "\">" + currentTallyState + "</span></div>";
-  html += "<div class=\"status-item\"><span>TSL Text:</span><span id=\"tallyText\">" + (currentTallyText.length() > 0 ? currentTallyText : "-") + "</span></div>";
-  if (eth_connected) {
-    html += "<div class=\"status-item\"><span>ETH MAC:</span><span>" + ETH.macAddress() + "</span></div>";
+// s as a quoted JSON string
+static String jsonString(const char *s) {
+  String json = "\"";
+  char piece[64];
+  while (*s) {
+    s += jsonEscape(s, piece, sizeof(piece));
+    json += piece;
   }
-  if (wifi_connected || ap_mode) {
-    html += "<div class=\"status-item\"><span>WiFi MAC:</span><span>" + WiFi.macAddress() + "</span></div>";
+  return json + "\"";
+}
+
+static String jsonString(const String &s) { return jsonString(s.c_str()); }
+
+// JSON response with CORS for cross-device pages
+void sendJson(AsyncWebServerRequest *request, int code, const String &json) {
+  AsyncWebServerResponse *response = request->beginResponse(code, "application/json", json);
+  response->addHeader("Access-Control-Allow-Origin", "*");
+  request->send(response);
+}
+
+// Queue a fleet command for the fleet task and answer with its sequence
+static void sendFleetCommand(AsyncWebServerRequest *request, uint8_t command, uint32_t arg, uint32_t arg2 = 0) {
+  if (fleetTaskHandle == NULL) {
+    sendJson(request, 409, "{\"error\":\"Fleet control needs a network connection and a fleet key\"}");
+    return;
   }
-  if (ap_mode) {
-    html += "<div class=\"status-item\"><span>AP SSID:</span><span>" + apSSID + "</span></div>";
-  }
-  html += "<div class=\"status-item\"><span>Firmware:</span><span id=\"fwVersion\">" + String(FIRMWARE_VERSION) + "</span>";
-  html += "<button type=\"button\" onclick=\"checkUpdate()\" style=\"width:auto;margin-left:10px;margin-top:0;padding:4px 12px;font-size:11px;cursor:pointer\">Check</button></div>";
-  html += "<div class=\"status-item\" id=\"updateNotice\" style=\"display:none\"><span style=\"color:#ff6b6b\">Update Available:</span>";
-  html += "<span id=\"latestVersion\" style=\"color:#ff6b6b\"></span>";
-  html += "<button type=\"button\" onclick=\"installUpdate()\" style=\"margin-left:10px;padding:2px 8px;font-size:12px;background:#4CAF50;color:white;border:none;border-radius:3px;cursor:pointer\">Install</button></div>";
-  html += "</div>";
-
-  // Test Tally buttons (momentary - on while pressed)
-  html += "<div class=\"card\"><h2>Test Tally</h2>";
-  html += "<p class=\"note\">Hold button to test - releases to off</p>";
-  html += "<div class=\"test-btns\">";
-  html += "<button type=\"button\" class=\"test-btn btn-green\" onmousedown=\"testOn(1)\" onmouseup=\"testOff()\" ontouchstart=\"testOn(1)\" ontouchend=\"testOff()\">GREEN</button>";
-  html += "<button type=\"button\" class=\"test-btn btn-red\" onmousedown=\"testOn(2)\" onmouseup=\"testOff()\" ontouchstart=\"testOn(2)\" ontouchend=\"testOff()\">RED</button>";
-  html += "<button type=\"button\" class=\"test-btn btn-yellow\" onmousedown=\"testOn(3)\" onmouseup=\"testOff()\" ontouchstart=\"testOn(3)\" ontouchend=\"testOff()\">YELLOW</button>";
-  html += "</div></div>";
-
-  // Network Devices section
-  html += "<div class=\"card\"><h2>Network Devices</h2>";
-  html += "<button type=\"button\" class=\"refresh-btn\" onclick=\"discoverDevices()\">Scan Network</button>";
-  html += "<div id=\"deviceList\" class=\"device-list\"><p class=\"no-devices\">Click Scan to find devices</p></div>";
-  html += "<div class=\"bulk-btns\">";
-  html += "<button type=\"button\" class=\"bulk-btn btn-green\" onclick=\"bulkTest(1)\">All GREEN</button>";
-  html += "<button type=\"button\" class=\"bulk-btn btn-red\" onclick=\"bulkTest(2)\">All RED</button>";
-  html += "<button type=\"button\" class=\"bulk-btn\" onclick=\"bulkTest(0)\" style=\"background:#333;color:#fff\">All OFF</button>";
-  html += "</div>";
-  html += "<p class=\"note\">Discovers other TSL tally lights on the network via mDNS</p>";
-  html += "</div>";
-
-  // Form
-  html += "<form action=\"/save\" method=\"POST\">";
-
-  // TSL Settings
-  html += "<div class=\"card\"><h2>TSL Settings</h2>";
-  html += "<label for=\"tslAddr\">TSL Address (0-126)</label>";
-  html += "<input type=\"number\" id=\"tslAddr\" name=\"tslAddr\" min=\"0\" max=\"126\" value=\"" + String(tslAddress) + "\" required>";
-  html += "<label for=\"tslMcast\">Multicast Address</label>";
-  html += "<input type=\"text\" id=\"tslMcast\" name=\"tslMcast\" value=\"" + tslMulticast + "\" required>";
-  html += "<label for=\"tslPort\">TSL Port</label>";
-  html += "<input type=\"number\" id=\"tslPort\" name=\"tslPort\" min=\"1\" max=\"65535\" value=\"" + String(tslPort) + "\" required>";
-  html += "<label for=\"maxBright\">Max Brightness (1-255)</label>";
-  html += "<input type=\"number\" id=\"maxBright\" name=\"maxBright\" min=\"1\" max=\"255\" value=\"" + String(maxBrightness) + "\" required>";
-  html += "<p class=\"note\">TSL brightness (0-3) maps to 0 - max brightness</p>";
-  html += "</div>";
-
-  // WiFi Settings
-  html += "<div class=\"card\"><h2>WiFi Settings</h2>";
-  html += "<label for=\"wifiEn\">WiFi</label>";
-  html += "<select id=\"wifiEn\" name=\"wifiEn\" onchange=\"toggleWifiFields()\">";
-  html += "<option value=\"0\"" + String(!wifiEnabled ? " selected" : "") + ">Disabled</option>";
-  html += "<option value=\"1\"" + String(wifiEnabled ? " selected" : "") + ">Enabled</option>";
-  html += "</select>";
-
-  html += "<div id=\"wifiFields\" class=\"wifi-fields\">";
-  html += "<label for=\"wifiSSID\">WiFi SSID</label>";
-  html += "<input type=\"text\" id=\"wifiSSID\" name=\"wifiSSID\" value=\"" + wifiSSID + "\" maxlength=\"32\">";
-  html += "<label for=\"wifiPass\">WiFi Password</label>";
-  html += "<input type=\"password\" id=\"wifiPass\" name=\"wifiPass\" value=\"" + wifiPassword + "\" maxlength=\"64\">";
-  html += "</div>";
-  html += "<p class=\"note\">If WiFi fails, device will start an AP: " + apSSID + " (password: " + apPassword + ")</p>";
-  html += "</div>";
-
-  // Ethernet/Network Settings
-  html += "<div class=\"card\"><h2>Ethernet Settings</h2>";
-  html += "<label for=\"hostname\">Hostname</label>";
-  html += "<input type=\"text\" id=\"hostname\" name=\"hostname\" value=\"" + deviceHostname + "\" maxlength=\"32\" required>";
-
-  html += "<label for=\"dhcp\">IP Configuration</label>";
-  html += "<select id=\"dhcp\" name=\"dhcp\" onchange=\"toggleIPFields()\">";
-  html += "<option value=\"1\"" + String(useDHCP ? " selected" : "") + ">DHCP (Automatic)</option>";
-  html += "<option value=\"0\"" + String(!useDHCP ? " selected" : "") + ">Static IP</option>";
-  html += "</select>";
-
-  html += "<div id=\"ipFields\" class=\"ip-fields\">";
-  html += "<label for=\"ip\">IP Address</label>";
-  html += "<input type=\"text\" id=\"ip\" name=\"ip\" value=\"" + staticIP + "\">";
-  html += "<label for=\"gw\">Gateway</label>";
-  html += "<input type=\"text\" id=\"gw\" name=\"gw\" value=\"" + gateway + "\">";
-  html += "<label for=\"sn\">Subnet Mask</label>";
-  html += "<input type=\"text\" id=\"sn\" name=\"sn\" value=\"" + subnet + "\">";
-  html += "<label for=\"dns\">DNS Server</label>";
-  html += "<input type=\"text\" id=\"dns\" name=\"dns\" value=\"" + dns + "\">";
-  html += "</div>";
-  html += "<p class=\"note\">Device will reboot after saving settings.</p>";
-  html += "</div>";
-
-  html += "<div style=\"display:flex;gap:10px;margin-top:20px\">";
-  html += "<button type=\"submit\" style=\"flex:2\">Save &amp; Reboot</button>";
-  html += "<button type=\"button\" style=\"flex:1;background:#c00\" onclick=\"resetDefaults()\">Reset Defaults</button>";
-  html += "</div>";
-  html += "</form>";
-  html += "<footer style=\"text-align:center;margin-top:30px;padding:20px;color:#666;font-size:12px\">";
-  html += "&copy; 2026 <a href=\"https://videowalrus.com\" style=\"color:#00d4ff\">Video Walrus</a>";
-  html += "</footer>";
-  html += "</div>";
-
-  // Disco mode overlay
-  html += "<div id=\"discoOverlay\" class=\"disco-overlay\">";
-  html += "<div class=\"disco-text\">DISCO MODE<br>ACTIVATED</div>";
-  html += "<button class=\"disco-cancel\" onclick=\"stopDisco()\">STOP THE PARTY</button>";
-  html += "</div>";
-
-  // JavaScript
-  html += "<script>";
-  html += "function toggleIPFields(){var d=document.getElementById('dhcp').value;var f=document.getElementById('ipFields');if(d==='0'){f.classList.add('show')}else{f.classList.remove('show')}}";
-  html += "function toggleWifiFields(){var w=document.getElementById('wifiEn').value;var f=document.getElementById('wifiFields');if(w==='1'){f.classList.add('show')}else{f.classList.remove('show')}}";
-  html += "function testOn(s){fetch('/test?state='+s).then(r=>r.json()).then(d=>{document.getElementById('tallyState').textContent=d.tally;document.getElementById('tallyState').className='tally-'+d.tally.toLowerCase();document.body.className='tally-'+d.tally.toLowerCase();})}";
-  html += "function testOff(){fetch('/test?state=0').then(r=>r.json()).then(d=>{document.getElementById('tallyState').textContent=d.tally;document.getElementById('tallyState').className='tally-'+d.tally.toLowerCase();document.body.className='tally-'+d.tally.toLowerCase();})}";
-  html += "var devices=[];";
-  html += "function discoverDevices(){";
-  html += "document.getElementById('deviceList').innerHTML='<p class=\"no-devices\">Scanning...</p>';";
-  html += "fetch('/discover').then(r=>r.json()).then(d=>{";
-  html += "devices=d.devices;var html='';";
-  html += "if(devices.length===0){html='<p class=\"no-devices\">No other devices found</p>';}";
-  html += "else{devices.forEach(function(dev){";
-  html += "html+='<div class=\"device-item\">';";
-  html += "html+='<div class=\"device-status off\" id=\"status-'+dev.ip.replace(/\\./g,'-')+'\"></div>';";
-  html += "html+='<div class=\"device-info\">';";
-  html += "html+='<div class=\"device-name\">'+dev.hostname+'</div>';";
-  html += "html+='<div class=\"device-details\">TSL:'+dev.tslAddress+' | '+dev.ip+'</div>';";
-  html += "html+='</div>';";
-  html += "html+='<a href=\"http://'+dev.ip+'/\" target=\"_blank\" class=\"device-link\">Open</a>';";
-  html += "html+='</div>';";
-  html += "});}";
-  html += "document.getElementById('deviceList').innerHTML=html;";
-  html += "updateDeviceStatuses();";
-  html += "}).catch(function(e){document.getElementById('deviceList').innerHTML='<p class=\"no-devices\">Scan failed</p>';});}";
-  html += "function updateDeviceStatuses(){";
-  html += "devices.forEach(function(dev){";
-  html += "fetch('http://'+dev.ip+'/status').then(r=>r.json()).then(d=>{";
-  html += "var el=document.getElementById('status-'+dev.ip.replace(/\\./g,'-'));";
-  html += "if(el){el.className='device-status '+d.tally.toLowerCase();}";
-  html += "}).catch(function(){});});}";
-  html += "function bulkTest(state){";
-  html += "devices.forEach(function(dev){fetch('http://'+dev.ip+'/test?state='+state).catch(function(){});});";
-  html += "fetch('/test?state='+state);}";
-  html += "function resetDefaults(){if(confirm('Reset all settings to factory defaults?\\n\\nThis will erase all configuration and reboot the device.')){window.location.href='/reset';}}";
-  // Firmware update functions
-  html += "function checkUpdate(){";
-  html += "document.getElementById('updateNotice').style.display='none';";
-  html += "fetch('/api/check-update').then(r=>r.json()).then(d=>{";
-  html += "document.getElementById('fwVersion').textContent=d.current;";
-  html += "if(d.updateAvailable){";
-  html += "document.getElementById('updateNotice').style.display='block';";
-  html += "document.getElementById('latestVersion').textContent=d.latest;";
-  html += "}else{alert('Firmware is up to date ('+d.current+')');}";
-  html += "}).catch(function(e){alert('Failed to check for updates');});}";
-  html += "function installUpdate(){";
-  html += "if(confirm('Install firmware update?\\n\\nThe device will download the new firmware and reboot.')){";
-  html += "document.getElementById('updateNotice').innerHTML='<span style=\\\"color:#ff6b6b\\\">Updating... Please wait, device will reboot</span>';";
-  html += "fetch('/api/update').catch(function(){});}}";
-  // Secret disco mode - type 'disco' anywhere to trigger
-  html += "var discoBuffer='';var discoTimer=null;";
-  html += "document.addEventListener('keydown',function(e){";
-  html += "discoBuffer+=e.key.toLowerCase();discoBuffer=discoBuffer.slice(-5);";
-  html += "if(discoBuffer==='disco'){startDisco();}});";
-  html += "function startDisco(){";
-  html += "document.getElementById('discoOverlay').classList.add('active');";  // Show overlay
-  html += "fetch('/disco?duration=30');";  // Trigger local device immediately
-  // If devices already discovered, use them; otherwise scan first
-  html += "if(devices.length>0){";
-  html += "devices.forEach(function(dev){fetch('http://'+dev.ip+'/disco?duration=30').catch(function(){});});";
-  html += "}else{";
-  html += "fetch('/discover').then(r=>r.json()).then(d=>{";
-  html += "devices=d.devices;";
-  html += "devices.forEach(function(dev){fetch('http://'+dev.ip+'/disco?duration=30').catch(function(){});});";
-  html += "}).catch(function(){});}";
-  html += "discoTimer=setTimeout(function(){document.getElementById('discoOverlay').classList.remove('active');},30000);";  // Auto-hide after 30s
-  html += "console.log('DISCO MODE!');}";
-  html += "function stopDisco(){";
-  html += "if(discoTimer){clearTimeout(discoTimer);}";
-  html += "document.getElementById('discoOverlay').classList.remove('active');";  // Hide overlay
-  html += "fetch('/disco-stop');";  // Stop local device
-  html += "devices.forEach(function(dev){fetch('http://'+dev.ip+'/disco-stop').catch(function(){});});";  // Stop all discovered devices
-  html += "}";
-  html += "toggleIPFields();toggleWifiFields();";
-  html += "discoverDevices();";  // Auto-discover devices on page load
-  html += "function updateStatus(){fetch('/status').then(r=>r.json()).then(d=>{document.getElementById('tallyState').textContent=d.tally;document.getElementById('tallyState').className='tally-'+d.tally.toLowerCase();document.getElementById('tallyText').textContent=d.text||'-';document.body.className='tally-'+d.tally.toLowerCase();}).catch(e=>{});}";
-  html += "updateStatus();";
-  html += "setInterval(updateStatus,2000);";
-  html += "setInterval(updateDeviceStatuses,5000);";
-  html += "</script></body></html>";
-
-  return html;
-}
-
-// Setup web server routes
+  FleetMessage cmd = { FLEET_COMMAND, ++fleetSequence, fleetDeviceId, arg, command, arg2 };
+  if (xQueueSend(fleetQueue, &cmd, 0) != pdTRUE) {
+    sendJson(request, 503, "{\"error\":\"Busy\"}");
+    return;
+  }
+  static const uint8_t wake = 0;
+  fleetWakeSocket.sendTo((uint32_t)IPAddress(127, 0, 0, 1), FLEET_PORT, &wake, 1);
+  sendJson(request, 200, "{\"sequence\":" + String(cmd.sequence) + "}");
+}
+
+// Setup web server routes. Handlers run on the AsyncTCP task and must never
+// block: slow work is flagged here and done by serviceWebJobs() in loop().
 void setupWebServer() {
-  // Main configuration page
-  server.on("/", HTTP_GET, []() {
-    server.send(200, "text/html", getConfigPage());
+  // Bound concurrent requests; each one holds a socket and buffers until it
+  // completes. Event streams are capped separately in events.onConnect.
+  server.addMiddleware([](AsyncWebServerRequest *request, ArMiddlewareNext next) {
+    if (request->url() == "/events") {
+      next();
+      return;
+    }
+    if (!httpLimit.admit()) {
+      TallyMetrics::increment(tallyMetrics.httpRejected);
+      request->send(503, "text/plain", "Busy");
+      return;
+    }
+    httpLimit.watch(request);
+    next();
+  });
+
+  // Main configuration page: static and precompressed, values come from /config
+  server.on("/", HTTP_GET, [](AsyncWebServerRequest *request) {
+    if (request->hasHeader("If-None-Match") && request->header("If-None-Match") == INDEX_HTML_ETAG) {
+      AsyncWebServerResponse *response = request->beginResponse(304);
+      response->addHeader("ETag", INDEX_HTML_ETAG);
+      request->send(response);
+      return;
+    }
+    // Streamed straight from flash
+    AsyncWebServerResponse *response = request->beginResponse(200, "text/html", INDEX_HTML_GZ, INDEX_HTML_GZ_LENGTH);
+    response->addHeader("Content-Encoding", "gzip");
+    response->addHeader("ETag", INDEX_HTML_ETAG);
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+  });
+
+  // Settings and device details for the configuration page
+  server.on("/config", HTTP_GET, [](AsyncWebServerRequest *request) {
+    AsyncResponseStream *response = request->beginResponseStream("application/json");
+    response->printf("{\"settings\":{\"tslProto\":\"%d\",\"tslAddr\":%d,\"tslMcast\":%s,\"tslPort\":%d,\"maxBright\":%d,\"ledRoles\":%s,\"ledOutputs\":%s,",
+                     tslProtocol, tslAddress, jsonString(tslMulticast).c_str(), tslPort, maxBrightness,
+                     jsonString(ledRoles).c_str(), jsonString(ledOutputs).c_str());
+    response->printf("\"tslMcastOn\":\"%d\",\"tslUdpPort\":%d,\"tslTcpHost\":%s,\"tslTcpPort\":%d,\"relayRole\":\"%d\",",
+                     tslMulticastOn ? 1 : 0, tslUnicastPort, jsonString(tslTcpHost).c_str(), tslTcpPort, relayRole);
+    response->printf("\"tslRules\":%s,\"restoreS\":%d,\"lostSignalS\":%d,\"lostColor\":%s,", jsonString(tslRules).c_str(),
+                     restoreTimeoutS, lostSignalS, jsonString(lostSignalColor).c_str());
+    response->printf("\"wifiEn\":\"%d\",\"failover\":\"%d\",\"wifiSSID\":%s,\"hostname\":%s,\"dhcp\":\"%d\",",
+                     wifiEnabled ? 1 : 0, netFailover, jsonString(wifiSSID).c_str(), jsonString(deviceHostname).c_str(),
+                     useDHCP ? 1 : 0);
+    response->printf("\"ip\":%s,\"gw\":%s,\"sn\":%s,\"dns\":%s},", jsonString(staticIP).c_str(),
+                     jsonString(gateway).c_str(), jsonString(subnet).c_str(), jsonString(dns).c_str());
+    response->printf("\"fleetKeySet\":%s,", fleetKey.length() > 0 ? "true" : "false");
+    response->printf("\"wifiPassSet\":%s,\"connection\":\"%s\",\"ethMac\":\"%s\",\"wifiMac\":\"%s\",",
+                     wifiPassword.length() > 0 ? "true" : "false", getConnectionStatus().c_str(),
+                     eth_connected ? ETH.macAddress().c_str() : "",
+                     wifi_connected || ap_mode ? WiFi.macAddress().c_str() : "");
+    response->printf("\"apMode\":%s,\"apSSID\":%s,\"apPassword\":%s,\"firmware\":\"%s\"}",
+                     ap_mode ? "true" : "false", jsonString(apSSID).c_str(), jsonString(apPassword).c_str(), FIRMWARE_VERSION);
+    request->send(response);
   });
 
   // Status endpoint (JSON) - with CORS for cross-device polling
-  server.on("/status", HTTP_GET, []() {
-    String json = "{\"tally\":\"" + currentTallyState + "\",\"text\":\"" + currentTallyText + "\",\"ip\":\"" + getActiveIP() + "\",\"connection\":\"" + getConnectionStatus() + "\"}";
-    server.sendHeader("Access-Control-Allow-Origin", "*");
-    server.send(200, "application/json", json);
+  server.on("/status", HTTP_GET, [](AsyncWebServerRequest *request) {
+    xSemaphoreTake(webDataMutex, portMAX_DELAY);
+    OtaProgress ota = otaProgress;
+    xSemaphoreGive(webDataMutex);
+    String json = "{\"tally\":\"" + String(tallyStateName(tallyRenderer.displayedState())) + "\",\"text\":" + jsonString(getTallyText()) + ",\"ip\":\"" + getActiveIP() + "\",\"connection\":\"" + getConnectionStatus() + "\",";
+    json += "\"signal\":\"" + String(tslSignalLost ? "lost" : "ok") + "\",";
+    json += "\"tcp\":\"" + String(tslTcpStateName(tslTcp.state())) + "\",";
+    if (relayRole == RELAY_ROLE_RELAY) {
+      json += "\"relay\":{\"role\":\"relay\",\"subscribers\":" + String((int)tslRelay.subscribers()) + "},";
+    } else if (relayRole == RELAY_ROLE_SUBSCRIBE) {
+      json += "\"relay\":{\"role\":\"subscribe\",\"from\":\"" + IPAddress(tslRelaySubscriber.relay()).toString() +
+              "\",\"gaps\":" + String(tslRelaySubscriber.gaps()) + "},";
+    }
+    json += "\"ota\":{\"state\":\"" + String(otaStateName(ota.state)) + "\",\"bytes\":" + String(ota.bytes) +
+            ",\"total\":" + String(ota.total) + ",\"requests\":" + String(ota.requests) +
+            ",\"resumes\":" + String(ota.resumes) + ",\"restarts\":" + String(ota.restarts) +
+            ",\"error\":" + jsonString(ota.error) + ",\"source\":\"" +
+            (otaMode == OTA_FLEET_PEER ? "fleet" : otaMode == OTA_FLEET_SEED ? "github+seed" : "github") +
+            "\",\"serving\":" + String((int)fleetOtaStreams) + "}}";
+    sendJson(request, 200, json);
   });
 
+  // Tally change push channel (SSE) - with CORS for cross-device pages
+  eventsCors.setOrigin("*");
+  events.addMiddleware(&eventsCors);
+  events.onConnect([](AsyncEventSourceClient *client) {
+    if (events.count() > MAX_EVENT_CLIENTS) {
+      client->close();  // The page falls back to polling /status
+      return;
+    }
+    char data[TALLY_EVENT_MAX_LENGTH];
+    getTallyEvent(data, sizeof(data));
+    client->send(data, "tally", millis(), 2000);
+  });
+  server.addHandler(&events);
+
   // Test tally endpoint - with CORS for cross-device control
-  server.on("/test", HTTP_GET, []() {
-    if (server.hasArg("state")) {
-      int state = server.arg("state").toInt();
+  server.on("/test", HTTP_GET, [](AsyncWebServerRequest *request) {
+    uint8_t state = tallyRenderer.displayedState();
+    if (request->hasArg("state")) {
+      state = request->arg("state").toInt();
       setTallyState(state);
     }
-    String json = "{\"tally\":\"" + currentTallyState + "\"}";
-    server.sendHeader("Access-Control-Allow-Origin", "*");
-    server.send(200, "application/json", json);
+    // The render task applies it asynchronously, so report what was requested
+    sendJson(request, 200, "{\"tally\":\"" + String(tallyStateName(state)) + "\"}");
   });
 
   // Device info endpoint (for multi-device discovery) - with CORS
-  server.on("/info", HTTP_GET, []() {
+  server.on("/info", HTTP_GET, [](AsyncWebServerRequest *request) {
     String mac = eth_connected ? ETH.macAddress() : WiFi.macAddress();
     String json = "{";
-    json += "\"hostname\":\"" + deviceHostname + "\",";
+    json += "\"hostname\":" + jsonString(deviceHostname) + ",";
     json += "\"ip\":\"" + getActiveIP() + "\",";
     json += "\"mac\":\"" + mac + "\",";
     json += "\"tslAddress\":" + String(tslAddress) + ",";
-    json += "\"tallyState\":\"" + currentTallyState + "\",";
-    json += "\"tallyText\":\"" + currentTallyText + "\",";
+    json += "\"tallyState\":\"" + String(tallyStateName(tallyRenderer.displayedState())) + "\",";
+    json += "\"tallyText\":" + jsonString(getTallyText()) + ",";
     json += "\"connection\":\"" + getConnectionStatus() + "\",";
-    json += "\"firmware\":\"" + String(FIRMWARE_VERSION) + "\"";
+    json += "\"firmware\":\"" + String(FIRMWARE_VERSION) + "\",";
+    json += "\"cueLatencyUs\":" + String(tallyRenderer.lastCueLatencyUs()) + ",";
+    json += "\"cueLatencyMaxUs\":" + String(tallyRenderer.maxCueLatencyUs());
     json += "}";
-    server.sendHeader("Access-Control-Allow-Origin", "*");
-    server.send(200, "application/json", json);
+    sendJson(request, 200, json);
   });
 
-  // Discover other tally devices on the network
-  server.on("/discover", HTTP_GET, []() {
-    // Only rescan if cache is stale (> 10 seconds)
-    if (millis() - lastDiscoveryScan > 10000) {
-      discoverTallyDevices();
+  // Boot timeline: ms after the app started at which each phase finished,
+  // null for phases not reached yet
+  server.on("/api/boot", HTTP_GET, [](AsyncWebServerRequest *request) {
+    String json = "{\"resetReason\":\"" + String(resetReasonName(esp_reset_reason())) + "\",";
+    json += "\"link\":\"" + String(bootLink) + "\",\"tallyRestored\":\"" + String(tallyRestoredFrom) + "\",\"uptimeMs\":" + String(millis()) + ",\"phases\":{";
+    for (int i = 0; i < NUM_BOOT_PHASES; i++) {
+      uint32_t us = bootPhaseUs[i];
+      if (i > 0) json += ",";
+      json += "\"" + String(bootPhaseNames[i]) + "\":" + (us ? String(us / 1000.0f, 1) : String("null"));
     }
+    json += "}}";
+    sendJson(request, 200, json);
+  });
 
-    // Build JSON array of discovered devices
-    String json = "{\"devices\":[";
-    for (int i = 0; i < numDiscoveredDevices; i++) {
-      if (i > 0) json += ",";
-      json += "{";
-      json += "\"hostname\":\"" + discoveredDevices[i].hostname + "\",";
-      json += "\"ip\":\"" + discoveredDevices[i].ip + "\",";
-      json += "\"tslAddress\":" + String(discoveredDevices[i].tslAddress);
-      json += "}";
+  // Recent log lines, oldest first
+  server.on("/log", HTTP_GET, [](AsyncWebServerRequest *request) {
+    AsyncResponseStream *response = request->beginResponseStream("text/plain");
+    xSemaphoreTake(logHistoryMutex, portMAX_DELAY);
+    if (logHistoryWrapped) {
+      response->write((const uint8_t *)logHistory + logHistoryHead, LOG_HISTORY_SIZE - logHistoryHead);
     }
-    json += "],\"count\":" + String(numDiscoveredDevices) + "}";
-    server.send(200, "application/json", json);
+    response->write((const uint8_t *)logHistory, logHistoryHead);
+    xSemaphoreGive(logHistoryMutex);
+    request->send(response);
   });
 
-  // Reset to factory defaults
-  server.on("/reset", HTTP_GET, []() {
-    resetSettings();
+  // Prometheus metrics: packet counters and cue latency histograms.
+  // Handlers run one at a time on the AsyncTCP task, so the static buffer
+  // is safe; send() copies it.
+  server.on("/metrics", HTTP_GET, [](AsyncWebServerRequest *request) {
+    size_t length = tallyMetrics.format(metricsBuffer, sizeof(metricsBuffer));
+    if (length >= sizeof(metricsBuffer)) {
+      // Cut short, it would not parse: TALLY_METRICS_MAX_LENGTH needs raising
+      LOG_WARN("[HTTP] /metrics needs %u bytes, buffer is %u", (uint32_t)length, (uint32_t)sizeof(metricsBuffer));
+      request->send(500, "text/plain", "Metrics buffer too small");
+      return;
+    }
+    request->send(200, "text/plain; version=0.0.4", metricsBuffer);
+  });
 
+  // Other tally devices on the network, a page at a time
+  // (?offset=&limit=, "total" is the table size). ?refresh=1 queries now;
+  // "scanning" is true while a query runs.
+  server.on("/discover", HTTP_GET, [](AsyncWebServerRequest *request) {
+    bool scanning = discoveryScanning;
+    if (request->hasArg("refresh") && discoveryTaskHandle != NULL) {
+      xTaskNotifyGive(discoveryTaskHandle);
+      scanning = true;
+    }
+
+    size_t offset = request->hasArg("offset") ? request->arg("offset").toInt() : 0;
+    size_t limit = request->hasArg("limit") ? request->arg("limit").toInt() : DISCOVER_PAGE_LIMIT;
+    if (limit == 0 || limit > MAX_DISCOVERED_DEVICES) limit = MAX_DISCOVERED_DEVICES;
+
+    // The stream buffers in RAM, so the page is written straight from the
+    // table while it is locked
+    uint32_t now = millis();
+    AsyncResponseStream *response = request->beginResponseStream("application/json");
+    response->print("{\"devices\":[");
+    xSemaphoreTake(webDataMutex, portMAX_DELAY);
+    size_t total = deviceTable.count();
+    size_t end = offset < total ? (offset + limit < total ? offset + limit : total) : offset;
+    char device[DEVICE_JSON_MAX_LENGTH];
+    for (size_t i = offset; i < end; i++) {
+      if (i > offset) response->print(",");
+      deviceTable.formatJson(i, now, device, sizeof(device));
+      response->print(device);
+    }
+    xSemaphoreGive(webDataMutex);
+    response->printf("],\"offset\":%u,\"count\":%u,\"total\":%u,\"scanning\":%s}", (unsigned)offset,
+                     (unsigned)(end - offset), (unsigned)total, scanning ? "true" : "false");
+    request->send(response);
+  });
+
+  // Reset to factory defaults
+  server.on("/reset", HTTP_GET, [](AsyncWebServerRequest *request) {
     String response = "<!DOCTYPE html><html><head>";
     response += "<meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">";
     response += "<title>Factory Reset</title>";
@@ -1168,107 +2170,213 @@ void setupWebServer() {
     response += "<p>Device is rebooting...</p>";
     response += "</div></body></html>";
 
-    server.send(200, "text/html", response);
-
-    delay(1000);
-    ESP.restart();
+    request->send(200, "text/html", response);
+    resetRequested = true;  // loop() clears NVS and restarts
   });
 
-  // Check for firmware updates
-  server.on("/api/check-update", HTTP_GET, []() {
-    checkForUpdates();
+  // Check for firmware updates. The GitHub request runs in loop(); the page
+  // polls with ?poll=1 until "checking" is false.
+  server.on("/api/check-update", HTTP_GET, [](AsyncWebServerRequest *request) {
+    if (!request->hasArg("poll")) updateCheckRequested = true;
+    xSemaphoreTake(webDataMutex, portMAX_DELAY);
     String json = "{\"current\":\"" + String(FIRMWARE_VERSION) + "\",";
-    json += "\"latest\":\"" + latestVersion + "\",";
+    json += "\"latest\":" + jsonString(latestVersion) + ",";
     json += "\"updateAvailable\":" + String(updateAvailable ? "true" : "false") + ",";
-    json += "\"firmwareURL\":\"" + firmwareURL + "\"}";
-    server.send(200, "application/json", json);
+    json += "\"firmwareURL\":" + jsonString(firmwareURL) + ",";
+    json += "\"sha256\":" + jsonString(firmwareSha256) + ",";
+    json += "\"checking\":" + String(updateCheckRequested ? "true" : "false") + "}";
+    xSemaphoreGive(webDataMutex);
+    request->send(200, "application/json", json);
   });
 
-  // Perform firmware update from GitHub
-  server.on("/api/update", HTTP_GET, []() {
-    if (!updateAvailable || firmwareURL.length() == 0) {
-      server.send(400, "application/json", "{\"error\":\"No update available\"}");
+  // Perform firmware update from GitHub (downloaded by the OTA task,
+  // which loop() starts). Progress is in /status.
+  server.on("/api/update", HTTP_GET, [](AsyncWebServerRequest *request) {
+    xSemaphoreTake(webDataMutex, portMAX_DELAY);
+    bool available = updateAvailable && firmwareURL.length() > 0;
+    bool verifiable = firmwareSha256.length() > 0;
+    bool running = otaTaskHandle != NULL;
+    if (available && verifiable && !running) otaProgress = {};  // No stale result for the page's first poll
+    xSemaphoreGive(webDataMutex);
+    if (!available) {
+      request->send(400, "application/json", "{\"error\":\"No update available\"}");
+      return;
+    }
+    if (!verifiable) {
+      request->send(400, "application/json", "{\"error\":\"Release has no SHA-256 to verify against\"}");
       return;
     }
-    server.send(200, "application/json", "{\"status\":\"starting\",\"message\":\"Downloading update...\"}");
-    delay(100);  // Give time for response to send
-    performOTAUpdate();
+    if (running) {
+      request->send(409, "application/json", "{\"error\":\"Update already in progress\"}");
+      return;
+    }
+    request->send(200, "application/json", "{\"status\":\"starting\",\"message\":\"Downloading update...\"}");
+    updateAsFleetSeed = false;
+    updateRequested = true;
   });
 
   // Secret disco mode endpoint - with CORS for cross-device sync
-  server.on("/disco", HTTP_GET, []() {
+  server.on("/disco", HTTP_GET, [](AsyncWebServerRequest *request) {
     int duration = 30;  // Default 30 seconds
-    if (server.hasArg("duration")) {
-      duration = constrain(server.arg("duration").toInt(), 1, 120);
+    if (request->hasArg("duration")) {
+      duration = constrain(request->arg("duration").toInt(), 1, 120);
     }
-    discoMode = true;
-    discoEndTime = millis() + (duration * 1000);
-    Serial.printf("[DISCO] Party mode activated for %d seconds!\n", duration);
-    server.sendHeader("Access-Control-Allow-Origin", "*");
-    server.send(200, "application/json", "{\"disco\":true,\"duration\":" + String(duration) + "}");
+    postRenderCommand(RENDER_DISCO, duration * 1000, esp_random() | 1, micros());
+    LOG_INFO("[DISCO] Party mode activated for %d seconds!", duration);
+    sendJson(request, 200, "{\"disco\":true,\"duration\":" + String(duration) + "}");
   });
 
   // Stop disco mode - with CORS for cross-device sync
-  server.on("/disco-stop", HTTP_GET, []() {
-    discoMode = false;
-    Serial.println("[DISCO] Party stopped by request!");
-    // Return to current tally state
-    setTallyState(currentTallyState == "Green" ? 1 :
-                  currentTallyState == "Red" ? 2 :
-                  currentTallyState == "Yellow" ? 3 : 0);
-    server.sendHeader("Access-Control-Allow-Origin", "*");
-    server.send(200, "application/json", "{\"disco\":false}");
+  server.on("/disco-stop", HTTP_GET, [](AsyncWebServerRequest *request) {
+    LOG_INFO("[DISCO] Party stopped by request!");
+    // Render task returns to the current tally state
+    postRenderCommand(RENDER_DISCO_STOP, 0);
+    sendJson(request, 200, "{\"disco\":false}");
   });
 
-  // Save settings
-  server.on("/save", HTTP_POST, []() {
-    if (server.hasArg("tslAddr")) {
-      tslAddress = server.arg("tslAddr").toInt();
-    }
-    if (server.hasArg("tslMcast")) {
-      tslMulticast = server.arg("tslMcast");
-    }
-    if (server.hasArg("tslPort")) {
-      tslPort = constrain(server.arg("tslPort").toInt(), 1, 65535);
-    }
-    if (server.hasArg("maxBright")) {
-      maxBrightness = constrain(server.arg("maxBright").toInt(), 1, 255);
+  // Fleet control: one authenticated datagram to every tally sharing our
+  // fleet key, instead of one request per device. Acks land in
+  // /api/fleet/status.
+  server.on("/api/fleet/test", HTTP_POST, [](AsyncWebServerRequest *request) {
+    int state = request->hasArg("state") ? constrain(request->arg("state").toInt(), 0, 3) : 0;
+    setTallyState(state);
+    sendFleetCommand(request, FLEET_CMD_TALLY, state);
+  });
+
+  // One show on every tally, frames in lockstep; the fleet task starts
+  // ours when it sends the command. ?duration=0 stops the party.
+  server.on("/api/fleet/disco", HTTP_POST, [](AsyncWebServerRequest *request) {
+    int duration = request->hasArg("duration") ? constrain(request->arg("duration").toInt(), 0, 120) : 30;
+    if (duration == 0) {
+      postRenderCommand(RENDER_DISCO_STOP, 0);
+      sendFleetCommand(request, FLEET_CMD_DISCO_STOP, 0);
+    } else {
+      sendFleetCommand(request, FLEET_CMD_DISCO, duration * 1000, esp_random() | 1);  // Seed; 0 is never a show
     }
-    if (server.hasArg("hostname")) {
-      deviceHostname = server.arg("hostname");
+  });
+
+  // Update every tally with our fleet key: we download the release from
+  // GitHub and the others pull it from us and from each other as it
+  // arrives (fleet_ota.h). Progress is in each device's /status.
+  server.on("/api/fleet/update", HTTP_POST, [](AsyncWebServerRequest *request) {
+    xSemaphoreTake(webDataMutex, portMAX_DELAY);
+    bool available = updateAvailable && firmwareURL.length() > 0 && firmwareSha256.length() > 0;
+    bool running = otaTaskHandle != NULL;
+    uint8_t sha256[32];
+    parseSha256(firmwareSha256.c_str(), sha256);
+    if (available && !running && fleetTaskHandle != NULL) {
+      otaProgress = {};
+      fleetOtaVersion = latestVersion;
+      fleetOtaSha256 = firmwareSha256;
     }
-    if (server.hasArg("dhcp")) {
-      useDHCP = server.arg("dhcp") == "1";
+    xSemaphoreGive(webDataMutex);
+    if (!available) {
+      sendJson(request, 400, "{\"error\":\"No verifiable update available; check for updates first\"}");
+      return;
     }
-    if (server.hasArg("ip")) {
-      staticIP = server.arg("ip");
+    if (running) {
+      sendJson(request, 409, "{\"error\":\"Update already in progress\"}");
+      return;
     }
-    if (server.hasArg("gw")) {
-      gateway = server.arg("gw");
+    sendFleetCommand(request, FLEET_CMD_UPDATE, fleetImageTag(sha256));
+    if (fleetTaskHandle == NULL) return;
+    otaFleetTag = fleetImageTag(sha256);
+    otaFleetHops = 0;
+    updateAsFleetSeed = true;
+    updateRequested = true;
+  });
+
+  // The image we are distributing: "version sha256 size mac" (fleet_ota.h)
+  server.on("/api/fleet/image", HTTP_GET, [](AsyncWebServerRequest *request) {
+    char image[FLEET_IMAGE_MAX_TEXT];
+    xSemaphoreTake(webDataMutex, portMAX_DELAY);
+    size_t len = fleetOtaSha256.length() > 0 ? formatFleetImage(fleetCodec, fleetOtaVersion.c_str(),
+                                                                fleetOtaSha256.c_str(), otaSink.size(), image,
+                                                                sizeof(image))
+                                             : 0;
+    xSemaphoreGive(webDataMutex);
+    if (len == 0) {
+      request->send(503, "text/plain", "Not distributing an update");
+      return;
     }
-    if (server.hasArg("sn")) {
-      subnet = server.arg("sn");
+    request->send(200, "text/plain", image);
+  });
+
+  // The image itself, as far as we have it, to FLEET_OTA_MAX_STREAMS peers
+  // at a time. Supports "Range: bytes=N-". Busy, or nothing to serve yet,
+  // is a 503: the peer tries another source.
+  server.on("/api/fleet/firmware.bin", HTTP_GET, [](AsyncWebServerRequest *request) {
+    uint32_t size = otaSink.size();
+    if (otaMode == OTA_FROM_GITHUB || size == 0 || fleetOtaStreams >= FLEET_OTA_MAX_STREAMS) {
+      request->send(503, "text/plain", "Busy");
+      return;
     }
-    if (server.hasArg("dns")) {
-      dns = server.arg("dns");
+    uint32_t start = 0;
+    if (request->hasHeader("Range")) {
+      if (sscanf(request->header("Range").c_str(), "bytes=%u-", &start) != 1 || start >= size) {
+        request->send(416, "text/plain", "Bad range");
+        return;
+      }
     }
 
-    // WiFi settings
-    if (server.hasArg("wifiEn")) {
-      wifiEnabled = server.arg("wifiEn") == "1";
+    fleetOtaStreams++;
+    httpLimit.watch(request, fleetOtaStreamDone);  // Keeps the request slot's release
+    AsyncWebServerResponse *response = request->beginResponse(
+        "application/octet-stream", size - start, [start](uint8_t *buf, size_t maxLen, size_t index) -> size_t {
+          int n = otaSink.readBack(start + index, buf, maxLen);
+          if (n < 0) return 0;            // Image abandoned: cut the peer off
+          if (n == 0) return RESPONSE_TRY_AGAIN;  // Not downloaded that far yet
+          return n;
+        });
+    if (start > 0) {
+      response->setCode(206);
+      response->addHeader("Content-Range", "bytes " + String(start) + "-" + String(size - 1) + "/" + String(size));
     }
-    if (server.hasArg("wifiSSID")) {
-      wifiSSID = server.arg("wifiSSID");
+    request->send(response);
+  });
+
+  // Acks for the last fleet command. "convergedUs" is the slowest ack once
+  // every device that was online has answered, otherwise null.
+  server.on("/api/fleet/status", HTTP_GET, [](AsyncWebServerRequest *request) {
+    AsyncResponseStream *response = request->beginResponseStream("application/json");
+    response->addHeader("Access-Control-Allow-Origin", "*");
+    xSemaphoreTake(webDataMutex, portMAX_DELAY);
+    response->printf("{\"enabled\":%s,\"sequence\":%u,\"command\":%u,\"arg\":%u,\"expected\":%u,\"acked\":%u,",
+                     fleetTaskHandle != NULL ? "true" : "false", fleetRound.sequence(), fleetRound.command(),
+                     fleetRound.arg(), (unsigned)fleetRound.expected(), (unsigned)fleetRound.count());
+    if (fleetRound.count() > 0 && fleetRound.count() >= fleetRound.expected()) {
+      response->printf("\"convergedUs\":%u,\"acks\":[", fleetRound.maxLatencyUs());
+    } else {
+      response->print("\"convergedUs\":null,\"acks\":[");
     }
-    if (server.hasArg("wifiPass")) {
-      wifiPassword = server.arg("wifiPass");
+    for (size_t i = 0; i < fleetRound.count(); i++) {
+      const FleetAck &a = fleetRound.ack(i);
+      int device = deviceTable.find(a.sender);
+      response->printf("%s{\"hostname\":%s,\"ip\":\"%s\",\"latencyUs\":%u}", i > 0 ? "," : "",
+                       jsonString(device >= 0 ? deviceTable.hostname(device) : "").c_str(), IPAddress(a.ip).toString().c_str(),
+                       a.latencyUs);
     }
+    xSemaphoreGive(webDataMutex);
+    response->print("]}");
+    request->send(response);
+  });
 
-    saveSettings();
+  // Save settings: loop() applies and stores them, then restarts
+  // (serviceWebJobs). Another /save before then is turned away.
+  server.on("/save", HTTP_POST, [](AsyncWebServerRequest *request) {
+    if (saveRequested) {
+      request->send(503, "text/plain", "Busy");
+      return;
+    }
+    saveForm.clear();
+    for (size_t i = 0; i < request->args(); i++) saveForm.add(request->argName(i), request->arg(i));
 
-    // Build the new address link
-    String newAddress = "http://" + deviceHostname + ".local/";
-    String ipAddress = useDHCP ? "(DHCP - check router)" : staticIP;
+    // Build the new address link from the form; the settings themselves
+    // change in loop()
+    String hostname = saveForm.has("hostname") ? saveForm.arg("hostname") : deviceHostname;
+    bool dhcp = saveForm.has("dhcp") ? saveForm.arg("dhcp") == "1" : useDHCP;
+    String ip = saveForm.has("ip") ? saveForm.arg("ip") : staticIP;
+    String newAddress = "http://" + hostname + ".local/";
 
     String response = "<!DOCTYPE html><html><head>";
     response += "<meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">";
@@ -1277,70 +2385,137 @@ void setupWebServer() {
     response += "</head><body><div class=\"message\"><h1>Settings Saved!</h1>";
     response += "<p>Device is rebooting...</p>";
     response += "<p>Reconnect at: <a href=\"" + newAddress + "\">" + newAddress + "</a></p>";
-    if (!useDHCP) {
-      response += "<p>Or: <a href=\"http://" + staticIP + "/\">http://" + staticIP + "/</a></p>";
+    if (!dhcp) {
+      response += "<p>Or: <a href=\"http://" + ip + "/\">http://" + ip + "/</a></p>";
     }
     response += "</div></body></html>";
 
-    server.send(200, "text/html", response);
-
-    // Reboot after a short delay to allow response to be sent
-    delay(1000);
-    ESP.restart();
+    request->send(200, "text/html", response);
+    saveRequested = true;
   });
 
   // Captive portal detection endpoints - respond with redirect to trigger popup
-  // Android
-  server.on("/generate_204", HTTP_GET, []() {
-    server.sendHeader("Location", "http://" + getActiveIP() + "/");
-    server.send(302, "text/plain", "");
-  });
-  // Windows
-  server.on("/ncsi.txt", HTTP_GET, []() {
-    server.sendHeader("Location", "http://" + getActiveIP() + "/");
-    server.send(302, "text/plain", "");
-  });
-  server.on("/connecttest.txt", HTTP_GET, []() {
-    server.sendHeader("Location", "http://" + getActiveIP() + "/");
-    server.send(302, "text/plain", "");
-  });
-  // Apple
-  server.on("/hotspot-detect.html", HTTP_GET, []() {
-    server.sendHeader("Location", "http://" + getActiveIP() + "/");
-    server.send(302, "text/plain", "");
-  });
-  server.on("/library/test/success.html", HTTP_GET, []() {
-    server.sendHeader("Location", "http://" + getActiveIP() + "/");
-    server.send(302, "text/plain", "");
-  });
+  static const char *captivePortalPaths[] = {
+    "/generate_204",               // Android
+    "/ncsi.txt",                   // Windows
+    "/connecttest.txt",
+    "/hotspot-detect.html",        // Apple
+    "/library/test/success.html",
+  };
+  for (const char *path : captivePortalPaths) {
+    server.on(path, HTTP_GET, [](AsyncWebServerRequest *request) {
+      request->redirect("http://" + getActiveIP() + "/");
+    });
+  }
 
   // Catch-all handler for captive portal (redirect unknown requests to config page)
-  server.onNotFound([]() {
+  server.onNotFound([](AsyncWebServerRequest *request) {
     if (ap_mode) {
-      server.sendHeader("Location", "http://" + getActiveIP() + "/");
-      server.send(302, "text/plain", "");
+      request->redirect("http://" + getActiveIP() + "/");
     } else {
-      server.send(404, "text/plain", "Not found");
+      request->send(404, "text/plain", "Not found");
     }
   });
 }
 
+// Put the last tally back before there is a network (see rtcTally)
+static void restoreTally() {
+  if (restoreTimeoutS <= 0) return;
+  uint32_t holdMs = (uint32_t)restoreTimeoutS * 1000;
+  SavedTally saved;
+  memcpy(&saved, &rtcTally, sizeof(saved));
+  if (esp_reset_reason() != ESP_RST_POWERON && savedTallyValid(saved)) {
+    // time() runs on through a software reset; if it went back, the age
+    // is unknown, as after a power cut
+    int32_t ageS = (int32_t)((uint32_t)time(NULL) - saved.savedAtS);
+    if (ageS >= restoreTimeoutS) return;  // NVS only holds older copies
+    if (ageS > 0) holdMs -= (uint32_t)ageS * 1000;
+    tallyRestoredFrom = "rtc";
+  } else {
+    tallyStore.begin(TALLY_STORE_NAMESPACE, true);
+    size_t n = tallyStore.getBytes("last", &saved, sizeof(saved));
+    tallyStore.end();
+    if (n != sizeof(saved) || !savedTallyValid(saved)) return;
+    tallySaveSchedule.known(saved);
+    tallyRestoredFrom = "nvs";
+  }
+  tslDecoder.restoreState(saved, holdMs);
+  tallyRestored = true;
+  Serial.printf("Restored tally %s from %s, held %u s unless TSL confirms it\n",
+                tallyStateName(saved.control[tslAddress] & 0x0F), tallyRestoredFrom, holdMs / 1000);
+}
+
+// Batch the RTC copy of the tally state into NVS (TallySaveSchedule)
+void serviceTallyMemory() {
+  static SavedTally latest;
+  static uint32_t latestSeq = 0;
+  uint32_t seq = rtcTallyWrites.load(std::memory_order_acquire);
+  if (seq == 0) return;  // Nothing new since boot
+  if (seq != latestSeq) {
+    if (!readRtcTally(latest, seq)) return;  // Raced a write; next pass
+    latestSeq = seq;
+  }
+  uint32_t now = millis();
+  if (!tallySaveSchedule.due(latest, now)) return;
+  tallyStore.begin(TALLY_STORE_NAMESPACE, false);
+  tallyStore.putBytes("last", &latest, sizeof(latest));
+  tallyStore.end();
+  tallySaveSchedule.written(latest, now);
+}
+
 void setup() {
-  Serial.begin(115200);
-  while (millis() < 3000);
+  Serial.begin(115200);  // Not waited for: early lines are in /log
   Serial.println("Video Walrus Single TSL tally interface 2025");
   Serial.println("");
+  startLogTask();
 
-  FastLED.addLeds<WS2812B, DATA_PIN, GRB>(leds, NUM_LEDS);  // GRB ordering is typical
+  // Load settings from NVS; the LED outputs come from them
+  loadSettings();
+  markBootPhase(BOOT_PHASE_SETTINGS);
+
+  if (!ledSink.begin(ledOutputs.c_str())) {
+    Serial.printf("Invalid LED outputs \"%s\", using %s\n", ledOutputs.c_str(), DEFAULT_LED_OUTPUTS);
+    ledSink.begin(DEFAULT_LED_OUTPUTS);
+  }
+  ledSink.transferTime = &tallyMetrics.ledTransfer;
   FastLED.setBrightness(maxBrightness);
   FastLED.clear();  // clear all pixel data
   FastLED.show();
 
   // Check for factory reset (hold BOOT button for 3 seconds)
   checkResetButton();
+  tslDecoder.address = tslAddress;
+  tslDecoder.maxBrightness = maxBrightness;
+  tslDecoder.metrics = &tallyMetrics;
+  tallyRenderer.maxBrightness = maxBrightness;
+  tallyRenderer.metrics = &tallyMetrics;
+  if (tallyRules.parse(tslRules.c_str()) && tallyRules.enabled()) {
+    tslDecoder.rules = &tallyRules;
+    tallyRenderer.rules = &tallyRules;
+    Serial.printf("%u tally rules active\n", (unsigned)tallyRules.count());
+  } else if (tslRules.length() > 0) {
+    Serial.printf("Ignoring invalid tally rules \"%s\"\n", tslRules.c_str());
+  }
+  if (!tallyRenderer.setLayout(ledRoles.c_str())) {
+    Serial.printf("Ignoring invalid LED roles \"%s\"\n", ledRoles.c_str());
+  }
+  multicastAddress.fromString(tslMulticast);
+  tslTcp.metrics = &tallyMetrics;
+  tslRelay.metrics = &tallyMetrics;
+  tslRelaySubscriber.metrics = &tallyMetrics;
+  fleetCodec.setKey(fleetKey.c_str());
+  if (relayRole == RELAY_ROLE_RELAY) tslRelay.begin(esp_random() | 1);
+  IPAddress tcpServer;
+  if (tslTcpHost.length() > 0 && tcpServer.fromString(tslTcpHost)) {
+    tslTcp.begin((uint32_t)tcpServer, tslTcpPort, tslProtocol, esp_random());
+  }
+  restoreTally();
 
-  // Load settings from NVS
-  loadSettings();
+  // From here on the render task owns the LEDs
+  webDataMutex = xSemaphoreCreateMutex();
+  startRenderTask();
+  markBootPhase(BOOT_PHASE_LEDS);
+  startUDPTask();  // Joins the multicast group once a link has an address
 
   Network.onEvent(onEvent);
 
@@ -1361,156 +2536,140 @@ void setup() {
   // Hardware reset the W5500
   pinMode(ETH_PHY_RST, OUTPUT);
   digitalWrite(ETH_PHY_RST, LOW);
-  delay(50);
+  delay(1);  // 500 us minimum
   digitalWrite(ETH_PHY_RST, HIGH);
-  delay(50);
+  delay(1);  // PLL lock
 
   // Initialize W5500 - uses ETH_PHY_* defines set before ETH.h include
   bool ethStarted = ETH.begin(ETH_PHY_TYPE, ETH_PHY_ADDR, ETH_PHY_CS, ETH_PHY_IRQ, ETH_PHY_RST,
                                ETH_PHY_SPI_HOST, ETH_PHY_SPI_SCK, ETH_PHY_SPI_MISO, ETH_PHY_SPI_MOSI);
   Serial.printf("ETH.begin() returned: %s\n", ethStarted ? "true" : "false");
 
+  bootStageStartMs = millis();
   if (ethStarted) {
-    // Wait for Ethernet with timeout, feeding watchdog
-    Serial.println("Waiting for Ethernet connection...");
-    unsigned long ethStartTime = millis();
-    while (!eth_connected && millis() - ethStartTime < 10000) {  // 10 second timeout
-      yield();  // Feed the watchdog
-      delay(20);
-      // Pulse orange while waiting for Ethernet
-      uint8_t brightness = (sin8(millis() / 4) * maxBrightness) / 255;
-      fill_solid(leds, NUM_LEDS, CRGB::Orange);
-      FastLED.setBrightness(brightness);
-      FastLED.show();
-    }
-    FastLED.setBrightness(maxBrightness);  // Restore brightness
-    fill_solid(leds, NUM_LEDS, CRGB::Black);
-    FastLED.show();
-    Serial.printf("Ethernet wait complete. Connected: %s\n", eth_connected ? "YES" : "NO");
-  }
-
-  // If Ethernet connected, use it exclusively
-  if (eth_connected) {
-    Serial.println("Ethernet connected - using wired network");
+    postRenderCommand(RENDER_PULSE, CRGB::Orange);  // Pulse orange while waiting for Ethernet
+    bootStage = BOOT_WAIT_ETHERNET;
+  } else if (startWiFi()) {
+    bootStage = BOOT_WAIT_WIFI;
   } else {
-    // No Ethernet - try WiFi, then AP mode as fallback
-    Serial.println("Ethernet not connected, trying WiFi...");
-
-    if (!setupWiFi()) {
-      Serial.println("WiFi failed, starting AP mode for configuration...");
-      startAP();
-    }
-  }
-
-  // Wait for network stack after AP mode
-  if (ap_mode) {
-    delay(2000);  // Give TCP/IP stack time to be ready
+    Serial.println("No network configured, starting AP mode for configuration...");
+    startAP();
+    startServices();
+    bootStage = BOOT_DONE;
   }
+}
 
-  // Setup UDP multicast listener if we have any network connection
+// Web server, discovery, mDNS, ArduinoOTA and fleet control, once the
+// tally is listening (or in AP mode)
+void startServices() {
+  startDiscoveryTask();
   if (eth_connected || wifi_connected) {
-    // Parse multicast address from string
-    multicastAddress.fromString(tslMulticast);
-    Serial.printf("TSL Multicast: %s:%d\n", multicastAddress.toString().c_str(), tslPort);
-
-    // Start UDP listener task on core 0 (main loop runs on core 1)
-    startUDPTask();
-
-    // Start mDNS responder
     startMDNS();
-
-    // Run LED test to indicate successful network connection
-    testLED();
-  } else {
-    Serial.println("No network connection for TSL - AP mode only for configuration");
-  }
-
-  // Only setup OTA if we have a real network connection (not AP-only mode)
-  if (eth_connected || wifi_connected) {
-    ArduinoOTA
-      .onStart([]() {
-        String type;
-        if (ArduinoOTA.getCommand() == U_FLASH) {
-          type = "sketch";
-        } else {
-          type = "filesystem";
-        }
-        Serial.println("Start updating " + type);
-      })
-      .onEnd([]() {
-        Serial.println("\nEnd");
-      })
-      .onProgress([](unsigned int progress, unsigned int total) {
-        Serial.printf("Progress: %u%%\r", (progress / (total / 100)));
-      })
-      .onError([](ota_error_t error) {
-        Serial.printf("Error[%u]: ", error);
-        if (error == OTA_AUTH_ERROR) Serial.println("Auth Failed");
-        else if (error == OTA_BEGIN_ERROR) Serial.println("Begin Failed");
-        else if (error == OTA_CONNECT_ERROR) Serial.println("Connect Failed");
-        else if (error == OTA_RECEIVE_ERROR) Serial.println("Receive Failed");
-        else if (error == OTA_END_ERROR) Serial.println("End Failed");
-      });
-
-    ArduinoOTA.setHostname(deviceHostname.c_str());
-    ArduinoOTA.setPassword("password");
-    ArduinoOTA.begin();
-    Serial.println("OTA enabled");
+    startOTA();
+    startFleetTask();
   } else {
     Serial.println("OTA disabled (AP mode only)");
   }
-
-  // Setup web server
   setupWebServer();
   server.begin();
   Serial.println("Web server started at http://" + getActiveIP());
+  markBootPhase(BOOT_PHASE_SERVICES);
 }
 
-void loop() {
-  // Handle DNS requests for captive portal (AP mode only)
-  if (ap_mode) {
-    dnsServer.processNextRequest();
-  }
+// A link has an address. The UDP task joins the group straight from the
+// GOT_IP event; start everything else.
+static void onNetworkUp() {
+  bootLink = eth_connected ? "Ethernet" : "WiFi";
+  Serial.printf("%s connected - TSL Multicast: %s:%d\n", bootLink, multicastAddress.toString().c_str(), tslPort);
+  postRenderCommand(RENDER_CLEAR, 0);
+  if (eth_connected && netFailover != FAILOVER_OFF) startWiFi(true);
+  startServices();
+}
 
-  // Handle disco mode animation
-  if (discoMode) {
-    if (millis() < discoEndTime) {
-      // Random rainbow color changes - all LEDs same color, distinct hues
-      static unsigned long lastColorChange = 0;
-      if (millis() - lastColorChange > 250) {  // Change every 250ms
-        lastColorChange = millis();
-        // Pick a random hue from 6 distinct rainbow colors (avoid in-between muddy colors)
-        uint8_t hueOptions[] = {0, 32, 64, 96, 160, 192};  // Red, Orange, Yellow, Green, Blue, Purple
-        uint8_t randomHue = hueOptions[random(6)];
-        FastLED.setBrightness(255);  // Full brightness for disco
-        fill_solid(leds, NUM_LEDS, CHSV(randomHue, 255, 255));
-        FastLED.show();
+// Boot stages after setup(); see BootStage
+void serviceBoot() {
+  uint32_t elapsed = millis() - bootStageStartMs;
+  switch (bootStage) {
+    case BOOT_WAIT_ETHERNET:
+      if (eth_connected) {
+        Serial.println("Ethernet connected - using wired network");
+        onNetworkUp();
+        bootStage = BOOT_SELF_TEST;
+      } else if (elapsed > (eth_link ? BOOT_ETH_IP_TIMEOUT_MS : BOOT_ETH_LINK_TIMEOUT_MS)) {
+        // No Ethernet - try WiFi, then AP mode as fallback
+        Serial.println("Ethernet not connected, trying WiFi...");
+        postRenderCommand(RENDER_CLEAR, 0);
+        if (startWiFi()) {
+          bootStage = BOOT_WAIT_WIFI;
+        } else {
+          Serial.println("WiFi failed, starting AP mode for configuration...");
+          startAP();
+          startServices();
+          bootStage = BOOT_DONE;
+        }
+      } else {
+        return;
       }
-    } else {
-      // Disco time is over
-      discoMode = false;
-      Serial.println("[DISCO] Party's over!");
-      // Return to current tally state
-      setTallyState(currentTallyState == "Green" ? 1 :
-                    currentTallyState == "Red" ? 2 :
-                    currentTallyState == "Yellow" ? 3 : 0);
+      bootStageStartMs = millis();
+      break;
+
+    case BOOT_WAIT_WIFI:
+      if (wifi_connected) {
+        onNetworkUp();
+        bootStage = BOOT_SELF_TEST;
+      } else if (elapsed > WIFI_CONNECT_TIMEOUT) {
+        Serial.println("WiFi connection failed, starting AP mode for configuration...");
+        WiFi.disconnect(true);
+        postRenderCommand(RENDER_CLEAR, 0);
+        startAP();
+        startServices();
+        bootStage = BOOT_DONE;
+      } else {
+        return;
+      }
+      bootStageStartMs = millis();
+      break;
+
+    case BOOT_SELF_TEST: {
+      // Red, green, blue to show the network is up. A tally wipes it and
+      // ends it at once, since it clears solid overlays. Skipped after a
+      // restore: the restored tally may be on air.
+      static const uint32_t colors[] = { CRGB::Red, CRGB::Green, CRGB::Blue };
+      static int shown = 0;
+      bool tally = bootPhaseUs[BOOT_PHASE_FIRST_TALLY] != 0 || tallyRestored;
+      if (tally || elapsed >= 3 * BOOT_SELF_TEST_STEP_MS) {
+        if (!tally) postRenderCommand(RENDER_CLEAR, 0);
+        markBootPhase(BOOT_PHASE_SELF_TEST);
+        bootStage = BOOT_DONE;
+      } else if (elapsed >= (uint32_t)shown * BOOT_SELF_TEST_STEP_MS) {
+        postRenderCommand(RENDER_SOLID, colors[shown++]);
+      }
+      break;
     }
+
+    case BOOT_DONE:
+      break;
   }
+}
 
-  // Handle web server requests
-  server.handleClient();
+void loop() {
+  uint32_t passStart = micros();
 
-  // Handle OTA updates
-  ArduinoOTA.handle();
+  serviceBoot();
 
-  // Periodic background device discovery (every 60 seconds)
-  static unsigned long lastAutoDiscovery = 0;
-  if ((eth_connected || wifi_connected) && !ap_mode) {
-    if (millis() - lastAutoDiscovery > 60000) {
-      lastAutoDiscovery = millis();
-      discoverTallyDevices();
-    }
+  // Handle DNS requests for captive portal (AP mode only)
+  if (ap_mode) {
+    dnsServer.processNextRequest();
   }
 
+  // HTTP is served by AsyncTCP; run what the handlers deferred, and push events
+  serviceWebJobs();
+  serviceEventClients();
+  serviceTallyMemory();
+
+  // Handle OTA updates, whether or not any TSL receiver is listening
+  if (arduinoOtaStarted) ArduinoOTA.handle();
+
+  tallyMetrics.loopPass.record(micros() - passStart);
   delay(10);
 }
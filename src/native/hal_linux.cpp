@@ -0,0 +1,271 @@
+/*
+    Linux implementations of the tally HAL (pio run -e native)
+    Video Walrus 2025
+*/
+
+#include "hal_linux.h"
+
+#include <netdb.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <fstream>
+
+#include "../log_ring.h"
+
+void TerminalLedSink::show(const Rgb *pixels, size_t n, uint8_t brightness) {
+  if (n > count) n = count;
+  printf("LEDs ");
+  for (size_t i = 0; i < n; i++) {
+    printf("\x1b[48;2;%d;%d;%dm  \x1b[0m ",
+           pixels[i].r * brightness / 255, pixels[i].g * brightness / 255, pixels[i].b * brightness / 255);
+  }
+  printf(" brightness %d\n", brightness);
+  fflush(stdout);
+}
+
+static uint64_t monotonicMicros() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+SteadyClock::SteadyClock() : startMicros(monotonicMicros()) {}
+
+uint32_t SteadyClock::millis() {
+  return (monotonicMicros() - startMicros) / 1000;
+}
+
+uint32_t SteadyClock::micros() {
+  return monotonicMicros() - startMicros;
+}
+
+uint32_t logMicros() {
+  static const uint64_t startMicros = monotonicMicros();
+  return monotonicMicros() - startMicros;
+}
+
+bool FileStore::begin(const char *ns, bool readOnly) {
+  prefix = std::string(ns) + ".";
+  writable = !readOnly;
+  dirty = false;
+  values.clear();
+
+  std::ifstream in(path);
+  std::string line;
+  while (std::getline(in, line)) {
+    size_t eq = line.find('=');
+    if (eq != std::string::npos) values[line.substr(0, eq)] = line.substr(eq + 1);
+  }
+  return true;
+}
+
+void FileStore::end() {
+  if (writable && dirty) {
+    std::ofstream out(path, std::ios::trunc);
+    for (const auto &kv : values) out << kv.first << '=' << kv.second << '\n';
+  }
+  dirty = false;
+}
+
+void FileStore::clear() {
+  for (auto it = values.begin(); it != values.end();) {
+    if (it->first.compare(0, prefix.size(), prefix) == 0) it = values.erase(it);
+    else ++it;
+  }
+  dirty = true;
+}
+
+const std::string *FileStore::find(const char *key) const {
+  auto it = values.find(prefix + key);
+  return it == values.end() ? NULL : &it->second;
+}
+
+int32_t FileStore::getInt(const char *key, int32_t defaultValue) {
+  const std::string *v = find(key);
+  return v ? atoi(v->c_str()) : defaultValue;
+}
+
+void FileStore::putInt(const char *key, int32_t value) {
+  values[prefix + key] = std::to_string(value);
+  dirty = true;
+}
+
+bool FileStore::getBool(const char *key, bool defaultValue) {
+  const std::string *v = find(key);
+  return v ? *v == "1" : defaultValue;
+}
+
+void FileStore::putBool(const char *key, bool value) {
+  values[prefix + key] = value ? "1" : "0";
+  dirty = true;
+}
+
+size_t FileStore::getString(const char *key, char *buf, size_t len, const char *defaultValue) {
+  const std::string *v = find(key);
+  snprintf(buf, len, "%s", v ? v->c_str() : defaultValue);
+  return strlen(buf);
+}
+
+void FileStore::putString(const char *key, const char *value) {
+  values[prefix + key] = value;
+  dirty = true;
+}
+
+size_t FileStore::getBytes(const char *key, void *buf, size_t len) {
+  const std::string *v = find(key);
+  if (v == NULL || v->size() != 2 * len) return 0;
+  uint8_t *out = (uint8_t *)buf;
+  for (size_t i = 0; i < len; i++) {
+    unsigned byte;
+    if (sscanf(v->c_str() + 2 * i, "%2x", &byte) != 1) return 0;
+    out[i] = byte;
+  }
+  return len;
+}
+
+void FileStore::putBytes(const char *key, const void *value, size_t len) {
+  std::string hex;
+  char digits[3];
+  for (size_t i = 0; i < len; i++) {
+    snprintf(digits, sizeof(digits), "%02x", ((const uint8_t *)value)[i]);
+    hex += digits;
+  }
+  values[prefix + key] = hex;
+  dirty = true;
+}
+
+#define HTTP_TIMEOUT_S 5
+
+bool SocketHttpSource::setUrl(const char *url) {
+  if (strncmp(url, "http://", 7) != 0) return false;
+  const char *h = url + 7;
+  const char *slash = strchr(h, '/');
+  std::string authority = slash ? std::string(h, slash - h) : std::string(h);
+  path = slash ? slash : "/";
+  size_t colon = authority.find(':');
+  host = authority.substr(0, colon);
+  port = colon == std::string::npos ? "80" : authority.substr(colon + 1);
+  return !host.empty();
+}
+
+// One header line without the CRLF; its length, or -1 on a drop
+int SocketHttpSource::readLine(char *line, size_t len) {
+  size_t n = 0;
+  for (;;) {
+    if (pendingPos == pendingLen) {
+      ssize_t got = recv(fd, pending, sizeof(pending), 0);
+      if (got <= 0) return -1;
+      pendingLen = got;
+      pendingPos = 0;
+    }
+    char c = pending[pendingPos++];
+    if (c == '\n') break;
+    if (c != '\r' && n + 1 < len) line[n++] = c;
+  }
+  line[n] = '\0';
+  return n;
+}
+
+int SocketHttpSource::open(uint32_t offset, char *contentRange, size_t rangeLen, int32_t *length) {
+  close();
+  contentRange[0] = '\0';
+  *length = -1;
+
+  struct addrinfo hints = {}, *addr;
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addr) != 0) return -1;
+  fd = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+  if (fd >= 0) {
+    struct timeval tv = { HTTP_TIMEOUT_S, 0 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    if (connect(fd, addr->ai_addr, addr->ai_addrlen) != 0) close();
+  }
+  freeaddrinfo(addr);
+  if (fd < 0) return -1;
+
+  char request[512];
+  int n = snprintf(request, sizeof(request), "GET %s HTTP/1.1\r\nHost: %s\r\nConnection: close\r\n", path.c_str(),
+                   host.c_str());
+  if (offset > 0) n += snprintf(request + n, sizeof(request) - n, "Range: bytes=%u-\r\n", offset);
+  n += snprintf(request + n, sizeof(request) - n, "\r\n");
+  if (send(fd, request, n, MSG_NOSIGNAL) != n) {
+    close();
+    return -1;
+  }
+
+  char line[256];
+  int status;
+  if (readLine(line, sizeof(line)) < 0 || sscanf(line, "HTTP/%*s %d", &status) != 1) {
+    close();
+    return -1;
+  }
+  int len;
+  while ((len = readLine(line, sizeof(line))) > 0) {
+    if (strncasecmp(line, "Content-Length:", 15) == 0) *length = atol(line + 15);
+    else if (strncasecmp(line, "Content-Range:", 14) == 0)
+      snprintf(contentRange, rangeLen, "%s", line + 14 + strspn(line + 14, " "));
+  }
+  if (len < 0) {
+    close();
+    return -1;
+  }
+  return status;
+}
+
+int SocketHttpSource::read(uint8_t *buf, size_t len) {
+  if (fd < 0) return -1;
+  if (pendingPos < pendingLen) {
+    size_t n = pendingLen - pendingPos < len ? pendingLen - pendingPos : len;
+    memcpy(buf, pending + pendingPos, n);
+    pendingPos += n;
+    return n;
+  }
+  return recv(fd, buf, len, 0);
+}
+
+void SocketHttpSource::close() {
+  if (fd >= 0) ::close(fd);
+  fd = -1;
+  pendingLen = pendingPos = 0;
+}
+
+bool FileFirmwareSink::begin(uint32_t size) {
+  abort();
+  imageSize = size;
+  written = 0;
+  file = fopen((path + ".part").c_str(), "wb");
+  return file != NULL;
+}
+
+bool FileFirmwareSink::write(const uint8_t *data, size_t len) {
+  if (!file || fwrite(data, 1, len, file) != len) return false;
+  written += len;
+  return true;
+}
+
+// Like Update.end(), a short or long image is not kept
+bool FileFirmwareSink::finish() {
+  if (!file) return false;
+  if (written != imageSize) {
+    abort();
+    return false;
+  }
+  bool ok = fclose(file) == 0;
+  file = NULL;
+  return ok && rename((path + ".part").c_str(), path.c_str()) == 0;
+}
+
+void FileFirmwareSink::abort() {
+  if (!file) return;
+  fclose(file);
+  file = NULL;
+  remove((path + ".part").c_str());
+}
@@ -0,0 +1,98 @@
+/*
+    Linux implementations of the tally HAL (pio run -e native)
+    Video Walrus 2025
+*/
+
+#pragma once
+
+#include <stdio.h>
+
+#include <map>
+#include <string>
+
+#include "../hal.h"
+
+// Draws the LED chain as a row of 24-bit colour blocks on stdout
+class TerminalLedSink : public LedSink {
+ public:
+  explicit TerminalLedSink(size_t count) : count(count) {}
+  size_t size() const override { return count; }
+  void show(const Rgb *pixels, size_t n, uint8_t brightness) override;
+
+ private:
+  size_t count;
+};
+
+// CLOCK_MONOTONIC, zeroed at construction like millis()/micros() at boot
+class SteadyClock : public Clock {
+ public:
+  SteadyClock();
+  uint32_t millis() override;
+  uint32_t micros() override;
+
+ private:
+  uint64_t startMicros;
+};
+
+// Settings in a text file, one "namespace.key=value" per line
+class FileStore : public KeyValueStore {
+ public:
+  explicit FileStore(const std::string &path) : path(path) {}
+  bool begin(const char *ns, bool readOnly) override;
+  void end() override;
+  void clear() override;
+  int32_t getInt(const char *key, int32_t defaultValue) override;
+  void putInt(const char *key, int32_t value) override;
+  bool getBool(const char *key, bool defaultValue) override;
+  void putBool(const char *key, bool value) override;
+  size_t getString(const char *key, char *buf, size_t len, const char *defaultValue) override;
+  void putString(const char *key, const char *value) override;
+  size_t getBytes(const char *key, void *buf, size_t len) override;  // Stored as hex
+  void putBytes(const char *key, const void *value, size_t len) override;
+
+ private:
+  const std::string *find(const char *key) const;
+
+  std::string path;
+  std::string prefix;
+  bool writable = false;
+  bool dirty = false;
+  std::map<std::string, std::string> values;
+};
+
+// Plain-HTTP GET over a socket (no TLS); enough for a local test server
+class SocketHttpSource : public HttpSource {
+ public:
+  // "http://host[:port]/path"; false if it isn't one
+  bool setUrl(const char *url);
+  int open(uint32_t offset, char *contentRange, size_t rangeLen, int32_t *length) override;
+  int read(uint8_t *buf, size_t len) override;
+  void close() override;
+
+ private:
+  int readLine(char *line, size_t len);
+
+  std::string host;
+  std::string port;
+  std::string path;
+  int fd = -1;
+  uint8_t pending[1024];  // Body bytes read along with the headers
+  size_t pendingLen = 0;
+  size_t pendingPos = 0;
+};
+
+// Writes the image to a file, renamed into place only by finish()
+class FileFirmwareSink : public FirmwareSink {
+ public:
+  explicit FileFirmwareSink(const std::string &path) : path(path) {}
+  bool begin(uint32_t size) override;
+  bool write(const uint8_t *data, size_t len) override;
+  bool finish() override;
+  void abort() override;
+
+ private:
+  std::string path;
+  FILE *file = NULL;
+  uint32_t imageSize = 0;  // From begin()
+  uint32_t written = 0;
+};
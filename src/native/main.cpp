@@ -0,0 +1,653 @@
+/*
+    Host build of the tally core (pio run -e native)
+    Video Walrus 2025
+
+    Runs the firmware's TSL decoder and renderer against Linux sockets,
+    with the LED chain drawn in the terminal. Settings use the same keys
+    as the firmware's NVS namespace:
+
+      .pio/build/native/program [settings-file]
+
+    e.g. a settings file containing
+      tally.tslAddress=3
+      tally.tslMcast=239.1.2.3
+
+    tally.tslUdpPort and tally.tslTcpHost/tslTcpPort add the unicast and
+    TCP receivers; scripts/tsl_test_server.py stands in for a switcher or
+    aggregator on either.
+
+    "program --ota <http-url> <sha256> <out-file>" runs the firmware's
+    resumable OTA download against a plain-HTTP server, e.g.
+    scripts/ota_drop_server.py, writing the image to out-file.
+
+    "program --fleet-sim [devices]" simulates a fleet update (fleet_ota.h)
+    and compares it with pushing espota to each device in turn.
+
+    "program --relay-bench [subscribers]" runs a TSL relay (tsl_relay.h)
+    and its subscribers over loopback UDP.
+
+    Left out of unit test builds (pio test -e native), which bring their
+    own main().
+*/
+
+#ifndef PIO_UNIT_TESTING
+
+#include <arpa/inet.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "../device_table.h"
+#include "../fleet_ota.h"
+#include "../log_ring.h"
+#include "../ota_stream.h"
+#include "../tally_core.h"
+#include "../tsl_relay.h"
+#include "../tsl_stream.h"
+#include "hal_linux.h"
+
+#define NUM_LEDS 7
+#define BUFFER_LENGTH 1472
+#define UDP_SELECT_TIMEOUT_MS 100
+#define LOG_DRAIN_INTERVAL_MS 50
+#define BENCH_FRAMES 200000
+#define BENCH_REPEAT_HZ 50
+
+// Fleet update model. Rates are assumptions for ESP32-S3 tallies on a
+// switched LAN, not measurements; change them to match a site.
+#define SIM_IMAGE_BYTES 1400000
+#define SIM_WAN_BYTES_PER_S 200000     // Seed's TLS download from GitHub
+#define SIM_FLASH_BYTES_PER_S 400000   // OTA partition erase + write
+#define SIM_SERVE_BYTES_PER_S 1200000  // One tally serving, split between its streams
+#define SIM_SITE_BYTES_PER_S 2500000   // Site uplink, when every device goes to GitHub itself
+#define SIM_ESPOTA_BYTES_PER_S 100000  // espota waits for an ack per 1460-byte block
+#define SIM_ESPOTA_OVERHEAD_S 6        // Invitation, reboot and wait, per device
+#define SIM_CONNECT_MS 20
+#define SIM_STEP_MS 10
+#define SIM_DROPS_PER_HOUR 36          // Per stream
+#define SIM_LIMIT_S 600
+
+// Relay bench: a switcher resending all 127 addresses at BENCH_REPEAT_HZ
+// with a cut every RELAY_BENCH_CUT_MS, one subscriber losing a share of
+// what it receives
+#define RELAY_BENCH_PORT 19903  // Subscribers on the ports after it
+#define RELAY_BENCH_MAX_SUBSCRIBERS 32
+#define RELAY_BENCH_SECONDS 60
+#define RELAY_BENCH_CUT_MS 500
+#define RELAY_BENCH_LOSS_PERCENT 5
+#define RELAY_BENCH_CUES 20000
+
+// Stand-in for the firmware's task notification
+class Notifier {
+ public:
+  void give() {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending = true;
+    cv.notify_one();
+  }
+
+  void take(uint32_t timeoutMs) {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] { return pending; });
+    pending = false;
+  }
+
+ private:
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool pending = false;
+};
+
+// Simulated time, for replaying a packet stream faster than real time
+class BenchClock : public Clock {
+ public:
+  uint32_t millis() override { return now / 1000; }
+  uint32_t micros() override { return now; }
+  uint32_t now = 1;
+};
+
+// One subscribing tally on its own loopback port
+struct RelayBenchTally {
+  RelayBenchTally(Clock &clock, const FleetCodec &codec, uint16_t port)
+      : decoder(mailbox, clock), subscriber(socket, clock, codec) {
+    socket.begin(port);
+    subscriber.broadcastAddr = inet_addr("127.0.0.1");
+    subscriber.relayPort = RELAY_BENCH_PORT;
+    subscriber.metrics = &metrics;
+  }
+  TallyMailbox mailbox;
+  TslDecoder decoder;
+  UdpSocket socket;
+  TslRelaySubscriber subscriber;
+  TallyMetrics metrics;
+  uint32_t received = 0;
+  uint32_t bytes = 0;
+};
+
+// Read every queued datagram; lossPercent of them are thrown away unread
+static void relayBenchReceive(RelayBenchTally &t, int lossPercent, uint32_t &rng) {
+  static uint8_t buffer[BUFFER_LENGTH];
+  int len;
+  uint32_t fromAddr;
+  while ((len = t.socket.receive(buffer, sizeof(buffer), &fromAddr)) > 0) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    if ((int)(rng % 100) < lossPercent) continue;
+    bool ours;
+    t.received++;
+    t.bytes += len;
+    t.subscriber.handle(buffer, len, fromAddr, t.decoder, 0, ours);
+  }
+}
+
+static void relayBenchServe(TslRelay &relay, UdpSocket &socket, const TslDecoder &decoder) {
+  static uint8_t buffer[BUFFER_LENGTH];
+  int len;
+  uint32_t fromAddr;
+  uint16_t fromPort;
+  while ((len = socket.receive(buffer, sizeof(buffer), &fromAddr, &fromPort)) > 0) {
+    relay.handle(buffer, len, fromAddr, fromPort, decoder);
+  }
+  relay.service(decoder);
+}
+
+// Addresses whose control byte differs from the relay's
+static int relayBenchMismatches(const TslDecoder &relay, const TslDecoder &subscriber) {
+  int differ = 0;
+  for (int addr = 0; addr <= TSL_MAX_ADDRESS; addr++) {
+    if (relay.display(addr).control != subscriber.display(addr).control ||
+        strcmp(relay.display(addr).label, subscriber.display(addr).label) != 0) {
+      differ++;
+    }
+  }
+  return differ;
+}
+
+// A switcher's full resend of every address: TSL 3.1 messages packed
+// into datagrams of up to BUFFER_LENGTH
+static size_t relayBenchSwitcher(TslDecoder &decoder, const uint8_t *controls, uint32_t rxMicros) {
+  static uint8_t datagram[BUFFER_LENGTH];
+  const int perDatagram = BUFFER_LENGTH / TSL31_MESSAGE_LENGTH;
+  size_t bytes = 0;
+  for (int first = 0; first <= TSL_MAX_ADDRESS; first += perDatagram) {
+    int n = TSL_MAX_ADDRESS + 1 - first < perDatagram ? TSL_MAX_ADDRESS + 1 - first : perDatagram;
+    for (int i = 0; i < n; i++) {
+      uint8_t *message = datagram + i * TSL31_MESSAGE_LENGTH;
+      message[0] = 0x80 + first + i;
+      message[1] = 0x30 | controls[first + i];
+      snprintf((char *)message + 2, 17, "CAM %-12d", first + i);
+    }
+    decoder.decodeTsl31(datagram, n * TSL31_MESSAGE_LENGTH, rxMicros);
+    bytes += n * TSL31_MESSAGE_LENGTH;
+  }
+  return bytes;
+}
+
+// RELAY_BENCH_SECONDS of a switcher at BENCH_REPEAT_HZ on simulated time:
+// what each subscriber receives from the relay against what every
+// multicast listener receives from the switcher
+static void benchRelayAirtime(int numSubscribers, const FleetCodec &codec) {
+  BenchClock clock;
+  TallyMailbox mailbox;
+  TslDecoder decoder(mailbox, clock);
+  UdpSocket relaySocket;
+  if (!relaySocket.begin(RELAY_BENCH_PORT)) return;
+  TslRelay relay(relaySocket, clock, codec);
+  TallyMetrics relayMetrics;
+  relay.metrics = &relayMetrics;
+  relay.maxUnicast = RELAY_BENCH_MAX_SUBSCRIBERS;  // No broadcast between loopback ports
+  relay.begin(0x5eed);
+  static RelayBenchTally *tallies[RELAY_BENCH_MAX_SUBSCRIBERS];
+  for (int i = 0; i < numSubscribers; i++) tallies[i] = new RelayBenchTally(clock, codec, RELAY_BENCH_PORT + 1 + i);
+
+  uint8_t controls[TSL_MAX_ADDRESS + 1] = {};
+  int program = 1, preview = 2;
+  controls[program] = 0x02;
+  controls[preview] = 0x01;
+  uint32_t rng = 0x12345678;
+  uint64_t switcherBytes = 0;
+  uint32_t frames = RELAY_BENCH_SECONDS * BENCH_REPEAT_HZ;
+  uint32_t cuts = 0;
+  uint32_t lossyBehind = 0, lossyRun = 0, lossyLongest = 0;  // Frames the lossy subscriber was out of step
+  for (uint32_t frame = 0; frame < frames; frame++) {
+    clock.now = 1 + frame * (1000000 / BENCH_REPEAT_HZ);
+    if (frame % (RELAY_BENCH_CUT_MS * BENCH_REPEAT_HZ / 1000) == 0 && frame > 0) {
+      // Cut: preview to program, a new camera to preview
+      controls[program] = 0;
+      program = preview;
+      rng ^= rng << 13;
+      rng ^= rng >> 17;
+      rng ^= rng << 5;
+      preview = 1 + rng % 24;
+      if (preview == program) preview = preview % 24 + 1;
+      controls[program] = 0x02;
+      controls[preview] = 0x01;
+      cuts++;
+    }
+    switcherBytes += relayBenchSwitcher(decoder, controls, clock.now);
+    relayBenchServe(relay, relaySocket, decoder);
+    for (int i = 0; i < numSubscribers; i++) {
+      tallies[i]->subscriber.service();
+      relayBenchReceive(*tallies[i], i == 0 ? RELAY_BENCH_LOSS_PERCENT : 0, rng);
+    }
+    if (relayBenchMismatches(decoder, tallies[0]->decoder) > 0) {
+      lossyBehind++;
+      if (++lossyRun > lossyLongest) lossyLongest = lossyRun;
+    } else {
+      lossyRun = 0;
+    }
+  }
+  // One more keyframe, none lost, and everyone should be in step
+  clock.now += TSL_RELAY_KEYFRAME_MS * 1000;
+  relayBenchServe(relay, relaySocket, decoder);
+  int behind = 0;
+  for (int i = 0; i < numSubscribers; i++) {
+    relayBenchReceive(*tallies[i], 0, rng);
+    if (relayBenchMismatches(decoder, tallies[i]->decoder) > 0) behind++;
+  }
+
+  double seconds = RELAY_BENCH_SECONDS;
+  printf("Switcher: %d addresses at %d Hz, %u cuts in %d s: %.1f KB/s to every multicast listener\n",
+         TSL_MAX_ADDRESS + 1, BENCH_REPEAT_HZ, cuts, RELAY_BENCH_SECONDS, switcherBytes / seconds / 1000);
+  RelayBenchTally &clean = *tallies[numSubscribers > 1 ? 1 : 0];
+  printf("Relay to %d subscribers: %.2f KB/s and %.1f datagrams/s each (%.1f%% of the multicast bytes), %u keyframes\n",
+         numSubscribers, clean.bytes / seconds / 1000, clean.received / seconds,
+         clean.bytes * 100.0 / switcherBytes, (unsigned)relayMetrics.relayKeyframes.load());
+  printf("Subscriber losing %d%%: %u datagrams missed, out of step %u ms in all, %u ms at most\n",
+         RELAY_BENCH_LOSS_PERCENT, (unsigned)tallies[0]->metrics.relayGaps.load(),
+         lossyBehind * 1000 / BENCH_REPEAT_HZ, lossyLongest * 1000 / BENCH_REPEAT_HZ);
+  printf("After a last keyframe: %d of %d subscribers out of step\n", behind, numSubscribers);
+  for (int i = 0; i < numSubscribers; i++) delete tallies[i];
+}
+
+// RELAY_BENCH_CUES single-address changes as fast as the relay and its
+// subscribers take them, on the real clock: decode at the relay, delta
+// out, and applied by every subscriber
+static void benchRelayThroughput(int numSubscribers, const FleetCodec &codec) {
+  SteadyClock clock;
+  TallyMailbox mailbox;
+  TslDecoder decoder(mailbox, clock);
+  UdpSocket relaySocket;
+  if (!relaySocket.begin(RELAY_BENCH_PORT)) return;
+  TslRelay relay(relaySocket, clock, codec);
+  relay.maxUnicast = RELAY_BENCH_MAX_SUBSCRIBERS;
+  relay.begin(0x5eed + 1);
+  static RelayBenchTally *tallies[RELAY_BENCH_MAX_SUBSCRIBERS];
+  for (int i = 0; i < numSubscribers; i++) tallies[i] = new RelayBenchTally(clock, codec, RELAY_BENCH_PORT + 1 + i);
+  uint32_t rng = 0x9abcdef1;
+  for (int i = 0; i < numSubscribers; i++) tallies[i]->subscriber.service();
+  relayBenchServe(relay, relaySocket, decoder);
+  for (int i = 0; i < numSubscribers; i++) relayBenchReceive(*tallies[i], 0, rng);
+
+  uint8_t message[TSL31_MESSAGE_LENGTH] = { 0x80, 0x30, 'C', 'A', 'M' };
+  uint32_t start = clock.micros();
+  for (uint32_t cue = 0; cue < RELAY_BENCH_CUES; cue++) {
+    message[0] = 0x80 + cue % (TSL_MAX_ADDRESS + 1);
+    message[1] = 0x30 | ((cue / (TSL_MAX_ADDRESS + 1)) & 0x03);
+    decoder.decodeTsl31(message, sizeof(message), clock.micros());
+    relayBenchServe(relay, relaySocket, decoder);
+    for (int i = 0; i < numSubscribers; i++) relayBenchReceive(*tallies[i], 0, rng);
+  }
+  uint32_t elapsed = clock.micros() - start;
+  int behind = 0;
+  for (int i = 0; i < numSubscribers; i++) {
+    if (relayBenchMismatches(decoder, tallies[i]->decoder) > 0) behind++;
+  }
+  printf("Cue storm: %d changes to %d subscribers in %.0f ms, %.1f us per change end to end (%.0f changes/s), %d out of step\n",
+         RELAY_BENCH_CUES, numSubscribers, elapsed / 1000.0, (double)elapsed / RELAY_BENCH_CUES,
+         RELAY_BENCH_CUES * 1e6 / elapsed, behind);
+
+  // The per-pass change scan with nothing to send
+  start = clock.micros();
+  for (uint32_t i = 0; i < BENCH_FRAMES / 10; i++) relay.service(decoder);
+  elapsed = clock.micros() - start;
+  printf("Relay pass with nothing changed: %.2f us\n", elapsed * 10.0 / BENCH_FRAMES);
+  for (int i = 0; i < numSubscribers; i++) delete tallies[i];
+}
+
+static int runRelayBench(int numSubscribers) {
+  if (numSubscribers < 1 || numSubscribers > RELAY_BENCH_MAX_SUBSCRIBERS) {
+    fprintf(stderr, "Subscribers must be 1-%d\n", RELAY_BENCH_MAX_SUBSCRIBERS);
+    return 2;
+  }
+  FleetCodec codec;
+  codec.setKey("relay bench");
+  benchRelayAirtime(numSubscribers, codec);
+  benchRelayThroughput(numSubscribers, codec);
+  return 0;
+}
+
+struct SimPeer {
+  double bytes;
+  uint32_t source;      // Index of the tally we pull from, while connected
+  uint32_t lastIp;
+  uint32_t rng;
+  uint32_t retryAtMs;
+  uint32_t connectedAtMs;
+  uint32_t backoffMs;
+  uint32_t doneMs;
+  int stalls;
+  uint8_t hops;
+  bool connected;
+  bool announced;
+  bool failed;
+};
+
+struct SimResult {
+  double seconds;  // Until the last tally verified, or the limit
+  double seedSeconds;
+  int maxHops;
+  int failed;
+};
+
+// Bytes of tally i's image a peer can read: all but the sector the OTA
+// library is still buffering, as UpdateSink::readBack()
+static double simReadable(const SimPeer &p) {
+  if (p.bytes >= SIM_IMAGE_BYTES) return SIM_IMAGE_BYTES;
+  return p.bytes >= 1 ? floor((p.bytes - 1) / 4096) * 4096 : 0;
+}
+
+// One fleet update. Tally 0 is the seed (IP 1); peers choose sources with
+// the firmware's FleetOtaSources and retry as OtaDownload does.
+static SimResult simulateFleetUpdate(int devices, int maxStreams) {
+  static SimPeer peers[MAX_DISCOVERED_DEVICES];
+  static int streams[MAX_DISCOVERED_DEVICES];
+  static FleetOtaSources sources;
+  const uint32_t tag = 0x5eed;
+  sources.begin(tag);
+  sources.add(tag, 1, 0);
+  for (int i = 0; i < devices; i++) {
+    peers[i] = SimPeer{};
+    peers[i].rng = 2654435761u * (i + 1) | 1;
+    peers[i].hops = i == 0 ? 0 : FLEET_OTA_UNKNOWN_HOPS;
+    peers[i].backoffMs = FLEET_OTA_RETRY_MS;
+    streams[i] = 0;
+  }
+
+  double seedRate = SIM_WAN_BYTES_PER_S < SIM_FLASH_BYTES_PER_S ? SIM_WAN_BYTES_PER_S : SIM_FLASH_BYTES_PER_S;
+  double dt = SIM_STEP_MS / 1000.0;
+  int done = 0;
+  uint32_t now = 0;
+  SimResult result = {};
+  for (; done < devices && now < SIM_LIMIT_S * 1000; now += SIM_STEP_MS) {
+    SimPeer &seed = peers[0];
+    if (seed.bytes < SIM_IMAGE_BYTES) {
+      seed.bytes += seedRate * dt;
+      if (seed.bytes >= SIM_IMAGE_BYTES) {
+        seed.bytes = SIM_IMAGE_BYTES;
+        seed.doneMs = now;
+        done++;
+      }
+    }
+
+    for (int i = 1; i < devices; i++) {
+      SimPeer &p = peers[i];
+      if (p.failed || p.bytes >= SIM_IMAGE_BYTES) continue;
+      if (!p.connected) {
+        if ((int32_t)(now - p.retryAtMs) < 0) continue;
+        uint32_t ip = sources.pick(p.hops, p.lastIp, p.rng);
+        int src = (int)ip - 1;
+        if (ip == 0 || streams[src] >= maxStreams) {
+          // 503 (or no source yet): back off with jitter, as the firmware
+          p.lastIp = ip;
+          if (++p.stalls >= FLEET_OTA_MAX_STALLS) {
+            p.failed = true;
+            done++;
+            continue;
+          }
+          p.rng ^= p.rng << 13;
+          p.rng ^= p.rng >> 17;
+          p.rng ^= p.rng << 5;
+          p.retryAtMs = now + p.backoffMs + p.rng % p.backoffMs;
+          p.backoffMs = p.backoffMs * 2 < FLEET_OTA_MAX_RETRY_MS ? p.backoffMs * 2 : FLEET_OTA_MAX_RETRY_MS;
+          continue;
+        }
+        streams[src]++;
+        p.source = src;
+        p.lastIp = ip;
+        p.connected = true;
+        p.connectedAtMs = now + SIM_CONNECT_MS;
+        uint8_t hops = sources.hops(ip) + 1;
+        if (hops < p.hops) p.hops = hops;
+        continue;
+      }
+      if ((int32_t)(now - p.connectedAtMs) < 0) continue;
+
+      // Streaming: the slowest of our flash, the source's share and how
+      // far the source itself has got
+      SimPeer &src = peers[p.source];
+      double rate = SIM_SERVE_BYTES_PER_S / streams[p.source];
+      if (rate > SIM_FLASH_BYTES_PER_S) rate = SIM_FLASH_BYTES_PER_S;
+      double before = p.bytes;
+      double limit = simReadable(src);
+      p.bytes = p.bytes + rate * dt < limit ? p.bytes + rate * dt : (p.bytes > limit ? p.bytes : limit);
+      if (p.bytes > before) {
+        p.stalls = 0;
+        p.backoffMs = FLEET_OTA_RETRY_MS;
+      }
+      if (!p.announced && p.bytes > 0) {
+        sources.add(tag, i + 1, p.hops);  // FLEET_SOURCE reaches every tally
+        p.announced = true;
+      }
+      p.rng ^= p.rng << 13;
+      p.rng ^= p.rng >> 17;
+      p.rng ^= p.rng << 5;
+      bool dropped = p.rng % (3600 * 1000 / SIM_STEP_MS) < SIM_DROPS_PER_HOUR;
+      if (p.bytes >= SIM_IMAGE_BYTES || dropped) {
+        streams[p.source]--;
+        p.connected = false;
+        p.retryAtMs = now + p.backoffMs;
+      }
+      if (p.bytes >= SIM_IMAGE_BYTES) {
+        p.doneMs = now;
+        done++;
+      }
+    }
+  }
+
+  result.seconds = now / 1000.0;
+  result.seedSeconds = peers[0].doneMs / 1000.0;
+  for (int i = 0; i < devices; i++) {
+    if (peers[i].failed || peers[i].bytes < SIM_IMAGE_BYTES) result.failed++;
+    if (peers[i].hops != FLEET_OTA_UNKNOWN_HOPS && peers[i].hops > result.maxHops) result.maxHops = peers[i].hops;
+  }
+  return result;
+}
+
+static int runFleetSim(int devices) {
+  if (devices < 1 || devices > MAX_DISCOVERED_DEVICES) {
+    fprintf(stderr, "Fleet size must be 1-%d\n", MAX_DISCOVERED_DEVICES);
+    return 2;
+  }
+  double image = SIM_IMAGE_BYTES;
+  double one = image / (SIM_WAN_BYTES_PER_S < SIM_FLASH_BYTES_PER_S ? SIM_WAN_BYTES_PER_S : SIM_FLASH_BYTES_PER_S);
+  printf("Image %.0f KB; one download from GitHub %.1f s\n", image / 1000, one);
+  printf("espota to each in turn: %.0f s\n", devices * (image / SIM_ESPOTA_BYTES_PER_S + SIM_ESPOTA_OVERHEAD_S));
+  double shared = devices * image / SIM_SITE_BYTES_PER_S;
+  printf("Every device from GitHub at once: %.1f s (and %d API calls against a 60/hour limit)\n",
+         shared > one ? shared : one, devices);
+
+  for (int cap = 1; cap <= 4; cap++) {
+    SimResult r = simulateFleetUpdate(devices, cap);
+    printf("Fleet update, %d stream(s) per tally%s: %.1f s for %d devices (%.2fx one download), %d hops, %d failed\n",
+           cap, cap == FLEET_OTA_MAX_STREAMS ? " (firmware)" : "", r.seconds, devices, r.seconds / one, r.maxHops,
+           r.failed);
+  }
+  static const int sizes[] = { 10, 40, 80, 128 };
+  for (int n : sizes) {
+    SimResult r = simulateFleetUpdate(n, FLEET_OTA_MAX_STREAMS);
+    printf("  %3d devices: %.1f s, %d hops\n", n, r.seconds, r.maxHops);
+  }
+  return 0;
+}
+
+static void printOtaProgress(const OtaProgress &p) {
+  static OtaState lastState = OTA_IDLE;
+  static uint32_t lastPercent = 101;
+  uint32_t percent = p.total ? (uint64_t)p.bytes * 100 / p.total : 0;
+  if (p.state == lastState && percent / 10 == lastPercent / 10) return;
+  lastState = p.state;
+  lastPercent = percent;
+  printf("OTA %-11s %u/%u bytes (%u%%), %u requests, %u resumes, %u restarts\n", otaStateName(p.state), p.bytes,
+         p.total, percent, p.requests, p.resumes, p.restarts);
+}
+
+static int runOta(const char *url, const char *sha256hex, const char *outPath) {
+  uint8_t sha256[32];
+  SocketHttpSource source;
+  if (!source.setUrl(url) || !parseSha256(sha256hex, sha256)) {
+    fprintf(stderr, "Usage: program --ota http://host:port/firmware.bin <sha256> <out-file>\n");
+    return 2;
+  }
+  FileFirmwareSink sink(outPath);
+  static OtaDownload download(source, sink);
+  download.sleepMs = [](uint32_t ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); };
+  download.report = printOtaProgress;
+
+  SteadyClock clock;
+  bool ok = download.run(sha256);
+  eventLog.drain([](const char *line, size_t len) { fwrite(line, 1, len, stderr); });
+  const OtaProgress &p = download.progress();
+  printf("%s in %.1f s: %u bytes, %u requests, %u resumes, %u restarts%s%s\n", ok ? "Verified" : "Failed",
+         clock.millis() / 1000.0, p.bytes, p.requests, p.resumes, p.restarts, ok ? "" : ": ", p.error);
+  return ok ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+  if (argc > 1 && strcmp(argv[1], "--fleet-sim") == 0) return runFleetSim(argc > 2 ? atoi(argv[2]) : 80);
+  if (argc > 1 && strcmp(argv[1], "--relay-bench") == 0) return runRelayBench(argc > 2 ? atoi(argv[2]) : 4);
+  if (argc > 1 && strcmp(argv[1], "--ota") == 0) return argc == 5 ? runOta(argv[2], argv[3], argv[4]) : runOta("", "", "");
+
+  FileStore settings(argc > 1 ? argv[1] : "tally-settings.txt");
+  settings.begin("tally", true);
+  int tslAddress = settings.getInt("tslAddress", 0);
+  int maxBrightness = settings.getInt("maxBright", 50);
+  int tslPort = settings.getInt("tslPort", 8901);
+  int tslProtocol = settings.getInt("tslProto", TSL_PROTOCOL_V31);
+  char tslMulticast[32];
+  settings.getString("tslMcast", tslMulticast, sizeof(tslMulticast), "239.1.2.3");
+  bool tslMulticastOn = settings.getBool("tslMcastOn", true);
+  int tslUnicastPort = settings.getInt("tslUdpPort", 0);
+  char tslTcpHost[32];
+  settings.getString("tslTcpHost", tslTcpHost, sizeof(tslTcpHost), "");
+  int tslTcpPort = settings.getInt("tslTcpPort", 8900);
+  char ledRoles[COMPOSITOR_MAX_PIXELS + 1];
+  settings.getString("ledRoles", ledRoles, sizeof(ledRoles), "T");
+  static char tslRules[640];
+  settings.getString("tslRules", tslRules, sizeof(tslRules), "");
+  int restoreTimeoutS = settings.getInt("restoreS", 600);
+  settings.end();
+
+  TerminalLedSink ledSink(NUM_LEDS);
+  SteadyClock clock;
+  TallyMailbox mailbox;
+  TslDecoder decoder(mailbox, clock);
+  TallyRenderer renderer(ledSink, clock, mailbox);
+  decoder.address = tslAddress;
+  decoder.maxBrightness = maxBrightness;
+  renderer.maxBrightness = maxBrightness;
+  if (!renderer.setLayout(ledRoles)) fprintf(stderr, "Ignoring invalid LED roles \"%s\"\n", ledRoles);
+  static TallyRules rules;
+  if (!rules.parse(tslRules)) {
+    fprintf(stderr, "Ignoring invalid tally rules \"%s\"\n", tslRules);
+  } else if (rules.enabled()) {
+    decoder.rules = &rules;
+    renderer.rules = &rules;
+  }
+
+  // Last tally, as the firmware's NVS copy (no RTC memory on a host)
+  TallySaveSchedule saveSchedule;
+  SavedTally saved;
+  settings.begin("tallymem", true);
+  bool haveSaved = settings.getBytes("last", &saved, sizeof(saved)) == sizeof(saved) && savedTallyValid(saved);
+  settings.end();
+  if (haveSaved) saveSchedule.known(saved);
+  if (haveSaved && restoreTimeoutS > 0) {
+    decoder.restoreState(saved, (uint32_t)restoreTimeoutS * 1000);
+    printf("Restored tally %s, held %d s unless TSL confirms it\n",
+           tallyStateName(saved.control[tslAddress] & 0x0F), restoreTimeoutS);
+  }
+
+  // The firmware's three receivers, into the one decoder
+  UdpSocket multicastSocket, unicastSocket;
+  TcpSocket tcpSocket;
+  TslTcpClient tcp(tcpSocket, clock);
+  printf("TSL %s address %d\n", tslProtocol == TSL_PROTOCOL_V50 ? "5.0" : "3.1", tslAddress);
+  if (tslMulticastOn) {
+    if (!multicastSocket.beginMulticast(inet_addr(tslMulticast), tslPort)) return 1;
+    printf("Multicast %s:%d\n", tslMulticast, tslPort);
+  }
+  if (tslUnicastPort > 0 && !(tslMulticastOn && tslUnicastPort == tslPort)) {
+    if (!unicastSocket.begin(tslUnicastPort)) return 1;
+    printf("Unicast port %d\n", tslUnicastPort);
+  }
+  if (tslTcpHost[0] != '\0') {
+    tcp.begin(inet_addr(tslTcpHost), tslTcpPort, tslProtocol, (uint32_t)time(NULL));
+    printf("TCP server %s:%d\n", tslTcpHost, tslTcpPort);
+  }
+
+  // Render thread, as the firmware's render task
+  Notifier renderNotify;
+  std::thread renderThread([&] {
+    for (;;) {
+      renderNotify.take(renderer.animating() ? (renderer.frameDueInUs() + 999) / 1000 : UDP_SELECT_TIMEOUT_MS);
+      renderer.update();
+    }
+  });
+  renderThread.detach();
+
+  // Log thread, as the firmware's log task
+  std::thread logThread([] {
+    for (;;) {
+      eventLog.drain([](const char *line, size_t len) { fwrite(line, 1, len, stderr); });
+      std::this_thread::sleep_for(std::chrono::milliseconds(LOG_DRAIN_INTERVAL_MS));
+    }
+  });
+  logThread.detach();
+
+  // Receive loop, as the firmware's UDP task
+  static uint8_t buffer[BUFFER_LENGTH];
+  uint32_t savedVersion = decoder.stateVersion();
+  UdpSocket *datagramSockets[] = { &multicastSocket, &unicastSocket };
+  Socket *sockets[] = { &multicastSocket, &unicastSocket, tcp.waitSocket() };
+  for (;;) {
+    tcp.service(true);
+    bool listening = false;
+    for (Socket *socket : sockets) listening |= socket->isOpen();
+    if (!listening) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(UDP_SELECT_TIMEOUT_MS));
+    } else if (Socket::wait(sockets, sizeof(sockets) / sizeof(sockets[0]), UDP_SELECT_TIMEOUT_MS)) {
+      for (UdpSocket *socket : datagramSockets) {
+        int len;
+        while ((len = socket->receive(buffer, sizeof(buffer))) > 0) {
+          uint32_t rxMicros = clock.micros();
+          bool ours = tslProtocol == TSL_PROTOCOL_V50 ? decoder.decodeTsl5(buffer, len, rxMicros)
+                                                       : decoder.decodeTsl31(buffer, len, rxMicros);
+          if (ours) renderNotify.give();
+        }
+      }
+      bool ours;
+      tcp.receive(decoder, clock.micros(), ours);
+      if (ours) renderNotify.give();
+    }
+
+    if (decoder.expire()) renderNotify.give();
+    if (decoder.stateVersion() != savedVersion) {
+      savedVersion = decoder.stateVersion();
+      decoder.saveState(saved, (uint32_t)time(NULL));
+    }
+    if (savedTallyValid(saved) && saveSchedule.due(saved, clock.millis())) {
+      settings.begin("tallymem", false);
+      settings.putBytes("last", &saved, sizeof(saved));
+      settings.end();
+      saveSchedule.written(saved, clock.millis());
+    }
+  }
+}
+
+#endif  // PIO_UNIT_TESTING
@@ -0,0 +1,280 @@
+/*
+    Resumable, verified firmware download
+    Video Walrus 2025
+*/
+
+#include "ota_stream.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "log_ring.h"
+
+// ---------------------------------------------------------------------------
+// SHA-256 (FIPS 180-4)
+// ---------------------------------------------------------------------------
+
+static const uint32_t sha256K[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static inline uint32_t ror32(uint32_t x, int n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+void Sha256::reset() {
+  static const uint32_t init[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+  };
+  memcpy(h, init, sizeof(h));
+  bufLen = 0;
+  totalLen = 0;
+}
+
+void Sha256::block(const uint8_t *p) {
+  uint32_t w[64];
+  for (int i = 0; i < 16; i++) {
+    w[i] = ((uint32_t)p[4 * i] << 24) | ((uint32_t)p[4 * i + 1] << 16) | ((uint32_t)p[4 * i + 2] << 8) | p[4 * i + 3];
+  }
+  for (int i = 16; i < 64; i++) {
+    uint32_t s0 = ror32(w[i - 15], 7) ^ ror32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    uint32_t s1 = ror32(w[i - 2], 17) ^ ror32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4], f = h[5], g = h[6], hh = h[7];
+  for (int i = 0; i < 64; i++) {
+    uint32_t t1 = hh + (ror32(e, 6) ^ ror32(e, 11) ^ ror32(e, 25)) + ((e & f) ^ (~e & g)) + sha256K[i] + w[i];
+    uint32_t t2 = (ror32(a, 2) ^ ror32(a, 13) ^ ror32(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+    hh = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+  h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+  h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+}
+
+void Sha256::update(const uint8_t *data, size_t len) {
+  totalLen += len;
+  if (bufLen > 0) {
+    size_t take = len < 64 - bufLen ? len : 64 - bufLen;
+    memcpy(buf + bufLen, data, take);
+    bufLen += take;
+    data += take;
+    len -= take;
+    if (bufLen < 64) return;
+    block(buf);
+    bufLen = 0;
+  }
+  for (; len >= 64; data += 64, len -= 64) block(data);
+  memcpy(buf, data, len);
+  bufLen = len;
+}
+
+void Sha256::finish(uint8_t digest[32]) {
+  uint64_t bits = totalLen * 8;
+  uint8_t pad[72] = { 0x80 };
+  size_t padLen = (bufLen < 56 ? 56 : 120) - bufLen;
+  for (int i = 0; i < 8; i++) pad[padLen + i] = bits >> (56 - 8 * i);
+  update(pad, padLen + 8);
+  for (int i = 0; i < 8; i++) {
+    digest[4 * i] = h[i] >> 24;
+    digest[4 * i + 1] = h[i] >> 16;
+    digest[4 * i + 2] = h[i] >> 8;
+    digest[4 * i + 3] = h[i];
+  }
+}
+
+static int hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+bool parseSha256(const char *hex, uint8_t digest[32]) {
+  for (int i = 0; i < 32; i++) {
+    int hi = hexValue(hex[2 * i]);
+    int lo = hi < 0 ? -1 : hexValue(hex[2 * i + 1]);
+    if (lo < 0) return false;
+    digest[i] = (hi << 4) | lo;
+  }
+  return hexValue(hex[64]) < 0;  // Exactly 64 digits
+}
+
+bool parseContentRange(const char *value, uint32_t *first, uint32_t *total) {
+  unsigned long a, b, t;
+  if (sscanf(value, "bytes %lu-%lu/%lu", &a, &b, &t) != 3) return false;
+  if (a > b || b >= t) return false;
+  *first = a;
+  *total = t;
+  return true;
+}
+
+// ---------------------------------------------------------------------------
+// Download
+// ---------------------------------------------------------------------------
+
+const char *otaStateName(OtaState state) {
+  switch (state) {
+    case OTA_DOWNLOADING: return "downloading";
+    case OTA_RETRYING: return "retrying";
+    case OTA_VERIFYING: return "verifying";
+    case OTA_DONE: return "done";
+    case OTA_FAILED: return "failed";
+    default: return "idle";
+  }
+}
+
+void OtaDownload::setState(OtaState s) {
+  state.state = s;
+  if (report) report(state);
+}
+
+void OtaDownload::fail(const char *error) {
+  snprintf(state.error, sizeof(state.error), "%s", error);
+  LOG_INFO_STR("[OTA] %s", state.error);
+}
+
+// Throw away what has been written and start the image again
+void OtaDownload::restart() {
+  if (begun) sink.abort();
+  begun = false;
+  hash.reset();
+  state.bytes = 0;
+  state.restarts++;
+}
+
+// One request: continue the image from state.bytes until it is complete
+// or the connection drops
+OtaDownload::Attempt OtaDownload::attempt() {
+  char contentRange[64] = "";
+  int32_t length = -1;
+  uint32_t offset = state.bytes;
+  state.requests++;
+  int status = source.open(offset, contentRange, sizeof(contentRange), &length);
+
+  uint32_t first = 0, total = 0;
+  if (status == 206 && parseContentRange(contentRange, &first, &total) && first == offset &&
+      (!begun || total == state.total)) {
+    if (offset > 0) state.resumes++;
+  } else if (status == 200 && length > 0) {
+    if (offset > 0) restart();  // Range ignored
+    total = length;
+  } else {
+    source.close();
+    char error[48];
+    if (status < 0) snprintf(error, sizeof(error), "Connection failed");
+    else if (status == 206) snprintf(error, sizeof(error), "Unexpected range \"%.20s\"", contentRange);
+    else snprintf(error, sizeof(error), "HTTP %d", status);
+    fail(error);
+    // A range we can't continue from starts the image again; other client
+    // errors won't fix themselves
+    if (status == 206 || status == 416) restart();
+    else if (status >= 400 && status < 500) return ATTEMPT_FATAL;
+    return ATTEMPT_DROPPED;
+  }
+
+  if (!begun) {
+    if (!sink.begin(total)) {
+      source.close();
+      fail("Image does not fit the OTA partition");
+      return ATTEMPT_FATAL;
+    }
+    begun = true;
+    state.total = total;
+  }
+
+  setState(OTA_DOWNLOADING);
+  while (state.bytes < state.total) {
+    uint32_t want = state.total - state.bytes;
+    int n = source.read(chunk, want < sizeof(chunk) ? want : sizeof(chunk));
+    if (n <= 0) {
+      source.close();
+      fail("Connection dropped");
+      return ATTEMPT_DROPPED;
+    }
+    if (!sink.write(chunk, n)) {
+      source.close();
+      fail("Flash write failed");
+      return ATTEMPT_FATAL;
+    }
+    hash.update(chunk, n);
+    state.bytes += n;
+    if (report) report(state);
+  }
+  source.close();
+  return ATTEMPT_COMPLETE;
+}
+
+bool OtaDownload::run(const uint8_t sha256[32]) {
+  if (begun) sink.abort();
+  begun = false;
+  hash.reset();
+  state = {};
+  setState(OTA_DOWNLOADING);
+
+  int stalls = 0;
+  uint32_t backoffMs = retryMs;
+  for (;;) {
+    uint32_t before = state.bytes;
+    Attempt result = attempt();
+    if (result == ATTEMPT_COMPLETE) break;
+    if (result == ATTEMPT_FATAL) {
+      if (begun) sink.abort();
+      begun = false;
+      setState(OTA_FAILED);
+      return false;
+    }
+
+    // A drop after progress starts the backoff again
+    if (state.bytes > before) {
+      stalls = 0;
+      backoffMs = retryMs;
+    }
+    if (++stalls >= maxStalls) {
+      fail("Gave up: no progress");
+      if (begun) sink.abort();
+      begun = false;
+      setState(OTA_FAILED);
+      return false;
+    }
+    LOG_INFO("[OTA] Retrying at byte %u in %u ms", state.bytes, backoffMs);
+    setState(OTA_RETRYING);
+    if (sleepMs) sleepMs(backoffMs);
+    backoffMs = backoffMs * 2 < maxRetryMs ? backoffMs * 2 : maxRetryMs;
+  }
+
+  setState(OTA_VERIFYING);
+  uint8_t digest[32];
+  hash.finish(digest);
+  if (memcmp(digest, sha256, sizeof(digest)) != 0) {
+    fail("SHA-256 mismatch");
+    sink.abort();
+    begun = false;
+    setState(OTA_FAILED);
+    return false;
+  }
+  begun = false;
+  if (!sink.finish()) {
+    fail("Could not finalise the image");
+    setState(OTA_FAILED);
+    return false;
+  }
+  state.error[0] = '\0';
+  setState(OTA_DONE);
+  return true;
+}
@@ -0,0 +1,101 @@
+/*
+    Resumable, verified firmware download
+    Video Walrus 2025
+
+    Streams a firmware image from an HttpSource into a FirmwareSink in
+    OTA_CHUNK_SIZE pieces. When the connection drops it reconnects with a
+    Range request and carries on from the last byte written, so a flaky
+    link costs a reconnect rather than the whole download. A server that
+    ignores the Range header restarts the image from zero.
+
+    Every byte is hashed as it is written, and the sink is only finished
+    (the new image marked bootable) if the SHA-256 matches the one
+    published with the release. Hardware-free, like the tally core.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hal.h"
+
+#define OTA_CHUNK_SIZE 4096
+#define OTA_MAX_STALLS 8          // Attempts in a row that add no bytes
+#define OTA_RETRY_MS 500          // First backoff; doubles each stalled attempt
+#define OTA_MAX_RETRY_MS 8000
+
+class Sha256 {
+ public:
+  Sha256() { reset(); }
+  void reset();
+  void update(const uint8_t *data, size_t len);
+  void finish(uint8_t digest[32]);
+
+ private:
+  void block(const uint8_t *p);
+
+  uint32_t h[8];
+  uint8_t buf[64];
+  size_t bufLen;
+  uint64_t totalLen;
+};
+
+// 64 hex digits (either case) to 32 bytes
+bool parseSha256(const char *hex, uint8_t digest[32]);
+// "bytes 1000-1999/5000": first byte and total size
+bool parseContentRange(const char *value, uint32_t *first, uint32_t *total);
+
+enum OtaState : uint8_t {
+  OTA_IDLE,
+  OTA_DOWNLOADING,
+  OTA_RETRYING,   // Waiting to reconnect after a drop
+  OTA_VERIFYING,
+  OTA_DONE,       // Verified and finished; reboot to run it
+  OTA_FAILED,
+};
+
+const char *otaStateName(OtaState state);
+
+struct OtaProgress {
+  OtaState state;
+  uint32_t bytes;     // Written and hashed so far
+  uint32_t total;     // Image size, 0 until the first response
+  uint16_t requests;  // HTTP requests made
+  uint16_t resumes;   // Range requests that continued the image
+  uint16_t restarts;  // Times the image started over from zero
+  char error[48];     // Last failure, "" if none
+};
+
+class OtaDownload {
+ public:
+  OtaDownload(HttpSource &source, FirmwareSink &sink) : source(source), sink(sink) {}
+
+  void (*sleepMs)(uint32_t ms) = NULL;          // Backoff between attempts
+  void (*report)(const OtaProgress &) = NULL;   // After every chunk and state change
+
+  // Retry policy; a fleet peer that can try another source retries
+  // sooner and for longer (fleet_ota.h)
+  uint32_t retryMs = OTA_RETRY_MS;
+  uint32_t maxRetryMs = OTA_MAX_RETRY_MS;
+  int maxStalls = OTA_MAX_STALLS;
+
+  // Download, verify and finish the image; false with progress().error
+  // set if it could not
+  bool run(const uint8_t sha256[32]);
+  const OtaProgress &progress() const { return state; }
+
+ private:
+  enum Attempt { ATTEMPT_COMPLETE, ATTEMPT_DROPPED, ATTEMPT_FATAL };
+  Attempt attempt();
+  void setState(OtaState s);
+  void fail(const char *error);
+  void restart();
+
+  HttpSource &source;
+  FirmwareSink &sink;
+  Sha256 hash;
+  OtaProgress state = {};
+  bool begun = false;
+  uint8_t chunk[OTA_CHUNK_SIZE];
+};
@@ -0,0 +1,45 @@
+/*
+    Cap on concurrent HTTP requests
+    Video Walrus 2025
+
+    Each admitted request holds a slot until the web server reports it
+    disconnected. The server keeps a single disconnect callback per
+    request and a second onDisconnect() replaces the first, so a handler
+    that needs its own goes through watch() as well: its hook runs, then
+    the slot goes back. Hardware-free, like the tally core; the request
+    type only needs onDisconnect(callback).
+*/
+
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+
+class RequestLimit {
+ public:
+  explicit RequestLimit(int maxActive) : maxActive(maxActive) {}
+
+  // Take a slot; false if all are in use. An admitted request must be
+  // watch()ed so the slot comes back.
+  bool admit() {
+    if (activeCount >= maxActive) return false;
+    activeCount++;
+    return true;
+  }
+
+  // Release the request's slot when it disconnects, after hook (if any).
+  // The latest watch() on a request is the one that counts.
+  template <typename Request>
+  void watch(Request *request, void (*hook)() = NULL) {
+    request->onDisconnect([this, hook]() {
+      if (hook != NULL) hook();
+      activeCount--;
+    });
+  }
+
+  int active() const { return activeCount; }
+
+ private:
+  const int maxActive;
+  std::atomic<int> activeCount{0};
+};
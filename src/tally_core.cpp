@@ -0,0 +1,610 @@
+/*
+    Tally core: TSL decoding, state handoff and LED rendering
+    Video Walrus 2025
+*/
+
+#include "tally_core.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "log_ring.h"
+
+const char *tallyStateName(uint8_t state) {
+  switch (state) {
+    case 1: return "Green";
+    case 2: return "Red";
+    case 3: return "Yellow";
+    default: return "Off";
+  }
+}
+
+// ---------------------------------------------------------------------------
+// Tally rules
+// ---------------------------------------------------------------------------
+
+// One "address:tally:colour:roles[:priority]" entry; returns the end of
+// it, or NULL if malformed
+static const char *parseRule(const char *p, TallyRule &rule) {
+  char *end;
+  long addr = strtol(p, &end, 10);
+  if (end == p || *end != ':' || addr < 0 || addr > TSL_MAX_ADDRESS) return NULL;
+  p = end + 1;
+  long tally = strtol(p, &end, 10);
+  if (end == p || *end != ':' || tally < 1 || tally > 4) return NULL;
+  p = end + 1;
+
+  if (p[0] == 'R' && p[1] == ':') rule.color = Rgb{ 255, 0, 0 };
+  else if (p[0] == 'G' && p[1] == ':') rule.color = Rgb{ 0, 128, 0 };
+  else if (p[0] == 'Y' && p[1] == ':') rule.color = Rgb{ 255, 255, 0 };
+  else {
+    unsigned long code = strtoul(p, &end, 16);
+    if (end - p != 6 || *end != ':') return NULL;
+    rule.color = rgbFromCode(code);
+    p = end - 1;
+  }
+  p += 2;  // Colour and ':'
+
+  rule.roleMask = 0;
+  for (; *p && *p != ':' && *p != ','; p++) {
+    if (*p == 'T') rule.roleMask |= 1 << ROLE_TALLY;
+    else if (*p == 'P') rule.roleMask |= 1 << ROLE_PROGRAM;
+    else if (*p == 'V') rule.roleMask |= 1 << ROLE_PREVIEW;
+    else return NULL;
+  }
+  if (rule.roleMask == 0) return NULL;
+
+  rule.priority = 0;
+  if (*p == ':') {
+    long priority = strtol(p + 1, &end, 10);
+    if (end == p + 1 || priority < 0 || priority > 255) return NULL;
+    rule.priority = priority;
+    p = end;
+  }
+  if (*p != ',' && *p != '\0') return NULL;
+  rule.address = addr;
+  rule.bit = tally - 1;
+  return p;
+}
+
+bool TallyRules::parse(const char *spec) {
+  TallyRule parsed[MAX_TALLY_RULES];
+  size_t n = 0;
+  for (const char *p = spec; *p;) {
+    if (*p == ',' || *p == ' ') {
+      p++;
+      continue;
+    }
+    if (n == MAX_TALLY_RULES) return false;
+    TallyRule rule;
+    p = parseRule(p, rule);
+    if (p == NULL) return false;
+    // Insert in ascending priority, after any equal ones, so a higher
+    // bit always means a stronger rule
+    size_t i = n++;
+    for (; i > 0 && parsed[i - 1].priority > rule.priority; i--) parsed[i] = parsed[i - 1];
+    parsed[i] = rule;
+  }
+
+  numRules = n;
+  memcpy(rules, parsed, n * sizeof(TallyRule));
+  memset(bitRules, 0, sizeof(bitRules));
+  memset(addrRules, 0, sizeof(addrRules));
+  memset(roleRules, 0, sizeof(roleRules));
+  for (size_t i = 0; i < n; i++) {
+    uint32_t bit = 1u << i;
+    bitRules[rules[i].address][rules[i].bit] |= bit;
+    addrRules[rules[i].address] |= bit;
+    for (int role = 0; role < NUM_PIXEL_ROLES; role++) {
+      if (rules[i].roleMask & (1 << role)) roleRules[role] |= bit;
+    }
+  }
+  return true;
+}
+
+void TallyRules::roleColors(uint32_t active, Rgb *colors) const {
+  for (int role = 0; role < NUM_PIXEL_ROLES; role++) {
+    uint32_t lit = active & roleRules[role];
+    colors[role] = lit ? rules[31 - __builtin_clz(lit)].color : Rgb{ 0, 0, 0 };  // Highest bit wins
+  }
+}
+
+// ---------------------------------------------------------------------------
+// TSL decoding
+// ---------------------------------------------------------------------------
+
+static inline uint16_t readLE16(const uint8_t *p) {
+  return p[0] | (p[1] << 8);
+}
+
+// Copy a wire label into a display slot: printable ASCII only, at most 16
+// characters, trailing spaces trimmed. UTF-16LE characters outside ASCII
+// become '?'.
+static void setDisplayLabel(TslDisplay &display, const uint8_t *text, int len, bool utf16) {
+  int stride = utf16 ? 2 : 1;
+  int textLen = 0;
+  for (int j = 0; j + stride <= len && textLen < 16; j += stride) {
+    uint16_t c = utf16 ? (text[j] | (text[j + 1] << 8)) : text[j];
+    if (c == 0) break;  // Stop at null terminator
+    if (c >= 32 && c < 127) display.label[textLen++] = c;  // Only printable ASCII
+    else if (c >= 128 && utf16) display.label[textLen++] = '?';
+  }
+  while (textLen > 0 && display.label[textLen - 1] == ' ') textLen--;  // Remove trailing spaces
+  display.label[textLen] = '\0';
+}
+
+// ---------------------------------------------------------------------------
+// Saved state
+// ---------------------------------------------------------------------------
+
+uint32_t savedTallyChecksum(const SavedTally &saved) {
+  const uint8_t *p = (const uint8_t *)&saved;
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < offsetof(SavedTally, checksum); i++) hash = (hash ^ p[i]) * 16777619u;
+  return hash;
+}
+
+// Same tally state, whenever it was saved
+bool TallySaveSchedule::sameAsWritten(const SavedTally &state) const {
+  return haveLast && state.address == last.address && memcmp(state.control, last.control, sizeof(state.control)) == 0 &&
+         strcmp(state.label, last.label) == 0;
+}
+
+bool TallySaveSchedule::due(const SavedTally &state, uint32_t nowMs) {
+  if (sameAsWritten(state)) return false;
+  if (state.checksum != pendingChecksum) {
+    pendingChecksum = state.checksum;  // Another change: settle again
+    changedMs = nowMs;
+    return false;
+  }
+  if (nowMs - changedMs < TALLY_SAVE_SETTLE_MS) return false;
+  return !wroteOnce || nowMs - lastWriteMs >= TALLY_SAVE_INTERVAL_MS;
+}
+
+void TallySaveSchedule::written(const SavedTally &state, uint32_t nowMs) {
+  known(state);
+  lastWriteMs = nowMs;
+  wroteOnce = true;
+}
+
+void TallySaveSchedule::known(const SavedTally &state) {
+  last = state;
+  haveLast = true;
+}
+
+// Convert a TSL 5.0 DMSG control word to a TSL 3.1 style control byte.
+// Any lamp (RH, text, LH) that is red sets program, green sets preview,
+// amber sets both; brightness moves from bits 6-7 to bits 4-5.
+static uint8_t tsl5ControlByte(uint16_t control) {
+  static const uint8_t lampBits[4] = { 0b00, 0b10, 0b01, 0b11 };  // Off, Red, Green, Amber
+  uint8_t tally = lampBits[control & 0x03] | lampBits[(control >> 2) & 0x03] | lampBits[(control >> 4) & 0x03];
+  return tally | (((control >> 6) & 0x03) << 4);
+}
+
+// Hand the state of our TSL address to the render stage
+void TslDecoder::publish(uint32_t rxMicros) {
+  const TslDisplay &display = displays[address];
+  TallySnapshot snap;
+  snap.state = display.control & 0b00001111;
+  snap.rules = activeRules;
+  snap.rxMicros = rxMicros;
+  snap.decodedMicros = clock.micros();
+  int bright = (display.control & 0b00110000) >> 4;
+  snap.brightness = bright * maxBrightness / 3;
+  memcpy(snap.text, display.label, sizeof(snap.text));
+  mailbox.publish(snap);
+
+  LOG_DEBUG_STR("[TSL] Text: %s, Brightness: %u", snap.text, snap.brightness);
+}
+
+// Refresh the lit rules for addr's new control byte. Rules belong to
+// exactly one address, so its bits can be replaced in place. True if any
+// rule watches addr.
+bool TslDecoder::updateRules(int addr) {
+  if (rules == NULL) return false;
+  uint32_t mask = rules->addressRules(addr);
+  activeRules = (activeRules & ~mask) | rules->lit(addr, displays[addr].control);
+  return mask != 0;
+}
+
+// Store one address's state, bumping the version if the control byte or
+// (for our address) the label changed
+void TslDecoder::setDisplay(int addr, uint8_t control, const uint8_t *text, int len, bool utf16) {
+  TslDisplay &display = displays[addr];
+  if (display.control != control) version++;
+  display.control = control;
+  if (addr != address) {
+    setDisplayLabel(display, text, len, utf16);
+    return;
+  }
+  char before[sizeof(display.label)];
+  memcpy(before, display.label, sizeof(before));
+  setDisplayLabel(display, text, len, utf16);
+  if (strcmp(before, display.label) != 0) version++;
+}
+
+// A well-formed datagram: the switcher is there, so a restored state is
+// as good as a fresh one
+void TslDecoder::heard() {
+  lastHeardMs = clock.millis();
+  holdMs = 0;
+}
+
+void TslDecoder::saveState(SavedTally &out, uint32_t savedAtS) const {
+  out.magic = SAVED_TALLY_MAGIC;
+  out.savedAtS = savedAtS;
+  out.address = address;
+  for (int addr = 0; addr <= TSL_MAX_ADDRESS; addr++) out.control[addr] = displays[addr].control;
+  memcpy(out.label, displays[address].label, sizeof(out.label));
+  memset(out.reserved, 0, sizeof(out.reserved));
+  out.checksum = savedTallyChecksum(out);
+}
+
+void TslDecoder::restoreState(const SavedTally &saved, uint32_t hold) {
+  activeRules = 0;
+  for (int addr = 0; addr <= TSL_MAX_ADDRESS; addr++) {
+    displays[addr].control = saved.control[addr] & 0b00111111;
+    displays[addr].label[0] = '\0';
+    updateRules(addr);
+  }
+  if (saved.address == address) {
+    memcpy(displays[address].label, saved.label, sizeof(saved.label));
+    displays[address].label[sizeof(saved.label) - 1] = '\0';
+  }
+  restoredMs = clock.millis();
+  holdMs = hold;
+  version++;
+  publish(clock.micros());
+}
+
+bool TslDecoder::expire() {
+  if (holdMs == 0 || clock.millis() - restoredMs < holdMs) return false;
+  LOG_INFO("[TSL] No TSL for %u s: restored tally cleared", holdMs / 1000);
+  holdMs = 0;
+  activeRules = 0;
+  for (int addr = 0; addr <= TSL_MAX_ADDRESS; addr++) {
+    displays[addr].control = 0;
+    displays[addr].label[0] = '\0';
+  }
+  version++;
+  publish(clock.micros());
+  return true;
+}
+
+void TslDecoder::countDatagram(bool ours, bool malformed) {
+  if (metrics == NULL) return;
+  if (ours) TallyMetrics::increment(metrics->packetsForUs);
+  if (malformed) TallyMetrics::increment(metrics->packetsMalformed);
+}
+
+// Decode every TSL 3.1 message in a datagram. Switchers pack several
+// 18-byte displays into one packet; a short final message is accepted with
+// whatever label bytes it carries.
+bool TslDecoder::decodeTsl31(const uint8_t *data, int len, uint32_t rxMicros) {
+  bool ours = false;
+  bool heardAny = false;
+  bool malformed = len % TSL31_MESSAGE_LENGTH == 1;  // A lone trailing header byte
+
+  for (int offset = 0; len - offset >= 2; offset += TSL31_MESSAGE_LENGTH) {
+    const uint8_t *message = data + offset;
+    int messageLen = len - offset < TSL31_MESSAGE_LENGTH ? len - offset : TSL31_MESSAGE_LENGTH;
+
+    // Header byte is address + 128
+    if (message[0] < 0x80 || message[0] - 0x80 > TSL_MAX_ADDRESS) {
+      malformed = true;
+      continue;
+    }
+    int addr = message[0] - 0x80;
+
+    setDisplay(addr, message[1] & 0b00111111, message + 2, messageLen - 2, false);
+    heardAny = true;
+
+    bool watched = updateRules(addr);
+    if (addr == address || watched) ours = true;
+  }
+
+  if (heardAny) heard();
+  if (ours) publish(rxMicros);
+  countDatagram(ours, malformed);
+  return ours;
+}
+
+// Decode TSL 5.0 packets in a datagram. Walks every packet (by PBC) and
+// every DMSG in one pass, reading straight out of the receive buffer.
+// Packets come unframed: TCP's DLE/STX is taken off by TslStreamDeframer.
+bool TslDecoder::decodeTsl5(const uint8_t *data, int len, uint32_t rxMicros) {
+  bool ours = false;
+  bool heardAny = false;
+  bool malformed = false;
+  const uint8_t *packet = data;
+  const uint8_t *end = data + len;
+
+  while (end - packet >= TSL5_HEADER_LENGTH) {
+    if (readLE16(packet) > end - packet - 2) {
+      malformed = true;  // Truncated packet
+      break;
+    }
+    const uint8_t *packetEnd = packet + 2 + readLE16(packet);
+    uint8_t flags = packet[3];
+    heardAny = true;
+    bool utf16 = flags & TSL5_FLAG_UNICODE;
+
+    const uint8_t *p = packet + TSL5_HEADER_LENGTH;
+    while (!(flags & TSL5_FLAG_SCONTROL) && packetEnd - p >= TSL5_DMSG_HEADER_LENGTH) {
+      uint16_t index = readLE16(p);
+      uint16_t control = readLE16(p + 2);
+      uint16_t textLen = readLE16(p + 4);
+      const uint8_t *text = p + TSL5_DMSG_HEADER_LENGTH;
+      if (textLen > packetEnd - text) {
+        malformed = true;  // DMSG runs past the packet
+        break;
+      }
+      p = text + textLen;
+      if (control & TSL5_CONTROL_DATA) continue;
+
+      int first = index, last = index;
+      if (index == TSL5_BROADCAST) {
+        first = 0;
+        last = TSL_MAX_ADDRESS;
+      } else if (index > TSL_MAX_ADDRESS) {
+        continue;
+      }
+      for (int addr = first; addr <= last; addr++) {
+        setDisplay(addr, tsl5ControlByte(control), text, textLen, utf16);
+        if (updateRules(addr)) ours = true;
+      }
+      if (address >= first && address <= last) ours = true;
+    }
+    if (!(flags & TSL5_FLAG_SCONTROL) && p != packetEnd) malformed = true;  // Partial DMSG
+    packet = packetEnd;
+  }
+  if (packet != end) malformed = true;  // Trailing bytes
+
+  if (heardAny) heard();
+  if (ours) publish(rxMicros);
+  countDatagram(ours, malformed);
+  return ours;
+}
+
+// Decode the entries of a relay datagram. The relay has already decoded
+// the switcher's TSL; each entry is one address's control byte and label
+// as it keeps them.
+bool TslDecoder::decodeRelay(const uint8_t *data, int len, uint32_t rxMicros) {
+  bool ours = false;
+  bool heardAny = false;
+  bool malformed = false;
+
+  for (int offset = 0; offset < len;) {
+    if (len - offset < 3 || data[offset + 2] > 16 || data[offset + 2] > len - offset - 3) {
+      malformed = true;  // Truncated entry
+      break;
+    }
+    int addr = data[offset];
+    uint8_t control = data[offset + 1];
+    int labelLen = data[offset + 2];
+    const uint8_t *label = data + offset + 3;
+    offset += 3 + labelLen;
+    if (addr > TSL_MAX_ADDRESS) {
+      malformed = true;
+      continue;
+    }
+
+    setDisplay(addr, control & 0b00111111, label, labelLen, false);
+    heardAny = true;
+    if (updateRules(addr) || addr == address) ours = true;
+  }
+
+  if (heardAny) heard();
+  if (ours) publish(rxMicros);
+  countDatagram(ours, malformed);
+  return ours;
+}
+
+// ---------------------------------------------------------------------------
+// Rendering
+// ---------------------------------------------------------------------------
+
+// Composite the current layers and send the frame if any pixel changed.
+// Brightness is already applied by the compositor's scale tables. A
+// changed frame inside the minimum show interval stays pending; update()
+// sends it once the interval is over (frameDueInUs() covers the wait).
+void TallyRenderer::showFrame() {
+  if (compositor.pixelCount() != sink.size()) compositor.setPixelCount(sink.size());  // Outputs set up after construction
+  uint32_t start = clock.micros();
+  bool changed = compositor.render(clock.millis(), frame);
+  if (!changed && !framePending) {
+    // Same pixels as on the LEDs already; a tally resend lands here
+    if (metrics) TallyMetrics::increment(metrics->framesSuppressed);
+    cuePending = false;
+    return;
+  }
+  if (shownOnce && start - lastShowUs < RENDER_MIN_SHOW_INTERVAL_US) {
+    if (changed && metrics) TallyMetrics::increment(metrics->framesDeferred);
+    framePending = true;
+    return;
+  }
+
+  framePending = false;
+  sink.show(frame, compositor.pixelCount(), 255);
+  lastShowUs = clock.micros();
+  shownOnce = true;
+  if (metrics) {
+    TallyMetrics::increment(metrics->framesShown);
+    metrics->showDuration.record(lastShowUs - start);
+  }
+  if (cuePending) recordCue(lastShowUs);
+}
+
+// Latency of a tally update that changed the LEDs
+void TallyRenderer::recordCue(uint32_t shownUs) {
+  cuePending = false;
+  if (metrics) metrics->decodeToShow.record(shownUs - cueDecodedUs);
+  uint32_t latency = shownUs - cueRxUs;
+  lastLatency = latency;
+  if (latency > maxLatency) maxLatency = latency;
+  LOG_DEBUG("Cue latency: %u us", latency);
+}
+
+void TallyRenderer::showTally(uint8_t state, uint8_t brightness) {
+  if (state > 3) {
+    if (displayed != 0) LOG_INFO("Tally: Off*");
+    state = 0;
+  } else if (state != displayed) {
+    LOG_INFO_STR("Tally: %s", tallyStateName(state));
+  }
+  if (tallyFromTsl && rules && rules->enabled()) {
+    // Rules can light us from other addresses, so our own brightness bits
+    // (possibly never sent) don't apply
+    Rgb colors[NUM_PIXEL_ROLES];
+    rules->roleColors(snap.rules, colors);
+    compositor.setBase(colors, maxBrightness);
+  } else {
+    compositor.setTally(state, brightness);
+  }
+  if (compositor.overlayMode() == OVERLAY_SOLID) compositor.clearOverlay();  // Flash and pulse stay on top
+  showFrame();
+  displayed = state;
+  changes++;
+}
+
+void TallyRenderer::handleCommand(const RenderCommand &cmd) {
+  switch (cmd.type) {
+    case RENDER_TALLY:
+      tallyState = cmd.arg;
+      tallyFromTsl = false;
+      if (!discoMode) {
+        compositor.clearOverlay();
+        lostShown = false;
+      }
+      redraw = true;
+      break;
+    case RENDER_DISCO:
+      if (cmd.seed == discoSeed) {
+        // Resync of the current show moves its epoch; one that has ended
+        // or been stopped stays stopped
+        if (!discoMode) break;
+      } else {
+        discoMode = true;
+        discoSeed = cmd.seed;
+        discoFrame = UINT32_MAX;
+        lostShown = false;
+      }
+      discoEpochUs = cmd.epochUs;
+      discoEndUs = cmd.epochUs + cmd.arg * 1000;
+      break;
+    case RENDER_DISCO_STOP:
+      if (discoMode) {
+        discoMode = false;
+        compositor.clearOverlay();
+        redraw = true;
+      }
+      break;
+    case RENDER_SOLID:
+      discoMode = false;
+      lostShown = false;
+      compositor.setOverlay(OVERLAY_SOLID, rgbFromCode(cmd.arg), maxBrightness);
+      showFrame();
+      break;
+    case RENDER_FLASH:
+    case RENDER_PULSE:
+      discoMode = false;
+      lostShown = false;
+      compositor.setOverlay(cmd.type == RENDER_FLASH ? OVERLAY_FLASH : OVERLAY_PULSE, rgbFromCode(cmd.arg), maxBrightness,
+                            cmd.type == RENDER_FLASH ? RENDER_FLASH_PERIOD_MS : RENDER_PULSE_PERIOD_MS);
+      showFrame();
+      break;
+    case RENDER_CLEAR:
+      if (!discoMode && compositor.overlayMode() != OVERLAY_NONE) {
+        compositor.clearOverlay();
+        lostShown = false;
+        showFrame();
+      }
+      break;
+    case RENDER_SIGNAL_LOST:
+      signalLost = true;
+      lostColor = rgbFromCode(cmd.arg);
+      break;
+    case RENDER_SIGNAL_OK:
+      signalLost = false;
+      break;
+  }
+}
+
+// The lost-signal pulse goes on whenever no other overlay is showing, and
+// comes off when TSL is back. Other overlays replace it while they run.
+void TallyRenderer::showSignal() {
+  if (discoMode) return;
+  if (signalLost && compositor.overlayMode() == OVERLAY_NONE) {
+    compositor.setOverlay(OVERLAY_PULSE, lostColor, maxBrightness, RENDER_LOST_SIGNAL_PERIOD_MS);
+    lostShown = true;
+    showFrame();
+  } else if (!signalLost && lostShown) {
+    compositor.clearOverlay();
+    lostShown = false;
+    showFrame();
+  }
+}
+
+uint32_t TallyRenderer::frameDueInUs() const {
+  if (framePending) {
+    uint32_t sinceShow = clock.micros() - lastShowUs;
+    return sinceShow < RENDER_MIN_SHOW_INTERVAL_US ? RENDER_MIN_SHOW_INTERVAL_US - sinceShow : 0;
+  }
+  if (!discoMode) return compositor.animating() ? COMPOSITOR_FRAME_US : 10000;
+  // Due exactly on the frame boundary so every tally changes together
+  int32_t elapsed = (int32_t)(clock.micros() - discoEpochUs);
+  return elapsed < 0 ? DISCO_FRAME_US - elapsed : DISCO_FRAME_US - (uint32_t)elapsed % DISCO_FRAME_US;
+}
+
+void TallyRenderer::update() {
+  uint32_t previousSeq = mailboxSeq;
+  if (mailbox.read(snap, mailboxSeq)) {
+    // Each publish advances the sequence by 2
+    if (metrics && previousSeq != 0 && mailboxSeq - previousSeq > 2) {
+      metrics->packetsDropped.fetch_add((mailboxSeq - previousSeq) / 2 - 1, std::memory_order_relaxed);
+    }
+    tallyState = snap.state;
+    tallyFromTsl = true;
+    if (!discoMode) {
+      if (!cuePending) {  // A held-back cue keeps its own timestamps
+        cuePending = true;
+        cueRxUs = snap.rxMicros;
+        cueDecodedUs = snap.decodedMicros;
+      }
+      showTally(tallyState, snap.brightness);
+      redraw = false;
+    }
+  }
+
+  if (discoMode) {
+    uint32_t now = clock.micros();
+    if ((int32_t)(now - discoEndUs) < 0) {
+      // Before the epoch (a follower's estimate can land just ahead) is frame 0
+      int32_t elapsed = (int32_t)(now - discoEpochUs);
+      uint32_t frame = elapsed > 0 ? (uint32_t)elapsed / DISCO_FRAME_US : 0;
+      if (frame != discoFrame) {
+        discoFrame = frame;
+        compositor.setOverlay(OVERLAY_SOLID, discoFrameColor(discoSeed, frame), 255);  // Full brightness for disco
+        showFrame();
+      } else if (framePending) {
+        showFrame();
+      }
+      return;
+    }
+    // Disco time is over
+    discoMode = false;
+    compositor.clearOverlay();
+    LOG_INFO("[DISCO] Party's over!");
+    redraw = true;
+  }
+
+  // Return to the current tally state, at the brightness TSL sent if
+  // it came from TSL
+  if (redraw) {
+    redraw = false;
+    showTally(tallyState, tallyFromTsl ? snap.brightness : maxBrightness);
+  } else if (compositor.animating() || framePending) {
+    showFrame();  // Next flash/pulse frame, or one the rate cap held back
+  }
+  showSignal();
+}
@@ -0,0 +1,344 @@
+/*
+    Tally core: TSL decoding, state handoff and LED rendering
+    Video Walrus 2025
+
+    Hardware-free; everything it needs comes in through hal.h.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "compositor.h"
+#include "disco_show.h"
+#include "hal.h"
+#include "tally_metrics.h"
+
+#define TSL_MAX_ADDRESS 126
+#define TSL31_MESSAGE_LENGTH 18  // Address + control + 16-char label
+
+// TSL 5.0 (UMD v5) framing
+#define TSL5_HEADER_LENGTH 6      // PBC(16) VER(8) FLAGS(8) SCREEN(16)
+#define TSL5_DMSG_HEADER_LENGTH 6 // INDEX(16) CONTROL(16) LENGTH(16)
+#define TSL5_FLAG_UNICODE 0x01    // Text is UTF-16LE
+#define TSL5_FLAG_SCONTROL 0x02   // Screen control data, no DMSGs
+#define TSL5_CONTROL_DATA 0x8000  // DMSG carries control data, not display text
+#define TSL5_BROADCAST 0xFFFF
+#define TSL5_DLE 0xFE             // TCP framing: DLE/STX starts a packet, DLE/DLE escapes
+#define TSL5_STX 0x02
+
+enum TslProtocol {
+  TSL_PROTOCOL_V31 = 0,
+  TSL_PROTOCOL_V50 = 1,
+};
+
+const char *tallyStateName(uint8_t state);
+
+// Tally rules: LED colours driven by the tally bits of any TSL addresses,
+// e.g. an ISO-record light on several cameras' program bits, instead of
+// only our own address. Written as comma-separated entries:
+//
+//   address:tally:colour:roles[:priority]
+//
+// tally is the TSL tally bit 1-4, colour is RRGGBB hex or R, G or Y (the
+// usual tally colours), roles are the compositor pixel roles it lights
+// (any of T, P, V) and priority (0-255, default 0) picks between rules
+// lit on the same role; equal priorities go to the later rule.
+//
+// parse() compiles the table into per-(address, bit) rule masks with the
+// rules ordered by priority, so the decoder finds the lit rules for an
+// address with a few ANDs and ORs whatever the table size, and the
+// renderer picks the winner per role with one count-leading-zeros.
+#define MAX_TALLY_RULES 32  // One bit each in a uint32_t
+
+struct TallyRule {
+  uint8_t address;
+  uint8_t bit;       // 0-3, tally 1-4
+  uint8_t roleMask;  // 1 << PixelRole
+  uint8_t priority;
+  Rgb color;
+};
+
+class TallyRules {
+ public:
+  // False (table unchanged) if any entry is malformed
+  bool parse(const char *spec);
+  size_t count() const { return numRules; }
+  bool enabled() const { return numRules > 0; }
+
+  // Rules on this address, as a mask; 0 if none
+  uint32_t addressRules(int addr) const { return addrRules[addr]; }
+  // Rules on addr lit by its control byte (branch-free)
+  uint32_t lit(int addr, uint8_t control) const {
+    const uint32_t *b = bitRules[addr];
+    return (-(uint32_t)(control & 1) & b[0]) | (-(uint32_t)((control >> 1) & 1) & b[1]) |
+           (-(uint32_t)((control >> 2) & 1) & b[2]) | (-(uint32_t)((control >> 3) & 1) & b[3]);
+  }
+  // Colour of each pixel role for a mask of lit rules
+  void roleColors(uint32_t active, Rgb *colors) const;
+
+ private:
+  size_t numRules = 0;
+  TallyRule rules[MAX_TALLY_RULES];  // Ascending priority: bit i of a mask is rules[i]
+  uint32_t bitRules[TSL_MAX_ADDRESS + 1][4] = {};
+  uint32_t addrRules[TSL_MAX_ADDRESS + 1] = {};
+  uint32_t roleRules[NUM_PIXEL_ROLES] = {};
+};
+
+// Tally state as published by the UDP task for the render task
+struct TallySnapshot {
+  uint8_t state;        // 0=Off, 1=Green, 2=Red, 3=Yellow
+  uint8_t brightness;   // Already scaled to maxBrightness
+  uint32_t rules;       // Lit TallyRules, when a rule table is set
+  uint32_t rxMicros;    // Packet receive time, for cue latency
+  uint32_t decodedMicros;  // Decode complete time
+  char text[17];        // TSL label, NUL terminated
+};
+
+// Single-writer seqlock: the UDP task publishes without ever blocking or
+// allocating; readers on the other core retry if they raced a write.
+class TallyMailbox {
+ public:
+  void publish(const TallySnapshot &snap) {
+    uint32_t seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);  // Odd = write in progress
+    std::atomic_thread_fence(std::memory_order_release);
+    data = snap;
+    sequence.store(seq + 2, std::memory_order_release);
+  }
+
+  // Copy out the latest snapshot if it changed since lastSeq
+  bool read(TallySnapshot &out, uint32_t &lastSeq) {
+    for (;;) {
+      uint32_t before = sequence.load(std::memory_order_acquire);
+      if (before == lastSeq) return false;
+      if (before & 1) continue;
+      out = data;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence.load(std::memory_order_relaxed) == before) {
+        lastSeq = before;
+        return true;
+      }
+    }
+  }
+
+  // Copy out the latest snapshot unconditionally
+  void peek(TallySnapshot &out) {
+    uint32_t seq = 1;  // Never a valid published sequence
+    read(out, seq);
+  }
+
+ private:
+  std::atomic<uint32_t> sequence{0};
+  TallySnapshot data = {};
+};
+
+// Last known state of one TSL display address
+struct TslDisplay {
+  uint8_t control;   // Tally bits 0-3, brightness bits 4-5
+  char label[17];    // Printable ASCII, trailing spaces trimmed
+};
+
+// Last known tally state, kept in RTC memory and NVS so a reboot can put
+// the light straight back: the control byte of every address (tally
+// rules may watch any of them) and our own label
+#define SAVED_TALLY_MAGIC 0x544C5931  // "TLY1"
+
+struct SavedTally {
+  uint32_t magic;
+  uint32_t savedAtS;  // Caller's clock (time() on the ESP32), for the age check
+  uint8_t address;    // Whose label this is
+  uint8_t control[TSL_MAX_ADDRESS + 1];
+  char label[17];
+  uint8_t reserved[3];  // Zero; no padding goes into the checksum
+  uint32_t checksum;    // FNV-1a of everything above
+};
+
+uint32_t savedTallyChecksum(const SavedTally &saved);
+inline bool savedTallyValid(const SavedTally &saved) {
+  return saved.magic == SAVED_TALLY_MAGIC && saved.checksum == savedTallyChecksum(saved);
+}
+
+// When a changed state goes to flash: once TALLY_SAVE_SETTLE_MS has
+// passed without another change, so a burst of cues is one write, at
+// most once per TALLY_SAVE_INTERVAL_MS, and never if it matches what was
+// last written. NVS levels wear across its pages; this bounds how often.
+#define TALLY_SAVE_SETTLE_MS 2000
+#define TALLY_SAVE_INTERVAL_MS 30000
+
+class TallySaveSchedule {
+ public:
+  // state is the latest copy; true if it should be written now
+  bool due(const SavedTally &state, uint32_t nowMs);
+  void written(const SavedTally &state, uint32_t nowMs);
+  void known(const SavedTally &state);  // Already in flash (restored at boot)
+
+ private:
+  bool sameAsWritten(const SavedTally &state) const;
+
+  SavedTally last = {};  // As written (or restored)
+  bool haveLast = false;
+  uint32_t lastWriteMs = 0;
+  bool wroteOnce = false;
+  uint32_t changedMs = 0;
+  uint32_t pendingChecksum = 0;
+};
+
+// TSL 3.1 / 5.0 decoder. Keeps the state of every address and publishes
+// our own address to the mailbox. Runs on the receive task only: no heap,
+// no LED access.
+class TslDecoder {
+ public:
+  TslDecoder(TallyMailbox &mailbox, Clock &clock) : mailbox(mailbox), clock(clock) {}
+
+  int address = 0;              // Our TSL address
+  uint8_t maxBrightness = 50;   // TSL brightness 0-3 maps to 0..maxBrightness
+  TallyMetrics *metrics = NULL; // Optional: counts ours/malformed datagrams
+  const TallyRules *rules = NULL;  // Optional: addresses and bits beyond our own; set before decoding
+
+  // Both return true if our address was updated (and published)
+  bool decodeTsl31(const uint8_t *data, int len, uint32_t rxMicros);
+  bool decodeTsl5(const uint8_t *data, int len, uint32_t rxMicros);  // Unframed; see TslStreamDeframer
+  // Entries from a TSL relay (tsl_relay.h): address, control byte, label
+  // length and label, one per address
+  bool decodeRelay(const uint8_t *data, int len, uint32_t rxMicros);
+
+  const TslDisplay &display(int addr) const { return displays[addr]; }
+
+  // Bumped whenever a control byte or our label changes
+  uint32_t stateVersion() const { return version; }
+  void saveState(SavedTally &out, uint32_t savedAtS) const;
+  // Put a saved state back and publish it, before decoding starts. It is
+  // held for holdMs (> 0); a well-formed TSL datagram in that time (any address)
+  // shows the switcher is still there and keeps it, otherwise expire()
+  // clears every address to Off.
+  void restoreState(const SavedTally &saved, uint32_t holdMs);
+  bool holdingRestored() const { return holdMs != 0; }
+  // Call on the receive task at least every 100 ms; true if it just
+  // cleared (and published) the restored state
+  bool expire();
+
+  // Since the last well-formed TSL datagram, or since we started
+  uint32_t silentMs() { return clock.millis() - lastHeardMs; }
+
+ private:
+  void publish(uint32_t rxMicros);
+  void setDisplay(int addr, uint8_t control, const uint8_t *text, int len, bool utf16);
+  void heard();
+  void countDatagram(bool ours, bool malformed);
+  bool updateRules(int addr);
+
+  uint32_t activeRules = 0;
+  uint32_t version = 0;
+  uint32_t lastHeardMs = 0;
+  uint32_t restoredMs = 0;
+  uint32_t holdMs = 0;  // 0 = not holding a restored state
+
+  TallyMailbox &mailbox;
+  Clock &clock;
+  TslDisplay displays[TSL_MAX_ADDRESS + 1] = {};
+};
+
+// Commands from the web/loop side to the render stage
+enum RenderCommandType : uint8_t {
+  RENDER_TALLY,       // arg = tally state, shown at maxBrightness (test buttons)
+  RENDER_DISCO,       // arg = duration in ms, plus the show's seed and epoch (disco_show.h)
+  RENDER_DISCO_STOP,
+  RENDER_SOLID,       // arg = 0xRRGGBB, shown at maxBrightness until the next tally change
+  RENDER_FLASH,       // arg = 0xRRGGBB, flashed over the tally until the next RENDER_TALLY
+  RENDER_PULSE,       // arg = 0xRRGGBB, pulsed over the tally until the next RENDER_TALLY
+  RENDER_CLEAR,       // Drop a solid, flash or pulse overlay and show the tally underneath
+  RENDER_SIGNAL_LOST, // arg = 0xRRGGBB, pulsed over the tally whenever nothing else is, until RENDER_SIGNAL_OK
+  RENDER_SIGNAL_OK,
+};
+
+#define RENDER_FLASH_PERIOD_MS 400
+#define RENDER_PULSE_PERIOD_MS 1500
+#define RENDER_LOST_SIGNAL_PERIOD_MS 3000
+
+// Shortest gap between two frames sent to the LEDs. A change inside the
+// gap is held back and sent (latest pixels only) when it ends.
+#ifndef RENDER_MIN_SHOW_INTERVAL_US
+#define RENDER_MIN_SHOW_INTERVAL_US 10000  // 100 fps cap
+#endif
+
+struct RenderCommand {
+  RenderCommandType type;
+  uint32_t arg;
+  uint32_t seed;     // RENDER_DISCO only, never 0
+  uint32_t epochUs;  // RENDER_DISCO only, on clock.micros()
+};
+
+// Render stage - sole owner of the compositor, the LED frame and the
+// LedSink. Call handleCommand() for each queued command, then update();
+// update() needs calling again within frameDueInUs() while animating() is
+// true. The sink only sees frames whose pixels changed, at most one per
+// RENDER_MIN_SHOW_INTERVAL_US.
+class TallyRenderer {
+ public:
+  TallyRenderer(LedSink &sink, Clock &clock, TallyMailbox &mailbox)
+      : sink(sink), clock(clock), mailbox(mailbox) {
+    compositor.setPixelCount(sink.size());
+  }
+
+  uint8_t maxBrightness = 50;
+  TallyMetrics *metrics = NULL;  // Optional: show latency and dropped updates
+  const TallyRules *rules = NULL;  // Optional: TSL updates light the LEDs through these
+
+  // Pixel roles (compositor.h), e.g. "TTTPPPP"; call before the render
+  // stage starts. False leaves the layout unchanged.
+  bool setLayout(const char *layout) { return compositor.setLayout(layout); }
+
+  void handleCommand(const RenderCommand &cmd);
+  void update();
+
+  bool animating() const { return discoMode || compositor.animating() || framePending; }
+  // Time until the next animation frame is due
+  uint32_t frameDueInUs() const;
+
+  uint8_t displayedState() const { return displayed; }
+  uint32_t displayChanges() const { return changes; }  // Bumped on every tally redraw
+  uint32_t lastCueLatencyUs() const { return lastLatency; }
+  uint32_t maxCueLatencyUs() const { return maxLatency; }
+
+ private:
+  void showTally(uint8_t state, uint8_t brightness);
+  void showFrame();
+  void showSignal();
+  void recordCue(uint32_t shownUs);
+
+  LedSink &sink;
+  Clock &clock;
+  TallyMailbox &mailbox;
+
+  Compositor compositor;
+  Rgb frame[COMPOSITOR_MAX_PIXELS];
+
+  TallySnapshot snap = {};
+  uint32_t mailboxSeq = 0;
+  uint8_t tallyState = 0;
+  bool tallyFromTsl = false;  // Last tally came from the mailbox, not a test command
+  bool redraw = false;
+  bool discoMode = false;
+  uint32_t discoSeed = 0;
+  uint32_t discoEpochUs = 0;
+  uint32_t discoEndUs = 0;
+  uint32_t discoFrame = 0;  // Last frame shown
+  bool signalLost = false;
+  bool lostShown = false;   // The overlay is the lost-signal pulse
+  Rgb lostColor = {0, 0, 0};
+
+  uint32_t lastShowUs = 0;
+  bool shownOnce = false;
+  bool framePending = false;  // Changed frame held back by the rate cap
+  bool cuePending = false;    // Tally update not on the LEDs yet
+  uint32_t cueRxUs = 0;
+  uint32_t cueDecodedUs = 0;
+
+  std::atomic<uint8_t> displayed{0};
+  std::atomic<uint32_t> changes{0};
+  std::atomic<uint32_t> lastLatency{0};
+  std::atomic<uint32_t> maxLatency{0};
+};
@@ -0,0 +1,46 @@
+/*
+    Tally change events for the /events stream
+    Video Walrus 2025
+*/
+
+#include "tally_events.h"
+
+#include <string.h>
+
+#include "json_text.h"
+#include "tally_core.h"
+
+// Append s to buf[n..len), always leaving room for the NUL
+static size_t appendText(char *buf, size_t len, size_t n, const char *s) {
+  for (; *s && n + 1 < len; s++) buf[n++] = *s;
+  return n;
+}
+
+size_t formatTallyEvent(uint8_t state, const char *text, char *buf, size_t len) {
+  size_t n = appendText(buf, len, 0, "{\"tally\":\"");
+  n = appendText(buf, len, n, tallyStateName(state));
+  n = appendText(buf, len, n, "\",\"text\":\"");
+  jsonEscape(text, buf + n, len - n);
+  n += strlen(buf + n);
+  n = appendText(buf, len, n, "\"}");
+  buf[n] = '\0';
+  return n;
+}
+
+TallyEventKind TallyEventFeed::poll(uint32_t changes, uint8_t state, const char *text, uint32_t nowMs) {
+  if (changes != lastChanges) {
+    lastChanges = changes;
+    char data[TALLY_EVENT_MAX_LENGTH];
+    formatTallyEvent(state, text, data, sizeof(data));
+    if (strcmp(data, lastData) != 0) {
+      memcpy(lastData, data, sizeof(lastData));
+      lastSentMs = nowMs;
+      return TALLY_EVENT_CHANGE;
+    }
+  }
+  if (nowMs - lastSentMs > EVENT_KEEPALIVE_MS) {
+    lastSentMs = nowMs;
+    return TALLY_EVENT_KEEPALIVE;
+  }
+  return TALLY_EVENT_NONE;
+}
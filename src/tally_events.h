@@ -0,0 +1,41 @@
+/*
+    Tally change events for the /events stream
+    Video Walrus 2025
+
+    Browsers hold a Server-Sent Events connection open and get a tally
+    event the moment the LEDs change, instead of polling /status. The feed
+    decides what goes out and when; the web server does the sending.
+    Hardware-free, like the tally core.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MAX_EVENT_CLIENTS 8
+#define EVENT_KEEPALIVE_MS 15000    // Finds dead clients between changes
+#define TALLY_EVENT_MAX_LENGTH 80   // {"tally":"Yellow","text":"..."} with every label character escaped
+
+// Event data, e.g. {"tally":"Red","text":"CAM 1"}; returns its length
+size_t formatTallyEvent(uint8_t state, const char *text, char *buf, size_t len);
+
+enum TallyEventKind {
+  TALLY_EVENT_NONE,
+  TALLY_EVENT_CHANGE,     // Send data() as a "tally" event
+  TALLY_EVENT_KEEPALIVE,  // Send an empty "keepalive" event
+};
+
+class TallyEventFeed {
+ public:
+  // Call from loop() with the renderer's change counter and the tally it
+  // shows. A redraw that leaves state and label as last sent is skipped,
+  // so a switcher's resends cost subscribers nothing.
+  TallyEventKind poll(uint32_t changes, uint8_t state, const char *text, uint32_t nowMs);
+  const char *data() const { return lastData; }
+
+ private:
+  uint32_t lastChanges = 0;
+  uint32_t lastSentMs = 0;
+  char lastData[TALLY_EVENT_MAX_LENGTH] = "";
+};
@@ -0,0 +1,122 @@
+/*
+    Tally latency and packet metrics
+    Video Walrus 2025
+*/
+
+#include "tally_metrics.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+
+const uint32_t LatencyHistogram::bucketBoundsUs[NUM_BUCKETS] = {
+  50, 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000
+};
+
+static const char *const bucketLabels[LatencyHistogram::NUM_BUCKETS] = {
+  "0.00005", "0.0001", "0.00025", "0.0005", "0.001", "0.0025", "0.005", "0.01", "0.025", "0.05", "0.1"
+};
+
+void LatencyHistogram::record(uint32_t us) {
+  int i = 0;
+  while (i < NUM_BUCKETS && us > bucketBoundsUs[i]) i++;
+  buckets[i].fetch_add(1, std::memory_order_relaxed);
+  count.fetch_add(1, std::memory_order_relaxed);
+  sumUs.fetch_add(us, std::memory_order_relaxed);
+}
+
+// snprintf that appends at buf + used and never runs past len. Returns
+// the length the text needs, even once buf is full, so the caller can
+// tell it was cut short.
+static size_t append(char *buf, size_t len, size_t used, const char *fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  int n = used < len ? vsnprintf(buf + used, len - used, fmt, args) : vsnprintf(NULL, 0, fmt, args);
+  va_end(args);
+  return n < 0 ? used : used + n;
+}
+
+size_t LatencyHistogram::format(char *buf, size_t len, size_t used, const char *name, const char *help) const {
+  used = append(buf, len, used, "# HELP %s %s\n# TYPE %s histogram\n", name, help, name);
+  uint32_t cumulative = 0;
+  for (int i = 0; i < NUM_BUCKETS; i++) {
+    cumulative += buckets[i].load(std::memory_order_relaxed);
+    used = append(buf, len, used, "%s_bucket{le=\"%s\"} %u\n", name, bucketLabels[i], (unsigned)cumulative);
+  }
+  cumulative += buckets[NUM_BUCKETS].load(std::memory_order_relaxed);
+  used = append(buf, len, used, "%s_bucket{le=\"+Inf\"} %u\n", name, (unsigned)cumulative);
+  used = append(buf, len, used, "%s_sum %.6f\n", name, sumUs.load(std::memory_order_relaxed) / 1e6);
+  used = append(buf, len, used, "%s_count %u\n", name, (unsigned)count.load(std::memory_order_relaxed));
+  return used;
+}
+
+static size_t formatCounter(char *buf, size_t len, size_t used, const char *name, const char *help,
+                            const std::atomic<uint32_t> &value) {
+  return append(buf, len, used, "# HELP %s %s\n# TYPE %s counter\n%s %u\n",
+                name, help, name, name, (unsigned)value.load(std::memory_order_relaxed));
+}
+
+static size_t formatGaugeMs(char *buf, size_t len, size_t used, const char *name, const char *help,
+                            const std::atomic<uint32_t> &ms) {
+  return append(buf, len, used, "# HELP %s %s\n# TYPE %s gauge\n%s %.3f\n",
+                name, help, name, name, ms.load(std::memory_order_relaxed) / 1e3);
+}
+
+size_t TallyMetrics::format(char *buf, size_t len) const {
+  size_t used = 0;
+  if (len > 0) buf[0] = '\0';
+  used = formatCounter(buf, len, used, "tally_packets_received_total",
+                       "TSL datagrams received", packetsReceived);
+  used = formatCounter(buf, len, used, "tally_packets_for_us_total",
+                       "TSL datagrams that updated this tally's address", packetsForUs);
+  used = formatCounter(buf, len, used, "tally_packets_malformed_total",
+                       "TSL datagrams with an invalid header, length or record", packetsMalformed);
+  used = formatCounter(buf, len, used, "tally_packets_dropped_total",
+                       "Tally updates overwritten before the render task showed them", packetsDropped);
+  used = formatCounter(buf, len, used, "tally_multicast_rejoins_total",
+                       "Multicast group joins after the first", multicastRejoins);
+  used = formatCounter(buf, len, used, "tally_http_rejected_total",
+                       "HTTP requests refused with 503 at the connection limit", httpRejected);
+  used = formatCounter(buf, len, used, "tally_fleet_rejected_total",
+                       "Fleet control datagrams with a bad length or authentication tag", fleetRejected);
+  used = formatCounter(buf, len, used, "tally_frames_shown_total",
+                       "LED frames sent to the strip", framesShown);
+  used = formatCounter(buf, len, used, "tally_frames_suppressed_total",
+                       "LED frames not sent because no pixel changed", framesSuppressed);
+  used = formatCounter(buf, len, used, "tally_frames_deferred_total",
+                       "Changed LED frames held back by the show-rate cap", framesDeferred);
+  used = formatCounter(buf, len, used, "tally_duplicates_dropped_total",
+                       "TSL datagrams dropped as the second copy from the other link", duplicatesDropped);
+  used = formatCounter(buf, len, used, "tally_failovers_total",
+                       "Times Ethernet went down and WiFi took over listening", failovers);
+  used = formatCounter(buf, len, used, "tally_failbacks_total",
+                       "Times listening moved back from WiFi to Ethernet", failbacks);
+  used = formatGaugeMs(buf, len, used, "tally_failover_listen_seconds",
+                       "Last failover: Ethernet down to listening on WiFi", failoverListenMs);
+  used = formatGaugeMs(buf, len, used, "tally_failover_first_packet_seconds",
+                       "Last failover: Ethernet down to the first TSL datagram on WiFi", failoverPacketMs);
+  used = formatCounter(buf, len, used, "tally_tcp_connects_total",
+                       "Connections made to the TSL TCP server", tcpConnects);
+  used = formatCounter(buf, len, used, "tally_tcp_drops_total",
+                       "TSL TCP connections lost after they were made", tcpDrops);
+  used = formatCounter(buf, len, used, "tally_relay_sent_total",
+                       "TSL relay datagrams sent to subscribers", relaySent);
+  used = formatCounter(buf, len, used, "tally_relay_bytes_total",
+                       "TSL relay bytes sent to subscribers", relayBytes);
+  used = formatCounter(buf, len, used, "tally_relay_keyframes_total",
+                       "TSL relay keyframes sent", relayKeyframes);
+  used = formatCounter(buf, len, used, "tally_relay_gaps_total",
+                       "TSL relay datagrams this subscriber missed", relayGaps);
+  used = receiveToDecode.format(buf, len, used, "tally_receive_to_decode_seconds",
+                                "Time from socket read to decode complete");
+  used = decodeToShow.format(buf, len, used, "tally_decode_to_show_seconds",
+                             "Time from decode complete to LED update complete");
+  used = showDuration.format(buf, len, used, "tally_show_duration_seconds",
+                             "Time the render task spends handing a frame to the LED output");
+  used = ledTransfer.format(buf, len, used, "tally_led_transfer_seconds",
+                            "Time FastLED.show() takes to clock a frame out on every output");
+  used = loopPass.format(buf, len, used, "tally_loop_pass_seconds",
+                         "Time spent in one pass of the Arduino loop()");
+  used = fleetAck.format(buf, len, used, "tally_fleet_ack_seconds",
+                         "Time from sending a fleet command to each device's ack");
+  return used;
+}
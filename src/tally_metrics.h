@@ -0,0 +1,73 @@
+/*
+    Tally latency and packet metrics
+    Video Walrus 2025
+
+    Counters and fixed-bucket histograms updated with relaxed atomics from
+    any task - no locks, no heap - and rendered as Prometheus text.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+// Room for format() with every counter and histogram at its largest
+// value (test_tally_metrics checks it); a new metric may need more
+#define TALLY_METRICS_MAX_LENGTH 10240
+
+class LatencyHistogram {
+ public:
+  static const int NUM_BUCKETS = 11;  // Plus +Inf
+  static const uint32_t bucketBoundsUs[NUM_BUCKETS];
+
+  void record(uint32_t us);
+  // Appends one Prometheus histogram to buf; returns the length needed
+  // so far (see TallyMetrics::format)
+  size_t format(char *buf, size_t len, size_t used, const char *name, const char *help) const;
+
+ private:
+  std::atomic<uint32_t> buckets[NUM_BUCKETS + 1] = {};
+  std::atomic<uint32_t> count{0};
+  std::atomic<uint64_t> sumUs{0};
+};
+
+struct TallyMetrics {
+  std::atomic<uint32_t> packetsReceived{0};   // Datagrams read from the socket
+  std::atomic<uint32_t> packetsForUs{0};      // Datagrams that updated our address
+  std::atomic<uint32_t> packetsMalformed{0};  // Datagrams with a bad header, length or record
+  std::atomic<uint32_t> packetsDropped{0};    // Updates overwritten in the mailbox before they were shown
+  std::atomic<uint32_t> multicastRejoins{0};  // Multicast joins after the first
+  std::atomic<uint32_t> httpRejected{0};      // Requests turned away with 503 (connection cap)
+  std::atomic<uint32_t> fleetRejected{0};     // Fleet datagrams with a bad length or tag
+  std::atomic<uint32_t> framesShown{0};       // Frames sent to the LEDs
+  std::atomic<uint32_t> framesSuppressed{0};  // Frames identical to the LEDs, not sent
+  std::atomic<uint32_t> framesDeferred{0};    // Changed frames held back by the show-rate cap
+  std::atomic<uint32_t> duplicatesDropped{0}; // Second copies of a datagram from the other link
+  std::atomic<uint32_t> failovers{0};         // Ethernet went down and WiFi took over listening
+  std::atomic<uint32_t> failbacks{0};         // Listening moved back from WiFi to Ethernet
+  std::atomic<uint32_t> failoverListenMs{0};  // Last failover: Ethernet down -> listening on WiFi
+  std::atomic<uint32_t> failoverPacketMs{0};  // Last failover: Ethernet down -> first datagram on WiFi
+  std::atomic<uint32_t> tcpConnects{0};       // TSL TCP connections made
+  std::atomic<uint32_t> tcpDrops{0};          // TSL TCP connections lost once made
+  std::atomic<uint32_t> relaySent{0};         // Relay datagrams sent (one per subscriber, or one broadcast)
+  std::atomic<uint32_t> relayBytes{0};        // Relay bytes sent
+  std::atomic<uint32_t> relayKeyframes{0};    // Relay keyframes sent, periodic or in answer to a subscription
+  std::atomic<uint32_t> relayGaps{0};         // Relay datagrams a subscriber missed
+
+  LatencyHistogram receiveToDecode;  // Socket read -> decoder done
+  LatencyHistogram decodeToShow;     // Decoder done -> FastLED.show() complete
+  LatencyHistogram showDuration;     // Render task handing a frame to the LED output
+  LatencyHistogram ledTransfer;      // FastLED.show() clocking a frame out on every output
+  LatencyHistogram loopPass;         // One loop() pass, excluding its idle delay
+  LatencyHistogram fleetAck;         // Fleet command sent -> each device's ack received
+
+  static void increment(std::atomic<uint32_t> &counter) {
+    counter.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Renders everything as Prometheus text into buf, always terminated.
+  // Returns the length the whole text needs: len or more means buf was
+  // too small and holds only the start of it.
+  size_t format(char *buf, size_t len) const;
+};
@@ -0,0 +1,90 @@
+/*
+    TCP client socket shared by the ESP32 (lwIP) and host builds
+    Video Walrus 2025
+*/
+
+#include "hal.h"
+#include "log_ring.h"
+
+#ifdef ARDUINO
+#include <lwip/sockets.h>
+#else
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// A server that vanishes without closing (cable pulled, power cut) is
+// noticed after about TCP_KEEPALIVE_IDLE_S + COUNT * INTERVAL_S seconds
+#define TCP_KEEPALIVE_IDLE_S 5
+#define TCP_KEEPALIVE_INTERVAL_S 1
+#define TCP_KEEPALIVE_COUNT 3
+
+bool TcpSocket::connect(uint32_t addr, uint16_t port) {
+  stop();
+
+  int s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+  if (s < 0) {
+    LOG_WARN("[TCP] socket() failed, errno %d", errno);
+    return false;
+  }
+
+  int on = 1, idle = TCP_KEEPALIVE_IDLE_S, interval = TCP_KEEPALIVE_INTERVAL_S, count = TCP_KEEPALIVE_COUNT;
+  setsockopt(s, SOL_SOCKET, SO_KEEPALIVE, &on, sizeof(on));
+  setsockopt(s, IPPROTO_TCP, TCP_KEEPIDLE, &idle, sizeof(idle));
+  setsockopt(s, IPPROTO_TCP, TCP_KEEPINTVL, &interval, sizeof(interval));
+  setsockopt(s, IPPROTO_TCP, TCP_KEEPCNT, &count, sizeof(count));
+  fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) | O_NONBLOCK);
+
+  struct sockaddr_in remote = {};
+  remote.sin_family = AF_INET;
+  remote.sin_port = htons(port);
+  remote.sin_addr.s_addr = addr;
+  if (::connect(s, (struct sockaddr *)&remote, sizeof(remote)) < 0 && errno != EINPROGRESS) {
+    LOG_WARN("[TCP] connect() failed, errno %d", errno);
+    close(s);
+    return false;
+  }
+  fd = s;
+  connecting = true;
+  return true;
+}
+
+int TcpSocket::connected() {
+  if (fd < 0) return -1;
+  if (!connecting) return 1;
+
+  fd_set writeSet;
+  FD_ZERO(&writeSet);
+  FD_SET(fd, &writeSet);
+  struct timeval now = { 0, 0 };
+  if (select(fd + 1, NULL, &writeSet, NULL, &now) <= 0) return 0;
+
+  int error = 0;
+  socklen_t errorLen = sizeof(error);
+  if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &errorLen) < 0 || error != 0) return -1;
+  connecting = false;
+  return 1;
+}
+
+void TcpSocket::stop() {
+  if (fd >= 0) {
+    close(fd);
+    fd = -1;
+  }
+  connecting = false;
+}
+
+int TcpSocket::receive(uint8_t *buf, size_t len) {
+  if (fd < 0 || connecting) return 0;
+
+  int n = recv(fd, buf, len, 0);
+  if (n > 0) return n;
+  if (n < 0 && (errno == EWOULDBLOCK || errno == EAGAIN)) return 0;
+  return -1;  // 0 is an orderly close
+}
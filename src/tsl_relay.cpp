@@ -0,0 +1,246 @@
+/*
+    TSL relay
+    Video Walrus 2025
+*/
+
+#include "tsl_relay.h"
+
+#include <string.h>
+
+#include "log_ring.h"
+
+static void writeLe32(uint8_t *p, uint32_t v) {
+  for (int i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static uint32_t readLe32(const uint8_t *p) {
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void writeHeader(uint8_t *buf, uint8_t type, uint32_t sequence, uint32_t epoch, uint8_t count) {
+  buf[0] = 'T';
+  buf[1] = 'R';
+  buf[2] = TSL_RELAY_VERSION;
+  buf[3] = type;
+  writeLe32(buf + 4, sequence);
+  writeLe32(buf + 8, epoch);
+  buf[12] = count;
+  buf[13] = buf[14] = buf[15] = 0;
+}
+
+static void writeTag(const FleetCodec &codec, uint8_t *buf, size_t len) {
+  uint64_t tag = codec.tag(buf, len);
+  for (int i = 0; i < TSL_RELAY_TAG_LENGTH; i++) buf[len + i] = (uint8_t)(tag >> (8 * i));
+}
+
+// A well-formed relay datagram of a known type with a valid tag
+static bool validDatagram(const FleetCodec &codec, const uint8_t *data, size_t len) {
+  if (!codec.enabled() || len < TSL_RELAY_HEADER_LENGTH + TSL_RELAY_TAG_LENGTH) return false;
+  if (data[0] != 'T' || data[1] != 'R' || data[2] != TSL_RELAY_VERSION) return false;
+  if (data[3] != TSL_RELAY_DELTA && data[3] != TSL_RELAY_KEYFRAME && data[3] != TSL_RELAY_SUBSCRIBE) return false;
+
+  // Whole-tag compare, as for fleet datagrams
+  size_t tagAt = len - TSL_RELAY_TAG_LENGTH;
+  uint64_t tag = 0;
+  for (int i = 0; i < TSL_RELAY_TAG_LENGTH; i++) tag |= (uint64_t)data[tagAt + i] << (8 * i);
+  return (codec.tag(data, tagAt) ^ tag) == 0;
+}
+
+// ---------------------------------------------------------------------------
+// Relay
+// ---------------------------------------------------------------------------
+
+void TslRelay::begin(uint32_t relayEpoch) {
+  epoch = relayEpoch;
+  sequence = 0;
+  keyframeMs = clock.millis();
+  memset(sent, 0, sizeof(sent));
+  numSubscribers = 0;
+  used = TSL_RELAY_HEADER_LENGTH;
+  count = 0;
+  repeatLen = 0;
+}
+
+bool TslRelay::handle(const uint8_t *data, size_t len, uint32_t fromAddr, uint16_t fromPort,
+                      const TslDecoder &decoder) {
+  if (!validDatagram(codec, data, len) || data[3] != TSL_RELAY_SUBSCRIBE) return false;
+
+  uint32_t now = clock.millis();
+  Subscriber *sub = NULL;
+  for (size_t i = 0; i < numSubscribers; i++) {
+    if (subs[i].addr == fromAddr && subs[i].port == fromPort) sub = &subs[i];
+  }
+  if (sub == NULL) {
+    if (numSubscribers == TSL_RELAY_MAX_SUBSCRIBERS) return false;
+    sub = &subs[numSubscribers++];
+    sub->addr = fromAddr;
+    sub->port = fromPort;
+    // fromAddr is in network byte order: first octet in the low byte
+    LOG_INFO("[RELAY] Subscriber %u.%u.%u.%u:%u (%u)", fromAddr & 0xFF, (fromAddr >> 8) & 0xFF,
+             (fromAddr >> 16) & 0xFF, fromAddr >> 24, fromPort, (uint32_t)numSubscribers);
+  }
+  sub->seenMs = now;
+
+  // The first subscriber starts the periodic stream from a full table;
+  // any later one gets a keyframe of its own
+  if (numSubscribers == 1) sendKeyframe(decoder, NULL);
+  else sendKeyframe(decoder, sub);
+  return true;
+}
+
+void TslRelay::service(const TslDecoder &decoder) {
+  expireSubscribers(clock.millis());
+  if (numSubscribers == 0) return;
+
+  if (repeatLen > 0 && clock.millis() - repeatMs >= TSL_RELAY_REPEAT_MS) {
+    sendAll(repeat, repeatLen);
+    repeatLen = 0;
+  }
+  if (clock.millis() - keyframeMs >= TSL_RELAY_KEYFRAME_MS) {
+    sendKeyframe(decoder, NULL);
+    return;
+  }
+
+  for (int addr = 0; addr <= TSL_MAX_ADDRESS; addr++) {
+    const TslDisplay &display = decoder.display(addr);
+    if (display.control == sent[addr].control && strcmp(display.label, sent[addr].label) == 0) continue;
+    addEntry(TSL_RELAY_DELTA, NULL, addr, display);
+    sent[addr] = display;
+  }
+  if (count > 0) flush(TSL_RELAY_DELTA, NULL);
+}
+
+// Every address, to one subscriber (to) or to all of them; a keyframe
+// to all of them also brings sent up to date
+void TslRelay::sendKeyframe(const TslDecoder &decoder, const Subscriber *to) {
+  for (int addr = 0; addr <= TSL_MAX_ADDRESS; addr++) {
+    const TslDisplay &display = decoder.display(addr);
+    addEntry(TSL_RELAY_KEYFRAME, to, addr, display);
+    if (to == NULL) sent[addr] = display;
+  }
+  flush(TSL_RELAY_KEYFRAME, to);
+  if (to == NULL) {
+    keyframeMs = clock.millis();
+    repeatLen = 0;  // Superseded
+  }
+  if (metrics) TallyMetrics::increment(metrics->relayKeyframes);
+}
+
+void TslRelay::addEntry(uint8_t type, const Subscriber *to, int addr, const TslDisplay &display) {
+  if (used + TSL_RELAY_MAX_ENTRY + TSL_RELAY_TAG_LENGTH > sizeof(buf)) flush(type, to);
+  size_t labelLen = strlen(display.label);
+  buf[used] = addr;
+  buf[used + 1] = display.control;
+  buf[used + 2] = labelLen;
+  memcpy(buf + used + 3, display.label, labelLen);
+  used += 3 + labelLen;
+  count++;
+}
+
+// Send the entries gathered so far. Datagrams to every subscriber take
+// the next sequence number; one to a single subscriber reuses the last.
+void TslRelay::flush(uint8_t type, const Subscriber *to) {
+  if (to == NULL) sequence++;
+  writeHeader(buf, type, sequence, epoch, count);
+  writeTag(codec, buf, used);
+  size_t len = used + TSL_RELAY_TAG_LENGTH;
+
+  if (to != NULL) {
+    send(to->addr, to->port, buf, len);
+  } else {
+    sendAll(buf, len);
+  }
+  if (type == TSL_RELAY_DELTA) {
+    // The last delta only: a subscriber that lost an earlier one sees the gap
+    memcpy(repeat, buf, len);
+    repeatLen = len;
+    repeatMs = clock.millis();
+  }
+  used = TSL_RELAY_HEADER_LENGTH;
+  count = 0;
+}
+
+void TslRelay::sendAll(const uint8_t *data, size_t len) {
+  if (numSubscribers > maxUnicast) {
+    send(broadcastAddr, broadcastPort, data, len);
+  } else {
+    for (size_t i = 0; i < numSubscribers; i++) send(subs[i].addr, subs[i].port, data, len);
+  }
+}
+
+void TslRelay::send(uint32_t addr, uint16_t port, const uint8_t *data, size_t len) {
+  if (!socket.sendTo(addr, port, data, len)) return;
+  if (metrics) {
+    TallyMetrics::increment(metrics->relaySent);
+    metrics->relayBytes.fetch_add(len, std::memory_order_relaxed);
+  }
+}
+
+void TslRelay::expireSubscribers(uint32_t nowMs) {
+  for (size_t i = 0; i < numSubscribers;) {
+    if (nowMs - subs[i].seenMs < TSL_RELAY_LEASE_MS) {
+      i++;
+      continue;
+    }
+    uint32_t addr = subs[i].addr;
+    subs[i] = subs[--numSubscribers];
+    LOG_INFO("[RELAY] Subscriber %u.%u.%u.%u gone (%u left)", addr & 0xFF, (addr >> 8) & 0xFF,
+             (addr >> 16) & 0xFF, addr >> 24, (uint32_t)numSubscribers);
+  }
+}
+
+// ---------------------------------------------------------------------------
+// Subscriber
+// ---------------------------------------------------------------------------
+
+void TslRelaySubscriber::service() {
+  if (clock.millis() - subscribeMs >= TSL_RELAY_SUBSCRIBE_MS || subscribeMs == 0) subscribe();
+}
+
+// To the relay being followed, or to everyone until there is one
+void TslRelaySubscriber::subscribe() {
+  uint8_t buf[TSL_RELAY_HEADER_LENGTH + TSL_RELAY_TAG_LENGTH];
+  if (!codec.enabled()) return;
+  subscribeMs = clock.millis() | 1;  // 0 = never subscribed
+  writeHeader(buf, TSL_RELAY_SUBSCRIBE, 0, 0, 0);
+  writeTag(codec, buf, TSL_RELAY_HEADER_LENGTH);
+  bool following = relayAddr != 0 && clock.millis() - heardMs < TSL_RELAY_TIMEOUT_MS;
+  socket.sendTo(following ? relayAddr : broadcastAddr, relayPort, buf, sizeof(buf));
+}
+
+bool TslRelaySubscriber::handle(const uint8_t *data, size_t len, uint32_t fromAddr, TslDecoder &decoder,
+                                uint32_t rxMicros, bool &ours) {
+  ours = false;
+  if (!validDatagram(codec, data, len) || data[3] == TSL_RELAY_SUBSCRIBE) return false;
+
+  uint32_t now = clock.millis();
+  uint32_t sequence = readLe32(data + 4);
+  uint32_t epoch = readLe32(data + 8);
+  if (fromAddr != relayAddr || epoch != relayEpoch) {
+    // Another relay only once ours has gone quiet; a restarted one at once
+    if (fromAddr != relayAddr && relayAddr != 0 && now - heardMs < TSL_RELAY_TIMEOUT_MS) return false;
+    if (fromAddr != relayAddr) {
+      LOG_INFO("[RELAY] Following relay %u.%u.%u.%u", fromAddr & 0xFF, (fromAddr >> 8) & 0xFF,
+               (fromAddr >> 16) & 0xFF, fromAddr >> 24);
+    }
+    relayAddr = fromAddr;
+    relayEpoch = epoch;
+    expected = sequence;
+  }
+
+  // A keyframe answering a subscription carries the last sequence sent
+  // to everyone, so it may be one behind
+  int32_t ahead = (int32_t)(sequence - expected);
+  if (ahead < (data[3] == TSL_RELAY_KEYFRAME ? -1 : 0)) return false;  // Stale
+  if (ahead > 0) {
+    missed += ahead;
+    if (metrics) metrics->relayGaps.fetch_add(ahead, std::memory_order_relaxed);
+    if (now - subscribeMs >= TSL_RELAY_RESYNC_MS) subscribe();  // Answered with a keyframe
+  }
+  expected = sequence + 1;
+  heardMs = now;
+
+  ours = decoder.decodeRelay(data + TSL_RELAY_HEADER_LENGTH,
+                             len - TSL_RELAY_HEADER_LENGTH - TSL_RELAY_TAG_LENGTH, rxMicros);
+  return true;
+}
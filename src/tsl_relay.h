@@ -0,0 +1,166 @@
+/*
+    TSL relay
+    Video Walrus 2025
+
+    One wired tally (the relay) decodes the switcher's full TSL stream
+    and passes on only what changed, to tallies that subscribe to it
+    (usually the WiFi ones) instead of joining the multicast group.
+    Switchers resend every address several times a second; the relay
+    sends an address again only when its tally bits or label change,
+    plus a keyframe of every address once per TSL_RELAY_KEYFRAME_MS.
+
+    Subscribers broadcast TSL_RELAY_SUBSCRIBE every TSL_RELAY_SUBSCRIBE_MS.
+    The relay answers each one with a keyframe, unicast, and keeps the
+    subscriber for TSL_RELAY_LEASE_MS. Deltas and keyframes go unicast to
+    each subscriber while there are at most TSL_RELAY_MAX_UNICAST of
+    them, and as one broadcast beyond that: unicast WiFi frames are acked
+    and retried by the access point, broadcast ones are sent once at the
+    lowest rate. Each delta is sent again TSL_RELAY_REPEAT_MS later, so
+    a single lost datagram costs that long rather than the time to the
+    next change. A subscriber that still sees a gap in the sequence
+    subscribes again at once, and is put right by the reply rather than
+    the next periodic keyframe. Deltas carry the latest state of an address, so
+    one that arrives after a gap is still applied; one older than the
+    last applied is dropped.
+
+    A keyframe lists every address, Off ones too, so it replaces the
+    subscriber's table; one too big for a datagram goes as several. The
+    keyframe answering a subscription reuses the relay's last sequence
+    number, since the other subscribers never see it.
+
+    Datagrams carry a SipHash-2-4 tag keyed from the fleet key, like fleet
+    control (fleet_control.h), so a relay needs one. Hardware-free, like
+    the tally core.
+
+    Layout (little-endian):
+      0  "TR"        magic
+      2  version     TSL_RELAY_VERSION
+      3  type        TSL_RELAY_DELTA, TSL_RELAY_KEYFRAME or TSL_RELAY_SUBSCRIBE
+      4  sequence    u32, per relay; deltas and keyframes share it
+      8  epoch       u32, random per relay start; a new one resets the sequence
+     12  count       entries
+     13  reserved    3 bytes, zero
+     16  entries     address, control byte, label length (0-16), label
+      .  tag         SipHash-2-4 of everything before it, 8 bytes
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fleet_control.h"
+#include "hal.h"
+#include "tally_core.h"
+
+#define TSL_RELAY_PORT 8903
+#define TSL_RELAY_VERSION 1
+#define TSL_RELAY_HEADER_LENGTH 16
+#define TSL_RELAY_TAG_LENGTH 8
+#define TSL_RELAY_MAX_DATAGRAM 1400       // Under a 1500-byte MTU on any path
+#define TSL_RELAY_MAX_ENTRY 19            // Address, control, length, 16-char label
+#define TSL_RELAY_KEYFRAME_MS 1000
+#define TSL_RELAY_REPEAT_MS 30            // Each delta again after this
+#define TSL_RELAY_SUBSCRIBE_MS 5000
+#define TSL_RELAY_RESYNC_MS 200           // Soonest a subscriber asks again after a gap
+#define TSL_RELAY_LEASE_MS 15000          // Subscriber dropped after this without a renewal
+#define TSL_RELAY_TIMEOUT_MS 3500         // Subscriber takes another relay after this without one
+#define TSL_RELAY_MAX_SUBSCRIBERS 32
+#define TSL_RELAY_MAX_UNICAST 4           // More subscribers than this: broadcast instead
+
+enum TslRelayType : uint8_t {
+  TSL_RELAY_DELTA = 1,
+  TSL_RELAY_KEYFRAME = 2,
+  TSL_RELAY_SUBSCRIBE = 3,  // No entries
+};
+
+// Relay side: the tally that listens to the switcher
+class TslRelay {
+ public:
+  TslRelay(UdpSocket &socket, Clock &clock, const FleetCodec &codec)
+      : socket(socket), clock(clock), codec(codec) {}
+
+  TallyMetrics *metrics = NULL;  // Optional: counts datagrams, bytes and keyframes sent
+  uint32_t broadcastAddr = 0xFFFFFFFF;  // Network byte order
+  uint16_t broadcastPort = TSL_RELAY_PORT;
+  size_t maxUnicast = TSL_RELAY_MAX_UNICAST;
+
+  // epoch: random, never 0
+  void begin(uint32_t epoch);
+
+  // A datagram that arrived on the relay port; true if it was a
+  // subscription (answered with a keyframe)
+  bool handle(const uint8_t *data, size_t len, uint32_t fromAddr, uint16_t fromPort, const TslDecoder &decoder);
+  // Send what changed in decoder since the last call, and a keyframe
+  // when one is due. Call after every batch of decoding and on every
+  // pass of the receive task.
+  void service(const TslDecoder &decoder);
+
+  size_t subscribers() const { return numSubscribers; }
+  bool repeatPending() const { return repeatLen > 0; }  // service() is due within TSL_RELAY_REPEAT_MS
+
+ private:
+  struct Subscriber {
+    uint32_t addr;
+    uint16_t port;
+    uint32_t seenMs;
+  };
+
+  void sendKeyframe(const TslDecoder &decoder, const Subscriber *to);
+  void addEntry(uint8_t type, const Subscriber *to, int addr, const TslDisplay &display);
+  void flush(uint8_t type, const Subscriber *to);
+  void sendAll(const uint8_t *data, size_t len);
+  void send(uint32_t addr, uint16_t port, const uint8_t *data, size_t len);
+  void expireSubscribers(uint32_t nowMs);
+
+  UdpSocket &socket;
+  Clock &clock;
+  const FleetCodec &codec;
+  uint32_t epoch = 0;
+  uint32_t sequence = 0;
+  uint32_t keyframeMs = 0;
+  TslDisplay sent[TSL_MAX_ADDRESS + 1] = {};  // As last sent to every subscriber
+  Subscriber subs[TSL_RELAY_MAX_SUBSCRIBERS];
+  size_t numSubscribers = 0;
+  uint8_t buf[TSL_RELAY_MAX_DATAGRAM];
+  size_t used = TSL_RELAY_HEADER_LENGTH;
+  uint8_t count = 0;
+  uint8_t repeat[TSL_RELAY_MAX_DATAGRAM];  // Last delta, until it has been sent again
+  size_t repeatLen = 0;
+  uint32_t repeatMs = 0;
+};
+
+// Subscriber side: a tally fed by a relay
+class TslRelaySubscriber {
+ public:
+  TslRelaySubscriber(UdpSocket &socket, Clock &clock, const FleetCodec &codec)
+      : socket(socket), clock(clock), codec(codec) {}
+
+  TallyMetrics *metrics = NULL;  // Optional: counts gaps
+  uint32_t broadcastAddr = 0xFFFFFFFF;  // Where subscriptions go; network byte order
+  uint16_t relayPort = TSL_RELAY_PORT;
+
+  // Subscribe when due. Call on every pass of the receive task.
+  void service();
+  // A datagram that arrived on the relay port; true if it was applied to
+  // decoder (not stale, and from the relay being followed), with ours
+  // set if it updated our address
+  bool handle(const uint8_t *data, size_t len, uint32_t fromAddr, TslDecoder &decoder, uint32_t rxMicros,
+              bool &ours);
+
+  uint32_t relay() const { return relayAddr; }  // Relay being followed, 0 if none
+  uint32_t gaps() const { return missed; }      // Datagrams missed
+
+ private:
+  void subscribe();
+
+  UdpSocket &socket;
+  Clock &clock;
+  const FleetCodec &codec;
+  uint32_t relayAddr = 0;
+  uint32_t relayEpoch = 0;
+  uint32_t expected = 0;   // Next sequence
+  uint32_t heardMs = 0;
+  uint32_t subscribeMs = 0;
+  uint32_t missed = 0;
+};
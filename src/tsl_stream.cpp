@@ -0,0 +1,220 @@
+/*
+    TSL over TCP
+    Video Walrus 2025
+*/
+
+#include "tsl_stream.h"
+
+#include "log_ring.h"
+
+// ---------------------------------------------------------------------------
+// Deframing
+// ---------------------------------------------------------------------------
+
+void TslStreamDeframer::begin(int streamProtocol) {
+  protocol = streamProtocol;
+  used = 0;
+  inPacket = false;
+  afterDle = false;
+}
+
+int TslStreamDeframer::next(const uint8_t *&data, size_t &len) {
+  return protocol == TSL_PROTOCOL_V50 ? nextTsl5(data, len) : nextTsl31(data, len);
+}
+
+int TslStreamDeframer::nextTsl31(const uint8_t *&data, size_t &len) {
+  while (len > 0) {
+    uint8_t b = *data++;
+    len--;
+    if (b & 0x80) {
+      discardedBytes += used;  // A message cut short
+      used = 0;
+    } else if (used == 0) {
+      discardedBytes++;  // Not at a message start
+      continue;
+    }
+    buf[used++] = b;
+    if (used == TSL31_MESSAGE_LENGTH) {
+      used = 0;
+      return TSL31_MESSAGE_LENGTH;
+    }
+  }
+  return 0;
+}
+
+// Keep one unstuffed byte of the packet; true once PBC says it is complete
+bool TslStreamDeframer::addTsl5Data(uint8_t b) {
+  if (used == 0) pbc = b;
+  else if (used == 1) pbc |= (uint16_t)b << 8;
+  buf[used++] = b;
+  return used >= 2 && used == 2u + pbc;
+}
+
+int TslStreamDeframer::nextTsl5(const uint8_t *&data, size_t &len) {
+  while (len > 0) {
+    if (inPacket && used == sizeof(buf)) {
+      discardedBytes += framedBytes;  // Too big to be a tally packet
+      inPacket = false;
+      used = 0;
+    }
+    uint8_t b = *data;
+    if (afterDle) {
+      afterDle = false;
+      if (b == TSL5_STX) {
+        // A packet starts; one still open was cut short
+        if (inPacket) discardedBytes += framedBytes;
+        data++;
+        len--;
+        used = 0;
+        framedBytes = 2;
+        inPacket = true;
+        continue;
+      }
+      if (!inPacket) {
+        discardedBytes++;
+        continue;  // b itself is looked at again
+      }
+      // DLE/DLE is one DLE of data. A lone DLE is taken as data too.
+      framedBytes++;
+      if (b == TSL5_DLE) {
+        data++;
+        len--;
+        framedBytes++;
+      }
+      if (addTsl5Data(TSL5_DLE)) break;
+      continue;
+    }
+
+    data++;
+    len--;
+    if (b == TSL5_DLE) {
+      afterDle = true;
+      continue;
+    }
+    if (!inPacket) {
+      discardedBytes++;
+      continue;
+    }
+    framedBytes++;
+    if (addTsl5Data(b)) break;
+  }
+  if (!inPacket || used < 2 || used != 2u + pbc) return 0;
+  inPacket = false;
+  int packetLen = used;
+  used = 0;
+  return packetLen;
+}
+
+// ---------------------------------------------------------------------------
+// Client
+// ---------------------------------------------------------------------------
+
+const char *tslTcpStateName(TslTcpState state) {
+  switch (state) {
+    case TSL_TCP_CONNECTING: return "connecting";
+    case TSL_TCP_CONNECTED: return "connected";
+    case TSL_TCP_WAITING: return "waiting";
+    default: return "off";
+  }
+}
+
+void TslTcpClient::setState(TslTcpState state) {
+  tcpState = state;
+  stateMs = clock.millis();
+}
+
+void TslTcpClient::begin(uint32_t serverAddr, uint16_t serverPort, int streamProtocol, uint32_t seed) {
+  stop();
+  rng = seed | 1;
+  addr = serverAddr;
+  port = serverPort;
+  protocol = streamProtocol;
+  if (addr == 0 || port == 0) return;
+  backoffMs = TSL_TCP_RETRY_MS;
+  waitMs = 0;  // First attempt as soon as there is a network
+  setState(TSL_TCP_WAITING);
+}
+
+void TslTcpClient::stop() {
+  socket.stop();
+  setState(TSL_TCP_OFF);
+}
+
+// Close the connection and wait a jittered back-off before the next
+// attempt, so a fleet of tallies doesn't reconnect in step
+void TslTcpClient::drop(const char *why) {
+  uint32_t now = clock.millis();
+  if (tcpState == TSL_TCP_CONNECTED) {
+    if (metrics) TallyMetrics::increment(metrics->tcpDrops);
+    if (now - stateMs >= TSL_TCP_STABLE_MS) backoffMs = TSL_TCP_RETRY_MS;
+  }
+  socket.stop();
+
+  rng ^= rng << 13;
+  rng ^= rng >> 17;
+  rng ^= rng << 5;
+  waitMs = backoffMs / 2 + rng % (backoffMs / 2 + 1);
+  backoffMs = backoffMs * 2 < TSL_TCP_MAX_RETRY_MS ? backoffMs * 2 : TSL_TCP_MAX_RETRY_MS;
+  LOG_INFO_STR("[TCP] %s; retrying in %u ms", why, waitMs);
+  setState(TSL_TCP_WAITING);
+}
+
+void TslTcpClient::service(bool online) {
+  uint32_t now = clock.millis();
+  switch (tcpState) {
+    case TSL_TCP_WAITING:
+      if (!online || now - stateMs < waitMs) return;
+      if (!socket.connect(addr, port)) {
+        drop("Connect failed");
+        return;
+      }
+      setState(TSL_TCP_CONNECTING);
+      return;
+
+    case TSL_TCP_CONNECTING: {
+      int result = socket.connected();
+      if (result > 0) {
+        setState(TSL_TCP_CONNECTED);
+        deframer.begin(protocol);
+        if (metrics) TallyMetrics::increment(metrics->tcpConnects);
+        // addr is in network byte order: first octet in the low byte
+        LOG_INFO("[TCP] Connected to %u.%u.%u.%u:%u", addr & 0xFF, (addr >> 8) & 0xFF, (addr >> 16) & 0xFF,
+                 addr >> 24, port);
+      } else if (result < 0) {
+        drop("Connect refused");
+      } else if (now - stateMs >= TSL_TCP_CONNECT_TIMEOUT_MS) {
+        drop("Connect timed out");
+      }
+      return;
+    }
+
+    case TSL_TCP_CONNECTED:
+      if (!online) drop("Network down");
+      return;
+
+    default:
+      return;
+  }
+}
+
+int TslTcpClient::receive(TslDecoder &decoder, uint32_t rxMicros, bool &ours) {
+  ours = false;
+  if (tcpState != TSL_TCP_CONNECTED) return 0;
+
+  int packets = 0;
+  int n;
+  while ((n = socket.receive(chunk, sizeof(chunk))) > 0) {
+    const uint8_t *data = chunk;
+    size_t len = n;
+    int packetLen;
+    while ((packetLen = deframer.next(data, len)) > 0) {
+      packets++;
+      if (metrics) TallyMetrics::increment(metrics->packetsReceived);
+      bool packetOurs = protocol == TSL_PROTOCOL_V50 ? decoder.decodeTsl5(deframer.packet(), packetLen, rxMicros)
+                                                     : decoder.decodeTsl31(deframer.packet(), packetLen, rxMicros);
+      if (packetOurs) ours = true;
+    }
+  }
+  if (n < 0) drop("Connection closed");
+  return packets;
+}
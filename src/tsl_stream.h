@@ -0,0 +1,114 @@
+/*
+    TSL over TCP
+    Video Walrus 2025
+
+    A persistent client connection to a TSL server or aggregator, for
+    networks where IGMP snooping drops or delays multicast. Bytes arrive
+    as a stream; TslStreamDeframer cuts it back into the packets the
+    decoder takes from UDP:
+
+      TSL 5.0  DLE/STX starts each packet and DLE/DLE escapes a DLE in
+               the data. A packet is handed over unstuffed, exactly as it
+               would come in a datagram, as soon as its byte count (PBC)
+               is complete, not when the next one starts.
+      TSL 3.1  18-byte messages back to back. Only the address byte has
+               bit 7 set, so a message that is cut short is dropped and
+               the stream picks up again at the next one.
+
+    TslTcpClient connects, reconnects with a doubling back-off after a
+    failure or drop, and feeds every packet to the same TslDecoder as the
+    UDP receivers. It runs on the receive task; no heap. Hardware-free,
+    like the tally core.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hal.h"
+#include "tally_core.h"
+
+#define TSL_STREAM_MAX_PACKET 2048    // Unstuffed bytes
+#define TSL_TCP_READ_SIZE 512
+#define TSL_TCP_CONNECT_TIMEOUT_MS 3000
+#define TSL_TCP_RETRY_MS 250          // First back-off; doubles after each failure
+#define TSL_TCP_MAX_RETRY_MS 8000
+#define TSL_TCP_STABLE_MS 10000       // Connected this long: the next drop starts the back-off again
+
+class TslStreamDeframer {
+ public:
+  void begin(int protocol);  // TslProtocol; drops any partial packet
+
+  // Consumes bytes from data (advancing data and len) until a packet is
+  // complete and returns its length, with the packet in packet(); 0 once
+  // len is used up without completing one
+  int next(const uint8_t *&data, size_t &len);
+  uint8_t *packet() { return buf; }
+  uint32_t discarded() const { return discardedBytes; }  // Bytes skipped to find a packet start
+
+ private:
+  int nextTsl31(const uint8_t *&data, size_t &len);
+  int nextTsl5(const uint8_t *&data, size_t &len);
+  bool addTsl5Data(uint8_t b);
+
+  int protocol = TSL_PROTOCOL_V31;
+  uint8_t buf[TSL_STREAM_MAX_PACKET];
+  size_t used = 0;           // Bytes in buf; TSL 5.0: unstuffed, PBC included
+  bool inPacket = false;     // TSL 5.0: after DLE/STX
+  bool afterDle = false;     // TSL 5.0: the last byte was an unpaired DLE
+  uint32_t framedBytes = 0;  // TSL 5.0: stream bytes of the open packet, for discarded()
+  uint16_t pbc = 0;
+  uint32_t discardedBytes = 0;
+};
+
+enum TslTcpState : uint8_t {
+  TSL_TCP_OFF,
+  TSL_TCP_CONNECTING,
+  TSL_TCP_CONNECTED,
+  TSL_TCP_WAITING,  // Back-off before the next attempt
+};
+
+const char *tslTcpStateName(TslTcpState state);
+
+class TslTcpClient {
+ public:
+  TslTcpClient(TcpSocket &socket, Clock &clock) : socket(socket), clock(clock) {}
+
+  TallyMetrics *metrics = NULL;  // Optional: counts connects and drops
+
+  // addr in network byte order; 0 turns the client off. seed spreads
+  // the back-off of tallies that lost the same server.
+  void begin(uint32_t addr, uint16_t port, int protocol, uint32_t seed = 1);
+  void stop();
+
+  // Start, finish or give up on a connect, or wait out the back-off.
+  // Call on every pass of the receive task; online is whether there is a
+  // network to connect over.
+  void service(bool online);
+  // Read what has arrived and decode every complete packet; returns how
+  // many, with ours set if any updated our address. A closed or failed
+  // connection is dropped here.
+  int receive(TslDecoder &decoder, uint32_t rxMicros, bool &ours);
+
+  Socket *waitSocket() { return &socket; }
+  TslTcpState state() const { return tcpState; }
+  uint32_t discarded() const { return deframer.discarded(); }
+
+ private:
+  void setState(TslTcpState state);
+  void drop(const char *why);
+
+  TcpSocket &socket;
+  Clock &clock;
+  TslStreamDeframer deframer;
+  uint32_t addr = 0;
+  uint16_t port = 0;
+  int protocol = TSL_PROTOCOL_V31;
+  TslTcpState tcpState = TSL_TCP_OFF;
+  uint32_t stateMs = 0;     // When tcpState last changed
+  uint32_t waitMs = 0;      // TSL_TCP_WAITING: until the next attempt
+  uint32_t backoffMs = TSL_TCP_RETRY_MS;
+  uint32_t rng = 1;         // Back-off jitter (xorshift32), never 0
+  uint8_t chunk[TSL_TCP_READ_SIZE];
+};
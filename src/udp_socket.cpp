@@ -0,0 +1,163 @@
+/*
+    UDP socket shared by the ESP32 (lwIP) and host builds
+    Video Walrus 2025
+*/
+
+#include "hal.h"
+#include "log_ring.h"
+
+#include <string.h>
+
+#ifdef ARDUINO
+#include <lwip/sockets.h>
+#else
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+bool UdpSocket::beginMulticast(uint32_t group, uint16_t port, const char *ifName, uint32_t ifAddr) {
+  stop();
+
+  int s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (s < 0) {
+    LOG_WARN("[UDP] socket() failed, errno %d", errno);
+    return false;
+  }
+
+  int reuse = 1;
+  setsockopt(s, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+  // One socket per interface on the same port: each only sees its own
+  if (ifName != NULL) {
+    struct ifreq iface = {};
+    strncpy(iface.ifr_name, ifName, sizeof(iface.ifr_name) - 1);
+    if (setsockopt(s, SOL_SOCKET, SO_BINDTODEVICE, &iface, sizeof(iface)) < 0) {
+      LOG_WARN_STR("[UDP] bind to %s failed, errno %d", ifName, errno);
+      close(s);
+      return false;
+    }
+  }
+
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+
+  struct ip_mreq mreq = {};
+  mreq.imr_multiaddr.s_addr = group;
+  mreq.imr_interface.s_addr = ifAddr;  // 0 = INADDR_ANY
+
+  if (bind(s, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+      setsockopt(s, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0) {
+    LOG_WARN("[UDP] bind/join failed, errno %d", errno);
+    close(s);
+    return false;
+  }
+
+  // Non-blocking so receive() can drain the queue after wait()
+  fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) | O_NONBLOCK);
+  fd = s;
+  return true;
+}
+
+bool UdpSocket::begin(uint16_t port) {
+  stop();
+
+  int s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (s < 0) {
+    LOG_WARN("[UDP] socket() failed, errno %d", errno);
+    return false;
+  }
+
+  int reuse = 1;
+  setsockopt(s, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  int broadcast = 1;  // The TSL relay sends to 255.255.255.255
+  setsockopt(s, SOL_SOCKET, SO_BROADCAST, &broadcast, sizeof(broadcast));
+
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  if (bind(s, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+    LOG_WARN("[UDP] bind to port %u failed, errno %d", port, errno);
+    close(s);
+    return false;
+  }
+
+  fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) | O_NONBLOCK);
+  fd = s;
+  return true;
+}
+
+bool UdpSocket::open() {
+  stop();
+
+  int s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (s < 0) {
+    LOG_WARN("[UDP] socket() failed, errno %d", errno);
+    return false;
+  }
+  fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) | O_NONBLOCK);
+  fd = s;
+  return true;
+}
+
+void UdpSocket::stop() {
+  if (fd >= 0) {
+    close(fd);
+    fd = -1;
+  }
+}
+
+uint16_t UdpSocket::localPort() const {
+  struct sockaddr_in addr = {};
+  socklen_t len = sizeof(addr);
+  if (fd < 0 || getsockname(fd, (struct sockaddr *)&addr, &len) < 0) return 0;
+  return ntohs(addr.sin_port);
+}
+
+// Shared with TcpSocket (tcp_socket.cpp)
+bool Socket::wait(Socket *const *sockets, size_t count, uint32_t timeoutMs) {
+  fd_set readSet, writeSet;
+  FD_ZERO(&readSet);
+  FD_ZERO(&writeSet);
+  int maxFd = -1;
+  for (size_t i = 0; i < count; i++) {
+    int s = sockets[i]->fd;
+    if (s < 0) continue;
+    FD_SET(s, sockets[i]->connecting ? &writeSet : &readSet);
+    if (s > maxFd) maxFd = s;
+  }
+  if (maxFd < 0) return false;
+
+  struct timeval timeout = { (time_t)(timeoutMs / 1000), (suseconds_t)((timeoutMs % 1000) * 1000) };
+  return select(maxFd + 1, &readSet, &writeSet, NULL, &timeout) > 0;
+}
+
+int UdpSocket::receive(uint8_t *buf, size_t len, uint32_t *fromAddr, uint16_t *fromPort) {
+  if (fd < 0) return 0;
+
+  struct sockaddr_in remote;
+  socklen_t remoteLen = sizeof(remote);
+  int n = recvfrom(fd, buf, len, 0, (struct sockaddr *)&remote, &remoteLen);
+  if (n <= 0) return 0;  // EWOULDBLOCK - queue drained
+  if (fromAddr) *fromAddr = remote.sin_addr.s_addr;
+  if (fromPort) *fromPort = ntohs(remote.sin_port);
+  return n;
+}
+
+bool UdpSocket::sendTo(uint32_t addr, uint16_t port, const uint8_t *buf, size_t len) {
+  if (fd < 0) return false;
+
+  struct sockaddr_in remote = {};
+  remote.sin_family = AF_INET;
+  remote.sin_port = htons(port);
+  remote.sin_addr.s_addr = addr;
+  return sendto(fd, buf, len, 0, (struct sockaddr *)&remote, sizeof(remote)) == (int)len;
+}
@@ -0,0 +1,409 @@
+// Generated by scripts/build_web.py from web/index.html - do not edit
+// 20395 bytes minified, 6340 bytes gzipped
+
+#pragma once
+
+#include <Arduino.h>
+
+#define INDEX_HTML_ETAG "\"b7739b923b0ecd26\""
+#define INDEX_HTML_GZ_LENGTH 6340
+
+const uint8_t INDEX_HTML_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xbd, 0x3c, 0x6b, 0x73, 0xe3, 0x36,
+  0x92, 0xdf, 0xfd, 0x2b, 0x10, 0x65, 0x13, 0x4a, 0x6b, 0x89, 0xa2, 0x2c, 0xdb, 0x3b, 0x91, 0x2c,
+  0xf9, 0x3c, 0x7e, 0x24, 0x73, 0x37, 0x33, 0x76, 0xd9, 0xce, 0xa4, 0x52, 0xc9, 0xd4, 0x15, 0x2c,
+  0x82, 0x12, 0x63, 0x8a, 0xe4, 0x91, 0x94, 0x65, 0xaf, 0x46, 0xff, 0xfd, 0xba, 0x1b, 0x20, 0x09,
+  0x3e, 0x64, 0xc9, 0xa9, 0xab, 0xdb, 0xad, 0xc4, 0x24, 0xd8, 0xe8, 0x17, 0xfa, 0x09, 0x40, 0x39,
+  0xf9, 0xee, 0xe2, 0xfa, 0xfc, 0xfe, 0xf7, 0x9b, 0x4b, 0x36, 0x4b, 0xe6, 0xde, 0xf8, 0x44, 0xfd,
+  0x5b, 0x70, 0x7b, 0x7c, 0x32, 0x17, 0x09, 0x67, 0x3e, 0x9f, 0x8b, 0x51, 0xe3, 0xc9, 0x15, 0xcb,
+  0x30, 0x88, 0x92, 0x06, 0x9b, 0x04, 0x7e, 0x22, 0xfc, 0x64, 0xd4, 0x58, 0xba, 0x76, 0x32, 0x1b,
+  0xd9, 0xe2, 0xc9, 0x9d, 0x88, 0x0e, 0xbd, 0xb4, 0x99, 0xeb, 0xbb, 0x89, 0xcb, 0xbd, 0x4e, 0x3c,
+  0xe1, 0x9e, 0x18, 0xf5, 0x1a, 0xe3, 0x13, 0xcf, 0xf5, 0x1f, 0x59, 0x24, 0xbc, 0x51, 0xc3, 0x85,
+  0x99, 0x0d, 0x36, 0x8b, 0x84, 0x33, 0x6a, 0xd8, 0x3c, 0xe1, 0x03, 0x77, 0xce, 0xa7, 0xa2, 0x1b,
+  0x3f, 0x4d, 0xf7, 0x9f, 0xe7, 0x5e, 0xfb, 0x04, 0x1e, 0x18, 0x3c, 0xf8, 0xf1, 0xc8, 0x98, 0x25,
+  0x49, 0x38, 0xe8, 0x76, 0x97, 0xcb, 0xa5, 0xb9, 0xec, 0x9b, 0x41, 0x34, 0xed, 0x1e, 0x58, 0x96,
+  0x85, 0xa0, 0x06, 0x43, 0x4e, 0xde, 0x07, 0xcf, 0x23, 0xc3, 0x62, 0x16, 0xeb, 0x59, 0xf4, 0x8f,
+  0x31, 0x3e, 0x99, 0xb8, 0xd1, 0xc4, 0x13, 0x6c, 0x02, 0x1f, 0x8e, 0x2c, 0x83, 0x4d, 0x5e, 0xe4,
+  0xdf, 0x68, 0x64, 0x1c, 0x1e, 0x19, 0xcc, 0x71, 0x3d, 0x6f, 0x64, 0xfc, 0x70, 0xd0, 0x77, 0x1c,
+  0x40, 0x64, 0x19, 0xdd, 0xf1, 0x09, 0x62, 0x1b, 0x03, 0x83, 0x89, 0x9b, 0x78, 0x62, 0x7c, 0x7f,
+  0xf7, 0x91, 0xdd, 0x73, 0xcf, 0x7b, 0x61, 0xe7, 0x81, 0xef, 0xb8, 0xd3, 0x45, 0xc4, 0x13, 0x37,
+  0xf0, 0x4f, 0xba, 0xf2, 0xf3, 0x49, 0x9c, 0xbc, 0xc0, 0x9f, 0xbd, 0x87, 0xc0, 0x7e, 0x59, 0x39,
+  0xa0, 0x81, 0x8e, 0xc3, 0xe7, 0xae, 0xf7, 0x32, 0x38, 0x8b, 0x40, 0xdc, 0x76, 0xcc, 0xfd, 0xb8,
+  0x13, 0x8b, 0xc8, 0x75, 0x86, 0x73, 0x1e, 0x4d, 0x5d, 0x7f, 0x70, 0x60, 0x85, 0xcf, 0xc3, 0x07,
+  0x3e, 0x79, 0x9c, 0x46, 0xc1, 0xc2, 0xb7, 0x07, 0xdf, 0xf7, 0x78, 0x8f, 0x1f, 0x88, 0xe1, 0x24,
+  0xf0, 0x82, 0x68, 0xf0, 0xbd, 0x10, 0x62, 0x98, 0x44, 0x30, 0xcb, 0x45, 0x2a, 0x83, 0x1c, 0xb0,
+  0x43, 0x00, 0xcc, 0x32, 0xfb, 0xf1, 0x9a, 0xa8, 0x99, 0x09, 0x72, 0xd5, 0x09, 0x1c, 0x67, 0x55,
+  0x45, 0xb7, 0xd6, 0x20, 0xa6, 0x91, 0x10, 0x7e, 0x01, 0xc6, 0xe2, 0x7d, 0xdb, 0xe2, 0x3a, 0x4c,
+  0x24, 0xec, 0x02, 0xc4, 0xa1, 0x8d, 0xda, 0xd0, 0x21, 0x5e, 0x84, 0xe7, 0x05, 0xcb, 0x12, 0x10,
+  0x82, 0xad, 0xf7, 0x4c, 0x5c, 0x79, 0xee, 0xfa, 0x22, 0x5a, 0xcd, 0xf9, 0xb3, 0x5c, 0xf1, 0xc1,
+  0x91, 0x85, 0x82, 0x2a, 0xa1, 0x2d, 0xc6, 0x17, 0x49, 0xb0, 0xde, 0x9b, 0xf5, 0x56, 0x4a, 0x4e,
+  0xcb, 0xb2, 0x0f, 0x1d, 0x67, 0x98, 0x88, 0xe7, 0xa4, 0xc3, 0x3d, 0x77, 0xea, 0x0f, 0x26, 0x60,
+  0x3b, 0x22, 0x42, 0x6c, 0x3c, 0x2a, 0x32, 0xd3, 0x3b, 0x3e, 0xe8, 0xf5, 0xc5, 0x30, 0xe4, 0xb6,
+  0xed, 0xfa, 0x53, 0xa5, 0xc1, 0x20, 0xb2, 0x45, 0xd4, 0x89, 0xb8, 0xed, 0x2e, 0xe2, 0x41, 0x2f,
+  0xa7, 0xd5, 0x79, 0x08, 0x92, 0x24, 0x98, 0x13, 0x94, 0x42, 0xc6, 0x66, 0x07, 0x2b, 0xf5, 0x31,
+  0x09, 0xc2, 0x81, 0x35, 0x2c, 0xf2, 0xa0, 0x50, 0xa9, 0x79, 0xbd, 0xf0, 0x99, 0xc5, 0x81, 0xe7,
+  0xda, 0xec, 0x7b, 0xcb, 0xe9, 0x1f, 0x1e, 0x5b, 0x29, 0xdd, 0x0c, 0x80, 0x10, 0x7b, 0xfc, 0x41,
+  0x78, 0x2b, 0xdb, 0x8d, 0x43, 0x8f, 0xbf, 0x0c, 0x1e, 0xbc, 0x60, 0xf2, 0x98, 0x0a, 0x8b, 0x00,
+  0x60, 0x81, 0x47, 0xc0, 0x12, 0x19, 0xc4, 0x52, 0xb8, 0xd3, 0x59, 0x32, 0x78, 0x08, 0x3c, 0x7b,
+  0xbd, 0xe7, 0xfa, 0xe1, 0x22, 0xf9, 0x23, 0x79, 0x09, 0xc5, 0x08, 0x65, 0xff, 0xda, 0xd6, 0x06,
+  0xfc, 0xc5, 0xfc, 0x41, 0x44, 0x85, 0xa1, 0x90, 0xc7, 0xf1, 0x12, 0xf8, 0xfb, 0xda, 0x8e, 0x85,
+  0x27, 0x26, 0xc9, 0x4a, 0x2a, 0x17, 0x2c, 0xfb, 0x87, 0x4c, 0x1f, 0xbd, 0x5c, 0x1f, 0x35, 0xdc,
+  0x17, 0x15, 0x75, 0x54, 0x32, 0x3e, 0x05, 0xa4, 0x19, 0xdf, 0x43, 0xf0, 0xdc, 0x89, 0xdd, 0x7f,
+  0x23, 0xe2, 0x4c, 0x31, 0xcf, 0x8a, 0xef, 0x81, 0x13, 0x4c, 0x16, 0xb1, 0x62, 0x45, 0xbe, 0xac,
+  0x82, 0x45, 0x02, 0x9e, 0x2c, 0x06, 0x7e, 0xe0, 0x8b, 0x94, 0x58, 0x41, 0xbf, 0xb0, 0x08, 0x6e,
+  0xd8, 0x71, 0x5c, 0xe1, 0xd9, 0x71, 0xdb, 0x5c, 0xba, 0x8e, 0xab, 0x5e, 0x32, 0xed, 0xe1, 0xd4,
+  0x75, 0x0e, 0x64, 0xc6, 0xb3, 0x60, 0x59, 0x80, 0xa4, 0x91, 0xa2, 0xb2, 0xc1, 0x07, 0x16, 0xb0,
+  0x1c, 0x7e, 0xad, 0x42, 0x2a, 0x52, 0xca, 0x85, 0x56, 0x6c, 0x29, 0x87, 0x53, 0x1a, 0xd3, 0xf9,
+  0xd6, 0x94, 0x44, 0x2b, 0x07, 0x7a, 0x10, 0x83, 0xde, 0x71, 0xcd, 0x42, 0x0e, 0x27, 0x8b, 0x28,
+  0x06, 0x64, 0x61, 0xe0, 0xa2, 0xd5, 0x0e, 0x35, 0xf3, 0x92, 0x86, 0x27, 0xb9, 0x1b, 0xcc, 0x82,
+  0x27, 0xf0, 0x8a, 0x22, 0x2f, 0x0f, 0x87, 0xf6, 0x3b, 0x50, 0x4a, 0x22, 0xe2, 0xa4, 0xf3, 0x90,
+  0xf8, 0xb9, 0x1e, 0x1c, 0x4f, 0x3c, 0x0f, 0xa7, 0x3c, 0x2c, 0x98, 0x33, 0xa2, 0x94, 0x26, 0x97,
+  0xcd, 0x58, 0x21, 0xe0, 0xa0, 0x57, 0x90, 0x97, 0xe9, 0x56, 0xf0, 0x9a, 0x4c, 0xaf, 0x08, 0xa1,
+  0xc9, 0x7c, 0x58, 0x20, 0xa8, 0xc4, 0x08, 0x42, 0x3e, 0x71, 0x93, 0x97, 0x81, 0x65, 0x22, 0xff,
+  0x30, 0x5e, 0x17, 0x5a, 0x1c, 0xcd, 0xbd, 0xac, 0x35, 0x41, 0x95, 0x83, 0x0b, 0x44, 0xda, 0x14,
+  0xc6, 0x01, 0xfb, 0x20, 0x98, 0x9a, 0xf0, 0xe2, 0x14, 0x51, 0xed, 0x99, 0x71, 0xc2, 0x13, 0xb0,
+  0xb8, 0x1a, 0xfb, 0x2d, 0xae, 0x7c, 0x45, 0xf0, 0xda, 0xc8, 0x20, 0xb1, 0x75, 0xdc, 0x44, 0xcc,
+  0x8b, 0x2b, 0xf0, 0xd7, 0x22, 0x4e, 0x5c, 0xe7, 0xa5, 0xa3, 0xf2, 0xd9, 0x20, 0x06, 0xb1, 0x45,
+  0xe7, 0x41, 0x24, 0x4b, 0x10, 0x36, 0x23, 0x85, 0x3a, 0x47, 0xa6, 0xf2, 0x28, 0xac, 0x78, 0x7d,
+  0xf7, 0xee, 0xdd, 0xba, 0x10, 0x79, 0x53, 0x19, 0x1c, 0x6b, 0xad, 0x45, 0xdb, 0x54, 0x01, 0x56,
+  0x36, 0xaa, 0x54, 0x90, 0x69, 0x06, 0xb1, 0xfb, 0x41, 0x22, 0x56, 0xda, 0xba, 0x1c, 0x80, 0x34,
+  0x39, 0x1d, 0xdd, 0x46, 0x8e, 0x64, 0xb8, 0x0b, 0x7c, 0xbf, 0x23, 0x92, 0x59, 0x8a, 0xe5, 0xf0,
+  0xfc, 0xec, 0xea, 0x08, 0x28, 0xd0, 0x38, 0x7a, 0x54, 0xfa, 0xe1, 0xa0, 0xf7, 0xd3, 0xf1, 0x55,
+  0x5f, 0x7d, 0xe0, 0x61, 0x3a, 0x7c, 0x75, 0xf5, 0xd3, 0x3b, 0xd2, 0xb5, 0xca, 0xde, 0x9e, 0x1b,
+  0x27, 0x14, 0xd4, 0x67, 0xd2, 0x6c, 0xfa, 0x14, 0xd5, 0xd1, 0x1a, 0x1c, 0xe0, 0xb5, 0xf3, 0x32,
+  0x90, 0x71, 0x3d, 0x05, 0xaf, 0x2a, 0x93, 0x62, 0x3b, 0x8d, 0xc7, 0x2a, 0xc2, 0x97, 0xe2, 0x56,
+  0x75, 0x31, 0xb7, 0xad, 0xdf, 0x3b, 0x92, 0x54, 0x51, 0x54, 0x36, 0xa1, 0xa2, 0x00, 0xaa, 0x47,
+  0x71, 0x4a, 0xcf, 0x25, 0x54, 0x10, 0x23, 0x14, 0xaa, 0x48, 0xc2, 0x20, 0x07, 0xc8, 0x66, 0x27,
+  0x9e, 0x45, 0x50, 0x8e, 0x0c, 0xac, 0x32, 0x62, 0xb3, 0x9c, 0x5e, 0x8f, 0x8f, 0x8f, 0xd7, 0x25,
+  0x90, 0x5a, 0x27, 0x28, 0x03, 0xd5, 0xf8, 0x40, 0x19, 0xa4, 0xde, 0x05, 0x34, 0xe5, 0xfa, 0x4e,
+  0x90, 0xba, 0xfe, 0xdc, 0xf5, 0x55, 0x9e, 0xd5, 0x00, 0xb0, 0x20, 0x5b, 0x55, 0x9c, 0x7c, 0x39,
+  0x03, 0xed, 0x77, 0xc8, 0x88, 0x21, 0x30, 0x2c, 0x23, 0x1e, 0x66, 0xeb, 0x37, 0x98, 0xb9, 0xb6,
+  0x0d, 0x36, 0x4d, 0x59, 0x38, 0x1b, 0x04, 0x36, 0xdc, 0x30, 0x76, 0xe3, 0x1c, 0xb1, 0x0d, 0xe5,
+  0x9e, 0xeb, 0xc5, 0x9b, 0x0d, 0x51, 0x37, 0x18, 0xff, 0x71, 0x95, 0xae, 0xf0, 0x3b, 0x8c, 0x4b,
+  0x07, 0xbb, 0x04, 0x63, 0xe2, 0xc0, 0x16, 0x93, 0x40, 0x56, 0x57, 0x75, 0x11, 0xec, 0xb0, 0x18,
+  0x95, 0x11, 0x6d, 0x55, 0xb4, 0x22, 0x23, 0xaf, 0x85, 0x5f, 0xa8, 0x36, 0x23, 0x11, 0xcf, 0x28,
+  0x9e, 0xbe, 0x12, 0x51, 0x48, 0x84, 0xaa, 0x0d, 0xf6, 0xa4, 0xbb, 0x69, 0x48, 0x6a, 0x68, 0xf5,
+  0xf8, 0x21, 0xff, 0x17, 0xc7, 0x50, 0xb9, 0xf0, 0x1e, 0x37, 0x84, 0xfa, 0x77, 0xa5, 0x48, 0x2f,
+  0xf1, 0xa6, 0x13, 0x2a, 0x91, 0xde, 0xaa, 0x2a, 0x41, 0xaf, 0x6c, 0x28, 0x62, 0x74, 0xa4, 0x06,
+  0xe2, 0x55, 0xa5, 0xb8, 0x4a, 0x95, 0x0e, 0x46, 0x5c, 0xa8, 0xa6, 0x50, 0x6b, 0x6e, 0x3c, 0x09,
+  0xc8, 0x06, 0x80, 0xbd, 0x42, 0x66, 0x1e, 0x86, 0x81, 0x2a, 0x46, 0x1d, 0xf7, 0x59, 0xd8, 0x43,
+  0x59, 0x42, 0x79, 0xc2, 0x49, 0xe0, 0x8f, 0x96, 0x7d, 0x53, 0xbf, 0xc3, 0x67, 0x4d, 0x0b, 0xd1,
+  0xf4, 0x81, 0x37, 0xad, 0x36, 0xfd, 0xdf, 0xfc, 0xa9, 0x35, 0xfc, 0x37, 0xd8, 0xb1, 0x0d, 0x42,
+  0xfd, 0x04, 0xff, 0xab, 0x84, 0x5a, 0xc5, 0x66, 0x4d, 0xd0, 0x20, 0x2f, 0xb5, 0xdd, 0x08, 0x0a,
+  0x0f, 0x64, 0x05, 0x04, 0x59, 0xcc, 0xfd, 0x32, 0xdf, 0x26, 0x87, 0xaf, 0x4f, 0xa2, 0xa0, 0xe5,
+  0x0c, 0x06, 0xb5, 0xa1, 0x59, 0xf0, 0xe1, 0xbb, 0xba, 0x8c, 0x58, 0x55, 0x19, 0xf7, 0xa1, 0x1b,
+  0x21, 0x9a, 0x12, 0x4d, 0x04, 0x85, 0xee, 0x43, 0xb0, 0x84, 0x42, 0xfc, 0x28, 0x66, 0x58, 0xf9,
+  0xf0, 0x08, 0x9a, 0x1b, 0x07, 0xfb, 0x1b, 0xb1, 0xde, 0xfb, 0x8f, 0x47, 0xf1, 0xe2, 0x44, 0xe0,
+  0x87, 0x31, 0x2b, 0x80, 0xaf, 0xac, 0x1f, 0xf4, 0x88, 0xdf, 0x3b, 0xfe, 0x41, 0x8f, 0xf3, 0xfd,
+  0xfe, 0x0f, 0x7a, 0x96, 0x38, 0xb2, 0xb4, 0x57, 0x67, 0x7d, 0x9c, 0x03, 0x5b, 0x96, 0xb3, 0x7e,
+  0xd7, 0xd7, 0x50, 0x39, 0x6b, 0xd4, 0xb7, 0x8e, 0x3a, 0x93, 0x77, 0xc2, 0xfd, 0x09, 0x94, 0xa8,
+  0x9a, 0x79, 0x1c, 0xa2, 0xf5, 0xe8, 0xeb, 0xce, 0x0e, 0x8b, 0xf6, 0x54, 0xe9, 0x4d, 0x26, 0x96,
+  0x55, 0xa8, 0x29, 0xf2, 0xac, 0x5d, 0x57, 0x80, 0x17, 0xcb, 0x89, 0x12, 0x23, 0x35, 0xfe, 0x81,
+  0xec, 0xee, 0x41, 0xbb, 0x45, 0x1d, 0xd4, 0x49, 0x57, 0xb6, 0x96, 0xd8, 0x72, 0x8c, 0x4f, 0x6c,
+  0xf7, 0x89, 0x4d, 0x3c, 0x28, 0x7e, 0x47, 0x8d, 0xac, 0xb9, 0x80, 0x96, 0x6c, 0xd6, 0xdb, 0xdc,
+  0x8f, 0xc1, 0x37, 0x7d, 0x9a, 0x0c, 0xaa, 0x8d, 0x9a, 0x31, 0x32, 0x2c, 0xf8, 0x00, 0x71, 0xc3,
+  0x1f, 0x03, 0x12, 0x5f, 0xd9, 0x14, 0x70, 0x82, 0x23, 0x34, 0xce, 0x5c, 0x9b, 0x28, 0xab, 0x6f,
+  0x8d, 0x71, 0x27, 0xfd, 0xda, 0x05, 0x7c, 0xdb, 0x90, 0x7e, 0xb8, 0x61, 0x67, 0xb6, 0x0d, 0x91,
+  0x21, 0xae, 0x41, 0xba, 0x88, 0x22, 0xb0, 0xac, 0x0f, 0x37, 0x6f, 0xc4, 0x29, 0x65, 0xbe, 0x83,
+  0x0f, 0xa2, 0x8a, 0x94, 0x0a, 0x08, 0xfa, 0xd6, 0x48, 0x51, 0x64, 0x75, 0xc9, 0x5b, 0xe9, 0xa0,
+  0x7e, 0xc1, 0x0b, 0x36, 0x10, 0xc1, 0x4f, 0xbb, 0x62, 0xa4, 0x59, 0x50, 0x8c, 0x7c, 0xe2, 0x93,
+  0xdb, 0x60, 0xd9, 0x60, 0xb4, 0xd0, 0xd0, 0xe2, 0x6b, 0xc1, 0x25, 0xa5, 0x7a, 0x79, 0xff, 0x0b,
+  0xfb, 0x74, 0x76, 0x5e, 0x25, 0x2a, 0xa7, 0x37, 0xc6, 0xbb, 0x13, 0xc4, 0x2a, 0x67, 0x07, 0x8a,
+  0xbf, 0xb9, 0x57, 0x6e, 0x3d, 0x49, 0x85, 0xe0, 0x2d, 0x34, 0x79, 0x78, 0x77, 0xf7, 0xe1, 0x62,
+  0x1b, 0xc9, 0xb3, 0x1b, 0x86, 0x60, 0x55, 0x8a, 0x72, 0xfa, 0x8e, 0x04, 0x15, 0xb2, 0x2b, 0x37,
+  0x9a, 0x2f, 0x79, 0x54, 0x63, 0x0c, 0xce, 0xf2, 0x8b, 0x88, 0xe2, 0xa2, 0xd5, 0xca, 0x76, 0x84,
+  0x51, 0x4f, 0xd9, 0x90, 0x2f, 0x0d, 0x16, 0xf8, 0x13, 0xcf, 0x9d, 0x3c, 0x82, 0x4d, 0xce, 0xc4,
+  0xe4, 0xf1, 0xd7, 0xd0, 0x06, 0xfb, 0x69, 0x3a, 0xdc, 0x8b, 0x45, 0x2b, 0x93, 0x43, 0x06, 0x78,
+  0xac, 0xf2, 0xd2, 0x44, 0x43, 0x91, 0xbf, 0xdc, 0xa1, 0xe4, 0x09, 0xf3, 0x30, 0xcd, 0xf9, 0x5a,
+  0x9a, 0xea, 0x55, 0x82, 0x43, 0x63, 0x7c, 0x8e, 0x34, 0x4f, 0xba, 0x92, 0x97, 0x5d, 0x74, 0xbc,
+  0x20, 0xfe, 0x3e, 0x07, 0x09, 0xe4, 0xb6, 0xd7, 0xd4, 0x9c, 0x7e, 0xca, 0x62, 0xd5, 0xf1, 0xc3,
+  0xf1, 0x43, 0x63, 0x2c, 0xc5, 0x63, 0x67, 0x4f, 0x50, 0xc9, 0xf0, 0x07, 0xaf, 0x46, 0x6f, 0x1e,
+  0xc7, 0x7e, 0x27, 0xd5, 0xdd, 0x06, 0x34, 0xbb, 0x29, 0xd4, 0xf5, 0x63, 0xf4, 0x16, 0xa5, 0xd2,
+  0x5c, 0x9b, 0x15, 0x15, 0x66, 0xd1, 0x18, 0xb4, 0xf6, 0xae, 0x9a, 0xdb, 0x0b, 0xbb, 0x2d, 0x54,
+  0xca, 0xab, 0x10, 0x4c, 0x95, 0xcf, 0x2b, 0xed, 0x5e, 0xbf, 0x46, 0xe3, 0x1f, 0x24, 0x53, 0x65,
+  0x9d, 0x57, 0x34, 0x8f, 0x5b, 0x26, 0x18, 0x6b, 0x0f, 0xc6, 0xf7, 0xa0, 0x0f, 0x19, 0x6c, 0x21,
+  0xbc, 0x1e, 0x8c, 0x4f, 0xc2, 0x14, 0x04, 0xdb, 0x92, 0xc6, 0xf8, 0x17, 0xc8, 0x98, 0x2c, 0x55,
+  0x44, 0xc0, 0x50, 0x7b, 0xac, 0x83, 0x5b, 0x7a, 0x82, 0xc7, 0x90, 0x00, 0x61, 0x08, 0xc2, 0xcf,
+  0x49, 0x37, 0x2c, 0x60, 0xcf, 0xda, 0xde, 0xc6, 0x06, 0x25, 0x96, 0xe0, 0x58, 0xd6, 0x67, 0xa2,
+  0x7e, 0xe7, 0xc1, 0x22, 0x16, 0x76, 0xb0, 0xf4, 0x25, 0xc0, 0xb5, 0xdf, 0xec, 0xb5, 0xb2, 0xf1,
+  0x45, 0xa8, 0x46, 0x1d, 0xa7, 0x49, 0xa3, 0x49, 0xb0, 0x98, 0xcc, 0x40, 0xe8, 0x28, 0x29, 0x81,
+  0xd3, 0x07, 0xe1, 0xdb, 0x3a, 0xfc, 0xf8, 0xe7, 0xdb, 0xcb, 0xcb, 0xcf, 0xb9, 0x76, 0x76, 0x66,
+  0x0e, 0x4a, 0xfb, 0x7a, 0xd6, 0x0e, 0xde, 0xc6, 0xda, 0xc1, 0x66, 0xd6, 0x6e, 0x2f, 0x2f, 0xfe,
+  0x06, 0x63, 0xb2, 0xa1, 0xa8, 0xe7, 0xad, 0xff, 0x36, 0xde, 0xfa, 0x9b, 0x79, 0xfb, 0xfd, 0xf2,
+  0xe3, 0xc7, 0xeb, 0xdf, 0xde, 0x60, 0x55, 0x9f, 0xa1, 0x93, 0x0e, 0xa2, 0x47, 0x76, 0x21, 0xcb,
+  0x54, 0x69, 0x5a, 0xaf, 0x09, 0xa5, 0x55, 0xd9, 0x9a, 0x8f, 0x51, 0x71, 0x01, 0x25, 0x85, 0x42,
+  0xd3, 0x4c, 0xa2, 0x05, 0xc4, 0xad, 0xf1, 0x1d, 0x94, 0x1b, 0x4c, 0x91, 0xc8, 0x99, 0x42, 0x46,
+  0xd0, 0xc7, 0x65, 0x69, 0xfc, 0x11, 0xba, 0xda, 0x0c, 0xbb, 0xd6, 0xe9, 0x36, 0x0a, 0x26, 0x9e,
+  0xd6, 0xd1, 0x10, 0xab, 0x90, 0x22, 0x23, 0xcc, 0x60, 0xd4, 0x50, 0xeb, 0xd9, 0xcc, 0x4e, 0x99,
+  0x0f, 0x6b, 0x64, 0xcd, 0xea, 0xfd, 0x2d, 0x36, 0x9e, 0xc2, 0x15, 0x6d, 0x5c, 0xc9, 0x87, 0x1f,
+  0xd1, 0x01, 0xd1, 0x64, 0xc7, 0x67, 0x9e, 0xc7, 0xde, 0x60, 0x9f, 0x05, 0xc4, 0xca, 0x3e, 0xcb,
+  0x68, 0x0f, 0x14, 0xda, 0x9d, 0x6d, 0x2b, 0x45, 0x5a, 0x87, 0xcc, 0xca, 0x63, 0x9c, 0x1e, 0xb3,
+  0xfa, 0xfd, 0xbe, 0x56, 0x33, 0x4a, 0x7a, 0xd7, 0x57, 0x57, 0x65, 0x63, 0x09, 0x65, 0xde, 0xf2,
+  0x84, 0x48, 0xee, 0x64, 0xd9, 0x56, 0x0c, 0x34, 0xa4, 0xe5, 0x52, 0xf0, 0xb9, 0x50, 0xcb, 0x1f,
+  0xb3, 0x20, 0x99, 0x89, 0x88, 0x61, 0xdd, 0x42, 0x15, 0x0a, 0x14, 0xe5, 0x50, 0xce, 0xc3, 0x30,
+  0x88, 0x31, 0x13, 0xcc, 0x57, 0xd6, 0xf6, 0xe4, 0x72, 0x36, 0xbf, 0xf8, 0x7c, 0xa7, 0xad, 0x98,
+  0x13, 0x44, 0x73, 0xc6, 0xa9, 0xc0, 0x1b, 0x35, 0xba, 0x31, 0x7f, 0x82, 0xbc, 0x32, 0x87, 0x82,
+  0x23, 0x00, 0x66, 0x6e, 0xae, 0xef, 0xee, 0x1b, 0x9b, 0xc2, 0x22, 0x90, 0xba, 0x13, 0x49, 0x02,
+  0x81, 0x5b, 0x59, 0x2f, 0xed, 0x06, 0x33, 0xc0, 0x07, 0x9e, 0x11, 0x7b, 0x37, 0x51, 0x90, 0x04,
+  0x8d, 0x31, 0xfd, 0x01, 0xe9, 0x4f, 0xba, 0xf4, 0x19, 0x32, 0x0d, 0xed, 0x9b, 0xca, 0x5a, 0x2a,
+  0x85, 0x52, 0xa7, 0x28, 0xf9, 0xac, 0x93, 0x20, 0x44, 0x86, 0xd8, 0x13, 0xf7, 0x16, 0xf0, 0xc1,
+  0x6a, 0x10, 0xb9, 0xbe, 0xd9, 0x3b, 0xe9, 0xca, 0x2f, 0x65, 0x88, 0x9e, 0x84, 0x38, 0x32, 0xad,
+  0x1c, 0xa2, 0x2b, 0x49, 0x95, 0x19, 0xc3, 0xa2, 0x54, 0x42, 0xab, 0xf2, 0x94, 0x35, 0xad, 0x4e,
+  0xef, 0xe0, 0xb8, 0x95, 0xb1, 0x48, 0xdb, 0xbc, 0x6a, 0xf9, 0xe5, 0x76, 0x74, 0x23, 0xe5, 0x97,
+  0x26, 0xe7, 0xec, 0xca, 0xd7, 0xb9, 0xeb, 0x23, 0x8f, 0x6c, 0xce, 0x9f, 0x81, 0x93, 0x83, 0xe3,
+  0x06, 0x84, 0xff, 0xff, 0x59, 0x40, 0x9b, 0x66, 0x97, 0x69, 0x7f, 0x9a, 0x70, 0x74, 0xb0, 0x4f,
+  0x0b, 0x0f, 0x12, 0x38, 0x3c, 0xa6, 0x2c, 0xd4, 0x92, 0xc6, 0x36, 0x2c, 0x23, 0x2c, 0x67, 0xe6,
+  0x94, 0xd5, 0xfb, 0x26, 0x42, 0x37, 0x78, 0x18, 0x45, 0x42, 0xe2, 0xd3, 0x2e, 0x92, 0xd1, 0x0c,
+  0x6d, 0x21, 0xe8, 0x95, 0x24, 0xeb, 0x29, 0xc9, 0x8e, 0x8f, 0x8e, 0xfa, 0x47, 0x5b, 0x64, 0xbb,
+  0xf6, 0x35, 0xe9, 0x36, 0xac, 0x79, 0x0a, 0x58, 0x12, 0x06, 0xa7, 0x56, 0x57, 0xf5, 0xda, 0xdf,
+  0xb4, 0xe4, 0x60, 0x14, 0xd7, 0x98, 0x59, 0xb7, 0x2c, 0xf7, 0xaf, 0x76, 0x28, 0x95, 0xf1, 0xab,
+  0x2f, 0x55, 0xbe, 0xab, 0x42, 0xd2, 0x89, 0x39, 0x9b, 0xd9, 0x48, 0x61, 0xc1, 0xa5, 0x5a, 0x2a,
+  0xae, 0x79, 0xe6, 0xc5, 0x50, 0x0d, 0xf0, 0x47, 0x41, 0x4e, 0x19, 0x43, 0xb7, 0x03, 0xb1, 0x01,
+  0x1a, 0x61, 0x70, 0x4b, 0xaa, 0x13, 0x66, 0x6e, 0xac, 0xe2, 0xa7, 0x74, 0x52, 0x78, 0xfd, 0xf5,
+  0xe2, 0x86, 0xe1, 0x29, 0xa2, 0xc9, 0x2c, 0x96, 0x2c, 0x22, 0x3f, 0x66, 0x6e, 0x82, 0xd5, 0x83,
+  0x49, 0xee, 0x5a, 0x14, 0xeb, 0x7e, 0x12, 0xfe, 0x12, 0xa0, 0x2d, 0xdd, 0x9f, 0x43, 0x41, 0x2d,
+  0x22, 0x08, 0x02, 0xec, 0xc3, 0xcd, 0x76, 0x3b, 0x4a, 0xe7, 0xe5, 0x52, 0x65, 0x23, 0x20, 0x8d,
+  0x27, 0xfc, 0x69, 0x32, 0x03, 0xc5, 0xc3, 0x3a, 0x87, 0x3c, 0x81, 0x8a, 0x09, 0x04, 0xfd, 0xc3,
+  0xea, 0xfc, 0x64, 0x7e, 0xfd, 0x67, 0xa3, 0x86, 0x05, 0x65, 0x66, 0xc0, 0xc2, 0xae, 0x5a, 0x4d,
+  0x27, 0x15, 0xe8, 0x6f, 0x34, 0xb6, 0x8a, 0x56, 0x21, 0x32, 0xbe, 0x30, 0xd5, 0x92, 0x0a, 0x1b,
+  0x15, 0xc9, 0x95, 0x7e, 0x49, 0x03, 0x41, 0xc4, 0xf8, 0x14, 0x72, 0xc8, 0x94, 0x27, 0xf8, 0x08,
+  0x29, 0x2a, 0x12, 0x0a, 0x9a, 0xb9, 0x0e, 0xaa, 0xd3, 0x8e, 0x82, 0x30, 0x36, 0xd9, 0x7b, 0x8f,
+  0xfb, 0x8f, 0xaf, 0x2b, 0x19, 0x4a, 0x38, 0xfe, 0x72, 0x1b, 0x78, 0x40, 0xf5, 0x16, 0x1f, 0xeb,
+  0xac, 0x39, 0x87, 0x51, 0xf2, 0x68, 0x93, 0xb6, 0x98, 0x6b, 0xc5, 0xd2, 0x89, 0x88, 0x8c, 0xe0,
+  0x81, 0x0a, 0xe7, 0x18, 0xca, 0x5d, 0xcc, 0xaf, 0xf5, 0x93, 0x0e, 0x40, 0xf5, 0xa9, 0x81, 0x39,
+  0x51, 0x00, 0x61, 0x9c, 0x45, 0x92, 0xd3, 0x8a, 0x4f, 0x94, 0x8d, 0x93, 0x2d, 0xd1, 0x85, 0x55,
+  0xae, 0xc0, 0x94, 0x8e, 0x67, 0x6c, 0x68, 0x88, 0x81, 0x0f, 0x03, 0x98, 0x32, 0x26, 0x33, 0xee,
+  0x4f, 0x65, 0x01, 0x4b, 0x5d, 0xa2, 0xe2, 0xa5, 0xcd, 0xa0, 0xea, 0x9e, 0xcc, 0x10, 0xc4, 0x87,
+  0xb4, 0x02, 0x38, 0x00, 0x23, 0xfb, 0x0b, 0xca, 0x6b, 0x9a, 0x35, 0xcf, 0x22, 0x1b, 0x66, 0xbf,
+  0xd0, 0x84, 0x22, 0x44, 0xd8, 0x31, 0x30, 0x46, 0x79, 0x8d, 0x3d, 0x8a, 0x97, 0x21, 0x69, 0x9d,
+  0xe5, 0x21, 0x10, 0x74, 0x9f, 0xa6, 0x29, 0x45, 0x03, 0x9e, 0x79, 0x22, 0x7d, 0x47, 0x17, 0xab,
+  0xb2, 0x42, 0x60, 0x28, 0xef, 0x69, 0x0f, 0x1b, 0x62, 0x0e, 0x7f, 0x66, 0xf2, 0xd9, 0xa7, 0x88,
+  0xde, 0xeb, 0x1c, 0x1c, 0x1d, 0x6d, 0x8f, 0xe8, 0x39, 0x06, 0xb5, 0x7e, 0xda, 0x40, 0xc1, 0x1c,
+  0x01, 0x9b, 0x1e, 0xf9, 0x4a, 0xea, 0xc4, 0x05, 0x78, 0xd0, 0xa8, 0x5b, 0x9d, 0x7e, 0x0b, 0xe6,
+  0x85, 0xa4, 0x3d, 0x0b, 0xda, 0x01, 0xc0, 0xa1, 0x01, 0x94, 0xe5, 0xf0, 0x84, 0x7d, 0xbd, 0x48,
+  0x80, 0x43, 0x28, 0x95, 0x3e, 0x5e, 0x5e, 0x30, 0xf5, 0xb2, 0xc5, 0x99, 0xb5, 0x59, 0x8a, 0x79,
+  0x7d, 0x44, 0x73, 0xe6, 0xe3, 0xc3, 0x92, 0x33, 0x0f, 0xda, 0x8c, 0xdc, 0xb9, 0x24, 0xc5, 0xcf,
+  0x37, 0x1f, 0xae, 0x07, 0x48, 0x7f, 0x02, 0x75, 0x4b, 0xc2, 0x42, 0xf4, 0x27, 0x42, 0xd7, 0x66,
+  0xc2, 0x9c, 0x9a, 0xac, 0x77, 0x3c, 0xe8, 0x1d, 0x1e, 0xb6, 0x7b, 0xff, 0x1a, 0x1c, 0x1c, 0xb2,
+  0xe6, 0x22, 0x44, 0xe1, 0x0e, 0x15, 0x08, 0xd8, 0xc5, 0x51, 0xef, 0x80, 0xc1, 0xec, 0xb8, 0x55,
+  0x23, 0x1e, 0x7a, 0x84, 0x12, 0x8e, 0x1e, 0xb7, 0x8b, 0x26, 0x67, 0xe4, 0x82, 0xa9, 0xf7, 0xd7,
+  0xc4, 0xba, 0x4f, 0x6e, 0xc2, 0x2f, 0x4f, 0x9d, 0x3a, 0xd1, 0xae, 0x7d, 0xc1, 0x3c, 0x81, 0xb0,
+  0x24, 0x16, 0xf2, 0xc1, 0x27, 0x51, 0x00, 0x6b, 0x05, 0x16, 0x97, 0x8a, 0x30, 0x60, 0xf7, 0xd2,
+  0x21, 0xda, 0x0c, 0xe2, 0x70, 0x14, 0x4c, 0x23, 0x3e, 0x27, 0x7f, 0x68, 0xb3, 0x2f, 0xf0, 0x2e,
+  0xf0, 0x6a, 0x85, 0x7a, 0xef, 0x50, 0xc4, 0x60, 0x67, 0x4c, 0x1a, 0x13, 0x58, 0x46, 0x28, 0x78,
+  0x12, 0xab, 0x5a, 0xeb, 0x39, 0x49, 0x89, 0x35, 0xfb, 0xf7, 0xa0, 0xb2, 0x9b, 0x96, 0xc9, 0xee,
+  0xe1, 0x8b, 0x87, 0xe6, 0xae, 0xbe, 0xa8, 0x19, 0x75, 0xa1, 0xfd, 0x76, 0x41, 0xca, 0x92, 0x7b,
+  0x5d, 0xf4, 0xb2, 0x3d, 0xac, 0xcb, 0x39, 0x79, 0x50, 0x55, 0xef, 0xba, 0xba, 0x2c, 0x48, 0x58,
+  0xa1, 0xc7, 0x27, 0x62, 0x06, 0x1d, 0xab, 0x00, 0x52, 0xb4, 0xa8, 0xfd, 0x41, 0x6f, 0x70, 0x3b,
+  0xb8, 0x87, 0xe5, 0x93, 0x0f, 0x55, 0xdd, 0x71, 0xb5, 0x89, 0x47, 0xaa, 0xc1, 0x3d, 0xe7, 0x60,
+  0x11, 0x0d, 0x22, 0x5c, 0x8e, 0x3f, 0x06, 0x61, 0xe4, 0x06, 0x91, 0x9b, 0xbc, 0x7c, 0x6d, 0x83,
+  0xd1, 0xcc, 0xe7, 0x1c, 0xe2, 0x70, 0xc8, 0x23, 0x68, 0xf7, 0x6d, 0x53, 0xed, 0x4f, 0xf6, 0x3a,
+  0x87, 0xf8, 0x0d, 0x27, 0xb1, 0xdb, 0xee, 0xcf, 0xdd, 0xdf, 0x31, 0x46, 0xdf, 0xde, 0xfe, 0xfc,
+  0xf3, 0xfb, 0xf7, 0x6d, 0x46, 0x58, 0xd8, 0x7d, 0xf7, 0xa6, 0xfb, 0x25, 0x0d, 0xc9, 0x0b, 0x6a,
+  0x9a, 0x67, 0x32, 0xa8, 0x29, 0xd2, 0x8c, 0x3f, 0x40, 0x91, 0x5b, 0x13, 0xa0, 0x63, 0x88, 0xf2,
+  0xe2, 0x0e, 0x43, 0x27, 0x3d, 0x29, 0x92, 0xcd, 0x18, 0x63, 0xbe, 0x1d, 0x6f, 0x77, 0xff, 0x0c,
+  0x43, 0x16, 0xbd, 0xd3, 0xf7, 0x42, 0x86, 0x7f, 0x77, 0x7c, 0x08, 0xca, 0xab, 0x06, 0x51, 0x07,
+  0x17, 0x12, 0x83, 0xd3, 0x43, 0x10, 0x80, 0x93, 0xe0, 0xf9, 0x3c, 0xb1, 0x4e, 0xeb, 0x2c, 0x43,
+  0x2b, 0xc4, 0x31, 0xe8, 0x13, 0x04, 0xa5, 0xa2, 0x47, 0x21, 0x42, 0x4c, 0x36, 0x94, 0xeb, 0xbd,
+  0xc0, 0x9f, 0xb2, 0x85, 0xef, 0xa1, 0x78, 0x28, 0x2a, 0x0c, 0xcd, 0x04, 0x14, 0xd7, 0x98, 0xfb,
+  0xa9, 0xeb, 0x84, 0xea, 0x80, 0x47, 0x8f, 0x15, 0xa1, 0x3d, 0x48, 0xd5, 0x77, 0xee, 0xd4, 0xe7,
+  0x1e, 0xc8, 0xfd, 0x11, 0x5e, 0x98, 0x7c, 0x7b, 0x83, 0xd4, 0x3a, 0x8a, 0xd4, 0xc1, 0xf4, 0xa1,
+  0x82, 0xec, 0xfd, 0x63, 0x12, 0xbd, 0xc4, 0xc1, 0x39, 0xb6, 0x33, 0x45, 0xfa, 0xe7, 0xb4, 0xc6,
+  0xdb, 0x1c, 0x3b, 0x9b, 0xab, 0x11, 0x56, 0x03, 0xba, 0xad, 0x96, 0x3c, 0xfb, 0xac, 0x73, 0xc5,
+  0x3b, 0xce, 0xd7, 0xd5, 0xf1, 0xba, 0xba, 0x0a, 0x37, 0x0b, 0x2f, 0x16, 0x52, 0xa7, 0xca, 0xcc,
+  0x9a, 0xd2, 0xbc, 0x5a, 0x0c, 0x3b, 0xa3, 0x2c, 0xaf, 0xbc, 0x40, 0xe2, 0xc2, 0x94, 0x15, 0x90,
+  0xba, 0x67, 0x1c, 0xac, 0x2a, 0x8a, 0xdc, 0x27, 0x48, 0x60, 0x20, 0x95, 0xcc, 0x38, 0x73, 0xee,
+  0xbf, 0x30, 0xa5, 0xc6, 0xad, 0x35, 0x18, 0x25, 0xb4, 0xff, 0x12, 0x2f, 0x8d, 0xf1, 0x15, 0xa5,
+  0x36, 0x78, 0xac, 0x15, 0x3e, 0xbd, 0xbc, 0xd2, 0xc8, 0xdb, 0x3b, 0x9c, 0xa5, 0xe4, 0xcf, 0xdf,
+  0x8b, 0x91, 0xad, 0x9a, 0x62, 0x54, 0x6a, 0x8c, 0x67, 0x3c, 0x82, 0x96, 0x4b, 0xcf, 0xa8, 0x32,
+  0x53, 0xa2, 0x9c, 0xd8, 0x59, 0xca, 0xa6, 0x32, 0x26, 0x8b, 0xa3, 0xdd, 0x01, 0x99, 0x43, 0x03,
+  0x5f, 0x4f, 0xce, 0x21, 0xb4, 0xa7, 0x22, 0xa9, 0xef, 0xdb, 0xf3, 0x16, 0x8f, 0xf2, 0xfe, 0xc6,
+  0x1e, 0x0f, 0x77, 0x88, 0x2f, 0xa1, 0x66, 0x47, 0xa8, 0xba, 0xda, 0x48, 0x7d, 0x57, 0x82, 0xa6,
+  0x6f, 0xe0, 0x0d, 0x54, 0x58, 0x80, 0x55, 0x04, 0xd3, 0xa9, 0x27, 0x7e, 0x83, 0xf1, 0x2b, 0xba,
+  0xdf, 0x82, 0xdb, 0x28, 0xd5, 0x9a, 0x09, 0x3a, 0x5c, 0xdc, 0xa8, 0xb4, 0x5f, 0x29, 0x9c, 0x2e,
+  0xfd, 0x12, 0x44, 0x56, 0xf5, 0xa4, 0x1b, 0x1e, 0xcb, 0x8c, 0x48, 0xd6, 0x53, 0x6b, 0x17, 0x6b,
+  0x1a, 0x15, 0xb1, 0xe4, 0x46, 0xb4, 0x14, 0x1f, 0x1e, 0xb7, 0x18, 0x75, 0x36, 0x43, 0x13, 0x55,
+  0xbe, 0x6b, 0x6b, 0xda, 0x3f, 0xa8, 0x92, 0xb9, 0x01, 0x4e, 0x14, 0x99, 0x1b, 0x65, 0x25, 0x3b,
+  0x98, 0x50, 0x36, 0x53, 0x23, 0x27, 0xdf, 0xcb, 0x26, 0xa4, 0x5b, 0x2b, 0x77, 0x3d, 0x74, 0x07,
+  0x24, 0x97, 0xcc, 0xd8, 0x25, 0x96, 0x97, 0xbe, 0xa8, 0xed, 0xd0, 0x32, 0xd0, 0xd4, 0x44, 0xb3,
+  0xa9, 0xb5, 0x15, 0x2d, 0x6b, 0x92, 0x00, 0x54, 0x37, 0x2e, 0x01, 0x37, 0x24, 0xd3, 0x0c, 0x3d,
+  0x86, 0x3f, 0x8c, 0x8d, 0xad, 0x57, 0x56, 0x0f, 0x2a, 0x7a, 0xdf, 0x7e, 0x80, 0xa8, 0x4d, 0x56,
+  0x4c, 0x2e, 0x0b, 0x95, 0x7a, 0x86, 0x81, 0xea, 0xf5, 0xd6, 0x2b, 0x15, 0xf0, 0xc5, 0x02, 0x82,
+  0x0f, 0xee, 0x5b, 0x81, 0x73, 0x37, 0x73, 0xc2, 0x60, 0xfd, 0xc4, 0x97, 0x0a, 0xc0, 0xad, 0x1a,
+  0xeb, 0x48, 0xb7, 0x5d, 0x0a, 0x7e, 0xf6, 0xc1, 0x91, 0xf3, 0x50, 0x6a, 0x28, 0x6a, 0x54, 0x87,
+  0xb6, 0x74, 0xc1, 0xb3, 0x28, 0x2c, 0x03, 0x66, 0x76, 0x76, 0x33, 0x60, 0xfa, 0xb9, 0xc5, 0x67,
+  0xb5, 0x3f, 0xa3, 0xce, 0x2d, 0x5e, 0x77, 0xaa, 0x8c, 0xc5, 0x8d, 0x8e, 0x35, 0x83, 0x98, 0x88,
+  0xaa, 0xc7, 0xbd, 0x65, 0xf9, 0xb4, 0xc5, 0x00, 0xb3, 0x09, 0x6a, 0xc5, 0xf2, 0xf7, 0xa2, 0x01,
+  0xd6, 0xb7, 0xee, 0xf6, 0x6c, 0x12, 0x36, 0xf0, 0xb4, 0xae, 0x74, 0x94, 0x58, 0xb5, 0x0c, 0x82,
+  0x54, 0x34, 0xe4, 0x73, 0xd9, 0x9b, 0x3f, 0xdc, 0x6c, 0xf4, 0x65, 0x58, 0xea, 0x8b, 0x5f, 0xa0,
+  0x51, 0x6c, 0x9e, 0x2d, 0x92, 0x00, 0x0f, 0x93, 0x27, 0xad, 0x57, 0x3a, 0x7b, 0xdc, 0x01, 0x73,
+  0x27, 0xd4, 0xd1, 0x6e, 0xf4, 0x6a, 0x37, 0x2c, 0xf9, 0x74, 0x76, 0x79, 0xae, 0x68, 0xfb, 0xae,
+  0x14, 0x6f, 0xb7, 0xad, 0x16, 0x37, 0x93, 0x10, 0xa7, 0xe9, 0x68, 0xa6, 0x4b, 0x28, 0x91, 0xa1,
+  0xb4, 0x59, 0xf2, 0x97, 0x2d, 0x38, 0x00, 0x52, 0xe1, 0xc0, 0x39, 0x3a, 0x8e, 0x18, 0xe2, 0xe5,
+  0xdd, 0xe2, 0x01, 0x97, 0xff, 0x13, 0x8f, 0x1f, 0xb7, 0xe0, 0x89, 0xb3, 0xe8, 0x89, 0xf3, 0x0a,
+  0x6b, 0x86, 0xbb, 0xaa, 0x17, 0x9f, 0xef, 0x54, 0xe7, 0xbf, 0x05, 0x0f, 0x42, 0xa7, 0xcb, 0x46,
+  0xdb, 0xb1, 0xb5, 0x96, 0x7f, 0xa1, 0x99, 0xba, 0x2c, 0x69, 0x18, 0xa7, 0x0a, 0x27, 0xe6, 0x4f,
+  0x98, 0x71, 0x62, 0x65, 0xaf, 0x66, 0xc9, 0xc2, 0x4b, 0x87, 0x50, 0x1b, 0xef, 0xef, 0xe1, 0xb9,
+  0x7a, 0x79, 0x2b, 0x38, 0x5e, 0x3c, 0xcc, 0xdd, 0x24, 0xdb, 0x35, 0xa5, 0x8b, 0x1e, 0xe0, 0xd3,
+  0x77, 0xfc, 0x49, 0xb0, 0x1f, 0xf9, 0x3c, 0x1c, 0xb2, 0x5b, 0xe2, 0x64, 0xcb, 0xde, 0xac, 0x3e,
+  0xbd, 0x57, 0x3e, 0xbb, 0xd7, 0x76, 0x6a, 0x61, 0xfd, 0x45, 0x72, 0x21, 0x1c, 0x0e, 0x89, 0x90,
+  0x6c, 0xf4, 0x16, 0x07, 0x58, 0x3a, 0x52, 0xd9, 0xbe, 0xc7, 0xbd, 0x51, 0xdc, 0x21, 0x0d, 0x48,
+  0x0d, 0x92, 0x48, 0xf5, 0x72, 0x84, 0x26, 0x63, 0xbf, 0x7c, 0xb9, 0x40, 0xbf, 0x6c, 0x52, 0x3c,
+  0xd6, 0x6a, 0x8c, 0xf7, 0x7e, 0x9c, 0x04, 0x21, 0xf4, 0xc3, 0x07, 0xd6, 0xc1, 0x31, 0x3b, 0xe1,
+  0xea, 0xee, 0x37, 0x5e, 0xee, 0x8e, 0x07, 0xdd, 0xee, 0x93, 0x6b, 0x8b, 0x60, 0xc9, 0xbd, 0x68,
+  0x11, 0x9b, 0x50, 0x5b, 0x97, 0x8f, 0xe2, 0xe4, 0x05, 0xa2, 0xc6, 0xf8, 0x0b, 0x82, 0xb1, 0xdf,
+  0x08, 0xee, 0xa4, 0xcb, 0x89, 0x69, 0x64, 0x57, 0x5f, 0x21, 0xb2, 0x01, 0x2c, 0x05, 0xae, 0xe5,
+  0x0d, 0x91, 0x7c, 0xd7, 0x5f, 0xbf, 0x37, 0x52, 0xdc, 0xe8, 0xcd, 0xaf, 0x8b, 0x80, 0x65, 0x7c,
+  0xb8, 0x3b, 0xbf, 0x66, 0x9f, 0xae, 0x2f, 0x2e, 0x4f, 0x1e, 0xa2, 0xf1, 0xd9, 0xf9, 0xfd, 0x87,
+  0x2f, 0x67, 0xf7, 0xb8, 0x61, 0x4e, 0x14, 0xd4, 0x8a, 0x14, 0xe6, 0xc9, 0xdb, 0x0e, 0x9a, 0xe6,
+  0xa1, 0xae, 0x0e, 0x69, 0xb3, 0x1a, 0xb5, 0x7e, 0x77, 0x7f, 0x7d, 0xc3, 0xee, 0x7f, 0xb9, 0x64,
+  0x37, 0x67, 0xb7, 0xf7, 0xbf, 0x97, 0xb5, 0x1e, 0x4f, 0x22, 0x37, 0x4c, 0xc6, 0x7b, 0xce, 0xc2,
+  0xa7, 0x5d, 0x69, 0xf6, 0x8f, 0xa6, 0x6b, 0xb7, 0x56, 0x91, 0xa0, 0x7d, 0x03, 0x3b, 0x98, 0x2c,
+  0xe6, 0xa0, 0x77, 0x73, 0x2a, 0x92, 0x4b, 0x4f, 0xe0, 0xe3, 0xfb, 0x97, 0x0f, 0x36, 0x82, 0x0c,
+  0xd7, 0xf9, 0x9c, 0x72, 0x38, 0x5a, 0x3d, 0xf1, 0x88, 0xd9, 0xa3, 0x7f, 0x34, 0x0d, 0x0c, 0x5c,
+  0x46, 0xcb, 0xa4, 0x50, 0x33, 0xc4, 0x51, 0x07, 0x47, 0xd3, 0x58, 0x62, 0xb4, 0x86, 0xae, 0xd3,
+  0xb4, 0x47, 0xa3, 0x91, 0x61, 0x19, 0xad, 0x95, 0x63, 0x92, 0x58, 0x78, 0x54, 0x62, 0xc2, 0xaa,
+  0x36, 0x0d, 0xac, 0xf1, 0x8d, 0xd6, 0x5a, 0x40, 0xcd, 0x59, 0xf8, 0x18, 0x89, 0x39, 0xa8, 0x31,
+  0xfb, 0x5e, 0xe1, 0x44, 0x2f, 0x73, 0x88, 0x97, 0x25, 0x52, 0x95, 0x45, 0x51, 0x95, 0x9b, 0xbc,
+  0x5e, 0x91, 0xfc, 0x2c, 0x91, 0x9f, 0xde, 0xff, 0x0d, 0x3f, 0x5e, 0xc0, 0x6d, 0x19, 0xe9, 0x81,
+  0x93, 0x3d, 0x47, 0x24, 0x93, 0x59, 0xd3, 0xe8, 0x4e, 0x68, 0x04, 0x38, 0xc1, 0x7d, 0x9d, 0x66,
+  0x34, 0x1a, 0x47, 0xe6, 0x5f, 0x71, 0xe0, 0x37, 0x5b, 0x6a, 0x64, 0x32, 0x1a, 0xaf, 0xf6, 0xae,
+  0x1f, 0xfe, 0x82, 0x00, 0x6c, 0x42, 0xc9, 0x19, 0x37, 0x27, 0x66, 0x1a, 0x0f, 0x5a, 0x26, 0xb8,
+  0xc9, 0x25, 0x07, 0x34, 0x29, 0x8d, 0xe6, 0xa3, 0x94, 0x51, 0x78, 0x20, 0xcc, 0x23, 0x49, 0x20,
+  0xbc, 0xd6, 0x4a, 0x78, 0x52, 0xce, 0x51, 0x3e, 0xf7, 0x8f, 0xc7, 0xaf, 0xc3, 0xf5, 0xba, 0x35,
+  0xdc, 0x03, 0xa1, 0xf3, 0x8b, 0x26, 0xc8, 0x06, 0x18, 0xde, 0xb9, 0xfa, 0x29, 0xc5, 0xc4, 0xcc,
+  0x3f, 0x11, 0x64, 0x76, 0xb6, 0x5f, 0x01, 0x74, 0xd4, 0x7d, 0x80, 0xe1, 0x1e, 0xd0, 0x9c, 0x98,
+  0xf2, 0xde, 0x44, 0x6b, 0x05, 0x73, 0xe4, 0x63, 0x65, 0x82, 0x1c, 0x1e, 0x66, 0x00, 0xb7, 0xa8,
+  0x2e, 0x93, 0x5c, 0xcd, 0x54, 0x11, 0x6d, 0x64, 0x60, 0x5c, 0x31, 0xc0, 0xba, 0x08, 0xa7, 0xba,
+  0x18, 0x41, 0x48, 0xd5, 0x73, 0x05, 0xab, 0x1a, 0x1f, 0xe6, 0x20, 0xdb, 0xf1, 0xf2, 0xf0, 0x53,
+  0x60, 0x0b, 0x42, 0x2b, 0x6f, 0x42, 0x54, 0xb0, 0xca, 0xe1, 0x61, 0x06, 0xf0, 0x2a, 0x4e, 0x82,
+  0xc2, 0xc2, 0x64, 0x03, 0x9a, 0x7d, 0x83, 0x35, 0xd3, 0xba, 0x72, 0xc0, 0x8c, 0x7d, 0x1c, 0x4f,
+  0x8b, 0xd0, 0x7d, 0xa3, 0x65, 0x90, 0xa2, 0xd3, 0xd2, 0x12, 0x70, 0xe8, 0x3b, 0x07, 0x52, 0x40,
+  0xfc, 0x00, 0x35, 0xcc, 0xa9, 0xd1, 0x5c, 0xa8, 0x2a, 0xc0, 0x6e, 0x19, 0x03, 0x43, 0xce, 0x4c,
+  0xfb, 0x9a, 0xca, 0xcc, 0xf4, 0x43, 0xfd, 0x4c, 0xfa, 0xaa, 0xea, 0xf9, 0x22, 0xf0, 0x70, 0xaf,
+  0xec, 0xd2, 0xc3, 0xaa, 0x67, 0x0d, 0xf7, 0xd6, 0x2d, 0x73, 0xc2, 0x13, 0xdd, 0x16, 0x5b, 0x2b,
+  0xb4, 0x2f, 0xcd, 0x01, 0xd0, 0x25, 0x68, 0xa3, 0xa0, 0x99, 0x90, 0xb6, 0xf3, 0x6b, 0x43, 0x25,
+  0x55, 0x25, 0xc3, 0xf2, 0x57, 0xf2, 0xaf, 0xcf, 0x98, 0x48, 0xe5, 0x78, 0xc7, 0xd8, 0x4f, 0xcc,
+  0x24, 0xf8, 0x18, 0x2c, 0x45, 0x74, 0xce, 0x63, 0x01, 0x1c, 0x64, 0xf1, 0x89, 0x7e, 0x35, 0xb2,
+  0xc3, 0x04, 0x3d, 0x54, 0xc8, 0x63, 0xe6, 0x18, 0xfc, 0x5c, 0xb9, 0x25, 0x8e, 0x9c, 0xe2, 0x25,
+  0x10, 0x40, 0xb0, 0x1f, 0x6f, 0xf4, 0x4e, 0x1b, 0xbc, 0x33, 0x17, 0xcb, 0x96, 0x57, 0xa9, 0x01,
+  0x75, 0xab, 0x8c, 0x1c, 0x0f, 0xab, 0xeb, 0x90, 0x5b, 0xc6, 0xdf, 0xc1, 0x4d, 0x31, 0x55, 0x1e,
+  0x01, 0x8f, 0xfe, 0xf8, 0x3a, 0xcc, 0x69, 0x11, 0x85, 0xf4, 0x48, 0x5a, 0x1d, 0x5c, 0x43, 0xb0,
+  0x41, 0x78, 0x98, 0x5d, 0x84, 0x0d, 0xf9, 0x54, 0x34, 0xa1, 0xc1, 0x86, 0x90, 0x00, 0x20, 0x2a,
+  0xca, 0xa7, 0x2c, 0xa6, 0xc7, 0xdb, 0xa7, 0x12, 0x00, 0x94, 0x20, 0x1f, 0xf6, 0x53, 0xac, 0x3f,
+  0xfe, 0xa8, 0xbe, 0x8c, 0x46, 0xd6, 0xa9, 0xf1, 0xa3, 0x1a, 0x1d, 0xf5, 0xd0, 0x9c, 0x5a, 0xaf,
+  0xca, 0xb4, 0x87, 0x9c, 0xc0, 0x3f, 0x18, 0x5c, 0xc0, 0x64, 0x40, 0x32, 0x25, 0x4a, 0x8b, 0x82,
+  0x87, 0x6d, 0xd2, 0x2e, 0xe8, 0xd8, 0x4a, 0x29, 0xec, 0xab, 0x91, 0x13, 0x50, 0x41, 0x00, 0x4a,
+  0xc8, 0x32, 0x92, 0x26, 0x40, 0x0a, 0x83, 0xab, 0x9a, 0xe1, 0x43, 0x22, 0xc3, 0x34, 0x7b, 0xa1,
+  0x85, 0xa2, 0x35, 0xea, 0x73, 0xad, 0xa2, 0x7d, 0x96, 0x8f, 0xf4, 0x73, 0xfd, 0x01, 0x5b, 0xd9,
+  0x0b, 0x66, 0xb2, 0xec, 0x18, 0x1f, 0x56, 0xcf, 0x85, 0x08, 0x19, 0xfd, 0x72, 0xff, 0xe9, 0xe3,
+  0xc8, 0xa8, 0x3f, 0xbe, 0xc7, 0x83, 0x7b, 0x1f, 0x62, 0xae, 0x69, 0x52, 0x01, 0x87, 0x31, 0xa2,
+  0x76, 0x99, 0x34, 0x0d, 0x91, 0x1a, 0x62, 0x35, 0xaf, 0xb5, 0x02, 0x01, 0xef, 0xdd, 0xb9, 0x80,
+  0x06, 0x4f, 0xf7, 0xae, 0x32, 0xbb, 0xf2, 0xea, 0xd4, 0x70, 0xdd, 0xc6, 0xdf, 0xa4, 0x91, 0x22,
+  0x94, 0x1a, 0x32, 0x85, 0x50, 0x9e, 0xc3, 0x1f, 0xd2, 0x8d, 0xd0, 0xe5, 0x91, 0x88, 0x1c, 0x37,
+  0x55, 0xab, 0x02, 0x4b, 0xd9, 0x5a, 0xd1, 0xf7, 0x9c, 0xfa, 0xe9, 0x8e, 0x52, 0x0d, 0x36, 0xc0,
+  0x7d, 0x4e, 0x8f, 0x54, 0xd4, 0x08, 0x94, 0xd1, 0x50, 0x1f, 0xa6, 0x8a, 0xa0, 0xf4, 0x99, 0x72,
+  0x51, 0xc9, 0x66, 0xf0, 0x01, 0x94, 0x8f, 0x0c, 0xed, 0x83, 0x72, 0xf5, 0x1a, 0x29, 0xbf, 0xef,
+  0xdf, 0x00, 0x3c, 0xaf, 0x80, 0xc8, 0x7b, 0x5c, 0x10, 0x66, 0x95, 0xac, 0xe4, 0x4c, 0x7f, 0xc0,
+  0xb3, 0xe9, 0x86, 0x5f, 0xbf, 0x7d, 0x33, 0xc0, 0x7c, 0x8c, 0xd6, 0xbe, 0xa1, 0xca, 0x7e, 0x79,
+  0xe9, 0xcb, 0xd8, 0x97, 0xdf, 0x21, 0x97, 0x53, 0x08, 0x6d, 0x76, 0xff, 0x34, 0xbb, 0xd3, 0xb6,
+  0xd1, 0x21, 0x48, 0x55, 0x2d, 0xbd, 0x4a, 0x15, 0xef, 0xca, 0x6f, 0x61, 0x4c, 0xf6, 0x99, 0x92,
+  0x54, 0xda, 0x36, 0xee, 0x1b, 0x3b, 0xe0, 0x56, 0xb7, 0xe1, 0xe9, 0xec, 0x63, 0x20, 0xe7, 0xab,
+  0xf3, 0x70, 0xe8, 0xb1, 0x20, 0xb9, 0x7c, 0x63, 0x29, 0xff, 0x24, 0xb3, 0x19, 0xf8, 0x78, 0x4d,
+  0xf8, 0xd4, 0x80, 0x15, 0x82, 0x6f, 0x20, 0x2f, 0xbe, 0xa2, 0x24, 0x15, 0x5a, 0xe5, 0x77, 0xbd,
+  0x30, 0x86, 0xba, 0x38, 0x43, 0x6b, 0x74, 0x1b, 0x0c, 0x3a, 0x72, 0xa8, 0x03, 0x47, 0x8d, 0xff,
+  0x7e, 0xc0, 0xcd, 0xe3, 0xea, 0x6d, 0x16, 0x18, 0x1b, 0x5f, 0x87, 0xc2, 0xc7, 0xca, 0xb8, 0x86,
+  0xc4, 0xba, 0x25, 0x33, 0xe5, 0x06, 0x4f, 0x42, 0xf0, 0xe1, 0x5e, 0xd9, 0x2e, 0x96, 0x3c, 0xf3,
+  0x1a, 0x70, 0x5c, 0x79, 0x21, 0x4f, 0xbe, 0xca, 0x6b, 0x1b, 0x62, 0x43, 0x22, 0x12, 0x7f, 0xd3,
+  0x69, 0x69, 0x2b, 0x42, 0xa4, 0xb6, 0x4a, 0xb1, 0x22, 0x0f, 0xbc, 0x97, 0x4f, 0x90, 0x6b, 0xe2,
+  0xd1, 0x6a, 0x3d, 0xcc, 0xc7, 0xc8, 0xb8, 0x70, 0x48, 0xcb, 0x79, 0xd8, 0xf6, 0x64, 0xdf, 0x9a,
+  0x6e, 0xd8, 0x96, 0x61, 0x7c, 0xb5, 0xa7, 0xdb, 0x23, 0xd8, 0xe2, 0x88, 0xc6, 0x4b, 0x29, 0x6a,
+  0x2f, 0x2b, 0xe6, 0x8c, 0xcc, 0x36, 0x6b, 0xed, 0x52, 0x86, 0x4e, 0x55, 0xeb, 0x69, 0xb9, 0xaf,
+  0xec, 0x05, 0x25, 0xa2, 0xb0, 0x08, 0x5a, 0xfc, 0xd3, 0xf4, 0xab, 0x5c, 0x0f, 0x70, 0x7e, 0xb7,
+  0x74, 0x7d, 0x3b, 0x58, 0x9a, 0x24, 0xef, 0x5d, 0xb0, 0x88, 0x26, 0xe2, 0xdb, 0x37, 0x5d, 0x05,
+  0xa9, 0x33, 0xa5, 0x61, 0x79, 0x28, 0xb5, 0x04, 0x71, 0xc7, 0x17, 0x4b, 0xa6, 0x4d, 0x6b, 0x1a,
+  0x55, 0x43, 0x12, 0x84, 0x02, 0x6a, 0xed, 0xbd, 0x3a, 0x94, 0x23, 0x08, 0x59, 0x7b, 0x60, 0x00,
+  0x50, 0x70, 0xd3, 0x87, 0x8f, 0xb4, 0xd9, 0x24, 0x22, 0x55, 0x1c, 0x18, 0x6d, 0x7d, 0x89, 0x4b,
+  0x9a, 0x96, 0x28, 0xda, 0xff, 0x79, 0x77, 0xfd, 0xd9, 0x0c, 0x79, 0x04, 0xea, 0x84, 0x5a, 0x8d,
+  0x27, 0xbc, 0x95, 0xe7, 0x51, 0xc2, 0x1d, 0x00, 0xbe, 0x08, 0x3a, 0x7b, 0x2d, 0xb0, 0xa2, 0x26,
+  0xf1, 0x27, 0x33, 0xdc, 0x96, 0xf5, 0x07, 0xc4, 0xc5, 0x03, 0x08, 0xb7, 0xc2, 0x13, 0x89, 0x60,
+  0x75, 0x7c, 0x42, 0x25, 0x5d, 0x48, 0x24, 0xf5, 0xa6, 0xb9, 0xda, 0xdb, 0x12, 0xe8, 0xb2, 0x80,
+  0xbc, 0x51, 0xb1, 0x2a, 0x3b, 0x57, 0xf5, 0x28, 0x17, 0x78, 0x4b, 0x2d, 0x51, 0xab, 0x20, 0xad,
+  0xae, 0xd8, 0x50, 0xc0, 0x15, 0x93, 0x64, 0x76, 0xe7, 0x8a, 0xea, 0x17, 0x55, 0x5b, 0x84, 0x1c,
+  0xb2, 0x47, 0xb9, 0x68, 0xc2, 0xbf, 0x64, 0x96, 0x7a, 0x6d, 0xd9, 0x5a, 0xd1, 0xdb, 0x39, 0x9e,
+  0x59, 0xf9, 0xd0, 0x46, 0x75, 0x79, 0xe8, 0x76, 0x69, 0xa8, 0x66, 0x76, 0x5b, 0x63, 0x05, 0xe9,
+  0x5e, 0x91, 0xf8, 0x48, 0x8c, 0x96, 0x4f, 0xa5, 0x8f, 0xca, 0x97, 0x32, 0xbb, 0xda, 0xc7, 0x6d,
+  0x6b, 0xb0, 0x41, 0xc1, 0x34, 0xb7, 0x56, 0x3d, 0xa8, 0x1d, 0x47, 0x23, 0xae, 0x62, 0x44, 0xa1,
+  0x9c, 0xa6, 0xc4, 0xac, 0x17, 0x69, 0xba, 0x06, 0x70, 0x5a, 0x1b, 0x20, 0x3c, 0xdc, 0x3c, 0x69,
+  0xdb, 0x60, 0x8e, 0x59, 0x73, 0x48, 0x9f, 0x56, 0xf2, 0x4a, 0xd8, 0xc0, 0xc0, 0x2b, 0x61, 0xc6,
+  0x3a, 0x5f, 0x61, 0xe9, 0x9d, 0x91, 0x19, 0x40, 0xcf, 0x97, 0xcc, 0xa2, 0x60, 0xc9, 0x22, 0xf5,
+  0xa3, 0x42, 0xd0, 0x80, 0x5e, 0x31, 0xe4, 0xf7, 0xda, 0xda, 0x47, 0x58, 0x18, 0x90, 0x9d, 0x11,
+  0x1d, 0xfc, 0x37, 0x15, 0xc2, 0xf9, 0xda, 0x2b, 0x46, 0x8a, 0x6b, 0xae, 0xa1, 0xd0, 0x5b, 0xd7,
+  0x7c, 0xe9, 0x76, 0x31, 0xbf, 0xac, 0x39, 0xb9, 0xcb, 0x80, 0xb5, 0x92, 0xdf, 0x36, 0xf1, 0x60,
+  0x04, 0x1a, 0x20, 0xc8, 0x50, 0x18, 0xa7, 0x4c, 0xf1, 0x1c, 0xd2, 0x4d, 0x13, 0x18, 0x49, 0x2b,
+  0x07, 0x82, 0xc0, 0x4c, 0x8e, 0x95, 0x23, 0x14, 0x3e, 0xd0, 0xbd, 0xfc, 0x1a, 0x7f, 0x37, 0x1a,
+  0xf9, 0x0b, 0xcf, 0x3b, 0x35, 0x98, 0xeb, 0xb3, 0xf2, 0xc7, 0x6e, 0x0f, 0x4b, 0x21, 0x08, 0xaa,
+  0x57, 0xf8, 0xdb, 0xa1, 0x66, 0x0f, 0xb2, 0x1e, 0x9b, 0xc7, 0x54, 0xa2, 0xee, 0xd4, 0xb1, 0x94,
+  0xb6, 0xad, 0x30, 0x32, 0x50, 0xbf, 0x1e, 0xcd, 0x9b, 0x86, 0xdc, 0xc1, 0xc2, 0x53, 0xec, 0xb4,
+  0xa7, 0xa6, 0xdb, 0x99, 0x7c, 0x92, 0x04, 0xd1, 0x0b, 0xf0, 0x2c, 0x27, 0x9d, 0xfe, 0xe9, 0xff,
+  0xe9, 0xdf, 0xe3, 0x19, 0x19, 0x6d, 0xef, 0x89, 0x08, 0x02, 0x3b, 0x4d, 0x9a, 0xe8, 0x7b, 0xbe,
+  0xea, 0xc2, 0x0c, 0x6d, 0xfd, 0xe1, 0x71, 0x92, 0x94, 0xd8, 0x84, 0xb8, 0xbe, 0x52, 0xe1, 0xd7,
+  0x0b, 0x26, 0x04, 0x69, 0x52, 0x4a, 0x36, 0xba, 0xc4, 0x19, 0x64, 0x25, 0x8d, 0x59, 0xfd, 0x1a,
+  0x7d, 0x18, 0x78, 0x9e, 0x8a, 0xdf, 0xf2, 0x11, 0x94, 0xaf, 0xdf, 0x60, 0xaf, 0xb6, 0xaf, 0x78,
+  0x8b, 0xdb, 0xc8, 0x43, 0x0c, 0x2d, 0x2e, 0x61, 0xec, 0xc8, 0x79, 0xa0, 0x5a, 0xc4, 0x74, 0x6a,
+  0x9c, 0xe2, 0x9f, 0x9d, 0xea, 0x7c, 0x59, 0xcc, 0x23, 0x8e, 0x57, 0xaa, 0x58, 0x9d, 0x6b, 0xba,
+  0x43, 0x0b, 0x05, 0x2c, 0xad, 0xda, 0x30, 0x8b, 0x7a, 0xaf, 0x6c, 0x3c, 0x00, 0x7e, 0xf9, 0x83,
+  0x16, 0xd5, 0x3a, 0x48, 0x5e, 0xb3, 0x5b, 0xf6, 0x2d, 0xb2, 0xba, 0xd7, 0x05, 0xa7, 0xdf, 0x73,
+  0xcb, 0xde, 0xb9, 0x70, 0x05, 0xbf, 0x42, 0x49, 0x7e, 0x05, 0xfb, 0xa0, 0xa8, 0xc3, 0x3d, 0x11,
+  0x25, 0x4d, 0x23, 0xfd, 0x1d, 0x04, 0x1e, 0x23, 0xcb, 0x8b, 0x19, 0x74, 0xcf, 0xbf, 0x89, 0x26,
+  0xac, 0x58, 0xc3, 0xa6, 0xbe, 0xe8, 0x64, 0x5a, 0xd6, 0x4a, 0xd1, 0x50, 0xa5, 0x81, 0xd3, 0x49,
+  0x1f, 0x74, 0x32, 0x2a, 0xd9, 0xc6, 0xe4, 0x58, 0xb2, 0xca, 0xd2, 0xf5, 0x7e, 0x52, 0x74, 0x66,
+  0x96, 0xea, 0x9a, 0x3d, 0x4b, 0x37, 0x64, 0x14, 0x1a, 0x65, 0x87, 0xa2, 0x70, 0xae, 0x82, 0x57,
+  0xb2, 0x71, 0x57, 0x4a, 0xdd, 0x9e, 0x58, 0xe6, 0x93, 0x72, 0x7b, 0x24, 0x23, 0xac, 0xd1, 0xa2,
+  0x5e, 0x41, 0x6d, 0xfe, 0xdd, 0x03, 0x95, 0xd5, 0xd0, 0xb4, 0xa9, 0x7b, 0xb5, 0x78, 0xba, 0x10,
+  0xa1, 0xaf, 0x28, 0xae, 0xa8, 0x79, 0xa0, 0xc3, 0x1b, 0xe3, 0x2d, 0x99, 0x42, 0x59, 0x64, 0x5b,
+  0xfe, 0x45, 0xef, 0xd2, 0x33, 0x85, 0x66, 0x67, 0x68, 0xaa, 0x52, 0x4d, 0xca, 0xa6, 0xf2, 0xac,
+  0x91, 0xcf, 0x95, 0x11, 0xb0, 0x9a, 0xbf, 0xe5, 0xb7, 0x62, 0xb8, 0x53, 0x94, 0x77, 0xb0, 0x7b,
+  0xaa, 0x2a, 0xc8, 0xef, 0x32, 0xf1, 0x4b, 0x16, 0x65, 0xa8, 0xdf, 0x84, 0xc8, 0x2a, 0x73, 0x20,
+  0xa3, 0x1e, 0xce, 0xca, 0x2d, 0xff, 0x35, 0x51, 0x6a, 0xe3, 0xd7, 0xce, 0xe4, 0xd0, 0xd4, 0xe8,
+  0x58, 0xcd, 0x28, 0x5b, 0x57, 0x4e, 0x48, 0x17, 0x7e, 0xa7, 0x08, 0x8f, 0x99, 0x2f, 0x00, 0x4f,
+  0x01, 0x16, 0x68, 0x39, 0x03, 0x33, 0x56, 0xf5, 0x93, 0x81, 0xa9, 0xc6, 0x80, 0x8e, 0xde, 0xc4,
+  0xfb, 0x82, 0x14, 0x0e, 0x76, 0x60, 0xf5, 0x09, 0xff, 0xcb, 0x25, 0x2e, 0x30, 0xdb, 0x61, 0x6a,
+  0x1a, 0x28, 0x29, 0x43, 0x81, 0xb9, 0x42, 0xbf, 0xac, 0x07, 0xc6, 0x64, 0x0c, 0x5f, 0xd3, 0x58,
+  0xa6, 0xd6, 0x1a, 0xd6, 0xde, 0xca, 0x8f, 0x74, 0x0e, 0xd9, 0xff, 0x1a, 0x9b, 0x30, 0x4b, 0x55,
+  0x1b, 0x6f, 0xb4, 0x82, 0xa0, 0x6c, 0x05, 0x54, 0x61, 0x4d, 0x92, 0x51, 0x20, 0xf7, 0x3f, 0x4e,
+  0x3f, 0x41, 0x5d, 0x60, 0x3a, 0x5e, 0x10, 0x44, 0x40, 0xec, 0xe1, 0x05, 0x62, 0xc4, 0x3f, 0x41,
+  0xc0, 0xae, 0xfa, 0xdc, 0x1a, 0x58, 0x14, 0xcc, 0x36, 0x11, 0xd4, 0x19, 0x24, 0x81, 0x5e, 0x40,
+  0x0a, 0xe3, 0xd4, 0xf8, 0x92, 0x3d, 0x0f, 0x34, 0x08, 0x60, 0x22, 0x52, 0x00, 0xb7, 0xe9, 0x85,
+  0x4e, 0x82, 0x31, 0x2e, 0x54, 0xf0, 0xc0, 0x37, 0xc8, 0xab, 0xa0, 0x07, 0xe0, 0x1d, 0xd8, 0xdc,
+  0x37, 0x7e, 0x80, 0x5c, 0x11, 0x40, 0xfd, 0x1c, 0x2f, 0xe6, 0x22, 0x86, 0xc4, 0xdc, 0x44, 0x99,
+  0xd4, 0x2b, 0x2c, 0x9a, 0x7c, 0x92, 0x1b, 0x8f, 0x60, 0x7a, 0x6f, 0xb6, 0xf1, 0xfa, 0x09, 0x07,
+  0xa9, 0x7f, 0xa7, 0x5d, 0x1a, 0xee, 0x8e, 0xbc, 0x5f, 0x38, 0x8e, 0x88, 0x70, 0xb7, 0x23, 0x1b,
+  0xc2, 0xa9, 0x11, 0x95, 0x0c, 0xd0, 0x73, 0xa4, 0x5b, 0x86, 0xd5, 0x06, 0xe3, 0x51, 0xbc, 0x60,
+  0x74, 0x2c, 0xb6, 0x18, 0x7b, 0x1a, 0xd2, 0xfd, 0x91, 0xc0, 0xfd, 0xf8, 0xf2, 0x26, 0xa4, 0x46,
+  0x55, 0x7b, 0x36, 0x63, 0x0f, 0x9b, 0xaa, 0xce, 0x91, 0xaa, 0xbe, 0x34, 0x28, 0x34, 0x40, 0x7c,
+  0x05, 0x2b, 0x21, 0x7f, 0x54, 0x67, 0x35, 0x94, 0x2f, 0xf4, 0x3e, 0x52, 0xfb, 0x46, 0xe1, 0x58,
+  0x3f, 0x56, 0x4a, 0x37, 0x48, 0xf3, 0xd3, 0x09, 0xf9, 0x4b, 0x64, 0xa3, 0xf5, 0x96, 0xa8, 0x4a,
+  0x18, 0x4f, 0x6d, 0x55, 0x92, 0x8c, 0xfa, 0x96, 0xd1, 0xa6, 0x21, 0x2c, 0x93, 0xb3, 0xb0, 0x99,
+  0x8d, 0x10, 0x8b, 0x9a, 0x46, 0xeb, 0xb3, 0xfb, 0x6b, 0x8c, 0xa6, 0x27, 0x25, 0x19, 0xaf, 0xeb,
+  0x76, 0xdf, 0x92, 0xcb, 0x0e, 0x86, 0x16, 0x07, 0x90, 0xa4, 0xbd, 0x60, 0xda, 0x34, 0xf2, 0x43,
+  0xb0, 0xef, 0x8c, 0x9a, 0x0d, 0x3b, 0xc9, 0x4c, 0x1e, 0xa9, 0xaa, 0x62, 0xb4, 0x6a, 0xf6, 0xba,
+  0xc6, 0xd6, 0xdf, 0xed, 0x05, 0x6a, 0x29, 0x6c, 0xec, 0x0d, 0x64, 0xb1, 0x50, 0xdc, 0xf0, 0x93,
+  0x1b, 0x75, 0x5a, 0xdc, 0xac, 0x6e, 0xd4, 0xfd, 0xbf, 0xb0, 0xb6, 0xb1, 0xfe, 0xd5, 0xf7, 0xec,
+  0xf3, 0xe3, 0xc3, 0x55, 0x66, 0xba, 0xb4, 0xe2, 0x50, 0xba, 0x79, 0x82, 0x47, 0xe9, 0xa2, 0x6b,
+  0x1f, 0xd4, 0xd6, 0xce, 0xce, 0xeb, 0xfe, 0xf7, 0x6d, 0xd4, 0x32, 0xea, 0x5b, 0x44, 0xa5, 0x88,
+  0x0e, 0x72, 0x6f, 0xd4, 0xf7, 0x8a, 0x65, 0x10, 0x15, 0x36, 0x30, 0xa2, 0xe8, 0x21, 0xa2, 0xe8,
+  0x80, 0x37, 0xf0, 0x15, 0xe2, 0x9d, 0xec, 0x04, 0xbe, 0xcb, 0x60, 0x5b, 0xab, 0x7c, 0x1a, 0xf8,
+  0xc1, 0x07, 0x3c, 0x9c, 0x7e, 0xe2, 0x5e, 0x53, 0x56, 0x0b, 0xaa, 0xf7, 0x52, 0x01, 0x6a, 0x5d,
+  0x42, 0x29, 0x7b, 0xfd, 0xe6, 0xc6, 0xcd, 0x16, 0x15, 0x16, 0x32, 0xca, 0xc3, 0xad, 0xbb, 0x2c,
+  0xda, 0xa6, 0x0a, 0xed, 0x6f, 0x04, 0xa1, 0xf0, 0x4b, 0xdb, 0x1b, 0x1a, 0xe7, 0xb4, 0x88, 0x19,
+  0xc7, 0xf9, 0x87, 0x61, 0x49, 0x13, 0xb8, 0xc5, 0xb1, 0xeb, 0x56, 0x8c, 0x3c, 0xf2, 0xad, 0x6e,
+  0xbd, 0x0c, 0x6b, 0x8e, 0x33, 0xd2, 0x93, 0x1e, 0xfc, 0x65, 0x77, 0xa5, 0xe4, 0xc6, 0xb7, 0x6f,
+  0xdf, 0x8c, 0x8e, 0x51, 0xde, 0xad, 0xd1, 0x75, 0x52, 0xb3, 0xf5, 0x92, 0xf5, 0xaa, 0x6f, 0x29,
+  0x5f, 0xfe, 0x3e, 0x73, 0x78, 0x86, 0x9a, 0xfe, 0xae, 0xbe, 0x02, 0xe6, 0x86, 0xc3, 0xd7, 0xce,
+  0x58, 0x6d, 0xfd, 0x8c, 0x35, 0x73, 0x49, 0x01, 0xfc, 0x90, 0xd5, 0xee, 0x74, 0xf6, 0xa6, 0x9f,
+  0x2c, 0x0f, 0xf7, 0xca, 0xe7, 0x02, 0xd9, 0x5e, 0x69, 0xaa, 0x15, 0xc8, 0xb9, 0xba, 0xe5, 0x51,
+  0x0a, 0x2e, 0xd9, 0x6c, 0x71, 0xef, 0x0a, 0xf7, 0x0d, 0x30, 0x2c, 0x43, 0xad, 0x2e, 0xaf, 0x08,
+  0x9c, 0x74, 0xe5, 0x7f, 0x27, 0xa1, 0x4b, 0xff, 0x55, 0xbe, 0xff, 0x05, 0xca, 0x5b, 0xfc, 0xed,
+  0xab, 0x4f, 0x00, 0x00,
+};
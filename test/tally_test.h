@@ -0,0 +1,111 @@
+/*
+    Shared helpers for the host unit tests (pio test -e native)
+    Video Walrus 2025
+
+    Header-only, included by every test program under test/. Builds TSL
+    packets the way a switcher sends them, and stands in for the clock
+    and the LED chain.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "hal.h"
+#include "tally_core.h"
+
+typedef std::vector<uint8_t> Bytes;
+
+// gtest prints Rgb as RRGGBB in failures
+inline void PrintTo(const Rgb &c, std::ostream *os) {
+  char hex[8];
+  snprintf(hex, sizeof(hex), "%02X%02X%02X", c.r, c.g, c.b);
+  *os << hex;
+}
+
+// Time that only moves when the test moves it
+class FakeClock : public Clock {
+ public:
+  uint32_t millis() override { return now / 1000; }
+  uint32_t micros() override { return now; }
+  void advanceMs(uint32_t ms) { now += ms * 1000; }
+  void advanceUs(uint32_t us) { now += us; }
+  uint32_t now = 1000000;
+};
+
+// Keeps the last frame shown
+class RecordingLedSink : public LedSink {
+ public:
+  explicit RecordingLedSink(size_t count) : count(count), pixels(count) {}
+  size_t size() const override { return count; }
+  void show(const Rgb *frame, size_t n, uint8_t brightness) override {
+    pixels.assign(frame, frame + n);
+    shows++;
+  }
+
+  size_t count;
+  std::vector<Rgb> pixels;
+  uint32_t shows = 0;
+};
+
+// One TSL 3.1 message: address + 0x80, control byte, label padded to 16
+inline Bytes tsl31Message(int addr, uint8_t control, const char *label) {
+  Bytes m(TSL31_MESSAGE_LENGTH, ' ');
+  m[0] = 0x80 + addr;
+  m[1] = control;
+  for (int i = 0; i < 16 && label[i]; i++) m[2 + i] = label[i];
+  return m;
+}
+
+inline void append(Bytes &to, const Bytes &from) {
+  to.insert(to.end(), from.begin(), from.end());
+}
+
+// TSL 5.0 DMSG control word: RH, text and LH lamps (0 off, 1 red,
+// 2 green, 3 amber) and brightness 0-3
+inline uint16_t tsl5Control(uint8_t rh, uint8_t text, uint8_t lh, uint8_t brightness) {
+  return rh | (text << 2) | (lh << 4) | (brightness << 6);
+}
+
+struct Tsl5Dmsg {
+  uint16_t index;
+  uint16_t control;
+  std::string text;  // Sent as UTF-16LE when the packet has TSL5_FLAG_UNICODE
+};
+
+// One TSL 5.0 packet: PBC, VER, FLAGS, SCREEN, then the DMSGs
+inline Bytes tsl5Packet(const std::vector<Tsl5Dmsg> &dmsgs, uint8_t flags = 0) {
+  Bytes body = { 0, flags, 0, 0 };  // VER, FLAGS, SCREEN
+  for (const Tsl5Dmsg &d : dmsgs) {
+    Bytes text;
+    for (unsigned char c : d.text) {
+      text.push_back(c);
+      if (flags & TSL5_FLAG_UNICODE) text.push_back(0);
+    }
+    uint16_t fields[3] = { d.index, d.control, (uint16_t)text.size() };
+    for (uint16_t f : fields) {
+      body.push_back(f & 0xFF);
+      body.push_back(f >> 8);
+    }
+    append(body, text);
+  }
+  Bytes packet = { (uint8_t)(body.size() & 0xFF), (uint8_t)(body.size() >> 8) };
+  append(packet, body);
+  return packet;
+}
+
+// TCP framing: DLE/STX, then the packet with every DLE doubled
+inline Bytes tsl5Stuff(const Bytes &packet) {
+  Bytes framed = { TSL5_DLE, TSL5_STX };
+  for (uint8_t b : packet) {
+    framed.push_back(b);
+    if (b == TSL5_DLE) framed.push_back(TSL5_DLE);
+  }
+  return framed;
+}
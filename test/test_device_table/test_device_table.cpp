@@ -0,0 +1,203 @@
+/*
+    DeviceTable: a simulated set of 200 mDNS responders over half an hour
+    of discovery rounds
+    Video Walrus 2025
+
+    env:native builds with -DMAX_DISCOVERED_DEVICES=256 so the table has
+    room for all of them.
+*/
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "device_table.h"
+
+// The discovery task's timing (main.cpp)
+#define QUERY_INTERVAL_MS 15000
+#define OFFLINE_MS 45000
+#define FORGET_MS 600000
+
+#define RESPONDERS 200
+
+struct Responder {
+  char mac[18];     // Empty: advertises no MAC, keyed by hostname
+  char hostname[33];
+  uint32_t ip;
+  uint8_t tslAddress;
+  bool up = true;
+};
+
+static uint32_t nextRandom(uint32_t &rng) {
+  rng ^= rng << 13;
+  rng ^= rng >> 17;
+  rng ^= rng << 5;
+  return rng;
+}
+
+class DeviceTableTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    if (MAX_DISCOVERED_DEVICES < RESPONDERS) GTEST_SKIP() << "needs -DMAX_DISCOVERED_DEVICES=256";
+    responders.resize(RESPONDERS);
+    for (int i = 0; i < RESPONDERS; i++) {
+      Responder &r = responders[i];
+      if (i % 10 == 9) r.mac[0] = '\0';  // Some older firmware advertises no MAC
+      else snprintf(r.mac, sizeof(r.mac), "24:0A:C4:%02X:%02X:%02X", i >> 16, (i >> 8) & 0xFF, i & 0xFF);
+      snprintf(r.hostname, sizeof(r.hostname), "tally-%02x%02x%02x", 0x24, i >> 8, i & 0xFF);
+      r.ip = htonl(0x0A000000 + 10 + i);
+      r.tslAddress = 1 + i % 126;
+    }
+  }
+
+  uint64_t key(const Responder &r) const { return DeviceTable::deviceKey(r.mac[0] ? r.mac : NULL, r.hostname); }
+
+  // One query: every responder that is up answers, less the ones mDNS
+  // loses (lossPct); then the table ages, as the discovery task does
+  size_t round(int lossPct) {
+    size_t answered = 0;
+    for (const Responder &r : responders) {
+      if (!r.up || (int)(nextRandom(rng) % 100) < lossPct) continue;
+      EXPECT_TRUE(table.update(key(r), r.hostname, r.ip, r.tslAddress, OFFLINE_MS, nowMs)) << r.hostname;
+      answered++;
+    }
+    table.age(nowMs, FORGET_MS);
+    nowMs += QUERY_INTERVAL_MS;
+    return answered;
+  }
+
+  size_t online() const {
+    size_t n = 0;
+    for (size_t i = 0; i < table.count(); i++) n += table.entry(i).online;
+    return n;
+  }
+
+  const DeviceEntry *lookup(const Responder &r) const {
+    int i = table.find(key(r));
+    return i < 0 ? NULL : &table.entry(i);
+  }
+
+  DeviceTable table;
+  std::vector<Responder> responders;
+  uint32_t nowMs = 5000;
+  uint32_t rng = 0x200;
+};
+
+TEST_F(DeviceTableTest, AllRespondersFound) {
+  round(0);
+  ASSERT_EQ(table.count(), (size_t)RESPONDERS);
+  EXPECT_EQ(online(), (size_t)RESPONDERS);
+  for (const Responder &r : responders) {
+    const DeviceEntry *e = lookup(r);
+    ASSERT_NE(e, nullptr) << r.hostname;
+    EXPECT_EQ(e->ip, r.ip);
+    EXPECT_EQ(e->tslAddress, r.tslAddress);
+    EXPECT_STREQ(table.hostname(e - &table.entry(0)), r.hostname);
+  }
+}
+
+TEST_F(DeviceTableTest, LossyAnswersKeepDevicesOnline) {
+  // 20% of answers lost every round: a device is rarely silent for the
+  // three rounds it takes to go offline
+  for (int i = 0; i < 120; i++) round(20);  // Half an hour
+  EXPECT_EQ(table.count(), (size_t)RESPONDERS);
+  EXPECT_GE(online(), (size_t)RESPONDERS * 95 / 100);
+}
+
+TEST_F(DeviceTableTest, SilentDevicesGoOfflineThenAreForgotten) {
+  round(0);
+  for (int i = 0; i < 20; i++) responders[i * 10].up = false;  // Switched off
+
+  for (int i = 0; i < 3; i++) round(0);  // 45 s: the TTL has just run out
+  EXPECT_EQ(online(), (size_t)RESPONDERS);
+  round(0);
+  EXPECT_EQ(online(), (size_t)RESPONDERS - 20);
+  EXPECT_EQ(table.count(), (size_t)RESPONDERS);
+  for (int i = 0; i < 20; i++) {
+    const DeviceEntry *e = lookup(responders[i * 10]);
+    ASSERT_NE(e, nullptr);
+    EXPECT_FALSE(e->online);
+  }
+
+  while (nowMs < 5000 + FORGET_MS + 2 * QUERY_INTERVAL_MS) round(0);
+  EXPECT_EQ(table.count(), (size_t)RESPONDERS - 20);
+  for (int i = 0; i < RESPONDERS; i++) {
+    EXPECT_EQ(lookup(responders[i]) != NULL, i % 10 != 0) << responders[i].hostname;
+  }
+
+  // Back on: found again, in the freed slots
+  for (int i = 0; i < 20; i++) responders[i * 10].up = true;
+  round(0);
+  EXPECT_EQ(table.count(), (size_t)RESPONDERS);
+  EXPECT_EQ(online(), (size_t)RESPONDERS);
+}
+
+TEST_F(DeviceTableTest, ChangesAreUpdatedInPlace) {
+  round(0);
+  responders[5].ip = htonl(0x0A0000FE);   // New DHCP lease
+  responders[6].tslAddress = 99;          // Re-addressed
+  strcpy(responders[7].hostname, "tally-jib");  // Renamed
+  round(0);
+  EXPECT_EQ(table.count(), (size_t)RESPONDERS);
+  EXPECT_EQ(lookup(responders[5])->ip, htonl(0x0A0000FE));
+  EXPECT_EQ(lookup(responders[6])->tslAddress, 99);
+  int i = table.find(key(responders[7]));
+  ASSERT_GE(i, 0);
+  EXPECT_STREQ(table.hostname(i), "tally-jib");
+}
+
+TEST_F(DeviceTableTest, RenamesDoNotExhaustTheNamePool) {
+  for (int r = 0; r < 200; r++) {
+    for (int i = 0; i < RESPONDERS; i += 3) {
+      if (responders[i].mac[0] == '\0') continue;  // Keyed by name: a rename is a new device
+      snprintf(responders[i].hostname, sizeof(responders[i].hostname), "tally-%03d-%03d-long-name", i % 1000,
+               r % 1000);
+    }
+    round(0);
+  }
+  EXPECT_EQ(table.count(), (size_t)RESPONDERS);
+  for (const Responder &r : responders) {
+    int i = table.find(key(r));
+    ASSERT_GE(i, 0);
+    EXPECT_STREQ(table.hostname(i), r.hostname);
+  }
+}
+
+TEST_F(DeviceTableTest, FullTableRefusesNewDevices) {
+  round(0);
+  char hostname[33];
+  size_t added = 0;
+  for (int i = 0; table.count() < MAX_DISCOVERED_DEVICES; i++) {
+    snprintf(hostname, sizeof(hostname), "extra-%d", i);
+    ASSERT_TRUE(table.update(DeviceTable::deviceKey(NULL, hostname), hostname, 1, 1, OFFLINE_MS, nowMs));
+    added++;
+  }
+  EXPECT_FALSE(table.update(DeviceTable::deviceKey(NULL, "one-too-many"), "one-too-many", 1, 1, OFFLINE_MS, nowMs));
+  // Known devices still refresh
+  EXPECT_TRUE(table.update(key(responders[0]), responders[0].hostname, 2, 1, OFFLINE_MS, nowMs));
+  EXPECT_EQ(table.count(), (size_t)MAX_DISCOVERED_DEVICES);
+  EXPECT_EQ(added, (size_t)MAX_DISCOVERED_DEVICES - RESPONDERS);
+}
+
+TEST(DeviceTable, FormatJson) {
+  DeviceTable table;
+  ASSERT_TRUE(table.update(1, "tally-\"cam\"", htonl(0x0A000005), 3, OFFLINE_MS, 1000));
+  char buf[DEVICE_JSON_MAX_LENGTH];
+  size_t n = table.formatJson(0, 13500, buf, sizeof(buf));
+  EXPECT_EQ(n, strlen(buf));
+  EXPECT_STREQ(buf, "{\"hostname\":\"tally-\\\"cam\\\"\",\"ip\":\"10.0.0.5\",\"tslAddress\":3,\"online\":true,\"lastSeen\":12}");
+
+  // The longest hostname, every character escaped, still fits
+  std::string name(DEVICE_HOSTNAME_LENGTH - 1, '\x01');
+  ASSERT_TRUE(table.update(2, name.c_str(), htonl(0xFFFFFFFF), 255, OFFLINE_MS, 0));
+  EXPECT_LT(table.formatJson(1, 0xFFFFFFFF, buf, sizeof(buf)), sizeof(buf));
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
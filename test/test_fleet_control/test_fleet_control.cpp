@@ -0,0 +1,261 @@
+/*
+    Fleet control: the datagram codec, ack collection, and a simulated
+    fan-out of one command to 200 tallies over a lossy network
+    Video Walrus 2025
+*/
+
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <queue>
+#include <vector>
+
+#include "fleet_control.h"
+
+// The fleet task's resend schedule (main.cpp)
+#define RETRANSMIT_MS 25
+#define RETRANSMITS 3
+
+static FleetMessage command(uint32_t sequence, uint8_t cmd, uint32_t arg) {
+  FleetMessage msg = {};
+  msg.type = FLEET_COMMAND;
+  msg.sequence = sequence;
+  msg.sender = 0x240AC4000001ULL;
+  msg.command = cmd;
+  msg.arg = arg;
+  return msg;
+}
+
+TEST(FleetCodec, RoundTrip) {
+  FleetCodec codec;
+  codec.setKey("studio-b");
+  FleetMessage msg = command(0x12345678, FLEET_CMD_DISCO, 30000);
+  msg.arg2 = 0xCAFEF00D;
+  uint8_t buf[FLEET_MESSAGE_LENGTH];
+  codec.encode(msg, buf);
+
+  FleetMessage out;
+  ASSERT_TRUE(codec.decode(buf, sizeof(buf), &out));
+  EXPECT_EQ(out.type, FLEET_COMMAND);
+  EXPECT_EQ(out.sequence, 0x12345678u);
+  EXPECT_EQ(out.sender, 0x240AC4000001ULL);
+  EXPECT_EQ(out.command, FLEET_CMD_DISCO);
+  EXPECT_EQ(out.arg, 30000u);
+  EXPECT_EQ(out.arg2, 0xCAFEF00Du);
+}
+
+TEST(FleetCodec, RejectsTamperingAndOtherKeys) {
+  FleetCodec codec, other, off;
+  codec.setKey("studio-b");
+  other.setKey("studio-c");
+  off.setKey("");
+  EXPECT_FALSE(off.enabled());
+
+  uint8_t buf[FLEET_MESSAGE_LENGTH];
+  codec.encode(command(1, FLEET_CMD_TALLY, 1), buf);
+  FleetMessage out;
+  EXPECT_FALSE(other.decode(buf, sizeof(buf), &out));
+  EXPECT_FALSE(off.decode(buf, sizeof(buf), &out));
+  EXPECT_FALSE(codec.decode(buf, sizeof(buf) - 1, &out));
+
+  // Every bit of the datagram, tag included, is covered
+  for (size_t bit = 0; bit < FLEET_MESSAGE_LENGTH * 8; bit++) {
+    buf[bit / 8] ^= 1 << (bit % 8);
+    EXPECT_FALSE(codec.decode(buf, sizeof(buf), &out)) << "bit " << bit;
+    buf[bit / 8] ^= 1 << (bit % 8);
+  }
+  EXPECT_TRUE(codec.decode(buf, sizeof(buf), &out));
+}
+
+TEST(FleetCodec, SipHashReferenceVector) {
+  // SipHash-2-4 paper, appendix A: key 00..0F, message 00..0E
+  FleetKey key = { 0x0706050403020100ULL, 0x0F0E0D0C0B0A0908ULL };
+  uint8_t data[15];
+  for (int i = 0; i < 15; i++) data[i] = i;
+  EXPECT_EQ(sipHash24(key, data, sizeof(data)), 0xA129CA6149BE45E5ULL);
+}
+
+TEST(FleetRound, RecordsFirstAckPerSender) {
+  FleetRound round;
+  round.begin(7, FLEET_CMD_TALLY, 2, 3, 1000);
+  EXPECT_TRUE(round.recordAck(7, 0xA, 0x0A000001, 3000));
+  EXPECT_FALSE(round.recordAck(7, 0xA, 0x0A000001, 9000));  // Ack to a resend
+  EXPECT_FALSE(round.recordAck(6, 0xB, 0x0A000002, 4000));  // Previous command
+  EXPECT_TRUE(round.recordAck(7, 0xB, 0x0A000002, 6000));
+  EXPECT_EQ(round.count(), 2u);
+  EXPECT_EQ(round.maxLatencyUs(), 5000u);
+  EXPECT_EQ(round.ack(0).latencyUs, 2000u);
+  EXPECT_EQ(round.ack(1).ip, 0x0A000002u);
+
+  round.begin(8, FLEET_CMD_TALLY, 0, 3, 0xFFFFF000);  // micros() about to wrap
+  EXPECT_TRUE(round.recordAck(8, 0xA, 0x0A000001, 0x00000800));
+  EXPECT_EQ(round.maxLatencyUs(), 0x1800u);
+}
+
+TEST(FleetRound, CapsAtTheTableSize) {
+  FleetRound round;
+  round.begin(1, FLEET_CMD_TALLY, 0, MAX_DISCOVERED_DEVICES, 0);
+  for (uint64_t s = 0; s < MAX_DISCOVERED_DEVICES; s++) EXPECT_TRUE(round.recordAck(1, s + 1, 0, 100));
+  EXPECT_FALSE(round.recordAck(1, 0xFFFF, 0, 100));
+  EXPECT_EQ(round.count(), (size_t)MAX_DISCOVERED_DEVICES);
+}
+
+// One sender and a fleet of followers on a network that drops and delays
+// datagrams. Followers apply each command once and ack every copy, as the
+// fleet task does; the sender resends until everyone has acked.
+class FleetFanOut {
+ public:
+  struct Follower {
+    FleetCodec codec;
+    uint64_t lastSender = 0;
+    uint32_t lastSequence = 0;
+    uint32_t tallyState = 0;
+    int applied = 0;
+  };
+
+  FleetFanOut(size_t devices, int lossPct, const char *key) : followers(devices), lossPct(lossPct) {
+    leader.setKey("studio-b");
+    for (Follower &f : followers) f.codec.setKey(key);
+  }
+
+  // Runs one round to the end of its resends; returns the acks collected
+  const FleetRound &run(const FleetMessage &cmd) {
+    round.begin(cmd.sequence, cmd.command, cmd.arg, followers.size(), (uint32_t)nowUs);
+    leader.encode(cmd, datagram);
+    int resendsLeft = RETRANSMITS;
+    uint64_t gapUs = RETRANSMIT_MS * 1000;
+    uint64_t resendAt = nowUs + gapUs;
+    multicast();
+    sent = 1;
+
+    for (;;) {
+      if (events.empty() && resendsLeft == 0) break;
+      uint64_t next = events.empty() ? resendAt : events.top().atUs;
+      if (resendsLeft > 0 && resendAt < next) next = resendAt;
+      nowUs = next;
+      if (!events.empty() && events.top().atUs == nowUs) {
+        Event e = events.top();
+        events.pop();
+        deliver(e);
+      } else {
+        multicast();
+        sent++;
+        resendsLeft--;
+        gapUs *= 2;
+        resendAt = nowUs + gapUs;
+      }
+      if (round.count() >= round.expected()) resendsLeft = 0;
+    }
+    return round;
+  }
+
+  std::vector<Follower> followers;
+  int sent = 0;
+
+ private:
+  struct Event {
+    uint64_t atUs;  // Simulation time; the round sees it wrap as micros() does
+    bool toLeader;
+    size_t device;
+    uint8_t buf[FLEET_MESSAGE_LENGTH];
+    bool operator<(const Event &o) const { return atUs > o.atUs; }
+  };
+
+  uint32_t nextRandom() {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+  }
+
+  // Wi-Fi: 1-8 ms one way, lossPct of datagrams lost
+  void post(bool toLeader, size_t device, const uint8_t *buf) {
+    if ((int)(nextRandom() % 100) < lossPct) return;
+    Event e;
+    e.atUs = nowUs + 1000 + nextRandom() % 7000;
+    e.toLeader = toLeader;
+    e.device = device;
+    memcpy(e.buf, buf, sizeof(e.buf));
+    events.push(e);
+  }
+
+  void multicast() {
+    for (size_t i = 0; i < followers.size(); i++) post(false, i, datagram);
+  }
+
+  void deliver(const Event &e) {
+    FleetMessage msg;
+    if (e.toLeader) {
+      if (leader.decode(e.buf, sizeof(e.buf), &msg) && msg.type == FLEET_ACK) {
+        round.recordAck(msg.sequence, msg.sender, (uint32_t)e.device, (uint32_t)nowUs);
+      }
+      return;
+    }
+    Follower &f = followers[e.device];
+    if (!f.codec.decode(e.buf, sizeof(e.buf), &msg) || msg.type != FLEET_COMMAND) return;
+    if (msg.sender != f.lastSender || msg.sequence != f.lastSequence) {
+      f.tallyState = msg.arg;
+      f.applied++;
+      f.lastSender = msg.sender;
+      f.lastSequence = msg.sequence;
+    }
+    FleetMessage ack = { FLEET_ACK, msg.sequence, 0x240AC4100000ULL + e.device, msg.arg, msg.command, 0 };
+    uint8_t buf[FLEET_MESSAGE_LENGTH];
+    f.codec.encode(ack, buf);
+    post(true, e.device, buf);
+  }
+
+  FleetCodec leader;
+  FleetRound round;
+  std::priority_queue<Event> events;
+  uint8_t datagram[FLEET_MESSAGE_LENGTH];
+  int lossPct;
+  uint64_t nowUs = 0xFFF00000;  // micros() wraps mid-test
+  uint32_t rng = 0x13;
+};
+
+#define FLEET_DEVICES 200
+
+TEST(FleetFanOut, CleanNetworkConvergesWithoutResends) {
+  if (MAX_DISCOVERED_DEVICES < FLEET_DEVICES) GTEST_SKIP() << "needs -DMAX_DISCOVERED_DEVICES=256";
+  FleetFanOut fleet(FLEET_DEVICES, 0, "studio-b");
+  const FleetRound &round = fleet.run(command(1, FLEET_CMD_TALLY, 1));
+  EXPECT_EQ(round.count(), (size_t)FLEET_DEVICES);
+  EXPECT_EQ(fleet.sent, 1);
+  EXPECT_LT(round.maxLatencyUs(), 16000u);  // Two legs of at most 8 ms
+  for (const FleetFanOut::Follower &f : fleet.followers) EXPECT_EQ(f.tallyState, 1u);
+}
+
+TEST(FleetFanOut, LossyNetworkConvergesOnResends) {
+  if (MAX_DISCOVERED_DEVICES < FLEET_DEVICES) GTEST_SKIP() << "needs -DMAX_DISCOVERED_DEVICES=256";
+  FleetFanOut fleet(FLEET_DEVICES, 10, "studio-b");
+  size_t converged = 0;
+  uint32_t slowestUs = 0;
+  const int rounds = 50;
+  for (int r = 1; r <= rounds; r++) {
+    const FleetRound &round = fleet.run(command(r, FLEET_CMD_TALLY, r & 3));
+    converged += round.count() == (size_t)FLEET_DEVICES;
+    if (round.maxLatencyUs() > slowestUs) slowestUs = round.maxLatencyUs();
+    // Each ack is counted once, and resends are never applied twice
+    for (const FleetFanOut::Follower &f : fleet.followers) EXPECT_LE(f.applied, r);
+    EXPECT_GE(round.count(), (size_t)FLEET_DEVICES - 2);
+  }
+  printf("  %d devices, 10%% loss each way: %zu/%d rounds reached every device, slowest ack %u ms\n",
+         FLEET_DEVICES, converged, rounds, slowestUs / 1000);
+  EXPECT_GE(converged, (size_t)rounds * 3 / 4);
+}
+
+TEST(FleetFanOut, OtherKeyIsIgnored) {
+  FleetFanOut fleet(20, 0, "studio-c");
+  const FleetRound &round = fleet.run(command(1, FLEET_CMD_TALLY, 1));
+  EXPECT_EQ(round.count(), 0u);
+  EXPECT_EQ(fleet.sent, 1 + RETRANSMITS);
+  for (const FleetFanOut::Follower &f : fleet.followers) EXPECT_EQ(f.applied, 0);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
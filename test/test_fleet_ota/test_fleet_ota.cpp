@@ -0,0 +1,104 @@
+/*
+    Fleet OTA: the authenticated image description and source picking
+    Video Walrus 2025
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "fleet_ota.h"
+
+static const char *SHA =
+    "9f86d081884c7d659a2feaa0c55ad015a3bf4f1b2b0b822cd15d6c15b0f00a08";
+
+class FleetImageTest : public ::testing::Test {
+ protected:
+  FleetImageTest() {
+    codec.setKey("studio fleet");
+    other.setKey("another fleet");
+  }
+
+  std::string format(const char *version = "1.4.0", const char *sha = SHA, uint32_t size = 1234567) {
+    char buf[FLEET_IMAGE_MAX_TEXT];
+    size_t n = formatFleetImage(codec, version, sha, size, buf, sizeof(buf));
+    return n == 0 ? std::string() : std::string(buf, n);
+  }
+
+  FleetCodec codec;
+  FleetCodec other;
+  FleetImage image;
+};
+
+TEST_F(FleetImageTest, RoundTrip) {
+  std::string text = format();
+  ASSERT_FALSE(text.empty());
+  EXPECT_EQ(text.rfind("1.4.0 ", 0), 0u);
+
+  ASSERT_TRUE(parseFleetImage(codec, text.c_str(), image));
+  EXPECT_STREQ(image.version, "1.4.0");
+  EXPECT_EQ(image.size, 1234567u);
+  EXPECT_EQ(image.sha256[0], 0x9f);
+  EXPECT_EQ(image.sha256[31], 0x08);
+  EXPECT_EQ(fleetImageTag(image.sha256), 0x9f86d081u);
+}
+
+TEST_F(FleetImageTest, OtherFleetKeyIsRefused) {
+  std::string text = format();
+  EXPECT_FALSE(parseFleetImage(other, text.c_str(), image));
+
+  FleetCodec none;
+  EXPECT_FALSE(parseFleetImage(none, text.c_str(), image));
+  char buf[FLEET_IMAGE_MAX_TEXT];
+  EXPECT_EQ(formatFleetImage(none, "1.4.0", SHA, 1, buf, sizeof(buf)), 0u);
+}
+
+TEST_F(FleetImageTest, AnyChangeBreaksTheMac) {
+  std::string text = format();
+  for (size_t i = 0; i < text.size(); i++) {
+    std::string tampered = text;
+    tampered[i] = tampered[i] == '1' ? '2' : '1';
+    EXPECT_FALSE(parseFleetImage(codec, tampered.c_str(), image)) << "byte " << i;
+  }
+  // A different hash with the old MAC
+  std::string swapped = text;
+  swapped.replace(6, 8, "00000000");
+  EXPECT_FALSE(parseFleetImage(codec, swapped.c_str(), image));
+}
+
+TEST_F(FleetImageTest, OldFormatIsRefused) {
+  std::string plain = std::string("1.4.0 ") + SHA + " 1234567";
+  EXPECT_FALSE(parseFleetImage(codec, plain.c_str(), image));
+  EXPECT_FALSE(parseFleetImage(codec, "", image));
+  EXPECT_FALSE(parseFleetImage(codec, "1.4.0", image));
+}
+
+TEST_F(FleetImageTest, MalformedArgumentsAreNotFormatted) {
+  EXPECT_TRUE(format("", SHA).empty());
+  EXPECT_TRUE(format("1.4 beta", SHA).empty());
+  EXPECT_TRUE(format("1.4.0", "9f86d081").empty());
+  std::string longVersion(FLEET_IMAGE_MAX_VERSION, '1');
+  EXPECT_TRUE(format(longVersion.c_str(), SHA).empty());
+
+  char small[40];
+  EXPECT_EQ(formatFleetImage(codec, "1.4.0", SHA, 1, small, sizeof(small)), 0u);
+}
+
+TEST(FleetOtaSources, PicksOnlyNearerSources) {
+  FleetOtaSources sources;
+  sources.begin(0x1234);
+  EXPECT_FALSE(sources.add(0x9999, 1, 0));  // Another image
+  EXPECT_TRUE(sources.add(0x1234, 1, 0));
+  EXPECT_TRUE(sources.add(0x1234, 2, 2));
+  EXPECT_EQ(sources.hops(2), 2);
+
+  uint32_t rng = 1;
+  for (int i = 0; i < 20; i++) EXPECT_EQ(sources.pick(1, 0, rng), 1u);
+  EXPECT_EQ(sources.pick(0, 0, rng), 0u);
+  EXPECT_EQ(sources.pick(3, 1, rng), 2u);  // Avoids the one that failed
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
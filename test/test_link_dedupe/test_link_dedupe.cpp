@@ -0,0 +1,143 @@
+/*
+    LinkDedupe: one copy of each datagram heard on two links
+    Video Walrus 2025
+*/
+
+#include <gtest/gtest.h>
+
+#include "../tally_test.h"
+#include "link_dedupe.h"
+
+class LinkDedupeTest : public ::testing::Test {
+ protected:
+  bool dup(int link, const Bytes &data) { return dedupe.duplicate(link, data.data(), data.size(), nowUs); }
+
+  LinkDedupe dedupe;
+  uint32_t nowUs = 1000000;
+  Bytes cam1 = tsl31Message(1, 0x32, "CAM 1");
+  Bytes cam2 = tsl31Message(2, 0x32, "CAM 2");
+};
+
+TEST_F(LinkDedupeTest, SecondLinkCopyIsDropped) {
+  EXPECT_FALSE(dup(0, cam1));
+  nowUs += 300;
+  EXPECT_TRUE(dup(1, cam1));
+}
+
+TEST_F(LinkDedupeTest, EitherLinkCanBeFirst) {
+  EXPECT_FALSE(dup(1, cam1));
+  EXPECT_TRUE(dup(0, cam1));
+}
+
+TEST_F(LinkDedupeTest, DifferentDatagramsPass) {
+  EXPECT_FALSE(dup(0, cam1));
+  EXPECT_FALSE(dup(1, cam2));
+  Bytes shorter(cam1.begin(), cam1.end() - 1);
+  EXPECT_FALSE(dup(1, shorter));
+}
+
+TEST_F(LinkDedupeTest, SameLinkResendPasses) {
+  EXPECT_FALSE(dup(0, cam1));
+  EXPECT_FALSE(dup(0, cam1));  // The switcher sent it again
+  EXPECT_TRUE(dup(1, cam1));
+  EXPECT_TRUE(dup(1, cam1));   // Its second copy
+  EXPECT_FALSE(dup(1, cam1));  // Nothing left to match
+}
+
+TEST_F(LinkDedupeTest, ResetForgetsEverything) {
+  EXPECT_FALSE(dup(0, cam1));
+  dedupe.reset();
+  EXPECT_FALSE(dup(1, cam1));
+}
+
+TEST_F(LinkDedupeTest, UnknownLinkIsNeverADuplicate) {
+  EXPECT_FALSE(dup(0, cam1));
+  EXPECT_FALSE(dup(2, cam1));
+  EXPECT_FALSE(dup(-1, cam1));
+  EXPECT_TRUE(dup(1, cam1));  // Link 0's copy was not used up
+}
+
+TEST_F(LinkDedupeTest, LaggingCopyInsideTheWindowIsDropped) {
+  EXPECT_FALSE(dup(0, cam1));
+  nowUs += LINK_DEDUPE_WINDOW_US;
+  EXPECT_TRUE(dup(1, cam1));
+}
+
+TEST_F(LinkDedupeTest, CopyAfterTheWindowPasses) {
+  EXPECT_FALSE(dup(0, cam1));
+  nowUs += LINK_DEDUPE_WINDOW_US + 2;
+  EXPECT_FALSE(dup(1, cam1));  // Taken as a new datagram
+  EXPECT_TRUE(dup(0, cam1));   // ...which link 0's next copy then matches
+}
+
+// Cut to camera 2 and back, with the Wi-Fi copies lagging so far behind
+// that all three Ethernet copies come first: three cues, in order
+TEST_F(LinkDedupeTest, CutAndBackWithALaggingLink) {
+  std::vector<const Bytes *> cues = { &cam1, &cam2, &cam1 };
+  std::vector<const Bytes *> decoded;
+  for (const Bytes *cue : cues) {
+    if (!dup(0, *cue)) decoded.push_back(cue);
+    nowUs += 40000;
+  }
+  for (const Bytes *cue : cues) {
+    EXPECT_TRUE(dup(1, *cue));
+    nowUs += 40000;
+  }
+  ASSERT_EQ(decoded.size(), 3u);
+  EXPECT_EQ(decoded[0], &cam1);
+  EXPECT_EQ(decoded[1], &cam2);
+  EXPECT_EQ(decoded[2], &cam1);
+}
+
+TEST_F(LinkDedupeTest, CutAndBackInterleaved) {
+  int decoded = 0;
+  for (const Bytes *cue : { &cam1, &cam2, &cam1, &cam2 }) {
+    decoded += !dup(1, *cue);  // Wi-Fi first this time
+    nowUs += 800;
+    decoded += !dup(0, *cue);
+    nowUs += 20000;
+  }
+  EXPECT_EQ(decoded, 4);
+}
+
+// A switcher resending its state at 50 Hz on both links: each resend is
+// decoded once
+TEST_F(LinkDedupeTest, PeriodicResendsOnBothLinks) {
+  int decoded = 0;
+  for (int i = 0; i < 500; i++) {
+    decoded += !dup(0, cam1);
+    nowUs += 3000;
+    decoded += !dup(1, cam1);
+    nowUs += 17000;
+  }
+  EXPECT_EQ(decoded, 500);
+}
+
+TEST_F(LinkDedupeTest, WorksAcrossTheMicrosWrap) {
+  nowUs = 0xFFFFFF00;
+  EXPECT_FALSE(dup(0, cam1));
+  nowUs += 300;  // Wrapped
+  EXPECT_TRUE(dup(1, cam1));
+
+  nowUs = 0xFFFFFFF0;
+  EXPECT_FALSE(dup(0, cam2));
+  nowUs += LINK_DEDUPE_WINDOW_US + 0x20;
+  EXPECT_FALSE(dup(1, cam2));  // Stale, even though the raw time is smaller
+}
+
+TEST_F(LinkDedupeTest, RemembersTheLatestSlotsPerLink) {
+  std::vector<Bytes> burst;
+  for (int i = 0; i <= LINK_DEDUPE_SLOTS; i++) {
+    char label[16];
+    snprintf(label, sizeof(label), "CAM %d", i);
+    burst.push_back(tsl31Message(i % 127, 0x31, label));
+    EXPECT_FALSE(dup(0, burst.back()));
+  }
+  EXPECT_FALSE(dup(1, burst[0]));  // Overwritten by the burst
+  for (int i = 1; i <= LINK_DEDUPE_SLOTS; i++) EXPECT_TRUE(dup(1, burst[i])) << i;
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,93 @@
+/*
+    RequestLimit: HTTP request slots come back, whoever set the last
+    disconnect callback
+    Video Walrus 2025
+*/
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <vector>
+
+#include "request_limit.h"
+
+// Like AsyncWebServerRequest: one disconnect callback, replaced by each
+// onDisconnect()
+struct FakeRequest {
+  void onDisconnect(std::function<void()> fn) { disconnectFn = fn; }
+  void disconnect() {
+    if (disconnectFn) disconnectFn();
+  }
+  std::function<void()> disconnectFn;
+};
+
+static int streams = 0;
+static int streamsDone = 0;
+static void streamDone() {
+  streams--;
+  streamsDone++;
+}
+
+// The web server's request path: the middleware admits and watches, and
+// a firmware.bin handler adds its own hook
+static bool serve(RequestLimit &limit, FakeRequest &request, bool stream) {
+  if (!limit.admit()) return false;
+  limit.watch(&request);
+  if (stream) {
+    streams++;
+    limit.watch(&request, streamDone);
+  }
+  return true;
+}
+
+TEST(RequestLimit, RejectsOnceFull) {
+  RequestLimit limit(2);
+  FakeRequest a, b, c;
+  EXPECT_TRUE(serve(limit, a, false));
+  EXPECT_TRUE(serve(limit, b, false));
+  EXPECT_FALSE(serve(limit, c, false));
+  EXPECT_EQ(limit.active(), 2);
+
+  a.disconnect();
+  EXPECT_EQ(limit.active(), 1);
+  EXPECT_TRUE(serve(limit, c, false));
+}
+
+TEST(RequestLimit, StreamsGiveTheirSlotsBack) {
+  const int maxRequests = 8;
+  RequestLimit limit(maxRequests);
+  streams = streamsDone = 0;
+
+  // Many more firmware streams than slots, a few at a time
+  for (int round = 0; round < 10; round++) {
+    std::vector<FakeRequest> requests(3);
+    for (FakeRequest &r : requests) ASSERT_TRUE(serve(limit, r, true)) << "round " << round;
+    EXPECT_EQ(streams, 3);
+    for (FakeRequest &r : requests) r.disconnect();
+  }
+  EXPECT_EQ(streams, 0);
+  EXPECT_EQ(streamsDone, 30);
+  EXPECT_EQ(limit.active(), 0);
+
+  // A normal request still gets through, and so does a full house
+  std::vector<FakeRequest> requests(maxRequests);
+  for (FakeRequest &r : requests) EXPECT_TRUE(serve(limit, r, false));
+  FakeRequest extra;
+  EXPECT_FALSE(serve(limit, extra, false));
+}
+
+TEST(RequestLimit, HookRunsBeforeTheSlotIsFree) {
+  static RequestLimit limit(1);
+  static int activeInHook = -1;
+  FakeRequest request;
+  ASSERT_TRUE(limit.admit());
+  limit.watch(&request, []() { activeInHook = limit.active(); });
+  request.disconnect();
+  EXPECT_EQ(activeInHook, 1);
+  EXPECT_EQ(limit.active(), 0);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,105 @@
+/*
+    ShowSync: disco epoch from the leader's beacons
+    Video Walrus 2025
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "../tally_test.h"
+
+TEST(ShowSync, FirstBeaconStartsTheShow) {
+  ShowSync sync;
+  EXPECT_FALSE(sync.running());
+  EXPECT_TRUE(sync.sample(42, 300000, 10000, 5000000));
+  EXPECT_TRUE(sync.running());
+  EXPECT_EQ(sync.seed(), 42u);
+  EXPECT_EQ(sync.epochUs(), 4700000u);
+  EXPECT_EQ(sync.durationMs(), 10000u);
+}
+
+TEST(ShowSync, LateBeaconLeavesTheEpoch) {
+  ShowSync sync;
+  sync.sample(42, 0, 10000, 5000000);
+  // One second on, delivered 3 ms late
+  EXPECT_FALSE(sync.sample(42, 1000000, 10000, 6003000));
+  EXPECT_EQ(sync.epochUs(), 5000000u);
+}
+
+TEST(ShowSync, EarlierBeaconMovesTheEpoch) {
+  ShowSync sync;
+  sync.sample(42, 0, 10000, 5004000);  // The first one was 4 ms late
+  EXPECT_TRUE(sync.sample(42, 1000000, 10000, 6001000));
+  EXPECT_EQ(sync.epochUs(), 5001000u);
+}
+
+TEST(ShowSync, OldBeaconsLeaveTheWindow) {
+  ShowSync sync;
+  uint32_t elapsed = 0;
+  sync.sample(42, elapsed, 10000, 5000000);  // Best: epoch 5000000
+  // Our clock runs 100 us per beacon slow against the leader's, so every
+  // later candidate is later; the best moves once the first has aged out
+  for (int i = 1; i < DISCO_SYNC_WINDOW; i++) {
+    elapsed += 1000000;
+    EXPECT_FALSE(sync.sample(42, elapsed, 10000, 5000000 + elapsed + 100 * i));
+  }
+  elapsed += 1000000;
+  EXPECT_TRUE(sync.sample(42, elapsed, 10000, 5000000 + elapsed + 100 * DISCO_SYNC_WINDOW));
+  EXPECT_EQ(sync.epochUs(), 5000100u);
+}
+
+TEST(ShowSync, NewSeedRestarts) {
+  ShowSync sync;
+  sync.sample(42, 0, 10000, 5000000);
+  EXPECT_TRUE(sync.sample(43, 0, 20000, 9000000));
+  EXPECT_EQ(sync.seed(), 43u);
+  EXPECT_EQ(sync.epochUs(), 9000000u);
+  EXPECT_EQ(sync.durationMs(), 20000u);
+}
+
+TEST(ShowSync, StopThenSameSeedStartsAgain) {
+  ShowSync sync;
+  sync.sample(42, 0, 10000, 5000000);
+  sync.stop();
+  EXPECT_FALSE(sync.running());
+  EXPECT_TRUE(sync.sample(42, 0, 10000, 8000000));
+  EXPECT_EQ(sync.epochUs(), 8000000u);
+}
+
+TEST(ShowSync, EpochAcrossMicrosWrap) {
+  ShowSync sync;
+  sync.sample(42, 0, 10000, 0xFFFFF000u);
+  // Received after micros() wrapped, and earlier than the first estimate
+  EXPECT_TRUE(sync.sample(42, 1000000, 10000, 0xFFFFF000u + 1000000 - 0x800));
+  EXPECT_EQ(sync.epochUs(), 0xFFFFE800u);
+  EXPECT_FALSE(sync.sample(42, 2000000, 10000, 0xFFFFF000u + 2000000));
+}
+
+TEST(DiscoFrameColor, SameSeedAndFrameSameColour) {
+  for (uint32_t frame = 0; frame < 100; frame++) {
+    EXPECT_EQ(discoFrameColor(7, frame), discoFrameColor(7, frame));
+  }
+}
+
+TEST(DiscoFrameColor, SeedsGiveDifferentShows) {
+  int differ = 0;
+  for (uint32_t frame = 0; frame < 100; frame++) {
+    if (discoFrameColor(7, frame) != discoFrameColor(8, frame)) differ++;
+  }
+  EXPECT_GT(differ, 50);
+}
+
+TEST(DiscoFrameColor, EveryColourIsUsed) {
+  std::vector<Rgb> seen;
+  for (uint32_t frame = 0; frame < 200; frame++) {
+    Rgb c = discoFrameColor(1234, frame);
+    if (std::find(seen.begin(), seen.end(), c) == seen.end()) seen.push_back(c);
+  }
+  EXPECT_EQ(seen.size(), 6u);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,221 @@
+/*
+    Tally events: the /events feed and its JSON escaping, and a load test
+    of many subscribers against a switcher's cue and resend stream
+    Video Walrus 2025
+*/
+
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "../tally_test.h"
+#include "json_text.h"
+#include "tally_events.h"
+
+TEST(TallyEvents, Format) {
+  char buf[TALLY_EVENT_MAX_LENGTH];
+  size_t n = formatTallyEvent(2, "CAM 1", buf, sizeof(buf));
+  EXPECT_EQ(n, strlen(buf));
+  EXPECT_STREQ(buf, "{\"tally\":\"Red\",\"text\":\"CAM 1\"}");
+  formatTallyEvent(0, "", buf, sizeof(buf));
+  EXPECT_STREQ(buf, "{\"tally\":\"Off\",\"text\":\"\"}");
+}
+
+TEST(TallyEvents, FormatEscapesQuotes) {
+  char buf[TALLY_EVENT_MAX_LENGTH];
+  formatTallyEvent(1, "A\"B\\C", buf, sizeof(buf));
+  EXPECT_STREQ(buf, "{\"tally\":\"Green\",\"text\":\"A\\\"B\\\\C\"}");
+
+  // The longest possible label still fits
+  formatTallyEvent(3, "\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"", buf, sizeof(buf));
+  EXPECT_EQ(buf[strlen(buf) - 1], '}');
+}
+
+TEST(JsonText, EscapesQuotesBackslashesAndControls) {
+  char buf[64];
+  EXPECT_EQ(jsonEscape("Studio \"A\"\\1\n\x01", buf, sizeof(buf)), 14u);
+  EXPECT_STREQ(buf, "Studio \\\"A\\\"\\\\1\\u000a\\u0001");
+  EXPECT_EQ(jsonEscape("Caf\xC3\xA9", buf, sizeof(buf)), 5u);  // UTF-8 passes through
+  EXPECT_STREQ(buf, "Caf\xC3\xA9");
+}
+
+TEST(JsonText, NeverSplitsAnEscape) {
+  // A string longer than the buffer goes in a piece at a time
+  const char *ssid = "a\"b\"c\"d\"e\"f";
+  std::string out;
+  for (const char *s = ssid; *s;) {
+    char buf[4];
+    size_t used = jsonEscape(s, buf, sizeof(buf));
+    ASSERT_GT(used, 0u);
+    ASSERT_LT(strlen(buf), sizeof(buf));
+    out += buf;
+    s += used;
+  }
+  EXPECT_EQ(out, "a\\\"b\\\"c\\\"d\\\"e\\\"f");
+
+  char tiny[2];
+  EXPECT_EQ(jsonEscape("\"", tiny, sizeof(tiny)), 0u);  // No room for the pair
+  EXPECT_STREQ(tiny, "");
+}
+
+TEST(TallyEvents, OnlyRealChangesAreSent) {
+  TallyEventFeed feed;
+  EXPECT_EQ(feed.poll(0, 0, "", 100), TALLY_EVENT_NONE);
+  EXPECT_EQ(feed.poll(1, 2, "CAM 1", 200), TALLY_EVENT_CHANGE);
+  EXPECT_STREQ(feed.data(), "{\"tally\":\"Red\",\"text\":\"CAM 1\"}");
+  EXPECT_EQ(feed.poll(1, 2, "CAM 1", 300), TALLY_EVENT_NONE);  // No redraw
+  EXPECT_EQ(feed.poll(2, 2, "CAM 1", 400), TALLY_EVENT_NONE);  // Redrawn the same
+  EXPECT_EQ(feed.poll(3, 2, "CAM 1B", 500), TALLY_EVENT_CHANGE);
+  EXPECT_EQ(feed.poll(4, 1, "CAM 1B", 600), TALLY_EVENT_CHANGE);
+}
+
+TEST(TallyEvents, KeepaliveWhenQuiet) {
+  TallyEventFeed feed;
+  EXPECT_EQ(feed.poll(1, 2, "CAM 1", 1000), TALLY_EVENT_CHANGE);
+  EXPECT_EQ(feed.poll(1, 2, "CAM 1", 1000 + EVENT_KEEPALIVE_MS), TALLY_EVENT_NONE);
+  EXPECT_EQ(feed.poll(1, 2, "CAM 1", 1001 + EVENT_KEEPALIVE_MS), TALLY_EVENT_KEEPALIVE);
+  EXPECT_EQ(feed.poll(1, 2, "CAM 1", 1002 + EVENT_KEEPALIVE_MS), TALLY_EVENT_NONE);
+  // A change restarts the keepalive interval
+  EXPECT_EQ(feed.poll(2, 1, "CAM 1", 10000 + EVENT_KEEPALIVE_MS), TALLY_EVENT_CHANGE);
+  EXPECT_EQ(feed.poll(2, 1, "CAM 1", 1002 + 2 * EVENT_KEEPALIVE_MS), TALLY_EVENT_NONE);
+}
+
+// ---------------------------------------------------------------------------
+// Load test
+// ---------------------------------------------------------------------------
+
+#define LOAD_BROWSERS 30         // A gallery with the config page open everywhere
+#define LOAD_TICK_MS 5           // One loop() pass
+#define LOAD_RESEND_MS 20        // Switcher resends our tally at 50 Hz
+#define LOAD_CUT_MS 2000         // A cut every 2 s
+#define LOAD_BUSY_MS 60000       // Then a quiet minute of resends only
+#define LOAD_QUIET_MS 60000
+#define POLL_INTERVAL_MS 2000    // What a page without events does
+#define STATUS_RESPONSE_BYTES 420  // /status JSON plus HTTP headers, approximately
+
+// Stands in for AsyncEventSource: the same cap on connect, and the SSE
+// bytes each client is sent
+class FakeEventSource {
+ public:
+  struct Client {
+    uint32_t tallyEvents = 0;
+    uint32_t keepalives = 0;
+    uint32_t bytes = 0;
+    std::string last;
+  };
+
+  bool connect(const char *initial, uint32_t nowMs) {
+    if (clients.size() + 1 > MAX_EVENT_CLIENTS) return false;  // events.count() includes the new client
+    clients.push_back(Client());
+    sendTo(clients.back(), initial, "tally", nowMs);
+    return true;
+  }
+  void send(const char *data, const char *event, uint32_t nowMs) {
+    for (Client &c : clients) sendTo(c, data, event, nowMs);
+  }
+
+  std::vector<Client> clients;
+
+ private:
+  static void sendTo(Client &c, const char *data, const char *event, uint32_t nowMs) {
+    char wire[160];
+    c.bytes += snprintf(wire, sizeof(wire), "id: %u\nevent: %s\ndata: %s\n\n", nowMs, event, data);
+    if (strcmp(event, "tally") == 0) {
+      c.tallyEvents++;
+      c.last = data;
+    } else {
+      c.keepalives++;
+    }
+  }
+};
+
+TEST(TallyEvents, LoadManySubscribers) {
+  FakeClock clock;
+  TallyMailbox mailbox;
+  TslDecoder decoder(mailbox, clock);
+  RecordingLedSink sink(7);
+  TallyRenderer renderer(sink, clock, mailbox);
+  TallyEventFeed feed;
+  FakeEventSource source;
+  decoder.address = 1;
+
+  char data[TALLY_EVENT_MAX_LENGTH];
+  TallySnapshot snap;
+  auto current = [&]() {
+    mailbox.peek(snap);
+    formatTallyEvent(renderer.displayedState(), snap.text, data, sizeof(data));
+    return data;
+  };
+
+  int subscribed = 0, refused = 0;
+  for (int i = 0; i < LOAD_BROWSERS; i++) {
+    if (source.connect(current(), clock.millis())) subscribed++;
+    else refused++;
+  }
+
+  uint8_t control = 0x31;
+  uint32_t cuts = 0, changesSent = 0, worstDelayMs = 0, cueMs = 0;
+  bool cuePending = false;
+  uint32_t startMs = clock.millis();
+  for (uint32_t t = 0; t < LOAD_BUSY_MS + LOAD_QUIET_MS; t += LOAD_TICK_MS) {
+    if (t < LOAD_BUSY_MS && t % LOAD_CUT_MS == 0) {
+      control ^= 0x03;  // Program <-> preview
+      cuts++;
+      cueMs = clock.millis();
+      cuePending = true;
+    }
+    if (t % LOAD_RESEND_MS == 0) {
+      Bytes packet = tsl31Message(1, control, "CAM 1");
+      decoder.decodeTsl31(packet.data(), packet.size(), clock.micros());
+    }
+    renderer.update();
+
+    mailbox.peek(snap);
+    switch (feed.poll(renderer.displayChanges(), renderer.displayedState(), snap.text, clock.millis())) {
+      case TALLY_EVENT_CHANGE:
+        source.send(feed.data(), "tally", clock.millis());
+        changesSent++;
+        if (cuePending) {
+          uint32_t delay = clock.millis() - cueMs;
+          if (delay > worstDelayMs) worstDelayMs = delay;
+          cuePending = false;
+        }
+        break;
+      case TALLY_EVENT_KEEPALIVE: source.send("", "keepalive", clock.millis()); break;
+      case TALLY_EVENT_NONE: break;
+    }
+    clock.advanceMs(LOAD_TICK_MS);
+  }
+  uint32_t elapsedMs = clock.millis() - startMs;
+
+  EXPECT_EQ(subscribed, MAX_EVENT_CLIENTS);
+  EXPECT_EQ(refused, LOAD_BROWSERS - MAX_EVENT_CLIENTS);
+  // One event per cut; 50 Hz resends of the same tally send nothing
+  EXPECT_EQ(changesSent, cuts);
+  EXPECT_LE(worstDelayMs, (uint32_t)LOAD_TICK_MS);
+  for (const FakeEventSource::Client &c : source.clients) {
+    EXPECT_EQ(c.tallyEvents, cuts + 1);  // Plus the state on connect
+    EXPECT_EQ(c.last, std::string(current()));
+    EXPECT_GE(c.keepalives, LOAD_QUIET_MS / EVENT_KEEPALIVE_MS - 1);
+    EXPECT_LE(c.keepalives, LOAD_QUIET_MS / EVENT_KEEPALIVE_MS);
+  }
+
+  // Against every browser polling /status
+  const FakeEventSource::Client &c = source.clients[0];
+  uint32_t pollRequests = LOAD_BROWSERS * (elapsedMs / POLL_INTERVAL_MS);
+  uint32_t fallbackRequests = refused * (elapsedMs / POLL_INTERVAL_MS);
+  printf("  %d subscribers, %d polling; %u cuts in %u s\n", subscribed, refused, cuts, elapsedMs / 1000);
+  printf("  per subscriber: %u events, %u keepalives, %u bytes\n", c.tallyEvents, c.keepalives, c.bytes);
+  printf("  /status requests: %u all polling, %u with events (%u KB against %u KB)\n", pollRequests,
+         fallbackRequests, (fallbackRequests * STATUS_RESPONSE_BYTES + subscribed * c.bytes) / 1024,
+         pollRequests * STATUS_RESPONSE_BYTES / 1024);
+  EXPECT_LT(subscribed * c.bytes, subscribed * (elapsedMs / POLL_INTERVAL_MS) * STATUS_RESPONSE_BYTES);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,177 @@
+/*
+    TallyMailbox: seqlock handoff from the UDP task to the render task
+    Video Walrus 2025
+*/
+
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../tally_test.h"
+
+#define STRESS_PUBLISHES 2000000
+
+static TallySnapshot snapshot(uint8_t state, const char *text) {
+  TallySnapshot snap = {};
+  snap.state = state;
+  snap.brightness = 50;
+  strncpy(snap.text, text, sizeof(snap.text) - 1);
+  return snap;
+}
+
+TEST(TallyMailbox, NothingBeforeFirstPublish) {
+  TallyMailbox mailbox;
+  TallySnapshot out;
+  uint32_t seq = 0;
+  EXPECT_FALSE(mailbox.read(out, seq));
+  EXPECT_EQ(seq, 0u);
+}
+
+TEST(TallyMailbox, ReadReturnsEachPublishOnce) {
+  TallyMailbox mailbox;
+  TallySnapshot out;
+  uint32_t seq = 0;
+
+  mailbox.publish(snapshot(2, "CAM 1"));
+  ASSERT_TRUE(mailbox.read(out, seq));
+  EXPECT_EQ(out.state, 2);
+  EXPECT_STREQ(out.text, "CAM 1");
+  EXPECT_FALSE(mailbox.read(out, seq));
+
+  mailbox.publish(snapshot(1, "CAM 2"));
+  ASSERT_TRUE(mailbox.read(out, seq));
+  EXPECT_EQ(out.state, 1);
+  EXPECT_STREQ(out.text, "CAM 2");
+}
+
+TEST(TallyMailbox, ReaderSeesOnlyTheLatest) {
+  TallyMailbox mailbox;
+  TallySnapshot out;
+  uint32_t seq = 0;
+
+  mailbox.publish(snapshot(1, "A"));
+  mailbox.publish(snapshot(2, "B"));
+  mailbox.publish(snapshot(3, "C"));
+  ASSERT_TRUE(mailbox.read(out, seq));
+  EXPECT_EQ(out.state, 3);
+  EXPECT_STREQ(out.text, "C");
+  EXPECT_EQ(seq % 2, 0u);  // Never an in-progress sequence
+  EXPECT_FALSE(mailbox.read(out, seq));
+}
+
+TEST(TallyMailbox, ReadersKeepTheirOwnPlace) {
+  TallyMailbox mailbox;
+  TallySnapshot out;
+  uint32_t first = 0, second = 0;
+
+  mailbox.publish(snapshot(2, "X"));
+  EXPECT_TRUE(mailbox.read(out, first));
+  EXPECT_TRUE(mailbox.read(out, second));
+  EXPECT_FALSE(mailbox.read(out, first));
+}
+
+TEST(TallyMailbox, PeekDoesNotConsume) {
+  TallyMailbox mailbox;
+  TallySnapshot out;
+  uint32_t seq = 0;
+
+  mailbox.peek(out);
+  EXPECT_EQ(out.state, 0);  // Zeroed before the first publish
+
+  mailbox.publish(snapshot(2, "P"));
+  mailbox.peek(out);
+  EXPECT_EQ(out.state, 2);
+  mailbox.peek(out);
+  EXPECT_EQ(out.state, 2);
+  EXPECT_TRUE(mailbox.read(out, seq));
+}
+
+// Every field derived from n, so a snapshot mixing two publishes shows
+static TallySnapshot stressSnapshot(uint32_t n) {
+  TallySnapshot snap;
+  snap.state = n & 3;
+  snap.brightness = n >> 3;
+  snap.rules = n * 2654435761u;
+  snap.rxMicros = n;
+  snap.decodedMicros = ~n;
+  snprintf(snap.text, sizeof(snap.text), "%08x%08x", n, ~n);
+  return snap;
+}
+
+static bool consistent(const TallySnapshot &snap) {
+  uint32_t n = snap.rxMicros;
+  TallySnapshot expected = stressSnapshot(n);
+  return snap.state == expected.state && snap.brightness == expected.brightness && snap.rules == expected.rules &&
+         snap.decodedMicros == expected.decodedMicros && strcmp(snap.text, expected.text) == 0;
+}
+
+// The UDP task and the render task on two threads, as on the two cores
+TEST(TallyMailbox, StressTwoThreads) {
+  TallyMailbox mailbox;
+  std::atomic<bool> done{false};
+  uint32_t reads = 0, torn = 0, backwards = 0;
+
+  std::thread reader([&]() {
+    TallySnapshot out;
+    uint32_t seq = 0;
+    uint32_t last = 0;
+    bool first = true;
+    while (!done) {
+      if (!mailbox.read(out, seq)) continue;
+      reads++;
+      if (!consistent(out)) torn++;
+      if (!first && out.rxMicros <= last) backwards++;
+      last = out.rxMicros;
+      first = false;
+    }
+    if (mailbox.read(out, seq)) {
+      reads++;
+      last = out.rxMicros;
+    }
+    EXPECT_EQ(last, (uint32_t)STRESS_PUBLISHES) << "last publish never seen";
+  });
+
+  for (uint32_t n = 1; n <= STRESS_PUBLISHES; n++) {
+    mailbox.publish(stressSnapshot(n));
+    if (n % 4096 == 0) std::this_thread::yield();  // Interleave on a single-core host too
+  }
+  done = true;
+  reader.join();
+
+  printf("  %u publishes, %u reads\n", STRESS_PUBLISHES, reads);
+  EXPECT_GT(reads, 0u);
+  EXPECT_EQ(torn, 0u);
+  EXPECT_EQ(backwards, 0u);
+}
+
+// Peek from several readers while the writer runs
+TEST(TallyMailbox, StressPeekers) {
+  TallyMailbox mailbox;
+  mailbox.publish(stressSnapshot(1));
+  std::atomic<bool> done{false};
+  std::atomic<uint32_t> torn{0};
+
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 3; i++) {
+    readers.emplace_back([&]() {
+      TallySnapshot out;
+      while (!done) {
+        mailbox.peek(out);
+        if (!consistent(out)) torn++;
+      }
+    });
+  }
+  for (uint32_t n = 2; n <= STRESS_PUBLISHES / 4; n++) mailbox.publish(stressSnapshot(n));
+  done = true;
+  for (std::thread &t : readers) t.join();
+  EXPECT_EQ(torn.load(), 0u);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
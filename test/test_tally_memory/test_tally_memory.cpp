@@ -0,0 +1,183 @@
+/*
+    Tally memory: saved state checksum, the flash write schedule, and
+    restoring a saved state at boot
+    Video Walrus 2025
+*/
+
+#include <gtest/gtest.h>
+
+#include "../tally_test.h"
+
+class TallyMemoryTest : public ::testing::Test {
+ protected:
+  TallyMemoryTest() : decoder(mailbox, clock) { decoder.address = 3; }
+
+  // Decode a TSL 3.1 update and take the decoder's state as saved
+  SavedTally cue(int addr, uint8_t control, const char *label = "CAM 3") {
+    Bytes data = tsl31Message(addr, control, label);
+    decoder.decodeTsl31(data.data(), data.size(), clock.micros());
+    SavedTally saved;
+    decoder.saveState(saved, 1000);
+    return saved;
+  }
+
+  FakeClock clock;
+  TallyMailbox mailbox;
+  TslDecoder decoder;
+  TallySaveSchedule schedule;
+};
+
+TEST_F(TallyMemoryTest, SavedStateCarriesEveryAddress) {
+  cue(9, 0x31);
+  SavedTally saved = cue(3, 0x32);
+  EXPECT_TRUE(savedTallyValid(saved));
+  EXPECT_EQ(saved.address, 3);
+  EXPECT_EQ(saved.control[3], 0x32);
+  EXPECT_EQ(saved.control[9], 0x31);
+  EXPECT_STREQ(saved.label, "CAM 3");
+}
+
+TEST_F(TallyMemoryTest, CorruptionFailsTheChecksum) {
+  SavedTally saved = cue(3, 0x32);
+  saved.control[40] ^= 1;
+  EXPECT_FALSE(savedTallyValid(saved));
+
+  saved = cue(3, 0x32);
+  saved.magic = 0;
+  saved.checksum = savedTallyChecksum(saved);
+  EXPECT_FALSE(savedTallyValid(saved));
+}
+
+TEST_F(TallyMemoryTest, WritesOnceTheStateSettles) {
+  uint32_t now = 10000;
+  SavedTally saved = cue(3, 0x32);
+  EXPECT_FALSE(schedule.due(saved, now));
+  EXPECT_FALSE(schedule.due(saved, now + TALLY_SAVE_SETTLE_MS - 1));
+  EXPECT_TRUE(schedule.due(saved, now + TALLY_SAVE_SETTLE_MS));
+}
+
+TEST_F(TallyMemoryTest, BurstOfCuesIsOneWrite) {
+  uint32_t now = 10000;
+  for (int i = 0; i < 10; i++, now += 500) {
+    EXPECT_FALSE(schedule.due(cue(3, i & 1 ? 0x32 : 0x31), now));
+  }
+  SavedTally saved = cue(3, 0x32);
+  EXPECT_FALSE(schedule.due(saved, now));
+  EXPECT_TRUE(schedule.due(saved, now + TALLY_SAVE_SETTLE_MS));
+  schedule.written(saved, now + TALLY_SAVE_SETTLE_MS);
+  EXPECT_FALSE(schedule.due(saved, now + 60000));
+}
+
+TEST_F(TallyMemoryTest, AtMostOneWritePerInterval) {
+  uint32_t now = 10000;
+  SavedTally first = cue(3, 0x32);
+  schedule.due(first, now);
+  ASSERT_TRUE(schedule.due(first, now + TALLY_SAVE_SETTLE_MS));
+  now += TALLY_SAVE_SETTLE_MS;
+  schedule.written(first, now);
+
+  SavedTally second = cue(3, 0x31);
+  schedule.due(second, now + 100);
+  EXPECT_FALSE(schedule.due(second, now + 100 + TALLY_SAVE_SETTLE_MS));
+  EXPECT_FALSE(schedule.due(second, now + TALLY_SAVE_INTERVAL_MS - 1));
+  EXPECT_TRUE(schedule.due(second, now + TALLY_SAVE_INTERVAL_MS));
+}
+
+TEST_F(TallyMemoryTest, BackToTheWrittenStateNeedsNoWrite) {
+  uint32_t now = 10000;
+  SavedTally first = cue(3, 0x32);
+  schedule.due(first, now);
+  schedule.due(first, now + TALLY_SAVE_SETTLE_MS);
+  schedule.written(first, now + TALLY_SAVE_SETTLE_MS);
+
+  cue(3, 0x31);
+  clock.advanceMs(5000);
+  SavedTally back = cue(3, 0x32);  // Cut away and back
+  EXPECT_NE(back.checksum, 0u);
+  EXPECT_FALSE(schedule.due(back, now + 60000));
+  EXPECT_FALSE(schedule.due(back, now + 120000));
+}
+
+TEST_F(TallyMemoryTest, KnownStateIsNotWrittenAgain) {
+  SavedTally saved = cue(3, 0x32);
+  schedule.known(saved);  // Restored from flash at boot
+  EXPECT_FALSE(schedule.due(saved, 10000));
+  EXPECT_FALSE(schedule.due(saved, 20000));
+
+  SavedTally changed = cue(3, 0x31);
+  EXPECT_FALSE(schedule.due(changed, 20000));
+  EXPECT_TRUE(schedule.due(changed, 20000 + TALLY_SAVE_SETTLE_MS));  // No write yet: no interval
+}
+
+TEST_F(TallyMemoryTest, LabelChangeIsSaved) {
+  SavedTally saved = cue(3, 0x32, "CAM 3");
+  schedule.known(saved);
+  SavedTally renamed = cue(3, 0x32, "JIB");
+  schedule.due(renamed, 10000);
+  EXPECT_TRUE(schedule.due(renamed, 10000 + TALLY_SAVE_SETTLE_MS));
+}
+
+// Restored at boot: a fresh decoder puts the saved state back and holds it
+class TallyRestoreTest : public TallyMemoryTest {
+ protected:
+  void SetUp() override {
+    cue(9, 0x31, "CAM 9");
+    saved = cue(3, 0x32, "CAM 3");
+    restored.address = 3;
+    restored.restoreState(saved, HOLD_MS);
+  }
+
+  static const uint32_t HOLD_MS = 60000;
+  SavedTally saved;
+  TallyMailbox restoredMailbox;
+  TslDecoder restored{restoredMailbox, clock};
+};
+
+TEST_F(TallyRestoreTest, RestorePublishesTheSavedTally) {
+  TallySnapshot snap;
+  restoredMailbox.peek(snap);
+  EXPECT_EQ(snap.state, 2);
+  EXPECT_STREQ(snap.text, "CAM 3");
+  EXPECT_TRUE(restored.holdingRestored());
+  EXPECT_EQ(restored.display(9).control, 0x31);
+  EXPECT_STREQ(restored.display(9).label, "");  // Only our own label is saved
+}
+
+TEST_F(TallyRestoreTest, ExpiresWithoutTsl) {
+  clock.advanceMs(HOLD_MS - 1);
+  EXPECT_FALSE(restored.expire());
+  clock.advanceMs(1);
+  EXPECT_TRUE(restored.expire());
+  EXPECT_FALSE(restored.holdingRestored());
+  TallySnapshot snap;
+  restoredMailbox.peek(snap);
+  EXPECT_EQ(snap.state, 0);
+  EXPECT_STREQ(snap.text, "");
+  EXPECT_EQ(restored.display(9).control, 0);
+  EXPECT_FALSE(restored.expire());  // Once
+}
+
+TEST_F(TallyRestoreTest, HeardDatagramKeepsTheRestoredState) {
+  clock.advanceMs(5000);
+  Bytes data = tsl31Message(9, 0x31, "CAM 9");  // Another address: still the switcher
+  EXPECT_FALSE(restored.decodeTsl31(data.data(), data.size(), clock.micros()));
+  EXPECT_FALSE(restored.holdingRestored());
+  clock.advanceMs(HOLD_MS);
+  EXPECT_FALSE(restored.expire());
+  TallySnapshot snap;
+  restoredMailbox.peek(snap);
+  EXPECT_EQ(snap.state, 2);
+}
+
+TEST_F(TallyRestoreTest, SavedForAnotherAddressKeepsNoLabel) {
+  TslDecoder other(restoredMailbox, clock);
+  other.address = 9;
+  other.restoreState(saved, HOLD_MS);
+  EXPECT_EQ(other.display(9).control, 0x31);
+  EXPECT_STREQ(other.display(9).label, "");
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,61 @@
+/*
+    TallyMetrics: Prometheus text and the /metrics buffer size
+    Video Walrus 2025
+*/
+
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+
+#include "tally_metrics.h"
+
+TEST(TallyMetrics, FormatsCountersAndHistograms) {
+  TallyMetrics metrics;
+  TallyMetrics::increment(metrics.packetsReceived);
+  TallyMetrics::increment(metrics.packetsReceived);
+  metrics.receiveToDecode.record(80);
+  metrics.receiveToDecode.record(200000);
+  static char buf[TALLY_METRICS_MAX_LENGTH];
+  size_t length = metrics.format(buf, sizeof(buf));
+  EXPECT_EQ(length, strlen(buf));
+  std::string text(buf);
+  EXPECT_NE(text.find("\ntally_packets_received_total 2\n"), std::string::npos);
+  EXPECT_NE(text.find("tally_receive_to_decode_seconds_bucket{le=\"0.00005\"} 0\n"), std::string::npos);
+  EXPECT_NE(text.find("tally_receive_to_decode_seconds_bucket{le=\"0.0001\"} 1\n"), std::string::npos);
+  EXPECT_NE(text.find("tally_receive_to_decode_seconds_bucket{le=\"+Inf\"} 2\n"), std::string::npos);
+  EXPECT_NE(text.find("tally_receive_to_decode_seconds_sum 0.200080\n"), std::string::npos);
+}
+
+// Every counter, bucket and sum at its largest value still fits the
+// buffer /metrics formats into
+TEST(TallyMetrics, LargestValuesFitTheBuffer) {
+  static TallyMetrics metrics;
+  memset((void *)&metrics, 0xFF, sizeof(metrics));
+  static char buf[TALLY_METRICS_MAX_LENGTH];
+  size_t length = metrics.format(buf, sizeof(buf));
+  printf("  /metrics at its largest: %zu of %d bytes\n", length, TALLY_METRICS_MAX_LENGTH);
+  EXPECT_LT(length, sizeof(buf));
+  EXPECT_EQ(length, strlen(buf));
+  EXPECT_NE(strstr(buf, "tally_fleet_ack_seconds_count 4294967295\n"), nullptr);  // The last line
+}
+
+TEST(TallyMetrics, SmallBufferReportsTheLengthNeeded) {
+  TallyMetrics metrics;
+  static char full[TALLY_METRICS_MAX_LENGTH];
+  size_t needed = metrics.format(full, sizeof(full));
+
+  char small[100];
+  memset(small, 'x', sizeof(small));
+  EXPECT_EQ(metrics.format(small, sizeof(small)), needed);
+  EXPECT_EQ(strlen(small), sizeof(small) - 1);  // Terminated, cut short
+  EXPECT_EQ(strncmp(small, full, sizeof(small) - 1), 0);
+  EXPECT_EQ(metrics.format(small, 0), needed);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
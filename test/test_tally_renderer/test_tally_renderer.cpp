@@ -0,0 +1,266 @@
+/*
+    TallyRenderer: headless, against a recording LED sink and a clock the
+    test moves by hand
+    Video Walrus 2025
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <deque>
+
+#include "../tally_test.h"
+#include "disco_show.h"
+
+#define PIXELS 7
+
+static RenderCommand renderCommand(RenderCommandType type, uint32_t arg = 0, uint32_t seed = 0,
+                                   uint32_t epochUs = 0) {
+  RenderCommand cmd = { type, arg, seed, epochUs };
+  return cmd;
+}
+
+static TallySnapshot snapshot(uint8_t state, uint8_t brightness, uint32_t rxMicros) {
+  TallySnapshot snap = {};
+  snap.state = state;
+  snap.brightness = brightness;
+  snap.rxMicros = rxMicros;
+  snap.decodedMicros = rxMicros;
+  return snap;
+}
+
+// One tally: its own clock, LEDs, mailbox and render stage
+struct Tally {
+  explicit Tally(uint32_t bootUs) : sink(PIXELS), renderer(sink, clock, mailbox) { clock.now = bootUs; }
+
+  void publish(uint8_t state, uint8_t brightness) { mailbox.publish(snapshot(state, brightness, clock.now)); }
+
+  FakeClock clock;
+  RecordingLedSink sink;
+  TallyMailbox mailbox;
+  TallyRenderer renderer;
+};
+
+// Moves both tallies' clocks together, rendering every millisecond
+static void run(Tally &a, Tally &b, uint32_t ms) {
+  for (uint32_t i = 0; i < ms; i++) {
+    a.clock.advanceMs(1);
+    b.clock.advanceMs(1);
+    a.renderer.update();
+    b.renderer.update();
+  }
+}
+
+TEST(TallyRenderer, TslUpdateLightsTheLeds) {
+  Tally t(1000000);
+  t.renderer.update();
+  t.publish(2, 50);
+  t.renderer.update();
+  EXPECT_EQ(t.renderer.displayedState(), 2);
+  ASSERT_EQ(t.sink.pixels.size(), (size_t)PIXELS);
+  EXPECT_GT(t.sink.pixels[0].r, 0);
+  EXPECT_EQ(t.sink.pixels[0].g, 0);
+}
+
+// The leader starts a show on its own clock and beacons it every second;
+// the follower, booted at another time, hears the start 3 ms late and the
+// beacons 1-5 ms late. Mid-frame, both show the same colour throughout.
+TEST(TallyRenderer, DiscoFollowerShowsTheLeadersFrames) {
+  Tally leader(1000000), follower(77777777);
+  const uint32_t seed = 0x5EED, durationMs = 6000;
+  const uint32_t skewUs = follower.clock.now - leader.clock.now;
+  ShowSync sync;
+
+  run(leader, follower, 20);
+  uint32_t epochUs = leader.clock.now;
+  leader.renderer.handleCommand(renderCommand(RENDER_DISCO, durationMs, seed, epochUs));
+
+  struct Beacon {
+    uint32_t deliverMs;
+    uint32_t elapsedUs;
+  };
+  std::deque<Beacon> inFlight = { { 3, 0 } };  // The start command
+  const uint32_t delaysMs[] = { 4, 1, 2, 5, 3 };
+  for (uint32_t i = 1; i <= 5; i++) inFlight.push_back({ i * DISCO_BEACON_MS + delaysMs[i - 1], i * DISCO_BEACON_MS * 1000 });
+
+  std::vector<Rgb> seen;
+  for (uint32_t ms = 0; ms < durationMs; ms++) {
+    while (!inFlight.empty() && inFlight.front().deliverMs == ms) {
+      if (sync.sample(seed, inFlight.front().elapsedUs, durationMs, follower.clock.now)) {
+        follower.renderer.handleCommand(renderCommand(RENDER_DISCO, durationMs, seed, sync.epochUs()));
+      }
+      inFlight.pop_front();
+    }
+    if (ms % (DISCO_FRAME_US / 1000) == DISCO_FRAME_US / 2000) {
+      ASSERT_EQ(leader.sink.pixels, follower.sink.pixels) << "at " << ms << " ms";
+      EXPECT_EQ(leader.sink.pixels[0], discoFrameColor(seed, ms * 1000 / DISCO_FRAME_US));
+      seen.push_back(leader.sink.pixels[0]);
+    }
+    run(leader, follower, 1);
+  }
+  // The best beacon (1 ms late) sets the follower's epoch
+  EXPECT_EQ(sync.epochUs() - skewUs, epochUs + 1000);
+  // A light show, not one colour
+  std::sort(seen.begin(), seen.end(), [](const Rgb &x, const Rgb &y) {
+    return (x.r << 16 | x.g << 8 | x.b) < (y.r << 16 | y.g << 8 | y.b);
+  });
+  EXPECT_GT(std::unique(seen.begin(), seen.end()) - seen.begin(), 4);
+}
+
+TEST(TallyRenderer, DiscoEndRedrawsAtTheTslBrightness) {
+  Tally t(1000000);
+  t.publish(2, 12);
+  t.renderer.update();
+  std::vector<Rgb> before = t.sink.pixels;
+  ASSERT_GT(before[0].r, 0);
+
+  t.renderer.handleCommand(renderCommand(RENDER_DISCO, 1000, 7, t.clock.now));
+  for (int i = 0; i < 100; i++) {
+    t.clock.advanceMs(5);
+    t.renderer.update();
+  }
+  EXPECT_NE(t.sink.pixels, before);
+  t.publish(2, 12);  // A resend during the show is not drawn
+  for (int i = 0; i < 200; i++) {
+    t.clock.advanceMs(5);
+    t.renderer.update();
+  }
+  EXPECT_FALSE(t.renderer.animating());
+  EXPECT_EQ(t.sink.pixels, before);  // Not maxBrightness
+}
+
+TEST(TallyRenderer, DiscoStopRedrawsAndStaysStopped) {
+  Tally t(1000000);
+  t.publish(1, 30);
+  t.renderer.update();
+  std::vector<Rgb> before = t.sink.pixels;
+
+  uint32_t epochUs = t.clock.now;
+  t.renderer.handleCommand(renderCommand(RENDER_DISCO, 10000, 9, epochUs));
+  t.clock.advanceMs(300);
+  t.renderer.update();
+  EXPECT_NE(t.sink.pixels, before);
+
+  t.renderer.handleCommand(renderCommand(RENDER_DISCO_STOP));
+  t.clock.advanceMs(20);
+  t.renderer.update();
+  EXPECT_EQ(t.sink.pixels, before);
+
+  // A late beacon for the stopped show does not restart it
+  t.renderer.handleCommand(renderCommand(RENDER_DISCO, 10000, 9, epochUs + 500));
+  t.clock.advanceMs(300);
+  t.renderer.update();
+  EXPECT_EQ(t.sink.pixels, before);
+}
+
+TEST(TallyRenderer, ClearAfterSolidRestoresTheTally) {
+  Tally t(1000000);
+  t.publish(2, 40);
+  t.renderer.update();
+  std::vector<Rgb> tally = t.sink.pixels;
+  uint32_t changes = t.renderer.displayChanges();
+
+  t.clock.advanceMs(20);
+  t.renderer.handleCommand(renderCommand(RENDER_SOLID, 0x0000FF));
+  EXPECT_NE(t.sink.pixels, tally);
+  EXPECT_GT(t.sink.pixels[0].b, 0);
+
+  t.clock.advanceMs(20);
+  t.renderer.handleCommand(renderCommand(RENDER_CLEAR));
+  EXPECT_EQ(t.sink.pixels, tally);
+  EXPECT_EQ(t.renderer.displayedState(), 2);
+  EXPECT_EQ(t.renderer.displayChanges(), changes);  // Not a tally change
+  EXPECT_FALSE(t.renderer.animating());
+}
+
+TEST(TallyRenderer, ClearInsideTheRateCapIsSentWhenItEnds) {
+  Tally t(1000000);
+  t.publish(1, 40);
+  t.renderer.update();
+  std::vector<Rgb> tally = t.sink.pixels;
+
+  t.clock.advanceMs(20);
+  t.renderer.handleCommand(renderCommand(RENDER_SOLID, 0xFFFFFF));
+  t.clock.advanceUs(RENDER_MIN_SHOW_INTERVAL_US / 2);
+  t.renderer.handleCommand(renderCommand(RENDER_CLEAR));
+  EXPECT_NE(t.sink.pixels, tally);  // Held back
+  EXPECT_TRUE(t.renderer.animating());
+  t.clock.advanceUs(t.renderer.frameDueInUs());
+  t.renderer.update();
+  EXPECT_EQ(t.sink.pixels, tally);
+}
+
+TEST(TallyRenderer, ClearWithNothingOnTopShowsNothing) {
+  Tally t(1000000);
+  t.publish(2, 40);
+  t.renderer.update();
+  uint32_t shows = t.sink.shows;
+  t.clock.advanceMs(20);
+  t.renderer.handleCommand(renderCommand(RENDER_CLEAR));
+  t.renderer.update();
+  EXPECT_EQ(t.sink.shows, shows);
+}
+
+// Pulses over the tally between updates; true if any frame differed
+static bool pulses(Tally &t, const std::vector<Rgb> &tally) {
+  bool differed = false;
+  for (int i = 0; i < RENDER_LOST_SIGNAL_PERIOD_MS / 20; i++) {
+    t.clock.advanceMs(20);
+    t.renderer.update();
+    if (t.sink.pixels != tally) differed = true;
+  }
+  return differed;
+}
+
+TEST(TallyRenderer, LostSignalPulsesUntilTslIsBack) {
+  Tally t(1000000);
+  t.publish(2, 40);
+  t.renderer.update();
+  std::vector<Rgb> tally = t.sink.pixels;
+
+  t.renderer.handleCommand(renderCommand(RENDER_SIGNAL_LOST, 0xFF8000));
+  EXPECT_TRUE(pulses(t, tally));
+  EXPECT_TRUE(t.renderer.animating());
+  EXPECT_EQ(t.renderer.displayedState(), 2);
+
+  t.renderer.handleCommand(renderCommand(RENDER_SIGNAL_OK));
+  t.clock.advanceMs(20);
+  t.renderer.update();
+  EXPECT_EQ(t.sink.pixels, tally);
+  EXPECT_FALSE(pulses(t, tally));
+}
+
+TEST(TallyRenderer, OtherOverlaysTakeOverFromLostSignal) {
+  Tally t(1000000);
+  t.publish(1, 40);
+  t.renderer.update();
+  std::vector<Rgb> tally = t.sink.pixels;
+  t.renderer.handleCommand(renderCommand(RENDER_SIGNAL_LOST, 0xFF8000));
+  t.clock.advanceMs(20);
+  t.renderer.update();
+
+  // A solid colour replaces the pulse and holds still
+  t.clock.advanceMs(20);
+  t.renderer.handleCommand(renderCommand(RENDER_SOLID, 0x0000FF));
+  std::vector<Rgb> solid = t.sink.pixels;
+  for (int i = 0; i < 50; i++) {
+    t.clock.advanceMs(20);
+    t.renderer.update();
+    ASSERT_EQ(t.sink.pixels, solid);
+  }
+
+  // Cleared while the signal is still lost: the pulse comes back
+  t.renderer.handleCommand(renderCommand(RENDER_CLEAR));
+  EXPECT_TRUE(pulses(t, tally));
+
+  // A disco show, then its end, does the same
+  t.renderer.handleCommand(renderCommand(RENDER_DISCO, 500, 3, t.clock.now));
+  t.clock.advanceMs(600);
+  t.renderer.update();
+  EXPECT_TRUE(pulses(t, tally));
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,145 @@
+/*
+    TallyRules: parsing, lit rules and per-role colours
+    Video Walrus 2025
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "../tally_test.h"
+
+TEST(TallyRules, ParsesEntries) {
+  TallyRules rules;
+  ASSERT_TRUE(rules.parse("4:1:R:T, 5:2:00FF80:PV:10,126:4:Y:V"));
+  EXPECT_EQ(rules.count(), 3u);
+  EXPECT_TRUE(rules.enabled());
+  EXPECT_NE(rules.addressRules(4), 0u);
+  EXPECT_NE(rules.addressRules(5), 0u);
+  EXPECT_NE(rules.addressRules(126), 0u);
+  EXPECT_EQ(rules.addressRules(6), 0u);
+}
+
+TEST(TallyRules, EmptySpecClears) {
+  TallyRules rules;
+  ASSERT_TRUE(rules.parse("4:1:R:T"));
+  ASSERT_TRUE(rules.parse(""));
+  EXPECT_EQ(rules.count(), 0u);
+  EXPECT_FALSE(rules.enabled());
+  EXPECT_EQ(rules.addressRules(4), 0u);
+}
+
+TEST(TallyRules, MalformedSpecLeavesTableUnchanged) {
+  TallyRules rules;
+  ASSERT_TRUE(rules.parse("4:1:R:T"));
+
+  const char *bad[] = {
+    "127:1:R:T",     // Address
+    "4:0:R:T",       // Tally bit
+    "4:5:R:T",
+    "4:1:X:T",       // Colour
+    "4:1:12345:T",
+    "4:1:R:",        // Roles
+    "4:1:R:Q",
+    "4:1:R:T:256",   // Priority
+    "4:1:R:T:",
+    "4:1:R:T;5:1:R:T",
+    "4",
+  };
+  for (const char *spec : bad) {
+    EXPECT_FALSE(rules.parse(spec)) << spec;
+    EXPECT_EQ(rules.count(), 1u) << spec;
+    EXPECT_NE(rules.addressRules(4), 0u) << spec;
+  }
+}
+
+TEST(TallyRules, AtMost32Rules) {
+  std::string spec;
+  for (int i = 0; i < MAX_TALLY_RULES; i++) spec += std::to_string(i) + ":1:R:T,";
+  TallyRules rules;
+  EXPECT_TRUE(rules.parse(spec.c_str()));
+  EXPECT_EQ(rules.count(), (size_t)MAX_TALLY_RULES);
+  spec += "100:1:R:T";
+  EXPECT_FALSE(rules.parse(spec.c_str()));
+  EXPECT_EQ(rules.count(), (size_t)MAX_TALLY_RULES);
+}
+
+TEST(TallyRules, LitFollowsTallyBits) {
+  TallyRules rules;
+  ASSERT_TRUE(rules.parse("4:1:R:T,4:2:G:T,4:4:Y:V"));
+  uint32_t all = rules.addressRules(4);
+
+  EXPECT_EQ(rules.lit(4, 0x00), 0u);
+  EXPECT_EQ(rules.lit(4, 0x0F), all);
+  EXPECT_EQ(__builtin_popcount(rules.lit(4, 0x01)), 1);
+  EXPECT_EQ(__builtin_popcount(rules.lit(4, 0x03)), 2);
+  EXPECT_EQ(rules.lit(4, 0x30), 0u);  // Brightness bits light nothing
+  EXPECT_EQ(rules.lit(5, 0x0F), 0u);
+}
+
+TEST(TallyRules, ColoursPerRole) {
+  TallyRules rules;
+  ASSERT_TRUE(rules.parse("4:1:R:T,4:2:0000FF:PV"));
+  Rgb colors[NUM_PIXEL_ROLES];
+
+  rules.roleColors(rules.lit(4, 0x01), colors);
+  EXPECT_EQ(colors[ROLE_TALLY], (Rgb{ 255, 0, 0 }));
+  EXPECT_EQ(colors[ROLE_PROGRAM], (Rgb{ 0, 0, 0 }));
+
+  rules.roleColors(rules.lit(4, 0x02), colors);
+  EXPECT_EQ(colors[ROLE_TALLY], (Rgb{ 0, 0, 0 }));
+  EXPECT_EQ(colors[ROLE_PROGRAM], (Rgb{ 0, 0, 255 }));
+  EXPECT_EQ(colors[ROLE_PREVIEW], (Rgb{ 0, 0, 255 }));
+  EXPECT_EQ(colors[ROLE_OFF], (Rgb{ 0, 0, 0 }));
+}
+
+TEST(TallyRules, HighestPriorityWins) {
+  TallyRules rules;
+  // The priority 5 rule wins however the table is ordered
+  ASSERT_TRUE(rules.parse("7:1:R:T:5,8:1:G:T"));
+  Rgb colors[NUM_PIXEL_ROLES];
+  rules.roleColors(rules.lit(7, 0x01) | rules.lit(8, 0x01), colors);
+  EXPECT_EQ(colors[ROLE_TALLY], (Rgb{ 255, 0, 0 }));
+
+  ASSERT_TRUE(rules.parse("8:1:G:T,7:1:R:T:5"));
+  rules.roleColors(rules.lit(7, 0x01) | rules.lit(8, 0x01), colors);
+  EXPECT_EQ(colors[ROLE_TALLY], (Rgb{ 255, 0, 0 }));
+}
+
+TEST(TallyRules, EqualPriorityGoesToTheLaterRule) {
+  TallyRules rules;
+  ASSERT_TRUE(rules.parse("7:1:R:T,8:1:G:T"));
+  Rgb colors[NUM_PIXEL_ROLES];
+  rules.roleColors(rules.lit(7, 0x01) | rules.lit(8, 0x01), colors);
+  EXPECT_EQ(colors[ROLE_TALLY], (Rgb{ 0, 128, 0 }));
+}
+
+TEST(TallyRules, DecoderPublishesWatchedAddresses) {
+  FakeClock clock;
+  TallyMailbox mailbox;
+  TslDecoder decoder(mailbox, clock);
+  TallyRules rules;
+  ASSERT_TRUE(rules.parse("9:1:R:T"));
+  decoder.address = 3;
+  decoder.rules = &rules;
+
+  Bytes data = tsl31Message(9, 0x31, "ISO");
+  EXPECT_TRUE(decoder.decodeTsl31(data.data(), data.size(), 0));  // Not our address, but watched
+  TallySnapshot snap;
+  uint32_t seq = 0;
+  ASSERT_TRUE(mailbox.read(snap, seq));
+  EXPECT_EQ(snap.rules, rules.addressRules(9));
+
+  data = tsl31Message(9, 0x30, "ISO");
+  decoder.decodeTsl31(data.data(), data.size(), 0);
+  ASSERT_TRUE(mailbox.read(snap, seq));
+  EXPECT_EQ(snap.rules, 0u);
+
+  data = tsl31Message(10, 0x31, "");
+  EXPECT_FALSE(decoder.decodeTsl31(data.data(), data.size(), 0));
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
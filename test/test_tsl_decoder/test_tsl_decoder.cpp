@@ -0,0 +1,286 @@
+/*
+    TslDecoder: TSL 3.1 and 5.0 datagrams, DLE bytes in the data, truncated input
+    Video Walrus 2025
+*/
+
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+
+#include "../tally_test.h"
+
+class TslDecoderTest : public ::testing::Test {
+ protected:
+  TslDecoderTest() : decoder(mailbox, clock) {
+    decoder.address = 3;
+    decoder.maxBrightness = 60;
+    decoder.metrics = &metrics;
+  }
+
+  // The snapshot published since the last call, if any
+  bool published(TallySnapshot &snap) { return mailbox.read(snap, seq); }
+
+  bool decode5(Bytes data) { return decoder.decodeTsl5(data.data(), data.size(), clock.micros()); }
+  bool decode31(const Bytes &data) { return decoder.decodeTsl31(data.data(), data.size(), clock.micros()); }
+
+  FakeClock clock;
+  TallyMailbox mailbox;
+  TallyMetrics metrics;
+  TslDecoder decoder;
+  uint32_t seq = 0;
+};
+
+// ---------------------------------------------------------------------------
+// TSL 3.1
+// ---------------------------------------------------------------------------
+
+TEST_F(TslDecoderTest, Tsl31OurAddressPublishes) {
+  EXPECT_TRUE(decode31(tsl31Message(3, 0x32, "CAM 3")));  // Brightness 3, tally 2
+
+  TallySnapshot snap;
+  ASSERT_TRUE(published(snap));
+  EXPECT_EQ(snap.state, 2);
+  EXPECT_EQ(snap.brightness, 60);
+  EXPECT_STREQ(snap.text, "CAM 3");
+  EXPECT_EQ(snap.rxMicros, clock.micros());
+  EXPECT_EQ(metrics.packetsForUs.load(), 1u);
+  EXPECT_EQ(metrics.packetsMalformed.load(), 0u);
+}
+
+TEST_F(TslDecoderTest, Tsl31BrightnessScalesToMax) {
+  decode31(tsl31Message(3, 0x11, ""));
+  TallySnapshot snap;
+  ASSERT_TRUE(published(snap));
+  EXPECT_EQ(snap.state, 1);
+  EXPECT_EQ(snap.brightness, 20);
+}
+
+TEST_F(TslDecoderTest, Tsl31OtherAddressIsKeptNotPublished) {
+  EXPECT_FALSE(decode31(tsl31Message(5, 0xF1, "CAM 5")));  // Reserved bits 6-7 dropped
+
+  TallySnapshot snap;
+  EXPECT_FALSE(published(snap));
+  EXPECT_EQ(decoder.display(5).control, 0x31);
+  EXPECT_STREQ(decoder.display(5).label, "CAM 5");
+  EXPECT_EQ(metrics.packetsForUs.load(), 0u);
+}
+
+TEST_F(TslDecoderTest, Tsl31SeveralMessagesInOneDatagram) {
+  Bytes data = tsl31Message(1, 0x31, "ONE");
+  append(data, tsl31Message(3, 0x33, "THREE"));
+  append(data, tsl31Message(126, 0x32, "LAST"));
+
+  EXPECT_TRUE(decode31(data));
+  EXPECT_EQ(decoder.display(1).control, 0x31);
+  EXPECT_EQ(decoder.display(3).control, 0x33);
+  EXPECT_STREQ(decoder.display(126).label, "LAST");
+  TallySnapshot snap;
+  ASSERT_TRUE(published(snap));
+  EXPECT_EQ(snap.state, 3);
+  EXPECT_EQ(metrics.packetsMalformed.load(), 0u);
+}
+
+TEST_F(TslDecoderTest, Tsl31FullRefreshFillsTheTable) {
+  Bytes data;
+  for (int addr = 1; addr <= TSL_MAX_ADDRESS; addr++) {
+    char label[20];  // Room for any int, as far as the compiler knows
+    snprintf(label, sizeof(label), "CAMERA %03d", addr);
+    append(data, tsl31Message(addr, 0x30 | (addr & 3), label));
+  }
+  EXPECT_TRUE(decode31(data));
+
+  for (int addr = 1; addr <= TSL_MAX_ADDRESS; addr++) {
+    char label[20];  // Room for any int, as far as the compiler knows
+    snprintf(label, sizeof(label), "CAMERA %03d", addr);
+    EXPECT_EQ(decoder.display(addr).control, 0x30 | (addr & 3)) << "address " << addr;
+    EXPECT_STREQ(decoder.display(addr).label, label);
+  }
+  EXPECT_EQ(metrics.packetsForUs.load(), 1u);
+  EXPECT_EQ(metrics.packetsMalformed.load(), 0u);
+}
+
+TEST_F(TslDecoderTest, Tsl31LabelKeepsPrintableAsciiOnly) {
+  decode31(tsl31Message(3, 0x30, "A\x01" "B\x7F" "C   "));
+  EXPECT_STREQ(decoder.display(3).label, "ABC");
+}
+
+TEST_F(TslDecoderTest, Tsl31ShortFinalMessageIsAccepted) {
+  Bytes data = tsl31Message(3, 0x32, "CAMERA THREE");
+  data.resize(8);  // Header, control and 6 label bytes
+  EXPECT_TRUE(decode31(data));
+  EXPECT_STREQ(decoder.display(3).label, "CAMERA");
+  EXPECT_EQ(metrics.packetsMalformed.load(), 0u);
+}
+
+TEST_F(TslDecoderTest, Tsl31LoneTrailingHeaderIsMalformed) {
+  Bytes data = tsl31Message(3, 0x32, "CAM 3");
+  data.push_back(0x84);
+  EXPECT_TRUE(decode31(data));  // The whole message still counts
+  EXPECT_EQ(metrics.packetsMalformed.load(), 1u);
+
+  EXPECT_FALSE(decode31(Bytes{ 0x83 }));
+  EXPECT_EQ(metrics.packetsMalformed.load(), 2u);
+}
+
+TEST_F(TslDecoderTest, Tsl31BadHeaderIsSkipped) {
+  Bytes data = tsl31Message(3, 0x32, "CAM 3");
+  data[0] = 0x7F;                    // Bit 7 clear
+  append(data, tsl31Message(0, 0x31, "ZERO"));
+  Bytes beyond = tsl31Message(0, 0x31, "");
+  beyond[0] = 0x80 + 127;            // Past TSL_MAX_ADDRESS
+  append(data, beyond);
+
+  EXPECT_FALSE(decode31(data));
+  EXPECT_EQ(decoder.display(3).control, 0);
+  EXPECT_EQ(decoder.display(0).control, 0x31);
+  EXPECT_EQ(metrics.packetsMalformed.load(), 1u);
+}
+
+TEST_F(TslDecoderTest, Tsl31HeardResetsSilence) {
+  clock.advanceMs(5000);
+  EXPECT_EQ(decoder.silentMs(), 6000u);  // Since the decoder started (clock 0)
+  decode31(tsl31Message(9, 0x00, ""));
+  EXPECT_EQ(decoder.silentMs(), 0u);
+
+  clock.advanceMs(100);
+  decode31(Bytes{ 0x10, 0x00 });  // Malformed only: not the switcher
+  EXPECT_EQ(decoder.silentMs(), 100u);
+}
+
+// ---------------------------------------------------------------------------
+// TSL 5.0
+// ---------------------------------------------------------------------------
+
+TEST_F(TslDecoderTest, Tsl5LampsMapToTally) {
+  // RH red: program
+  EXPECT_TRUE(decode5(tsl5Packet({ { 3, tsl5Control(1, 0, 0, 3), "CAM 3" } })));
+  EXPECT_EQ(decoder.display(3).control, 0x32);
+  EXPECT_STREQ(decoder.display(3).label, "CAM 3");
+
+  // Text green: preview
+  decode5(tsl5Packet({ { 3, tsl5Control(0, 2, 0, 3), "" } }));
+  EXPECT_EQ(decoder.display(3).control, 0x31);
+
+  // LH red and RH green: both
+  decode5(tsl5Packet({ { 3, tsl5Control(2, 0, 1, 1), "" } }));
+  EXPECT_EQ(decoder.display(3).control, 0x13);
+
+  // Amber: both
+  decode5(tsl5Packet({ { 3, tsl5Control(0, 3, 0, 2), "" } }));
+  EXPECT_EQ(decoder.display(3).control, 0x23);
+
+  TallySnapshot snap;
+  ASSERT_TRUE(published(snap));
+  EXPECT_EQ(snap.state, 3);
+  EXPECT_EQ(snap.brightness, 40);
+}
+
+TEST_F(TslDecoderTest, Tsl5SeveralDmsgsAndPackets) {
+  Bytes data = tsl5Packet({ { 1, tsl5Control(1, 0, 0, 3), "ONE" }, { 2, tsl5Control(2, 0, 0, 3), "TWO" } });
+  append(data, tsl5Packet({ { 3, tsl5Control(0, 0, 0, 3), "THREE" } }));
+
+  EXPECT_TRUE(decode5(data));
+  EXPECT_EQ(decoder.display(1).control, 0x32);
+  EXPECT_EQ(decoder.display(2).control, 0x31);
+  EXPECT_EQ(decoder.display(3).control, 0x30);
+  EXPECT_STREQ(decoder.display(2).label, "TWO");
+  EXPECT_EQ(metrics.packetsMalformed.load(), 0u);
+}
+
+TEST_F(TslDecoderTest, Tsl5BroadcastSetsEveryAddress) {
+  EXPECT_TRUE(decode5(tsl5Packet({ { TSL5_BROADCAST, tsl5Control(1, 0, 0, 3), "ALL" } })));
+  for (int addr = 0; addr <= TSL_MAX_ADDRESS; addr++) {
+    EXPECT_EQ(decoder.display(addr).control, 0x32) << "address " << addr;
+  }
+}
+
+TEST_F(TslDecoderTest, Tsl5IndexBeyondRangeIsIgnored) {
+  EXPECT_FALSE(decode5(tsl5Packet({ { 200, tsl5Control(1, 0, 0, 3), "FAR" } })));
+  EXPECT_EQ(metrics.packetsMalformed.load(), 0u);
+}
+
+TEST_F(TslDecoderTest, Tsl5ControlDataAndScreenControlAreSkipped) {
+  EXPECT_FALSE(decode5(tsl5Packet({ { 3, (uint16_t)(TSL5_CONTROL_DATA | tsl5Control(1, 0, 0, 3)), "" } })));
+  EXPECT_EQ(decoder.display(3).control, 0);
+
+  EXPECT_FALSE(decode5(tsl5Packet({ { 3, tsl5Control(1, 0, 0, 3), "" } }, TSL5_FLAG_SCONTROL)));
+  EXPECT_EQ(decoder.display(3).control, 0);
+  EXPECT_EQ(metrics.packetsMalformed.load(), 0u);
+  EXPECT_EQ(decoder.silentMs(), 0u);  // Still the switcher talking
+}
+
+TEST_F(TslDecoderTest, Tsl5Utf16Text) {
+  decode5(tsl5Packet({ { 3, tsl5Control(1, 0, 0, 3), "Cam \xE9" } }, TSL5_FLAG_UNICODE));
+  EXPECT_STREQ(decoder.display(3).label, "Cam ?");
+}
+
+TEST_F(TslDecoderTest, Tsl5PbcStartingLikeDleStxIsPlainData) {
+  // PBC 0x02FE puts FE 02 at the start of the datagram, the same bytes
+  // as TCP's DLE/STX; a UDP packet is never framed, so it is taken as is
+  std::string text(0x02FE - 4 - 6, 'x');
+  text.replace(0, 5, "CAM 3");
+  Bytes data = tsl5Packet({ { 3, tsl5Control(1, 0, 0, 3), text } });
+  ASSERT_EQ(data[0], TSL5_DLE);
+  ASSERT_EQ(data[1], TSL5_STX);
+
+  EXPECT_TRUE(decode5(data));
+  EXPECT_EQ(decoder.display(3).control, 0x32);
+  EXPECT_EQ(strncmp(decoder.display(3).label, "CAM 3", 5), 0);
+  EXPECT_EQ(metrics.packetsMalformed.load(), 0u);
+}
+
+TEST_F(TslDecoderTest, Tsl5DleInTheDataIsLeftAlone) {
+  // Control word 0x00FE: on UDP the DLE byte is just data, never doubled
+  EXPECT_TRUE(decode5(tsl5Packet({ { 3, 0x00FE, "CAM 3" } })));
+  EXPECT_EQ(decoder.display(3).control, 0x33);
+  EXPECT_STREQ(decoder.display(3).label, "CAM 3");
+  EXPECT_EQ(metrics.packetsMalformed.load(), 0u);
+}
+
+TEST_F(TslDecoderTest, Tsl5TruncatedPacketIsMalformed) {
+  Bytes data = tsl5Packet({ { 3, tsl5Control(1, 0, 0, 3), "CAM 3" } });
+  data.resize(data.size() - 2);  // PBC now runs past the datagram
+
+  EXPECT_FALSE(decode5(data));
+  EXPECT_EQ(decoder.display(3).control, 0);
+  EXPECT_EQ(metrics.packetsMalformed.load(), 1u);
+}
+
+TEST_F(TslDecoderTest, Tsl5DmsgPastPacketIsMalformed) {
+  Bytes data = tsl5Packet({ { 3, tsl5Control(1, 0, 0, 3), "CAM 3" } });
+  data[TSL5_HEADER_LENGTH + 4] = 40;  // Text length beyond the packet
+
+  EXPECT_FALSE(decode5(data));
+  EXPECT_EQ(decoder.display(3).control, 0);
+  EXPECT_EQ(metrics.packetsMalformed.load(), 1u);
+}
+
+TEST_F(TslDecoderTest, Tsl5TrailingBytesAreMalformed) {
+  Bytes data = tsl5Packet({ { 3, tsl5Control(1, 0, 0, 3), "CAM 3" } });
+  data.push_back(0);
+  data.push_back(0);
+
+  EXPECT_TRUE(decode5(data));  // The complete packet still counts
+  EXPECT_EQ(metrics.packetsMalformed.load(), 1u);
+
+  EXPECT_FALSE(decode5(Bytes{ 0x04, 0x00, 0x00 }));  // Shorter than a header
+  EXPECT_EQ(metrics.packetsMalformed.load(), 2u);
+}
+
+TEST_F(TslDecoderTest, StateVersionTracksChanges) {
+  uint32_t v = decoder.stateVersion();
+  decode31(tsl31Message(3, 0x32, "CAM 3"));
+  EXPECT_GT(decoder.stateVersion(), v);
+
+  v = decoder.stateVersion();
+  decode31(tsl31Message(3, 0x32, "CAM 3"));  // Periodic resend: nothing new
+  EXPECT_EQ(decoder.stateVersion(), v);
+
+  decode31(tsl31Message(3, 0x32, "CAM 3B"));  // Our label
+  EXPECT_GT(decoder.stateVersion(), v);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
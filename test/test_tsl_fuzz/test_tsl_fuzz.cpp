@@ -0,0 +1,190 @@
+/*
+    Fuzzing the TSL decoders and the stream deframer with mutated packets
+    Video Walrus 2025
+
+    Deterministic (fixed xorshift seeds), so a failure replays. Each case
+    starts from a well-formed packet and flips bits, truncates, repeats
+    or splices it, then checks that the decoder kept its invariants.
+    Every input sits in a buffer of exactly its length, so building with
+    -fsanitize=address also catches a read past the end.
+*/
+
+#include <gtest/gtest.h>
+
+#include "../tally_test.h"
+#include "tsl_stream.h"
+
+#define FUZZ_CASES 200000
+
+static uint32_t nextRandom(uint32_t &rng) {
+  rng ^= rng << 13;
+  rng ^= rng >> 17;
+  rng ^= rng << 5;
+  return rng;
+}
+
+// A well-formed datagram of a random shape
+static Bytes seedPacket(uint32_t &rng, bool tsl5) {
+  Bytes data;
+  int messages = 1 + nextRandom(rng) % 6;
+  if (!tsl5) {
+    for (int i = 0; i < messages; i++) {
+      append(data, tsl31Message(nextRandom(rng) % (TSL_MAX_ADDRESS + 1), nextRandom(rng), "FUZZ LABEL"));
+    }
+    return data;
+  }
+  std::vector<Tsl5Dmsg> dmsgs;
+  for (int i = 0; i < messages; i++) {
+    uint16_t index = nextRandom(rng) % 8 == 0 ? TSL5_BROADCAST : nextRandom(rng) % 200;
+    dmsgs.push_back({ index, (uint16_t)nextRandom(rng), std::string("FUZZ\xFE") + (char)(nextRandom(rng) % 128) });
+  }
+  data = tsl5Packet(dmsgs, nextRandom(rng) % 4);
+  if (nextRandom(rng) % 2) data = tsl5Stuff(data);
+  return data;
+}
+
+static void mutate(Bytes &data, uint32_t &rng) {
+  int edits = 1 + nextRandom(rng) % 4;
+  for (int e = 0; e < edits; e++) {
+    switch (nextRandom(rng) % 6) {
+      case 0:  // Flip a bit
+        if (!data.empty()) data[nextRandom(rng) % data.size()] ^= 1 << (nextRandom(rng) % 8);
+        break;
+      case 1:  // Truncate
+        data.resize(data.empty() ? 0 : nextRandom(rng) % data.size());
+        break;
+      case 2:  // Random byte anywhere, often a DLE
+        data.insert(data.begin() + (data.empty() ? 0 : nextRandom(rng) % data.size()),
+                    nextRandom(rng) % 2 ? TSL5_DLE : (uint8_t)nextRandom(rng));
+        break;
+      case 3:  // Big length field
+        if (data.size() >= 2) {
+          size_t at = nextRandom(rng) % (data.size() - 1);
+          data[at] = 0xFF;
+          data[at + 1] = nextRandom(rng) % 2 ? 0xFF : 0x7F;
+        }
+        break;
+      case 4:  // Repeat a slice
+        if (!data.empty()) {
+          size_t at = nextRandom(rng) % data.size();
+          Bytes slice(data.begin() + at, data.end());
+          append(data, slice);
+        }
+        break;
+      case 5:  // Pure noise tail
+        for (int i = nextRandom(rng) % 8; i > 0; i--) data.push_back(nextRandom(rng));
+        break;
+    }
+  }
+}
+
+static void expectSane(const TslDecoder &decoder) {
+  for (int addr = 0; addr <= TSL_MAX_ADDRESS; addr++) {
+    const TslDisplay &d = decoder.display(addr);
+    ASSERT_EQ(d.control & 0xC0, 0) << "address " << addr;
+    size_t len = strnlen(d.label, sizeof(d.label));
+    ASSERT_LE(len, 16u) << "address " << addr;
+    for (size_t i = 0; i < len; i++) ASSERT_TRUE(d.label[i] >= 32 && d.label[i] < 127) << "address " << addr;
+    if (len > 0) {
+      ASSERT_NE(d.label[len - 1], ' ');
+    }
+  }
+}
+
+static void expectSnapshotSane(TallyMailbox &mailbox, uint8_t maxBrightness) {
+  TallySnapshot snap;
+  mailbox.peek(snap);
+  ASSERT_LE(snap.state, 15);
+  ASSERT_LE(snap.brightness, maxBrightness);
+  ASSERT_LE(strnlen(snap.text, sizeof(snap.text)), 16u);
+}
+
+class TslFuzzTest : public ::testing::TestWithParam<bool> {};
+
+TEST_P(TslFuzzTest, MutatedDatagramsKeepInvariants) {
+  bool tsl5 = GetParam();
+  FakeClock clock;
+  TallyMailbox mailbox;
+  TallyMetrics metrics;
+  TallyRules rules;
+  ASSERT_TRUE(rules.parse("1:1:R:T,126:4:G:PV:9,0:2:Y:T"));
+  TslDecoder decoder(mailbox, clock);
+  decoder.address = 5;
+  decoder.metrics = &metrics;
+  decoder.rules = &rules;
+
+  uint32_t rng = tsl5 ? 0x5eed5 : 0x5eed3;
+  for (int i = 0; i < FUZZ_CASES; i++) {
+    Bytes data = seedPacket(rng, tsl5);
+    mutate(data, rng);
+    Bytes exact(data);  // Exactly len bytes on the heap
+    if (tsl5) decoder.decodeTsl5(exact.data(), exact.size(), clock.micros());
+    else decoder.decodeTsl31(exact.data(), exact.size(), clock.micros());
+    if (i % 1000 == 0) {
+      expectSane(decoder);
+      expectSnapshotSane(mailbox, decoder.maxBrightness);
+      if (HasFatalFailure()) FAIL() << "case " << i;
+    }
+  }
+  expectSane(decoder);
+  EXPECT_GT(metrics.packetsMalformed.load(), 0u);  // The mutations did reach the checks
+}
+
+TEST_P(TslFuzzTest, WrongProtocolIsHarmless) {
+  bool tsl5 = GetParam();
+  FakeClock clock;
+  TallyMailbox mailbox;
+  TslDecoder decoder(mailbox, clock);
+  uint32_t rng = 0xfeed;
+  for (int i = 0; i < FUZZ_CASES / 10; i++) {
+    Bytes data = seedPacket(rng, !tsl5);  // The other protocol's packets
+    if (tsl5) decoder.decodeTsl5(data.data(), data.size(), 0);
+    else decoder.decodeTsl31(data.data(), data.size(), 0);
+  }
+  expectSane(decoder);
+}
+
+TEST_P(TslFuzzTest, DeframerSurvivesAnyStream) {
+  bool tsl5 = GetParam();
+  FakeClock clock;
+  TallyMailbox mailbox;
+  TslDecoder decoder(mailbox, clock);
+  TslStreamDeframer deframer;
+  deframer.begin(tsl5 ? TSL_PROTOCOL_V50 : TSL_PROTOCOL_V31);
+
+  uint32_t rng = 0xabcdef;
+  size_t packets = 0;
+  for (int i = 0; i < FUZZ_CASES / 10; i++) {
+    Bytes data = seedPacket(rng, tsl5);
+    if (tsl5 && data[0] != TSL5_DLE) data = tsl5Stuff(data);  // Always framed on TCP
+    if (nextRandom(rng) % 3 == 0) mutate(data, rng);
+    const uint8_t *p = data.data();
+    size_t len = data.size();
+    while (len > 0) {
+      size_t chunk = 1 + nextRandom(rng) % (len < 64 ? len : 64);
+      size_t left = chunk;
+      const uint8_t *before = p;
+      while (left > 0) {
+        int n = deframer.next(p, left);
+        if (n <= 0) continue;
+        ASSERT_LE((size_t)n, (size_t)TSL_STREAM_MAX_PACKET);
+        packets++;
+        Bytes packet(deframer.packet(), deframer.packet() + n);
+        if (tsl5) decoder.decodeTsl5(packet.data(), packet.size(), 0);
+        else decoder.decodeTsl31(packet.data(), packet.size(), 0);
+      }
+      ASSERT_EQ(p, before + chunk);
+      len -= chunk;
+    }
+  }
+  expectSane(decoder);
+  EXPECT_GT(packets, (size_t)FUZZ_CASES / 20);
+}
+
+INSTANTIATE_TEST_SUITE_P(Protocols, TslFuzzTest, ::testing::Values(false, true),
+                         [](const ::testing::TestParamInfo<bool> &info) { return info.param ? "Tsl5" : "Tsl31"; });
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,138 @@
+/*
+    TslStreamDeframer: TSL 3.1 and 5.0 packets back out of a TCP stream
+    Video Walrus 2025
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "../tally_test.h"
+#include "tsl_stream.h"
+
+// Feeds the stream in pieces of at most chunk bytes; returns every packet
+static std::vector<Bytes> deframe(TslStreamDeframer &deframer, const Bytes &stream, size_t chunk) {
+  std::vector<Bytes> packets;
+  for (size_t at = 0; at < stream.size(); at += chunk) {
+    const uint8_t *data = stream.data() + at;
+    size_t len = std::min(chunk, stream.size() - at);
+    while (len > 0) {
+      int n = deframer.next(data, len);
+      if (n > 0) packets.push_back(Bytes(deframer.packet(), deframer.packet() + n));
+    }
+  }
+  return packets;
+}
+
+TEST(TslStreamDeframer, Tsl31MessagesInAnyPieces) {
+  Bytes stream = tsl31Message(1, 0x31, "ONE");
+  append(stream, tsl31Message(2, 0x32, "TWO"));
+  append(stream, tsl31Message(3, 0x33, "THREE"));
+
+  for (size_t chunk : { (size_t)1, (size_t)5, (size_t)18, (size_t)64 }) {
+    TslStreamDeframer deframer;
+    deframer.begin(TSL_PROTOCOL_V31);
+    std::vector<Bytes> packets = deframe(deframer, stream, chunk);
+    ASSERT_EQ(packets.size(), 3u) << "chunk " << chunk;
+    EXPECT_EQ(packets[0], tsl31Message(1, 0x31, "ONE"));
+    EXPECT_EQ(packets[2], tsl31Message(3, 0x33, "THREE"));
+    EXPECT_EQ(deframer.discarded(), 0u);
+  }
+}
+
+TEST(TslStreamDeframer, Tsl31ResyncsOnTheNextHeader) {
+  Bytes stream = { 'x', 'y' };                   // Joined mid-message
+  Bytes cut = tsl31Message(1, 0x31, "CUT");
+  stream.insert(stream.end(), cut.begin(), cut.begin() + 7);  // Cut short
+  append(stream, tsl31Message(2, 0x32, "TWO"));
+
+  TslStreamDeframer deframer;
+  deframer.begin(TSL_PROTOCOL_V31);
+  std::vector<Bytes> packets = deframe(deframer, stream, 4);
+  ASSERT_EQ(packets.size(), 1u);
+  EXPECT_EQ(packets[0], tsl31Message(2, 0x32, "TWO"));
+  EXPECT_EQ(deframer.discarded(), 9u);
+}
+
+TEST(TslStreamDeframer, Tsl5PacketsAsSoonAsComplete) {
+  Bytes first = tsl5Packet({ { 1, tsl5Control(1, 0, 0, 3), "ONE" } });
+  Bytes second = tsl5Packet({ { 2, tsl5Control(2, 0, 0, 3), "TWO" } });
+  Bytes framed = tsl5Stuff(first);
+
+  TslStreamDeframer deframer;
+  deframer.begin(TSL_PROTOCOL_V50);
+  const uint8_t *data = framed.data();
+  size_t len = framed.size();
+  EXPECT_EQ(deframer.next(data, len), (int)first.size());  // No need to wait for the next DLE/STX
+  EXPECT_EQ(len, 0u);
+  EXPECT_EQ(Bytes(deframer.packet(), deframer.packet() + first.size()), first);
+
+  Bytes stream = framed;
+  append(stream, tsl5Stuff(second));
+  for (size_t chunk : { (size_t)1, (size_t)3, (size_t)100 }) {
+    deframer.begin(TSL_PROTOCOL_V50);
+    std::vector<Bytes> packets = deframe(deframer, stream, chunk);
+    ASSERT_EQ(packets.size(), 2u) << "chunk " << chunk;
+    EXPECT_EQ(packets[0], first);
+    EXPECT_EQ(packets[1], second);
+    EXPECT_EQ(deframer.discarded(), 0u);
+  }
+}
+
+TEST(TslStreamDeframer, Tsl5StuffedDleSplitAcrossReads) {
+  // Control 0x00FE puts a DLE in the data, doubled on the wire
+  Bytes packet = tsl5Packet({ { 3, 0x00FE, "CAM 3" } });
+  Bytes framed = tsl5Stuff(packet);
+  ASSERT_EQ(framed.size(), packet.size() + 3);  // DLE/STX and one doubled DLE
+
+  TslStreamDeframer deframer;
+  deframer.begin(TSL_PROTOCOL_V50);
+  std::vector<Bytes> packets = deframe(deframer, framed, 1);
+  ASSERT_EQ(packets.size(), 1u);
+  EXPECT_EQ(packets[0], packet);
+
+  // The decoder takes it as it would the datagram
+  FakeClock clock;
+  TallyMailbox mailbox;
+  TslDecoder decoder(mailbox, clock);
+  decoder.address = 3;
+  EXPECT_TRUE(decoder.decodeTsl5(packets[0].data(), packets[0].size(), 0));
+  EXPECT_EQ(decoder.display(3).control, 0x33);
+  EXPECT_STREQ(decoder.display(3).label, "CAM 3");
+}
+
+TEST(TslStreamDeframer, Tsl5CutPacketIsDropped) {
+  Bytes cut = tsl5Stuff(tsl5Packet({ { 1, tsl5Control(1, 0, 0, 3), "LOST" } }));
+  cut.resize(cut.size() - 3);
+  Bytes good = tsl5Packet({ { 2, tsl5Control(2, 0, 0, 3), "TWO" } });
+  Bytes stream = { 0x11, 0x22 };  // Noise before any DLE/STX
+  append(stream, cut);
+  append(stream, tsl5Stuff(good));
+
+  TslStreamDeframer deframer;
+  deframer.begin(TSL_PROTOCOL_V50);
+  std::vector<Bytes> packets = deframe(deframer, stream, 7);
+  ASSERT_EQ(packets.size(), 1u);
+  EXPECT_EQ(packets[0], good);
+  EXPECT_EQ(deframer.discarded(), 2u + cut.size());  // Counted as they came on the wire
+}
+
+TEST(TslStreamDeframer, BeginDropsAPartialPacket) {
+  Bytes packet = tsl5Packet({ { 1, tsl5Control(1, 0, 0, 3), "ONE" } });
+  Bytes framed = tsl5Stuff(packet);
+  TslStreamDeframer deframer;
+  deframer.begin(TSL_PROTOCOL_V50);
+  const uint8_t *data = framed.data();
+  size_t len = 5;
+  EXPECT_EQ(deframer.next(data, len), 0);
+
+  deframer.begin(TSL_PROTOCOL_V50);  // Reconnected
+  std::vector<Bytes> packets = deframe(deframer, framed, framed.size());
+  ASSERT_EQ(packets.size(), 1u);
+  EXPECT_EQ(packets[0], packet);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
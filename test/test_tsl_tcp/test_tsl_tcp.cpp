@@ -0,0 +1,234 @@
+/*
+    TslTcpClient against a TSL server stand-in on 127.0.0.1: packets
+    split across writes, a dropped connection, and the reconnect back-off
+    Video Walrus 2025
+
+    The socket is real; the client's clock is the test's, so the back-off
+    is timed without waiting for it.
+*/
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <thread>
+
+#include "../tally_test.h"
+#include "tsl_stream.h"
+
+#define SERVER_PORT 19892
+
+// Listens on the loopback and talks to one client at a time
+class TslServer {
+ public:
+  ~TslServer() {
+    closeClient();
+    stopListening();
+  }
+
+  bool listen() {
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(SERVER_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || ::listen(fd, 4) < 0) return false;
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    return true;
+  }
+
+  void stopListening() {
+    if (fd >= 0) close(fd);
+    fd = -1;
+  }
+
+  bool accept() {
+    if (client < 0 && fd >= 0) client = ::accept(fd, NULL, NULL);
+    return client >= 0;
+  }
+
+  // Each piece is its own write, with a pause so it is its own segment
+  void send(const Bytes &data, size_t piece) {
+    for (size_t i = 0; i < data.size(); i += piece) {
+      size_t n = std::min(piece, data.size() - i);
+      ASSERT_EQ(::send(client, data.data() + i, n, MSG_NOSIGNAL), (ssize_t)n);
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+  }
+
+  void closeClient() {
+    if (client >= 0) close(client);
+    client = -1;
+  }
+
+ private:
+  int fd = -1;
+  int client = -1;
+};
+
+class TslTcpTest : public ::testing::Test {
+ protected:
+  TslTcpTest() : decoder(mailbox, clock), client(socket, clock) {
+    decoder.address = 1;
+    client.metrics = &metrics;
+  }
+
+  // Run the receive task's calls until done() or a second has passed
+  template <typename Done>
+  bool pump(Done done) {
+    for (int i = 0; i < 1000; i++) {
+      client.service(true);
+      bool ours;
+      packets += client.receive(decoder, clock.micros(), ours);
+      server.accept();
+      if (done()) return true;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+  }
+
+  bool connect() {
+    return pump([&]() { return client.state() == TSL_TCP_CONNECTED && server.accept(); });
+  }
+
+  // Let the back-off run out on the test's clock, 10 ms at a time; the
+  // time it took
+  uint32_t waitOut() {
+    uint32_t start = clock.millis();
+    while (client.state() == TSL_TCP_WAITING && clock.millis() - start < 20000) {
+      clock.advanceMs(10);
+      client.service(true);
+    }
+    return clock.millis() - start;
+  }
+
+  FakeClock clock;
+  TallyMailbox mailbox;
+  TslDecoder decoder;
+  TallyMetrics metrics;
+  TcpSocket socket;
+  TslTcpClient client;
+  TslServer server;
+  int packets = 0;
+};
+
+TEST_F(TslTcpTest, Tsl31SplitAcrossWrites) {
+  ASSERT_TRUE(server.listen());
+  client.begin(htonl(INADDR_LOOPBACK), SERVER_PORT, TSL_PROTOCOL_V31);
+  ASSERT_TRUE(connect());
+
+  Bytes stream = tsl31Message(1, 0x31, "CAM 1");
+  append(stream, tsl31Message(2, 0x32, "CAM 2"));
+  append(stream, tsl31Message(1, 0x32, "CAM 1 LIVE"));
+  server.send(stream, 7);  // No write is a whole message
+  ASSERT_TRUE(pump([&]() { return packets == 3; }));
+  EXPECT_STREQ(decoder.display(1).label, "CAM 1 LIVE");
+  EXPECT_EQ(decoder.display(1).control, 0x32);
+  EXPECT_STREQ(decoder.display(2).label, "CAM 2");
+  EXPECT_EQ(metrics.tcpConnects.load(), 1u);
+  EXPECT_EQ(client.discarded(), 0u);
+}
+
+TEST_F(TslTcpTest, Tsl5SplitInsideDleStuffing) {
+  ASSERT_TRUE(server.listen());
+  client.begin(htonl(INADDR_LOOPBACK), SERVER_PORT, TSL_PROTOCOL_V50);
+  ASSERT_TRUE(connect());
+
+  // 0x10 (DLE) in the index and the text: every pair is doubled on the wire
+  Bytes stream = tsl5Stuff(tsl5Packet({ { 1, tsl5Control(1, 0, 0, 3), "A\x10" "B" } }));
+  append(stream, tsl5Stuff(tsl5Packet({ { 0x10, tsl5Control(2, 0, 0, 3), "SIXTEEN" } })));
+  for (size_t piece : { 1, 2, 3 }) {
+    packets = 0;
+    server.send(stream, piece);
+    ASSERT_TRUE(pump([&]() { return packets == 2; })) << piece << "-byte writes";
+  }
+  EXPECT_STREQ(decoder.display(16).label, "SIXTEEN");
+  EXPECT_EQ(client.discarded(), 0u);
+}
+
+TEST_F(TslTcpTest, ReconnectsAfterTheServerDrops) {
+  ASSERT_TRUE(server.listen());
+  client.begin(htonl(INADDR_LOOPBACK), SERVER_PORT, TSL_PROTOCOL_V31);
+  ASSERT_TRUE(connect());
+  server.send(tsl31Message(1, 0x31, "BEFORE"), 18);
+  ASSERT_TRUE(pump([&]() { return packets == 1; }));
+
+  server.closeClient();
+  ASSERT_TRUE(pump([&]() { return client.state() == TSL_TCP_WAITING; }));
+  EXPECT_EQ(metrics.tcpDrops.load(), 1u);
+  EXPECT_LE(waitOut(), (uint32_t)TSL_TCP_RETRY_MS + 10);
+
+  ASSERT_TRUE(connect());
+  server.send(tsl31Message(1, 0x32, "AFTER"), 5);
+  ASSERT_TRUE(pump([&]() { return packets == 2; }));
+  EXPECT_STREQ(decoder.display(1).label, "AFTER");
+  EXPECT_EQ(metrics.tcpConnects.load(), 2u);
+}
+
+TEST_F(TslTcpTest, PartialMessageAtTheDropIsDiscarded) {
+  ASSERT_TRUE(server.listen());
+  client.begin(htonl(INADDR_LOOPBACK), SERVER_PORT, TSL_PROTOCOL_V31);
+  ASSERT_TRUE(connect());
+  Bytes cut = tsl31Message(1, 0x32, "CUT");
+  cut.resize(9);
+  server.send(cut, 9);
+  server.closeClient();
+  ASSERT_TRUE(pump([&]() { return client.state() == TSL_TCP_WAITING; }));
+  waitOut();
+  ASSERT_TRUE(connect());
+  server.send(tsl31Message(2, 0x31, "WHOLE"), 18);
+  ASSERT_TRUE(pump([&]() { return packets == 1; }));
+  EXPECT_EQ(decoder.display(1).control, 0);  // The half message never decoded
+  EXPECT_STREQ(decoder.display(2).label, "WHOLE");
+}
+
+// No server: each refused attempt doubles the back-off, with jitter, up
+// to TSL_TCP_MAX_RETRY_MS
+TEST_F(TslTcpTest, BackOffDoublesWhileRefused) {
+  client.begin(htonl(INADDR_LOOPBACK), SERVER_PORT, TSL_PROTOCOL_V31, 0x1234);
+  client.service(true);  // First attempt straight away
+  uint32_t backoff = TSL_TCP_RETRY_MS;
+  for (int attempt = 0; attempt < 8; attempt++) {
+    ASSERT_TRUE(pump([&]() { return client.state() == TSL_TCP_WAITING; }));
+    uint32_t waited = waitOut();
+    EXPECT_GE(waited, backoff / 2) << "attempt " << attempt;
+    EXPECT_LE(waited, backoff + 10) << "attempt " << attempt;
+    backoff = std::min(backoff * 2, (uint32_t)TSL_TCP_MAX_RETRY_MS);
+  }
+  EXPECT_EQ(metrics.tcpConnects.load(), 0u);
+  EXPECT_EQ(metrics.tcpDrops.load(), 0u);  // Never connected, so never dropped
+
+  // A connection that stays up resets it
+  ASSERT_TRUE(server.listen());
+  ASSERT_TRUE(pump([&]() { return client.state() == TSL_TCP_WAITING; }));  // The attempt already under way
+  waitOut();
+  ASSERT_TRUE(connect());
+  clock.advanceMs(TSL_TCP_STABLE_MS);
+  server.closeClient();
+  ASSERT_TRUE(pump([&]() { return client.state() == TSL_TCP_WAITING; }));
+  EXPECT_LE(waitOut(), (uint32_t)TSL_TCP_RETRY_MS + 10);
+}
+
+TEST_F(TslTcpTest, NetworkDownDropsTheConnection) {
+  ASSERT_TRUE(server.listen());
+  client.begin(htonl(INADDR_LOOPBACK), SERVER_PORT, TSL_PROTOCOL_V31);
+  ASSERT_TRUE(connect());
+  client.service(false);
+  EXPECT_EQ(client.state(), TSL_TCP_WAITING);
+  EXPECT_EQ(metrics.tcpDrops.load(), 1u);
+  clock.advanceMs(TSL_TCP_MAX_RETRY_MS);
+  client.service(false);
+  EXPECT_EQ(client.state(), TSL_TCP_WAITING);  // No attempt without a network
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,130 @@
+/*
+    Loopback UDP harness: cue latency of the blocking, draining receive
+    loop against the old 5 ms polling loop
+    Video Walrus 2025
+
+    A sender thread replays bursts of TSL 3.1 packets to a receiver on
+    127.0.0.1. Each packet's label carries its sequence number, so the
+    receiver can time it from send to decoded (mailbox published).
+*/
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "../tally_test.h"
+#include "native/hal_linux.h"
+
+#define LOOPBACK_BURSTS 40
+#define LOOPBACK_BURST_PACKETS 8   // A cut plus the resends of a busy switcher
+#define LOOPBACK_BURST_GAP_MS 50   // Polling keeps up between bursts
+#define LOOPBACK_POLL_MS 5         // The old udpListenerTask delay
+
+enum ReceiveMode {
+  RECEIVE_DRAIN,  // wait() on the socket, then every queued datagram
+  RECEIVE_POLL,   // One receive(), then sleep LOOPBACK_POLL_MS
+};
+
+struct LatencyResult {
+  size_t received;
+  uint32_t p50Us;
+  uint32_t p99Us;
+};
+
+static uint32_t percentile(std::vector<uint32_t> v, int pct) {
+  std::sort(v.begin(), v.end());
+  return v[(v.size() - 1) * pct / 100];
+}
+
+static LatencyResult replay(ReceiveMode mode) {
+  const size_t total = LOOPBACK_BURSTS * LOOPBACK_BURST_PACKETS;
+  SteadyClock clock;
+  TallyMailbox mailbox;
+  TslDecoder decoder(mailbox, clock);
+  decoder.address = 1;
+
+  UdpSocket rx;
+  EXPECT_TRUE(rx.begin(0));  // Any free port, so parallel runs don't collide
+  uint16_t port = rx.localPort();
+  EXPECT_NE(port, 0);
+  std::vector<uint32_t> sentUs(total, 0);
+  std::vector<uint32_t> latencyUs;
+  std::atomic<bool> sending{true};
+
+  std::thread sender([&]() {
+    UdpSocket tx;
+    tx.open();
+    for (size_t seq = 0; seq < total; seq++) {
+      char label[17];
+      snprintf(label, sizeof(label), "%05u", (unsigned)seq);
+      Bytes packet = tsl31Message(1, seq & 1 ? 0x32 : 0x31, label);
+      sentUs[seq] = clock.micros();
+      tx.sendTo(htonl(INADDR_LOOPBACK), port, packet.data(), packet.size());
+      if (seq % LOOPBACK_BURST_PACKETS == LOOPBACK_BURST_PACKETS - 1) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(LOOPBACK_BURST_GAP_MS));
+      }
+    }
+    sending = false;
+  });
+
+  // The receive task: decode, then time the snapshot the render task gets
+  uint8_t buf[256];
+  TallySnapshot snap;
+  uint32_t seq = 0;
+  auto handle = [&](int len) {
+    decoder.decodeTsl31(buf, len, clock.micros());
+    if (!mailbox.read(snap, seq)) return;
+    unsigned n = atoi(snap.text);
+    if (n < total) latencyUs.push_back(snap.decodedMicros - sentUs[n]);
+  };
+  for (;;) {
+    bool done = !sending;  // Read before the last pass, so nothing sent is missed
+    int len = 0;
+    if (mode == RECEIVE_DRAIN) {
+      if (rx.wait(50)) {
+        while ((len = rx.receive(buf, sizeof(buf))) > 0) handle(len);
+      }
+    } else {
+      len = rx.receive(buf, sizeof(buf));
+      if (len > 0) handle(len);
+      std::this_thread::sleep_for(std::chrono::milliseconds(LOOPBACK_POLL_MS));
+    }
+    if (done && len == 0 && !rx.wait(0)) break;
+  }
+  sender.join();
+  rx.stop();
+
+  LatencyResult result = { latencyUs.size(), 0, 0 };
+  if (!latencyUs.empty()) {
+    result.p50Us = percentile(latencyUs, 50);
+    result.p99Us = percentile(latencyUs, 99);
+  }
+  return result;
+}
+
+TEST(UdpLoopback, DrainBeatsPolling) {
+  LatencyResult drain = replay(RECEIVE_DRAIN);
+  LatencyResult poll = replay(RECEIVE_POLL);
+  printf("  drain: %zu packets, p50 %u us, p99 %u us\n", drain.received, drain.p50Us, drain.p99Us);
+  printf("  poll:  %zu packets, p50 %u us, p99 %u us\n", poll.received, poll.p50Us, poll.p99Us);
+
+  const size_t total = LOOPBACK_BURSTS * LOOPBACK_BURST_PACKETS;
+  EXPECT_EQ(drain.received, total);
+  EXPECT_EQ(poll.received, total);
+  // Polling takes one packet per 5 ms, so a burst queues behind itself
+  // and waits tens of milliseconds. Only the ordering is checked, with
+  // room to spare, so a loaded machine doesn't fail the test.
+  EXPECT_LT(drain.p50Us, poll.p50Us / 2);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}